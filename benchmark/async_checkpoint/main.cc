@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+
+#include <xtensor/xarray.hpp>
+#include <xtensor/xrandom.hpp>
+
+#include "benchmark/util.h"
+#include "tensorward/core.h"
+#include "tensorward/function.h"
+#include "tensorward/model.h"
+#include "tensorward/optimizer.h"
+
+#define DEBUG_PRINT_SCALAR(var) std::cout << #var << " = " << var << std::endl;
+
+namespace TW = tensorward::core;
+namespace F = tensorward::function;
+namespace M = tensorward::model;
+namespace O = tensorward::optimizer;
+
+int main(int argc, char* argv[]) {
+  // Same size as the model of the MNIST example.
+  constexpr std::size_t kBatchSize = 100;
+  constexpr std::size_t kInSize = 784;
+  constexpr std::size_t kHiddenSize = 1000;
+  constexpr std::size_t kOutSize = 10;
+  constexpr float kLearningRate = 0.01;
+  constexpr float kMomentum = 0.9;
+
+  constexpr std::size_t kMaxIteration = 200;
+  constexpr std::size_t kCheckpointInterval = 20;
+
+  M::MultiLayerPerceptron model({kHiddenSize, kHiddenSize, kOutSize}, TW::AsFunctionSharedPtr<F::ReLU>());
+  O::MomentumStochasticGradientDescent optimizer(kLearningRate, kMomentum);
+  const TW::TensorSharedPtr x_ptr = TW::AsTensorSharedPtr(xt::random::rand<float>({kBatchSize, kInSize}));
+  const TW::TensorSharedPtr t_ptr =
+      TW::AsTensorSharedPtr(xt::xarray<float>(xt::random::randint<int>({kBatchSize}, 0, kOutSize)));
+
+  const std::filesystem::path file_path = std::filesystem::temp_directory_path() / "tensorward_benchmark.ckpt";
+
+  // Trains with the synchronous checkpoints first, and then with the asynchronous ones.
+  double max_sync_stall_seconds = 0.0;
+  double sum_sync_stall_seconds = 0.0;
+  double max_async_stall_seconds = 0.0;
+  double sum_async_stall_seconds = 0.0;
+  std::size_t num_checkpoints = 0;
+  TW::AsyncCheckpointWriter checkpoint_writer;
+  for (const bool does_write_asynchronously : {false, true}) {
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < kMaxIteration; ++i) {
+      const TW::TensorSharedPtr y_ptr = model.Predict({x_ptr})[0];
+      const TW::TensorSharedPtr loss_ptr = F::softmax_cross_entropy_error(y_ptr, t_ptr);
+      model.ClearGrads();
+      loss_ptr->Backpropagation();
+      optimizer.Update(model.GetParamPtrs());
+
+      if ((i + 1) % kCheckpointInterval != 0) {
+        continue;
+      }
+      if (does_write_asynchronously) {
+        checkpoint_writer.Save(file_path, model, &optimizer);
+        max_async_stall_seconds = std::max(max_async_stall_seconds, checkpoint_writer.last_stall_seconds());
+        sum_async_stall_seconds += checkpoint_writer.last_stall_seconds();
+      } else {
+        const double stall_seconds = benchmark::MeasureSeconds([&]() {
+          TW::SaveCheckpoint(file_path, TW::TakeCheckpointSnapshot(model, &optimizer), /* does_sync = */ true);
+        });
+        max_sync_stall_seconds = std::max(max_sync_stall_seconds, stall_seconds);
+        sum_sync_stall_seconds += stall_seconds;
+        ++num_checkpoints;
+      }
+    }
+    checkpoint_writer.Wait();
+    const double seconds = benchmark::SecondsSince(start);
+
+    DEBUG_PRINT_SCALAR(does_write_asynchronously);
+    DEBUG_PRINT_SCALAR(seconds);
+  }
+  std::filesystem::remove(file_path);
+  std::cout << std::endl;
+
+  DEBUG_PRINT_SCALAR(num_checkpoints);
+  DEBUG_PRINT_SCALAR(checkpoint_writer.num_written_checkpoints());
+  DEBUG_PRINT_SCALAR(checkpoint_writer.num_dropped_checkpoints());
+  DEBUG_PRINT_SCALAR(sum_sync_stall_seconds / num_checkpoints);   // [s]
+  DEBUG_PRINT_SCALAR(max_sync_stall_seconds);                     // [s]
+  DEBUG_PRINT_SCALAR(sum_async_stall_seconds / num_checkpoints);  // [s]
+  DEBUG_PRINT_SCALAR(max_async_stall_seconds);                    // [s]
+
+  return EXIT_SUCCESS;
+}
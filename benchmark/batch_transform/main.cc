@@ -0,0 +1,110 @@
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <xtensor/xarray.hpp>
+#include <xtensor/xmanipulation.hpp>
+#include <xtensor/xmath.hpp>
+#include <xtensor/xrandom.hpp>
+#include <xtensor/xview.hpp>
+
+#include "benchmark/util.h"
+#include "tensorward/core.h"
+#include "tensorward/transforms.h"
+
+#define DEBUG_PRINT_SCALAR(var) std::cout << #var << " = " << var << std::endl;
+
+namespace TW = tensorward::core;
+namespace TF = tensorward::transforms;
+
+namespace {
+
+// Same shape as the training dataset of MNIST.
+constexpr std::size_t kNumImages = 60000;
+constexpr std::size_t kHeight = 28;
+constexpr std::size_t kWidth = 28;
+constexpr std::size_t kCropSize = 24;
+constexpr std::size_t kBatchSize = 100;
+
+// Dataset of the random images {N, 1, H, W} of [0, 255].
+class RandomImageDataset : public TW::Dataset {
+ public:
+  RandomImageDataset(const std::vector<TW::TransformLambda>& data_transform_lambdas)
+      : TW::Dataset(true, data_transform_lambdas, {}, "RandomImage") {
+    Init();
+  }
+
+  void Init() override {
+    data_ = xt::floor(xt::random::rand<float>({kNumImages, std::size_t(1), kHeight, kWidth}, 0.0, 256.0));
+    label_ = xt::floor(xt::random::rand<float>({kNumImages}, 0.0, 10.0));
+  }
+};
+
+// Measures the time of an epoch of getting the batches from the data loader.
+void MeasureEpoch(const std::string& name, TW::DataLoader& data_loader) {
+  float checksum = 0.0;
+  const double epoch_seconds = benchmark::MeasureSeconds([&]() {
+    for (std::size_t i = 0; i < data_loader.max_iteration(); ++i) {
+      checksum += data_loader.GetBatchAt(i).first.flat(0);
+    }
+  });
+
+  std::cout << "---- " << name << " ----" << std::endl;
+  DEBUG_PRINT_SCALAR(epoch_seconds);
+  DEBUG_PRINT_SCALAR(checksum);
+  std::cout << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const TW::TransformLambda flatten_lambda = [](const xt::xarray<float>& input_data) {
+    return xt::flatten(input_data);
+  };
+  const TW::TransformLambda normalize_lambda = [](const xt::xarray<float>& input_data) {
+    return (input_data - 0.0) / 255.0;
+  };
+  const TW::TransformLambda random_crop_lambda = [](const xt::xarray<float>& input_data) {
+    const std::size_t top = xt::random::randint<std::size_t>({1}, 0, kHeight - kCropSize + 1)(0);
+    const std::size_t left = xt::random::randint<std::size_t>({1}, 0, kWidth - kCropSize + 1)(0);
+    return xt::xarray<float>(
+        xt::view(input_data, xt::all(), xt::range(top, top + kCropSize), xt::range(left, left + kCropSize)));
+  };
+  const TW::TransformLambda random_flip_lambda = [](const xt::xarray<float>& input_data) {
+    return (xt::random::rand<float>({1})(0) < 0.5) ? xt::xarray<float>(xt::flip(input_data, 2)) : input_data;
+  };
+
+  // Flatten and normalize (as the MNIST example).
+  {
+    const TW::DatasetSharedPtr dataset_ptr =
+        std::make_shared<RandomImageDataset>(std::vector<TW::TransformLambda>({flatten_lambda, normalize_lambda}));
+    TW::DataLoader data_loader(dataset_ptr, kBatchSize, true);
+    MeasureEpoch("Flatten + Normalize (transform lambdas for each sample)", data_loader);
+  }
+  {
+    const TW::DatasetSharedPtr dataset_ptr = std::make_shared<RandomImageDataset>(std::vector<TW::TransformLambda>());
+    TW::DataLoader data_loader(dataset_ptr, kBatchSize, true, 1,
+                               TF::Compose({TF::Flatten(), TF::Normalize(0.0, 255.0)}));
+    MeasureEpoch("Flatten + Normalize (Compose for each batch)", data_loader);
+  }
+
+  // With the augmentation.
+  {
+    const TW::DatasetSharedPtr dataset_ptr = std::make_shared<RandomImageDataset>(
+        std::vector<TW::TransformLambda>({random_crop_lambda, random_flip_lambda, flatten_lambda, normalize_lambda}));
+    TW::DataLoader data_loader(dataset_ptr, kBatchSize, true);
+    MeasureEpoch("RandomCrop + RandomHorizontalFlip + Flatten + Normalize (transform lambdas for each sample)",
+                 data_loader);
+  }
+  {
+    const TW::DatasetSharedPtr dataset_ptr = std::make_shared<RandomImageDataset>(std::vector<TW::TransformLambda>());
+    TW::DataLoader data_loader(dataset_ptr, kBatchSize, true, 1,
+                               TF::Compose({TF::RandomCrop(kCropSize, kCropSize), TF::RandomHorizontalFlip(),
+                                            TF::Flatten(), TF::Normalize(0.0, 255.0)}));
+    MeasureEpoch("RandomCrop + RandomHorizontalFlip + Flatten + Normalize (Compose for each batch)", data_loader);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,132 @@
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+#include <xtensor/xarray.hpp>
+#include <xtensor/xmanipulation.hpp>
+#include <xtensor/xmath.hpp>
+#include <xtensor/xpad.hpp>
+#include <xtensor/xrandom.hpp>
+#include <xtensor/xview.hpp>
+
+#include "benchmark/util.h"
+#include "tensorward/core.h"
+
+#define DEBUG_PRINT_SCALAR(var) std::cout << #var << " = " << var << std::endl;
+
+namespace TW = tensorward::core;
+
+namespace {
+
+// Same shape as the training dataset of MNIST.
+constexpr std::size_t kNumImages = 60000;
+constexpr std::size_t kHeight = 28;
+constexpr std::size_t kWidth = 28;
+constexpr std::size_t kBatchSize = 100;
+constexpr std::size_t kNumEpochs = 3;
+
+// Dataset of the random images {N, 1, H, W} of [0, 255].
+class RandomImageDataset : public TW::Dataset {
+ public:
+  RandomImageDataset(const std::vector<TW::TransformLambda>& data_transform_lambdas)
+      : TW::Dataset(true, data_transform_lambdas, {}, "RandomImage") {
+    Init();
+  }
+
+  void Init() override {
+    xt::random::seed(0);
+    data_ = xt::floor(xt::random::rand<float>({kNumImages, std::size_t(1), kHeight, kWidth}, 0.0, 256.0));
+    label_ = xt::floor(xt::random::rand<float>({kNumImages}, 0.0, 10.0));
+  }
+};
+
+// Measures the time of each epoch of getting the batches from the data loader, with the cache stats if it's cached.
+void MeasureEpochs(const std::string& name, TW::DataLoader& data_loader, TW::CachedDataset* cached_dataset = nullptr) {
+  std::cout << "---- " << name << " ----" << std::endl;
+  for (std::size_t epoch = 0; epoch < kNumEpochs; ++epoch) {
+    if (cached_dataset) {
+      cached_dataset->ResetCacheStats();
+    }
+    data_loader.Init();  // Reshuffles the dataset.
+
+    float checksum = 0.0;
+    const double epoch_seconds = benchmark::MeasureSeconds([&]() {
+      for (std::size_t i = 0; i < data_loader.max_iteration(); ++i) {
+        checksum += data_loader.GetBatchAt(i).first.flat(0);
+      }
+    });
+
+    DEBUG_PRINT_SCALAR(epoch);
+    DEBUG_PRINT_SCALAR(epoch_seconds);
+    DEBUG_PRINT_SCALAR(checksum);
+    if (cached_dataset) {
+      const std::size_t num_cache_hits = cached_dataset->num_cache_hits();
+      const std::size_t num_cache_misses = cached_dataset->num_cache_misses();
+      DEBUG_PRINT_SCALAR(num_cache_hits);
+      DEBUG_PRINT_SCALAR(num_cache_misses);
+    }
+  }
+  std::cout << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  // Deterministic transforms: normalization, 3x3 box blur, and flattening.
+  const TW::TransformLambda normalize_lambda = [](const xt::xarray<float>& input_data) {
+    return (input_data - 0.0) / 255.0;
+  };
+  const TW::TransformLambda blur_lambda = [](const xt::xarray<float>& input_data) {
+    const xt::xarray<float> padded_data = xt::pad(input_data, {{0, 0}, {1, 1}, {1, 1}}, xt::pad_mode::edge);
+    xt::xarray<float> output_data = xt::zeros<float>(input_data.shape());
+    for (std::size_t dy = 0; dy < 3; ++dy) {
+      for (std::size_t dx = 0; dx < 3; ++dx) {
+        output_data += xt::view(padded_data, xt::all(), xt::range(dy, dy + kHeight), xt::range(dx, dx + kWidth));
+      }
+    }
+    return xt::xarray<float>(output_data / 9.0);
+  };
+  const TW::TransformLambda flatten_lambda = [](const xt::xarray<float>& input_data) {
+    return xt::flatten(input_data);
+  };
+
+  // Random transform: Gaussian noise.
+  const TW::TransformLambda random_noise_lambda = [](const xt::xarray<float>& input_data) {
+    return xt::xarray<float>(input_data + 0.01 * xt::random::randn<float>(input_data.shape()));
+  };
+
+  const std::vector<TW::TransformLambda> deterministic_lambdas({normalize_lambda, blur_lambda, flatten_lambda});
+
+  {
+    std::vector<TW::TransformLambda> lambdas = deterministic_lambdas;
+    lambdas.push_back(random_noise_lambda);
+    const TW::DatasetSharedPtr dataset_ptr = std::make_shared<RandomImageDataset>(lambdas);
+    TW::DataLoader data_loader(dataset_ptr, kBatchSize, true);
+    MeasureEpochs("Without the cache", data_loader);
+  }
+  {
+    const auto cached_dataset_ptr = std::make_shared<TW::CachedDataset>(
+        std::make_shared<RandomImageDataset>(deterministic_lambdas),
+        std::vector<TW::TransformLambda>({random_noise_lambda}), std::vector<TW::TransformLambda>());
+    TW::DataLoader data_loader(cached_dataset_ptr, kBatchSize, true);
+    MeasureEpochs("In-memory cache", data_loader, cached_dataset_ptr.get());
+  }
+
+  // The second run reuses the cache file of the first one.
+  const std::filesystem::path cache_file_path =
+      std::filesystem::temp_directory_path() / ("tensorward_cached_dataset_" + std::to_string(getpid()));
+  for (const std::string name : {"Cache file (first run)", "Cache file (second run)"}) {
+    const auto cached_dataset_ptr = std::make_shared<TW::CachedDataset>(
+        std::make_shared<RandomImageDataset>(deterministic_lambdas),
+        std::vector<TW::TransformLambda>({random_noise_lambda}), std::vector<TW::TransformLambda>(), cache_file_path);
+    TW::DataLoader data_loader(cached_dataset_ptr, kBatchSize, true);
+    MeasureEpochs(name, data_loader, cached_dataset_ptr.get());
+  }
+  std::filesystem::remove(cache_file_path);
+
+  return EXIT_SUCCESS;
+}
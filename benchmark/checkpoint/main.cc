@@ -0,0 +1,76 @@
+#include <filesystem>
+#include <iostream>
+
+#include <xtensor/xarray.hpp>
+#include <xtensor/xrandom.hpp>
+
+#include "benchmark/util.h"
+#include "tensorward/core.h"
+#include "tensorward/function.h"
+#include "tensorward/model.h"
+#include "tensorward/optimizer.h"
+
+#define DEBUG_PRINT_SCALAR(var) std::cout << #var << " = " << var << std::endl;
+
+namespace TW = tensorward::core;
+namespace F = tensorward::function;
+namespace M = tensorward::model;
+namespace O = tensorward::optimizer;
+
+int main(int argc, char* argv[]) {
+  constexpr std::size_t kBatchSize = 8;
+  constexpr std::size_t kInSize = 4096;
+  constexpr std::size_t kHiddenSize = 4096;
+  constexpr std::size_t kOutSize = 10;
+  constexpr float kLearningRate = 0.01;
+  constexpr float kMomentum = 0.9;
+
+  // Performs a single training step, so that the parameters and the velocities of the momentum exist.
+  M::MultiLayerPerceptron model({kHiddenSize, kHiddenSize, kHiddenSize, kOutSize},
+                                TW::AsFunctionSharedPtr<F::ReLU>());
+  O::MomentumStochasticGradientDescent optimizer(kLearningRate, kMomentum);
+  const TW::TensorSharedPtr x_ptr = TW::AsTensorSharedPtr(xt::random::randn<float>({kBatchSize, kInSize}));
+  model.Predict({x_ptr})[0]->Backpropagation();
+  optimizer.Update(model.GetParamPtrs());
+
+  std::size_t num_params = 0;
+  for (const auto& param_ptr : model.GetParamPtrs()) {
+    num_params += param_ptr->data().size();
+  }
+
+  const std::filesystem::path file_path = std::filesystem::temp_directory_path() / "tensorward_benchmark.ckpt";
+
+  bool is_saved = false;
+  const double save_seconds =
+      benchmark::MeasureSeconds([&]() { is_saved = TW::SaveCheckpoint(file_path, model, &optimizer); });
+  const double file_size_in_megabytes = std::filesystem::file_size(file_path) / 1.0e6;
+
+  // Loads into a fresh model (the parameters are created) and then into the existing model (overwritten in place).
+  M::MultiLayerPerceptron fresh_model({kHiddenSize, kHiddenSize, kHiddenSize, kOutSize},
+                                      TW::AsFunctionSharedPtr<F::ReLU>());
+  O::MomentumStochasticGradientDescent fresh_optimizer(kLearningRate, kMomentum);
+  bool is_fresh_loaded = false;
+  const double fresh_load_seconds = benchmark::MeasureSeconds(
+      [&]() { is_fresh_loaded = TW::LoadCheckpoint(file_path, fresh_model, &fresh_optimizer); });
+
+  bool is_in_place_loaded = false;
+  const double in_place_load_seconds =
+      benchmark::MeasureSeconds([&]() { is_in_place_loaded = TW::LoadCheckpoint(file_path, model, &optimizer); });
+
+  std::filesystem::remove(file_path);
+
+  DEBUG_PRINT_SCALAR(num_params);
+  DEBUG_PRINT_SCALAR(file_size_in_megabytes);  // [MB]
+  std::cout << std::endl;
+
+  DEBUG_PRINT_SCALAR(is_saved);
+  DEBUG_PRINT_SCALAR(is_fresh_loaded);
+  DEBUG_PRINT_SCALAR(is_in_place_loaded);
+  DEBUG_PRINT_SCALAR(save_seconds);                                    // [s]
+  DEBUG_PRINT_SCALAR(fresh_load_seconds);                              // [s]
+  DEBUG_PRINT_SCALAR(in_place_load_seconds);                           // [s]
+  DEBUG_PRINT_SCALAR(file_size_in_megabytes / save_seconds);           // [MB/s]
+  DEBUG_PRINT_SCALAR(file_size_in_megabytes / in_place_load_seconds);  // [MB/s]
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,141 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+#include <xtensor/xarray.hpp>
+
+#include "benchmark/util.h"
+#include "tensorward/core.h"
+#include "tensorward/dataset.h"
+#include "tensorward/distributed.h"
+#include "tensorward/function.h"
+#include "tensorward/model.h"
+#include "tensorward/optimizer.h"
+#include "tensorward/transforms.h"
+
+#define DEBUG_PRINT_SCALAR(var) std::cout << #var << " = " << var << std::endl;
+
+namespace TW = tensorward::core;
+namespace D = tensorward::dataset;
+namespace DI = tensorward::distributed;
+namespace F = tensorward::function;
+namespace M = tensorward::model;
+namespace O = tensorward::optimizer;
+namespace TF = tensorward::transforms;
+
+namespace {
+
+constexpr std::size_t kHiddenSize = 1000;
+constexpr std::size_t kOutSize = 10;
+
+// Global batch size, which is split evenly among the workers, so that every world size trains the same model.
+constexpr std::size_t kGlobalBatchSize = 120;
+constexpr std::size_t kNumEpochs = 1;
+constexpr float kLearningRate = 0.1;
+constexpr std::uint64_t kSeed = 0;
+
+// Trains the MLP on the shard of MNIST of the worker, averaging the gradients of all of the workers at each iteration,
+// either after the backpropagation or overlapped with it by the buckets.
+int Train(const DI::WorkerContext& context, const std::string& shared_memory_name, const bool does_overlap) {
+  const TW::DatasetSharedPtr dataset_ptr = std::make_shared<TW::SharedMemoryDataset>(
+      /* is_training_mode = */ true, std::vector<TW::TransformLambda>(), std::vector<TW::TransformLambda>(),
+      "SharedMemory", shared_memory_name);
+  const std::size_t batch_size = kGlobalBatchSize / context.world_size;
+  TW::DataLoader data_loader(dataset_ptr, batch_size,
+                             std::make_shared<TW::DistributedSampler>(dataset_ptr->size(), context.world_size,
+                                                                      context.rank, /* does_shuffle = */ true, kSeed),
+                             /* does_drop_last = */ true,
+                             TF::Compose({TF::Flatten(), TF::Normalize(/* mean = */ 0.0, /* stddev = */ 255.0)}));
+
+  DI::SharedMemoryAllReduce all_reduce(context.rendezvous_file_path, context.rank, context.world_size);
+  if (!all_reduce.is_valid()) {
+    return EXIT_FAILURE;
+  }
+
+  // The parameters are initialized in the same way on all of the workers, since `LaunchWorkers()` seeds `xt::random`.
+  M::MultiLayerPerceptron model({kHiddenSize, kOutSize}, TW::AsFunctionSharedPtr<F::ReLU>());
+  O::StochasticGradientDescent optimizer(kLearningRate);
+
+  // Initializes the parameters by a forward calculation, so that they can be grouped into the buckets.
+  {
+    TW::UseConfig with(TW::Config::kDoesEnableBackpropagation, false);
+    model.Predict({TW::AsTensorSharedPtr(data_loader.GetBatchAt(0).first)});
+  }
+  std::unique_ptr<DI::BucketedAllReduce> bucketed_all_reduce_ptr;
+  if (does_overlap) {
+    bucketed_all_reduce_ptr = std::make_unique<DI::BucketedAllReduce>(all_reduce, model.GetParamPtrs());
+  }
+
+  for (std::size_t epoch = 0; epoch < kNumEpochs; ++epoch) {
+    float sum_loss = 0.0;
+    for (std::size_t i = 0; i < data_loader.max_iteration(); ++i) {
+      const auto [batch_x, batch_t] = data_loader.GetBatchAt(i);
+      const TW::TensorSharedPtr batch_x_ptr = TW::AsTensorSharedPtr(batch_x, "batch_x");
+      const TW::TensorSharedPtr batch_t_ptr = TW::AsTensorSharedPtr(batch_t, "batch_t");
+      const TW::TensorSharedPtr batch_y_pred_ptr = model.Predict({batch_x_ptr})[0];
+      const TW::TensorSharedPtr batch_loss_ptr = F::softmax_cross_entropy_error(batch_y_pred_ptr, batch_t_ptr);
+
+      model.ClearGrads();
+      batch_loss_ptr->Backpropagation();
+      if (does_overlap) {
+        bucketed_all_reduce_ptr->Wait();
+      } else {
+        all_reduce.AllReduceGrads(model.GetParamPtrs());
+      }
+      optimizer.Update(model.GetParamPtrs());
+
+      sum_loss += batch_loss_ptr->data()(0);
+    }
+
+    if (context.rank == 0) {
+      const float average_loss_of_rank_0 = sum_loss / data_loader.max_iteration();
+      DEBUG_PRINT_SCALAR(epoch);
+      DEBUG_PRINT_SCALAR(average_loss_of_rank_0);
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  // The parent process loads MNIST once, and shares it with the workers.
+  const std::string shared_memory_name = "/tensorward_data_parallel_" + std::to_string(getpid());
+  {
+    const TW::DatasetSharedPtr mnist_ptr = TW::AsDatasetSharedPtr<D::Mnist>(/* is_training_mode = */ true);
+    if (!TW::WriteSharedMemoryDataset(shared_memory_name, mnist_ptr->data(), mnist_ptr->label())) {
+      return EXIT_FAILURE;
+    }
+  }
+  const std::string rendezvous_file_path = "/dev/shm/tensorward_data_parallel_" + std::to_string(getpid());
+
+  double single_worker_seconds = 0.0;
+  for (const bool does_overlap : {false, true}) {
+    for (const std::size_t world_size : {1, 2, 4}) {
+      std::cout << "---- " << world_size << " worker(s)" << (does_overlap ? ", overlapped by the buckets" : "")
+                << " ----" << std::endl;
+      const auto start = std::chrono::steady_clock::now();
+      const bool is_success = DI::LaunchWorkers(
+          world_size,
+          [&](const DI::WorkerContext& context) { return Train(context, shared_memory_name, does_overlap); },
+          rendezvous_file_path, kSeed);
+      const double seconds = benchmark::SecondsSince(start);
+      if (world_size == 1 && !does_overlap) {
+        single_worker_seconds = seconds;
+      }
+      const double speedup = single_worker_seconds / seconds;
+
+      DEBUG_PRINT_SCALAR(is_success);
+      DEBUG_PRINT_SCALAR(seconds);
+      DEBUG_PRINT_SCALAR(speedup);
+      std::cout << std::endl;
+    }
+  }
+
+  TW::RemoveSharedMemoryDataset(shared_memory_name);
+  return EXIT_SUCCESS;
+}
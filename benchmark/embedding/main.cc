@@ -0,0 +1,82 @@
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <xtensor/xarray.hpp>
+#include <xtensor/xrandom.hpp>
+
+#include "benchmark/util.h"
+#include "tensorward/core.h"
+#include "tensorward/layer.h"
+#include "tensorward/optimizer.h"
+
+#define DEBUG_PRINT_SCALAR(var) std::cout << #var << " = " << var << std::endl;
+
+namespace TW = tensorward::core;
+namespace L = tensorward::layer;
+namespace O = tensorward::optimizer;
+
+namespace {
+
+constexpr std::size_t kEmbeddingSize = 128;
+constexpr std::size_t kBatchSize = 256;
+constexpr float kLearningRate = 0.01;
+
+// Measures the average time in milliseconds of a training step (forward, backward and update) of an embedding layer,
+// whose gradient is either row-sparse (lazy update of only the touched rows) or densified (update of the whole table).
+double MeasureStepMilliseconds(const std::size_t num_embeddings, const bool does_densify_grad) {
+  constexpr int kRepeat = 10;
+
+  const std::shared_ptr<L::Embedding> embedding_layer_ptr =
+      std::make_shared<L::Embedding>(num_embeddings, kEmbeddingSize);
+  const TW::ParameterSharedPtr W_ptr = embedding_layer_ptr->param_map().at(embedding_layer_ptr->W_name());
+  O::StochasticGradientDescent stochastic_gradient_descent_optimizer(kLearningRate);
+
+  double total_milliseconds = 0.0;
+  for (int i = 0; i < kRepeat + 1; ++i) {
+    const xt::xarray<float> ids = xt::cast<float>(xt::random::randint<std::size_t>({kBatchSize}, 0, num_embeddings));
+
+    const auto start = std::chrono::steady_clock::now();
+    embedding_layer_ptr->ClearGrads();
+    const TW::TensorSharedPtr y_ptr = embedding_layer_ptr->Call({TW::AsTensorSharedPtr(ids)})[0];
+    y_ptr->SetGradOpt(xt::ones_like(y_ptr->data()));
+    y_ptr->Backpropagation();
+    if (does_densify_grad) {
+      W_ptr->SetGradOpt(TW::DensifyRowSparseGrad(W_ptr->sparse_grad(), W_ptr->data().shape()));
+      W_ptr->SetSparseGradOpt(std::nullopt);
+    }
+    stochastic_gradient_descent_optimizer.Update({W_ptr});
+    const double seconds = benchmark::SecondsSince(start);
+
+    if (0 < i) {  // The first step is for warming up.
+      total_milliseconds += seconds * 1.0e3;
+    }
+  }
+
+  return total_milliseconds / kRepeat;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  DEBUG_PRINT_SCALAR(kEmbeddingSize);
+  DEBUG_PRINT_SCALAR(kBatchSize);
+  std::cout << std::endl;
+
+  // The sparse step cost should stay flat as the table grows, while the dense one grows with the table.
+  const double dense_10k_milliseconds = MeasureStepMilliseconds(10000, true);
+  const double dense_100k_milliseconds = MeasureStepMilliseconds(100000, true);
+  const double sparse_10k_milliseconds = MeasureStepMilliseconds(10000, false);
+  const double sparse_100k_milliseconds = MeasureStepMilliseconds(100000, false);
+  const double sparse_1M_milliseconds = MeasureStepMilliseconds(1000000, false);
+
+  DEBUG_PRINT_SCALAR(dense_10k_milliseconds);
+  DEBUG_PRINT_SCALAR(dense_100k_milliseconds);
+  DEBUG_PRINT_SCALAR(sparse_10k_milliseconds);
+  DEBUG_PRINT_SCALAR(sparse_100k_milliseconds);
+  DEBUG_PRINT_SCALAR(sparse_1M_milliseconds);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,86 @@
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <xtensor/xarray.hpp>
+#include <xtensor/xindex_view.hpp>
+#include <xtensor/xrandom.hpp>
+
+#include "benchmark/util.h"
+#include "tensorward/util.h"
+
+#define DEBUG_PRINT_SCALAR(var) std::cout << #var << " = " << var << std::endl;
+
+namespace U = tensorward::util;
+
+namespace {
+
+// Number of the repeats of each measurement.
+constexpr std::size_t kNumRepeats = 5;
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  // Embedding-like lookup: 100k indices into a table of 10k rows whose size is 64.
+  constexpr std::size_t kNumIndices = 100000;
+  constexpr std::size_t kNumRows = 10000;
+  constexpr std::size_t kRowSize = 64;
+
+  const xt::xarray<float> table = xt::random::randn<float>({kNumRows, kRowSize});
+  const xt::xarray<std::size_t> random_rows = xt::random::randint<std::size_t>({kNumIndices}, 0, kNumRows);
+  const xt::xarray<std::size_t> random_cols = xt::random::randint<std::size_t>({kNumIndices}, 0, kRowSize);
+
+  // Element-wise indexing (one element per index).
+  std::vector<xt::xindex> indices;
+  indices.reserve(kNumIndices);
+  for (std::size_t i = 0; i < kNumIndices; ++i) {
+    indices.push_back({random_rows(i), random_cols(i)});
+  }
+  const xt::xarray<float> dL_dy = xt::random::randn<float>({kNumIndices});
+
+  const double index_view_gather_milliseconds = benchmark::MeasureMilliseconds(kNumRepeats, [&]() {
+    const xt::xarray<float> y = xt::index_view(table, indices);
+  });
+  const double index_view_scatter_add_milliseconds = benchmark::MeasureMilliseconds(kNumRepeats, [&]() {
+    // The previous `GetItem::Backward()` implementation.
+    xt::xarray<float> dL_dx = xt::zeros_like(table);
+    for (std::size_t i = 0; i < indices.size(); ++i) {
+      const std::vector<xt::xindex> ith_index_vector({indices[i]});
+      xt::index_view(dL_dx, ith_index_vector) += dL_dy[i];
+    }
+  });
+
+  const double kernel_gather_milliseconds = benchmark::MeasureMilliseconds(kNumRepeats, [&]() {
+    const xt::xarray<float> y = U::XtensorGather(table, U::XtensorFlatOffsets(table.shape(), indices));
+  });
+  const double kernel_scatter_add_milliseconds = benchmark::MeasureMilliseconds(kNumRepeats, [&]() {
+    const xt::xarray<float> dL_dx =
+        U::XtensorScatterAdd(dL_dy, U::XtensorFlatOffsets(table.shape(), indices), table.shape());
+  });
+
+  // Leading-axis indexing (one row per index).
+  const std::vector<std::size_t> row_indices(random_rows.begin(), random_rows.end());
+  const xt::xarray<float> dL_dy_rows = xt::random::randn<float>({kNumIndices, kRowSize});
+
+  const double kernel_gather_rows_milliseconds = benchmark::MeasureMilliseconds(kNumRepeats, [&]() {
+    const xt::xarray<float> y = U::XtensorGatherRows(table, row_indices);
+  });
+  const double kernel_scatter_add_rows_milliseconds = benchmark::MeasureMilliseconds(kNumRepeats, [&]() {
+    const xt::xarray<float> dL_dx = U::XtensorScatterAddRows(dL_dy_rows, row_indices, table.shape());
+  });
+
+  DEBUG_PRINT_SCALAR(kNumIndices);
+  DEBUG_PRINT_SCALAR(std::thread::hardware_concurrency());
+  std::cout << std::endl;
+
+  DEBUG_PRINT_SCALAR(index_view_gather_milliseconds);
+  DEBUG_PRINT_SCALAR(kernel_gather_milliseconds);
+  DEBUG_PRINT_SCALAR(index_view_scatter_add_milliseconds);
+  DEBUG_PRINT_SCALAR(kernel_scatter_add_milliseconds);
+  std::cout << std::endl;
+
+  DEBUG_PRINT_SCALAR(kernel_gather_rows_milliseconds);
+  DEBUG_PRINT_SCALAR(kernel_scatter_add_rows_milliseconds);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,152 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <xtensor/xarray.hpp>
+#include <xtensor/xrandom.hpp>
+
+#include "benchmark/util.h"
+#include "tensorward/core.h"
+#include "tensorward/dataset.h"
+#include "tensorward/function.h"
+#include "tensorward/model.h"
+#include "tensorward/optimizer.h"
+#include "tensorward/transforms.h"
+#include "tensorward/util.h"
+
+#define DEBUG_PRINT_SCALAR(var) std::cout << #var << " = " << var << std::endl;
+
+namespace TW = tensorward::core;
+namespace D = tensorward::dataset;
+namespace F = tensorward::function;
+namespace M = tensorward::model;
+namespace O = tensorward::optimizer;
+namespace TF = tensorward::transforms;
+namespace U = tensorward::util;
+
+namespace {
+
+constexpr std::size_t kInSize = 784;
+constexpr std::size_t kHiddenSize = 1000;
+constexpr std::size_t kOutSize = 10;
+
+// Batch size of each worker, so that each update has the same noise regardless of the number of the workers.
+constexpr std::size_t kBatchSize = 100;
+constexpr std::size_t kNumEpochs = 1;
+constexpr float kLearningRate = 0.1;
+constexpr std::uint64_t kSeed = 0;
+
+const TF::Compose kDataTransform({TF::Flatten(), TF::Normalize(/* mean = */ 0.0, /* stddev = */ 255.0)});
+
+// Accuracy of the model on the whole dataset.
+const float Evaluate(const M::MultiLayerPerceptron& model, const TW::DatasetSharedPtr dataset_ptr) {
+  TW::UseConfig with(TW::Config::kDoesEnableBackpropagation, false);
+  TW::DataLoader data_loader(dataset_ptr, kBatchSize, /* does_shuffle_dataset = */ false, /* decimating_scale = */ 1,
+                             kDataTransform);
+  float sum_accuracy = 0.0;
+  for (std::size_t i = 0; i < data_loader.max_iteration(); ++i) {
+    const auto [batch_x, batch_t] = data_loader.GetBatchAt(i);
+    const TW::TensorSharedPtr batch_y_pred_ptr = model.Predict({TW::AsTensorSharedPtr(batch_x)})[0];
+    sum_accuracy += U::Accuracy(batch_y_pred_ptr->data(), batch_t) * batch_x.shape(0);
+  }
+  return sum_accuracy / data_loader.dataset_size();
+}
+
+// Trains the MLP by the workers, each of which takes its own shard of the dataset (so the epoch has the same samples
+// regardless of the number of the workers) and updates the shared parameters without any lock.
+void MeasureHogwild(const TW::DatasetSharedPtr train_dataset_ptr, const TW::DatasetSharedPtr test_dataset_ptr,
+                    const std::size_t num_workers, const O::HogwildUpdateMode update_mode) {
+  // Every configuration starts from the same parameters.
+  xt::random::seed(kSeed);
+  M::MultiLayerPerceptron model({kHiddenSize, kOutSize}, TW::AsFunctionSharedPtr<F::ReLU>());
+  {
+    // Initializes the parameters.
+    TW::UseConfig with(TW::Config::kDoesEnableBackpropagation, false);
+    model.Predict({TW::AsTensorSharedPtr(xt::zeros<float>({std::size_t(1), kInSize}))});
+  }
+  O::HogwildStochasticGradientDescent optimizer(model, kLearningRate, update_mode);
+
+  std::vector<std::unique_ptr<M::MultiLayerPerceptron>> replica_ptrs;
+  std::vector<std::unique_ptr<TW::DataLoader>> data_loader_ptrs;
+  for (std::size_t rank = 0; rank < num_workers; ++rank) {
+    replica_ptrs.push_back(std::make_unique<M::MultiLayerPerceptron>(std::vector<std::size_t>({kHiddenSize, kOutSize}),
+                                                                     TW::AsFunctionSharedPtr<F::ReLU>()));
+    optimizer.ShareParams(*replica_ptrs.back());
+    data_loader_ptrs.push_back(std::make_unique<TW::DataLoader>(
+        train_dataset_ptr, kBatchSize,
+        std::make_shared<TW::DistributedSampler>(train_dataset_ptr->size(), num_workers, rank,
+                                                 /* does_shuffle = */ true, kSeed),
+        /* does_drop_last = */ true, kDataTransform));
+  }
+
+  std::vector<float> sum_losses(num_workers, 0.0);
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (std::size_t rank = 0; rank < num_workers; ++rank) {
+    threads.emplace_back([&, rank] {
+      M::MultiLayerPerceptron& replica = *replica_ptrs[rank];
+      TW::DataLoader& data_loader = *data_loader_ptrs[rank];
+      for (std::size_t epoch = 0; epoch < kNumEpochs; ++epoch) {
+        for (std::size_t i = 0; i < data_loader.max_iteration(); ++i) {
+          const auto [batch_x, batch_t] = data_loader.GetBatchAt(i);
+          const std::uint64_t read_clock = optimizer.clock();
+          const TW::TensorSharedPtr batch_y_pred_ptr = replica.Predict({TW::AsTensorSharedPtr(batch_x)})[0];
+          const TW::TensorSharedPtr batch_loss_ptr =
+              F::softmax_cross_entropy_error(batch_y_pred_ptr, TW::AsTensorSharedPtr(batch_t));
+
+          replica.ClearGrads();
+          batch_loss_ptr->Backpropagation();
+          optimizer.Update(replica.GetParamPtrs(), read_clock);
+
+          sum_losses[rank] += batch_loss_ptr->data()(0);
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  const double seconds = benchmark::SecondsSince(start);
+
+  const double throughput = optimizer.clock() * kBatchSize / seconds;  // [samples/s]
+  float sum_loss = 0.0;
+  for (const float worker_sum_loss : sum_losses) {
+    sum_loss += worker_sum_loss;
+  }
+  const float average_train_loss = sum_loss / optimizer.clock();
+  const float test_accuracy = Evaluate(model, test_dataset_ptr);
+  const double average_staleness = optimizer.average_staleness();
+  const std::uint64_t max_staleness = optimizer.max_staleness();
+
+  DEBUG_PRINT_SCALAR(num_workers);
+  DEBUG_PRINT_SCALAR(seconds);
+  DEBUG_PRINT_SCALAR(throughput);
+  DEBUG_PRINT_SCALAR(average_train_loss);
+  DEBUG_PRINT_SCALAR(test_accuracy);
+  DEBUG_PRINT_SCALAR(average_staleness);
+  DEBUG_PRINT_SCALAR(max_staleness);
+  std::cout << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const TW::DatasetSharedPtr train_dataset_ptr = TW::AsDatasetSharedPtr<D::Mnist>(/* is_training_mode = */ true);
+  const TW::DatasetSharedPtr test_dataset_ptr = TW::AsDatasetSharedPtr<D::Mnist>(/* is_training_mode = */ false);
+
+  // The single worker is the same as the synchronous stochastic gradient descent.
+  for (const O::HogwildUpdateMode update_mode :
+       {O::HogwildUpdateMode::kRelaxedAtomic, O::HogwildUpdateMode::kBenignRace}) {
+    const bool is_relaxed_atomic = update_mode == O::HogwildUpdateMode::kRelaxedAtomic;
+    std::cout << "---- " << (is_relaxed_atomic ? "relaxed atomic" : "benign race") << " updates ----" << std::endl;
+    for (const std::size_t num_workers : {1, 2, 4, 8}) {
+      MeasureHogwild(train_dataset_ptr, test_dataset_ptr, num_workers, update_mode);
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,106 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <xtensor/xarray.hpp>
+#include <xtensor/xbuilder.hpp>
+#include <xtensor/xrandom.hpp>
+#include <xtensor/xview.hpp>
+#include <zlib.h>
+
+#include "benchmark/util.h"
+#include "tensorward/util.h"
+
+#define DEBUG_PRINT_SCALAR(var) std::cout << #var << " = " << var << std::endl;
+
+namespace U = tensorward::util;
+
+namespace {
+
+// Same size as the training images of MNIST.
+constexpr std::size_t kNumImages = 60000;
+constexpr std::size_t kHeight = 28;
+constexpr std::size_t kWidth = 28;
+
+// Parses the decompressed images pixel by pixel through a string stream into the per-image arrays (as `ReadDataFile()`
+// of MNIST did before), to compare with `U::ReadIdxFile()`.
+const xt::xarray<float> ParseByPixel(const std::string& decompressed_bytes) {
+  std::stringstream ss(decompressed_bytes);
+  ss.seekg(16);  // Skips the header.
+
+  xt::xarray<float> data = xt::zeros<float>({kNumImages, std::size_t(1), kHeight, kWidth});
+  for (std::size_t i = 0; i < kNumImages; ++i) {
+    xt::xarray<float> ith_data = xt::zeros<float>({kHeight, kWidth});
+    for (std::size_t h = 0; h < kHeight; ++h) {
+      for (std::size_t w = 0; w < kWidth; ++w) {
+        std::uint8_t one_byte;
+        ss.read(reinterpret_cast<char*>(&one_byte), sizeof(one_byte));
+        ith_data(h, w) = static_cast<float>(one_byte);
+      }
+    }
+    xt::view(data, i, 0) = ith_data;
+  }
+  return data;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const std::filesystem::path directory_path = std::filesystem::temp_directory_path() / "tensorward_benchmark_idx";
+  std::filesystem::create_directories(directory_path);
+  const std::filesystem::path raw_file_path = directory_path / "train-images-idx3-ubyte";
+  const std::filesystem::path gzip_file_path = directory_path / "train-images-idx3-ubyte.gz";
+
+  // Writes the random images (with the header of the big-endian magic number and shape) in both of raw and gzip.
+  std::string bytes = {0, 0, 0x08, 3};
+  for (const std::uint32_t length : {kNumImages, kHeight, kWidth}) {
+    for (int shift = 24; 0 <= shift; shift -= 8) {
+      bytes.push_back(static_cast<char>((length >> shift) & 255));
+    }
+  }
+  const xt::xarray<int> pixels = xt::random::randint<int>({kNumImages * kHeight * kWidth}, 0, 256);
+  for (const int pixel : pixels) {
+    bytes.push_back(static_cast<char>(pixel));
+  }
+  std::ofstream(raw_file_path, std::ios::out | std::ios::binary).write(bytes.data(), bytes.size());
+  gzFile gzip_file = gzopen(gzip_file_path.c_str(), "wb");
+  gzwrite(gzip_file, bytes.data(), bytes.size());
+  gzclose(gzip_file);
+
+  std::cout << "---- Pixel-by-pixel parsing (from the decompressed bytes) ----" << std::endl;
+  const auto by_pixel_start = std::chrono::steady_clock::now();
+  const xt::xarray<float> by_pixel_data = ParseByPixel(bytes);
+  const double by_pixel_parse_seconds = benchmark::SecondsSince(by_pixel_start);
+  DEBUG_PRINT_SCALAR(by_pixel_parse_seconds);
+  std::cout << std::endl;
+
+  for (const auto& file_path : {raw_file_path, gzip_file_path}) {
+    std::cout << "---- Bulk parsing of " << file_path.filename() << " ----" << std::endl;
+    U::IdxFile idx_file;
+    const auto read_start = std::chrono::steady_clock::now();
+    const bool is_read = U::ReadIdxFile(file_path, idx_file);
+    const double read_seconds = benchmark::SecondsSince(read_start);
+
+    xt::xarray<float> data = xt::empty<float>({kNumImages, std::size_t(1), kHeight, kWidth});
+    const auto convert_start = std::chrono::steady_clock::now();
+    U::ConvertIdxFileToFloat(idx_file, 0, idx_file.size, data.data());
+    const double convert_seconds = benchmark::SecondsSince(convert_start);
+    const double convert_gigabytes_per_second = idx_file.size * (1 + sizeof(float)) / convert_seconds / 1.0e9;
+
+    DEBUG_PRINT_SCALAR(is_read);
+    DEBUG_PRINT_SCALAR(read_seconds);
+    DEBUG_PRINT_SCALAR(convert_seconds);
+    DEBUG_PRINT_SCALAR(convert_gigabytes_per_second);
+    DEBUG_PRINT_SCALAR((data == by_pixel_data));
+    std::cout << std::endl;
+  }
+
+  std::filesystem::remove_all(directory_path);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,123 @@
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <xtensor/xarray.hpp>
+#include <xtensor/xrandom.hpp>
+#include <xtensor/xview.hpp>
+
+#include "benchmark/util.h"
+#include "tensorward/core.h"
+#include "tensorward/function.h"
+#include "tensorward/model.h"
+#include "tensorward/serving.h"
+
+#define DEBUG_PRINT_SCALAR(var) std::cout << #var << " = " << var << std::endl;
+
+namespace TW = tensorward::core;
+namespace F = tensorward::function;
+namespace M = tensorward::model;
+namespace S = tensorward::serving;
+
+namespace {
+
+// Same size as the model of the MNIST example.
+constexpr std::size_t kInSize = 784;
+constexpr std::size_t kHiddenSize = 1000;
+constexpr std::size_t kOutSize = 10;
+
+constexpr std::size_t kNumClients = 32;
+constexpr std::size_t kNumRequestsPerClient = 200;
+
+// Returns the percentile of the sorted latencies.
+double Percentile(const std::vector<double>& sorted_latencies, const double percentage) {
+  const std::size_t index = std::min(sorted_latencies.size() - 1,
+                                     static_cast<std::size_t>(percentage / 100.0 * sorted_latencies.size()));
+  return sorted_latencies[index];
+}
+
+// Runs the closed-loop load generator (each client sends the next request after receiving the previous response), and
+// prints the latencies and the throughput.
+void RunLoadGenerator(const M::MultiLayerPerceptron& model, const std::size_t max_batch_size,
+                      const std::chrono::microseconds max_latency) {
+  const std::filesystem::path socket_path =
+      std::filesystem::temp_directory_path() / ("tensorward_benchmark_" + std::to_string(getpid()) + ".sock");
+  S::BatchingInferenceEngine engine(model, max_batch_size, max_latency);
+  S::UnixSocketServer server(engine, socket_path, kInSize);
+  if (!server.Start()) {
+    std::cout << "Failed to start the server at " << socket_path << std::endl;
+    return;
+  }
+
+  const xt::xarray<float> xs = xt::random::rand<float>({kNumClients, kInSize});
+  std::vector<std::vector<double>> client_latencies(kNumClients);
+  std::vector<std::thread> threads;
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t c = 0; c < kNumClients; ++c) {
+    threads.emplace_back([&socket_path, &xs, &client_latencies, c] {
+      S::UnixSocketClient client;
+      if (!client.Connect(socket_path)) {
+        return;
+      }
+      const xt::xarray<float> x = xt::view(xs, c, xt::all());
+      xt::xarray<float> y;
+      client_latencies[c].reserve(kNumRequestsPerClient);
+      for (std::size_t i = 0; i < kNumRequestsPerClient; ++i) {
+        const auto request_start = std::chrono::steady_clock::now();
+        if (!client.Predict(x, y)) {
+          return;
+        }
+        client_latencies[c].push_back(benchmark::SecondsSince(request_start) * 1.0e3);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const double seconds = benchmark::SecondsSince(start);
+  server.Stop();
+
+  std::vector<double> latencies;
+  for (const auto& client_latency : client_latencies) {
+    latencies.insert(latencies.end(), client_latency.begin(), client_latency.end());
+  }
+  std::sort(latencies.begin(), latencies.end());
+
+  DEBUG_PRINT_SCALAR(max_batch_size);
+  DEBUG_PRINT_SCALAR(max_latency.count());  // [us]
+  DEBUG_PRINT_SCALAR(latencies.size());
+  DEBUG_PRINT_SCALAR(engine.num_batches());
+  DEBUG_PRINT_SCALAR(static_cast<double>(engine.num_requests()) / engine.num_batches());  // Average batch size
+  DEBUG_PRINT_SCALAR(Percentile(latencies, 50.0));                                        // [ms]
+  DEBUG_PRINT_SCALAR(Percentile(latencies, 99.0));                                        // [ms]
+  DEBUG_PRINT_SCALAR(latencies.size() / seconds);                                         // [requests/s]
+  std::cout << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  M::MultiLayerPerceptron model({kHiddenSize, kHiddenSize, kOutSize}, TW::AsFunctionSharedPtr<F::ReLU>());
+  {
+    // Initializes the parameters.
+    TW::UseConfig with(TW::Config::kDoesEnableBackpropagation, false);
+    model.Predict({TW::AsTensorSharedPtr(xt::zeros<float>({std::size_t(1), kInSize}))});
+  }
+
+  DEBUG_PRINT_SCALAR(kNumClients);
+  DEBUG_PRINT_SCALAR(kNumRequestsPerClient);
+  std::cout << std::endl;
+
+  // Without batching (one request at a time) vs with batching.
+  RunLoadGenerator(model, 1, std::chrono::microseconds(0));
+  RunLoadGenerator(model, 8, std::chrono::microseconds(500));
+  RunLoadGenerator(model, 32, std::chrono::microseconds(1000));
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <xtensor/xarray.hpp>
+#include <xtensor/xrandom.hpp>
+#include <xtensor/xview.hpp>
+#include <xtensor-blas/xlinalg.hpp>
+
+#include "benchmark/util.h"
+#include "tensorward/core.h"
+#include "tensorward/function.h"
+#include "tensorward/util.h"
+
+#define DEBUG_PRINT_SCALAR(var) std::cout << #var << " = " << var << std::endl;
+
+namespace TW = tensorward::core;
+namespace F = tensorward::function;
+namespace U = tensorward::util;
+
+namespace {
+
+// 64 MiB per array, much larger than the last level caches, so the elementwise kernels are bound by the memory.
+constexpr std::size_t kSize = 1 << 24;
+
+// GEMM of {kM, kK} x {kK, kN}, whose rows are split into the chunks of the threads.
+constexpr std::size_t kM = 1 << 13;
+constexpr std::size_t kK = 1 << 11;
+constexpr std::size_t kN = 1 << 7;
+
+constexpr std::size_t kNumIterations = 20;
+
+// Measures the average latency [ms] of the kernel, and the bandwidth [GB/s] of the bytes which it reads and writes.
+void MeasureBandwidth(const std::string& name, const std::size_t num_bytes,
+                      const std::function<const TW::TensorSharedPtr()>& kernel) {
+  // NOTE: The first call warms up (e.g. the page faults of the output).
+  float checksum = 0.0;
+  const double latency =
+      benchmark::MeasureMilliseconds(kNumIterations, [&]() { checksum += kernel()->data().flat(0); });
+  const double bandwidth = num_bytes / latency / 1.0e6;
+  std::cout << name << std::endl;
+  DEBUG_PRINT_SCALAR(latency);    // [ms]
+  DEBUG_PRINT_SCALAR(bandwidth);  // [GB/s]
+  DEBUG_PRINT_SCALAR(checksum);   // Should be the same regardless of the placement.
+}
+
+// Measures the kernels with the data created (copied into the tensors) by the placement policy, and the thread pool
+// whose workers are pinned (or not) by it.
+void Measure(const bool does_use_numa_local_placement) {
+  TW::UseConfig with(TW::Config::kDoesUseNumaLocalPlacement, does_use_numa_local_placement);
+  U::ThreadPool::ResetInstance(std::max<std::size_t>(std::thread::hardware_concurrency(), 1) - 1,
+                               does_use_numa_local_placement);
+  DEBUG_PRINT_SCALAR(does_use_numa_local_placement);
+  DEBUG_PRINT_SCALAR(U::NumNumaNodes());
+  DEBUG_PRINT_SCALAR(U::ThreadPool::instance().num_threads());
+
+  // The data is generated by the main thread (so all of its pages are on a single node), and copied into the tensors,
+  // which places it on the nodes of the workers processing it if the placement is enabled.
+  const xt::xarray<float> x0 = xt::random::randn<float>({kSize});
+  const xt::xarray<float> x1 = xt::random::randn<float>({kSize});
+  const xt::xarray<float> A = xt::random::randn<float>({kM, kK});
+  const xt::xarray<float> B = xt::random::randn<float>({kK, kN});
+  const TW::TensorSharedPtr x0_ptr = TW::AsTensorSharedPtr(x0);
+  const TW::TensorSharedPtr x1_ptr = TW::AsTensorSharedPtr(x1);
+  const TW::TensorSharedPtr A_ptr = TW::AsTensorSharedPtr(A);
+
+  // Only the forward calculations are measured.
+  TW::UseConfig without_backpropagation(TW::Config::kDoesEnableBackpropagation, false);
+
+  // Reads 2 arrays, and writes 1 array.
+  MeasureBandwidth("Add", 3 * kSize * sizeof(float), [&] { return x0_ptr + x1_ptr; });
+
+  // Reads 1 array, and writes 1 array.
+  MeasureBandwidth("Sigmoid", 2 * kSize * sizeof(float), [&] { return F::sigmoid(x0_ptr); });
+
+  // The rows of "A" are split into the same chunks as the flattened "A" (both into the max number of the chunks of the
+  // thread pool), so each thread reads its rows from the memory placed on its node, while "B" is small and cached.
+  // NOTE: Run with a single-threaded BLAS (e.g. `OPENBLAS_NUM_THREADS=1`) so as not to oversubscribe the CPUs.
+  MeasureBandwidth("GEMM", (kM * kK + kK * kN + kM * kN) * sizeof(float), [&] {
+    const xt::xarray<float>& A = A_ptr->data();
+    xt::xarray<float> C = xt::empty<float>({kM, kN});
+    U::ThreadPool::instance().ParallelFor(0, kM, 1, [&](const std::size_t begin, const std::size_t end) {
+      xt::view(C, xt::range(begin, end), xt::all()) = xt::linalg::dot(xt::view(A, xt::range(begin, end), xt::all()), B);
+    });
+    return TW::AsTensorSharedPtr(std::move(C));
+  });
+  std::cout << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  Measure(/* does_use_numa_local_placement = */ false);
+  Measure(/* does_use_numa_local_placement = */ true);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,76 @@
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <xtensor/xarray.hpp>
+#include <xtensor/xbuilder.hpp>
+#include <xtensor/xrandom.hpp>
+
+#include "benchmark/util.h"
+#include "tensorward/core.h"
+#include "tensorward/function.h"
+#include "tensorward/model.h"
+
+#define DEBUG_PRINT_SCALAR(var) std::cout << #var << " = " << var << std::endl;
+
+namespace TW = tensorward::core;
+namespace F = tensorward::function;
+namespace M = tensorward::model;
+
+namespace {
+
+// Deep enough to be split into several stages of about the same cost.
+constexpr std::size_t kInSize = 1024;
+constexpr std::size_t kHiddenSize = 1024;
+constexpr std::size_t kNumHiddenLayers = 8;
+constexpr std::size_t kOutSize = 10;
+
+constexpr std::size_t kBatchSize = 256;
+constexpr std::size_t kNumIterations = 20;
+
+// Measures the throughput [samples/s] of the forward and backward calculations of the pipeline.
+void MeasureThroughput(const M::MultiLayerPerceptron& model, const xt::xarray<float>& batch_x,
+                       const xt::xarray<float>& batch_t, const std::size_t num_stages,
+                       const std::size_t num_micro_batches) {
+  M::PipelineMultiLayerPerceptron pipeline(model, num_stages, num_micro_batches, F::softmax_cross_entropy_error);
+
+  // NOTE: The first call warms up the threads and the memory allocator.
+  float loss = 0.0;
+  const double milliseconds =
+      benchmark::MeasureMilliseconds(kNumIterations, [&]() { loss = pipeline.ForwardBackward(batch_x, batch_t); });
+  const double throughput = kBatchSize / (milliseconds / 1.0e3);
+
+  DEBUG_PRINT_SCALAR(num_stages);
+  DEBUG_PRINT_SCALAR(num_micro_batches);
+  DEBUG_PRINT_SCALAR(throughput);  // [samples/s]
+  DEBUG_PRINT_SCALAR(loss);        // Should be the same among the configurations.
+  std::cout << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::vector<std::size_t> out_sizes(kNumHiddenLayers, kHiddenSize);
+  out_sizes.push_back(kOutSize);
+  M::MultiLayerPerceptron model(out_sizes, TW::AsFunctionSharedPtr<F::ReLU>());
+
+  const xt::xarray<float> batch_x = xt::random::randn<float>({kBatchSize, kInSize});
+  xt::xarray<float> batch_t = xt::zeros<float>({kBatchSize, kOutSize});
+  for (std::size_t n = 0; n < kBatchSize; ++n) {
+    batch_t(n, n % kOutSize) = 1.0;
+  }
+  {
+    // Initializes the parameters.
+    TW::UseConfig with(TW::Config::kDoesEnableBackpropagation, false);
+    model.Predict({TW::AsTensorSharedPtr(batch_x)});
+  }
+
+  // The single stage without the micro-batches is the serial baseline. The gradients are accumulated without being
+  // applied, so that every configuration calculates the same loss.
+  MeasureThroughput(model, batch_x, batch_t, 1, 1);
+  for (const std::size_t num_stages : {2, 4, 8}) {
+    MeasureThroughput(model, batch_x, batch_t, num_stages, 8);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,122 @@
+#include <functional>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include <xtensor/xarray.hpp>
+#include <xtensor/xmanipulation.hpp>
+
+#include "benchmark/util.h"
+#include "tensorward/core.h"
+#include "tensorward/dataset.h"
+#include "tensorward/function.h"
+#include "tensorward/model.h"
+#include "tensorward/optimizer.h"
+#include "tensorward/util.h"
+
+#define DEBUG_PRINT_SCALAR(var) std::cout << #var << " = " << var << std::endl;
+
+namespace TW = tensorward::core;
+namespace D = tensorward::dataset;
+namespace F = tensorward::function;
+namespace M = tensorward::model;
+namespace O = tensorward::optimizer;
+namespace U = tensorward::util;
+
+namespace {
+
+constexpr std::size_t kHiddenSize = 1000;
+constexpr std::size_t kOutSize = 10;
+constexpr std::size_t kBatchSize = 100;
+
+// Runs the prediction over all of the batches of the test dataset, and returns the accuracy and the throughput (the
+// number of the images per second).
+std::pair<float, double> MeasureAccuracyAndThroughput(
+    TW::DataLoader& test_data_loader, const std::function<xt::xarray<float>(const xt::xarray<float>&)>& predict) {
+  float sum_accuracy = 0.0;
+  double total_seconds = 0.0;
+  for (std::size_t i = 0; i < test_data_loader.max_iteration(); ++i) {
+    const auto [batch_x, batch_t] = test_data_loader.GetBatchAt(i);
+
+    xt::xarray<float> batch_y;
+    total_seconds += benchmark::MeasureSeconds([&]() { batch_y = predict(batch_x); });
+
+    sum_accuracy += U::Accuracy(batch_y, batch_t) * batch_x.shape(0);
+  }
+
+  const float accuracy = sum_accuracy / test_data_loader.dataset_size();
+  const double throughput = test_data_loader.dataset_size() / total_seconds;
+  return {accuracy, throughput};
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  constexpr std::size_t kMaxEpoch = 1;
+  constexpr float kLearningRate = 0.01;
+  constexpr float kMomentum = 0.9;
+
+  // Decimates the training dataset (to 1/10), and uses a part of it (1/100) for the calibration.
+  constexpr std::size_t kTrainDecimatingScale = 10;
+  constexpr std::size_t kCalibrationDecimatingScale = 100;
+
+  const TW::TransformLambda flatten_lambda = [](const xt::xarray<float>& input_data) {
+    return xt::flatten(input_data);
+  };
+  const TW::TransformLambda normalize_lambda = [](const xt::xarray<float>& input_data) {
+    const float stddev = 255.0;
+    return input_data / stddev;
+  };
+  const std::vector<TW::TransformLambda> data_transform_lambdas({flatten_lambda, normalize_lambda});
+
+  const TW::DatasetSharedPtr train_dataset_ptr =
+      TW::AsDatasetSharedPtr<D::Mnist>(/* is_training_mode = */ true, data_transform_lambdas);
+  const TW::DatasetSharedPtr test_dataset_ptr =
+      TW::AsDatasetSharedPtr<D::Mnist>(/* is_training_mode = */ false, data_transform_lambdas);
+
+  TW::DataLoader train_data_loader(train_dataset_ptr, kBatchSize, /* does_shuffle_dataset = */ true,
+                                   kTrainDecimatingScale);
+  TW::DataLoader calibration_data_loader(train_dataset_ptr, kBatchSize, /* does_shuffle_dataset = */ true,
+                                         kCalibrationDecimatingScale);
+  TW::DataLoader test_data_loader(test_dataset_ptr, kBatchSize, /* does_shuffle_dataset = */ false);
+
+  // Trains the float model briefly.
+  M::MultiLayerPerceptron model({kHiddenSize, kHiddenSize, kOutSize}, TW::AsFunctionSharedPtr<F::ReLU>());
+  O::MomentumStochasticGradientDescent optimizer(kLearningRate, kMomentum);
+  for (std::size_t epoch = 0; epoch < kMaxEpoch; ++epoch) {
+    for (std::size_t i = 0; i < train_data_loader.max_iteration(); ++i) {
+      const auto [batch_x, batch_t] = train_data_loader.GetBatchAt(i);
+      const TW::TensorSharedPtr batch_y_ptr = model.Predict({TW::AsTensorSharedPtr(batch_x)})[0];
+      const TW::TensorSharedPtr batch_loss_ptr =
+          F::softmax_cross_entropy_error(batch_y_ptr, TW::AsTensorSharedPtr(batch_t));
+      model.ClearGrads();
+      batch_loss_ptr->Backpropagation();
+      optimizer.Update(model.GetParamPtrs());
+    }
+  }
+
+  // Calibrates and quantizes the trained model.
+  const M::QuantizedMultiLayerPerceptron quantized_model(model, calibration_data_loader);
+
+  const auto [float_accuracy, float_throughput] =
+      MeasureAccuracyAndThroughput(test_data_loader, [&model](const xt::xarray<float>& x) {
+        TW::UseConfig with(TW::Config::kDoesEnableBackpropagation, false);
+        return xt::xarray<float>(model.Predict({TW::AsTensorSharedPtr(x)})[0]->data());
+      });
+  const auto [int8_accuracy, int8_throughput] =
+      MeasureAccuracyAndThroughput(test_data_loader, [&quantized_model](const xt::xarray<float>& x) {
+        return quantized_model.Predict(x);
+      });
+
+  DEBUG_PRINT_SCALAR(test_data_loader.dataset_size());
+  DEBUG_PRINT_SCALAR(kBatchSize);
+  std::cout << std::endl;
+
+  DEBUG_PRINT_SCALAR(float_accuracy);
+  DEBUG_PRINT_SCALAR(int8_accuracy);
+  DEBUG_PRINT_SCALAR(float_throughput);  // [images/s]
+  DEBUG_PRINT_SCALAR(int8_throughput);   // [images/s]
+  DEBUG_PRINT_SCALAR(int8_throughput / float_throughput);
+
+  return EXIT_SUCCESS;
+}
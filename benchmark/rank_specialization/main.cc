@@ -0,0 +1,59 @@
+#include <iostream>
+
+#include <xtensor/xarray.hpp>
+#include <xtensor/xmath.hpp>
+#include <xtensor/xrandom.hpp>
+
+#include "benchmark/util.h"
+#include "tensorward/util.h"
+
+#define DEBUG_PRINT_SCALAR(var) std::cout << #var << " = " << var << std::endl;
+
+namespace U = tensorward::util;
+
+namespace {
+
+constexpr std::size_t kNumIterations = 100000;
+
+// Measures the average latency [us] of the sigmoid (the forward and the backward) on the small tensor of the shape,
+// where the dynamic-rank bookkeeping dominates, with both of the dynamic rank and the static rank.
+void MeasureLatency(const xt::xarray<float>::shape_type& shape) {
+  const xt::xarray<float> x = xt::random::randn<float>(shape);
+  const xt::xarray<float> dL_dy = xt::random::randn<float>(shape);
+
+  float dynamic_checksum = 0.0;
+  const double dynamic_latency = 1.0e3 * benchmark::MeasureMilliseconds(kNumIterations, [&]() {
+    const xt::xarray<float> y = 1.0 / (1.0 + xt::exp(-x));
+    const xt::xarray<float> dL_dx = dL_dy * (y * (1.0 - y));
+    dynamic_checksum += dL_dx.flat(0);
+  });
+
+  float static_checksum = 0.0;
+  const double static_latency = 1.0e3 * benchmark::MeasureMilliseconds(kNumIterations, [&]() {
+    const xt::xarray<float> y =
+        U::XtensorEvaluateWithRank(x.shape(), [](const auto& x) { return 1.0 / (1.0 + xt::exp(-x)); }, x);
+    const xt::xarray<float> dL_dx = U::XtensorEvaluateWithRank(
+        dL_dy.shape(), [](const auto& dL_dy, const auto& y) { return dL_dy * (y * (1.0 - y)); }, dL_dy, y);
+    static_checksum += dL_dx.flat(0);
+  });
+
+  DEBUG_PRINT_SCALAR(x.dimension());
+  DEBUG_PRINT_SCALAR(x.size());
+  DEBUG_PRINT_SCALAR(dynamic_latency);  // [us]
+  DEBUG_PRINT_SCALAR(static_latency);   // [us]
+  DEBUG_PRINT_SCALAR(dynamic_latency / static_latency);
+  DEBUG_PRINT_SCALAR(dynamic_checksum - static_checksum);  // Should be (almost) zero.
+  std::cout << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  // Same shapes as the hidden layers of the examples (e.g. the linear regression and the spiral classification).
+  MeasureLatency({100, 1});
+  MeasureLatency({300, 10});
+  MeasureLatency({30, 10, 10});
+  MeasureLatency({30, 1, 10, 10});
+
+  return EXIT_SUCCESS;
+}
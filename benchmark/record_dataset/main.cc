@@ -0,0 +1,93 @@
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <xtensor/xarray.hpp>
+#include <xtensor/xrandom.hpp>
+#include <xtensor/xview.hpp>
+
+#include "benchmark/util.h"
+#include "tensorward/core.h"
+
+#define DEBUG_PRINT_SCALAR(var) std::cout << #var << " = " << var << std::endl;
+
+namespace TW = tensorward::core;
+
+namespace {
+
+// Same size as the training dataset of MNIST.
+constexpr std::size_t kNumRecords = 60000;
+constexpr std::size_t kInSize = 784;
+constexpr std::size_t kNumRecordFiles = 4;
+
+// Measures the throughput of reading all of the records in the order of the indices with the threads, each of which
+// reads every `num_threads`-th index.
+void MeasureThroughput(const TW::RecordDataset& dataset, const xt::xarray<std::size_t>& indices,
+                       const std::size_t num_threads) {
+  std::vector<float> checksums(num_threads, 0.0);
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&dataset, &indices, &checksums, num_threads, t] {
+      for (std::size_t i = t; i < indices.size(); i += num_threads) {
+        checksums[t] += dataset.at(indices(i)).first(0);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const double seconds = benchmark::SecondsSince(start);
+  const double num_records_per_second = indices.size() / seconds;
+  const double megabytes_per_second = num_records_per_second * (kInSize + 1) * sizeof(float) / 1.0e6;
+
+  DEBUG_PRINT_SCALAR(num_threads);
+  DEBUG_PRINT_SCALAR(num_records_per_second);
+  DEBUG_PRINT_SCALAR(megabytes_per_second);
+  std::cout << std::endl;
+}
+
+}  // namespace
+
+// NOTE: The record files are in the page cache right after being written, so drop the page cache (e.g.
+// NOTE: `echo 3 > /proc/sys/vm/drop_caches`) before the random reads to measure the disk (e.g. IOPS of SSD).
+int main(int argc, char* argv[]) {
+  const std::filesystem::path directory_path = std::filesystem::temp_directory_path() / "tensorward_benchmark_records";
+  std::filesystem::create_directories(directory_path);
+
+  std::vector<std::filesystem::path> record_file_paths;
+  const xt::xarray<float> data = xt::random::rand<float>({kNumRecords / kNumRecordFiles, kInSize});
+  for (std::size_t f = 0; f < kNumRecordFiles; ++f) {
+    record_file_paths.push_back(directory_path / ("mnist-" + std::to_string(f) + ".twrec"));
+    TW::RecordFileWriter writer(record_file_paths.back());
+    for (std::size_t i = 0; i < data.shape(0); ++i) {
+      writer.Write(xt::view(data, i), xt::xarray<float>(static_cast<float>(i % 10)));
+    }
+  }
+
+  const auto open_start = std::chrono::steady_clock::now();
+  const TW::RecordDataset dataset(true, {}, {}, "Record", record_file_paths, true);
+  const double open_seconds_with_checksums = benchmark::SecondsSince(open_start);
+  DEBUG_PRINT_SCALAR(dataset.is_valid());
+  DEBUG_PRINT_SCALAR(dataset.size());
+  DEBUG_PRINT_SCALAR(open_seconds_with_checksums);
+  std::cout << std::endl;
+
+  std::cout << "---- Sequential reads ----" << std::endl;
+  const xt::xarray<std::size_t> sequential_indices = xt::arange<std::size_t>(dataset.size());
+  MeasureThroughput(dataset, sequential_indices, 1);
+
+  std::cout << "---- Random reads ----" << std::endl;
+  const xt::xarray<std::size_t> random_indices = xt::random::permutation<std::size_t>(dataset.size());
+  for (const std::size_t num_threads : {1, 2, 4, 8}) {
+    MeasureThroughput(dataset, random_indices, num_threads);
+  }
+
+  std::filesystem::remove_all(directory_path);
+
+  return EXIT_SUCCESS;
+}
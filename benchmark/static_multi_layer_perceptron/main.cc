@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <iostream>
+
+#include <xtensor/xarray.hpp>
+#include <xtensor/xfixed.hpp>
+#include <xtensor/xrandom.hpp>
+
+#include "benchmark/util.h"
+#include "tensorward/core.h"
+#include "tensorward/function.h"
+#include "tensorward/model.h"
+
+#define DEBUG_PRINT_SCALAR(var) std::cout << #var << " = " << var << std::endl;
+
+namespace TW = tensorward::core;
+namespace F = tensorward::function;
+namespace M = tensorward::model;
+
+namespace {
+
+// Same size as the model of the MNIST example.
+constexpr std::size_t kInSize = 784;
+constexpr std::size_t kHiddenSize = 1000;
+constexpr std::size_t kOutSize = 10;
+
+constexpr std::size_t kNumIterations = 100;
+
+using MnistStaticMultiLayerPerceptron = M::StaticMultiLayerPerceptron<kInSize, kHiddenSize, kHiddenSize, kOutSize>;
+
+// Measures the average latency [ms] of the prediction of both of the dynamic model and the static model at the batch
+// size.
+template <std::size_t BatchSize>
+void MeasureLatency(const M::MultiLayerPerceptron& model, const MnistStaticMultiLayerPerceptron& static_model) {
+  const xt::xarray<float> x = xt::random::rand<float>({BatchSize, kInSize});
+  const TW::TensorSharedPtr x_ptr = TW::AsTensorSharedPtr(x);
+  MnistStaticMultiLayerPerceptron::Input<BatchSize> static_x;
+  std::copy(x.begin(), x.end(), static_x.begin());
+  MnistStaticMultiLayerPerceptron::Output<BatchSize> static_y;
+
+  TW::UseConfig with(TW::Config::kDoesEnableBackpropagation, false);
+  float dynamic_checksum = 0.0;
+  const double dynamic_latency = benchmark::MeasureMilliseconds(
+      kNumIterations, [&]() { dynamic_checksum += model.Predict({x_ptr})[0]->data()(0, 0); });
+
+  float static_checksum = 0.0;
+  const double static_latency = benchmark::MeasureMilliseconds(kNumIterations, [&]() {
+    static_model.Predict<BatchSize>(static_x, static_y);
+    static_checksum += static_y(0, 0);
+  });
+
+  DEBUG_PRINT_SCALAR(BatchSize);
+  DEBUG_PRINT_SCALAR(dynamic_latency);  // [ms]
+  DEBUG_PRINT_SCALAR(static_latency);   // [ms]
+  DEBUG_PRINT_SCALAR(dynamic_latency / static_latency);
+  DEBUG_PRINT_SCALAR(dynamic_checksum - static_checksum);  // Should be (almost) zero.
+  std::cout << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  M::MultiLayerPerceptron model({kHiddenSize, kHiddenSize, kOutSize}, TW::AsFunctionSharedPtr<F::ReLU>());
+  {
+    // Initializes the parameters.
+    TW::UseConfig with(TW::Config::kDoesEnableBackpropagation, false);
+    model.Predict({TW::AsTensorSharedPtr(xt::zeros<float>({std::size_t(1), kInSize}))});
+  }
+  const MnistStaticMultiLayerPerceptron static_model(model);
+
+  MeasureLatency<1>(model, static_model);
+  MeasureLatency<2>(model, static_model);
+  MeasureLatency<4>(model, static_model);
+  MeasureLatency<8>(model, static_model);
+  MeasureLatency<16>(model, static_model);
+
+  return EXIT_SUCCESS;
+}
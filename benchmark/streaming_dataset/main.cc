@@ -0,0 +1,92 @@
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <xtensor/xarray.hpp>
+#include <xtensor/xrandom.hpp>
+
+#include "benchmark/util.h"
+#include "tensorward/core.h"
+
+#define DEBUG_PRINT_SCALAR(var) std::cout << #var << " = " << var << std::endl;
+
+namespace TW = tensorward::core;
+
+namespace {
+
+// Same record as the flattened MNIST image.
+constexpr std::size_t kInSize = 784;
+constexpr std::size_t kNumShards = 8;
+constexpr std::size_t kBatchSize = 128;
+constexpr std::size_t kChunkSize = 4096;
+constexpr std::size_t kShuffleBufferSize = 16;
+
+// Measures the throughput of an epoch over the shards through `DataLoader`.
+void MeasureThroughput(const std::vector<std::filesystem::path>& shard_file_paths,
+                       const TW::StreamingDataset::NamedArg& arg) {
+  const auto dataset_ptr = std::make_shared<TW::StreamingDataset>(true, std::vector<TW::TransformLambda>(),
+                                                                  std::vector<TW::TransformLambda>(), "Streaming",
+                                                                  shard_file_paths, arg);
+  TW::DataLoader data_loader(dataset_ptr, kBatchSize, false);
+
+  float checksum = 0.0;
+  const double seconds = benchmark::MeasureSeconds([&]() {
+    for (std::size_t i = 0; i < data_loader.max_iteration(); ++i) {
+      checksum += data_loader.GetBatchAt(i).first(0, 0);
+    }
+  });
+  const double num_records_per_second = dataset_ptr->size() / seconds;
+  const double megabytes_per_second = num_records_per_second * (kInSize + 1) * sizeof(float) / 1.0e6;
+
+  DEBUG_PRINT_SCALAR(arg.shuffle_buffer_size);
+  DEBUG_PRINT_SCALAR(arg.does_use_direct_io);
+  DEBUG_PRINT_SCALAR(dataset_ptr->num_read_chunks());
+  DEBUG_PRINT_SCALAR(num_records_per_second);
+  DEBUG_PRINT_SCALAR(megabytes_per_second);
+  DEBUG_PRINT_SCALAR(checksum);
+  std::cout << std::endl;
+}
+
+}  // namespace
+
+// Usage: main [dataset size in megabytes (default: 1024)]
+// NOTE: The shards are in the page cache right after being written, so drop the page cache (e.g.
+// NOTE: `echo 3 > /proc/sys/vm/drop_caches`) between the runs to measure the disk bandwidth with the buffered I/O.
+int main(int argc, char* argv[]) {
+  const std::size_t dataset_size_in_megabytes = (2 <= argc) ? std::stoul(argv[1]) : 1024;
+  const std::size_t num_records_per_shard =
+      dataset_size_in_megabytes * 1000000 / ((kInSize + 1) * sizeof(float)) / kNumShards;
+
+  // Writes the shards one by one, so that only a shard is in the memory at a time.
+  const std::filesystem::path directory_path = std::filesystem::temp_directory_path() / "tensorward_benchmark_shards";
+  std::filesystem::create_directories(directory_path);
+  std::vector<std::filesystem::path> shard_file_paths;
+  for (std::size_t s = 0; s < kNumShards; ++s) {
+    const xt::xarray<float> data = xt::random::rand<float>({num_records_per_shard, kInSize});
+    const xt::xarray<float> label = xt::random::randint<int>({num_records_per_shard}, 0, 10);
+    shard_file_paths.push_back(directory_path / ("shard" + std::to_string(s)));
+    if (!TW::WriteStreamingShard(shard_file_paths.back(), data, label)) {
+      std::cerr << "Failed to write " << shard_file_paths.back() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  DEBUG_PRINT_SCALAR(dataset_size_in_megabytes);
+  DEBUG_PRINT_SCALAR(num_records_per_shard * kNumShards);
+  std::cout << std::endl;
+
+  MeasureThroughput(shard_file_paths, {.chunk_size = kChunkSize});
+  MeasureThroughput(shard_file_paths, {.chunk_size = kChunkSize,
+                                       .shuffle_buffer_size = kShuffleBufferSize,
+                                       .max_num_cached_chunks = kShuffleBufferSize + 1});
+  MeasureThroughput(shard_file_paths, {.chunk_size = kChunkSize,
+                                       .shuffle_buffer_size = kShuffleBufferSize,
+                                       .max_num_cached_chunks = kShuffleBufferSize + 1,
+                                       .does_use_direct_io = true});
+
+  std::filesystem::remove_all(directory_path);
+
+  return EXIT_SUCCESS;
+}
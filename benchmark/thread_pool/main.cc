@@ -0,0 +1,77 @@
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <xtensor/xarray.hpp>
+#include <xtensor/xrandom.hpp>
+
+#include "benchmark/util.h"
+#include "tensorward/core.h"
+#include "tensorward/function.h"
+#include "tensorward/util.h"
+
+#define DEBUG_PRINT_SCALAR(var) std::cout << #var << " = " << var << std::endl;
+
+namespace TW = tensorward::core;
+namespace F = tensorward::function;
+namespace U = tensorward::util;
+
+namespace {
+
+constexpr std::size_t kHeight = 1 << 12;
+constexpr std::size_t kWidth = 1 << 10;
+constexpr std::size_t kNumIterations = 20;
+
+// Total numbers of the threads (including the calling thread) to measure the scaling with.
+const std::vector<std::size_t> kNumsThreads = {1, 2, 4, 8};
+
+// Measures the average latency [ms] of the kernel, and its speedup over the single thread, for each number of the
+// threads of the pool shared by the kernels.
+void MeasureScaling(const std::string& name, const std::function<const TW::TensorSharedPtr()>& kernel) {
+  std::cout << name << std::endl;
+  double single_thread_latency = 0.0;
+  for (const std::size_t num_threads : kNumsThreads) {
+    U::ThreadPool::ResetInstance(num_threads - 1);
+
+    // NOTE: The first call warms up (e.g. the page faults of the output).
+    float checksum = 0.0;
+    const double latency =
+        benchmark::MeasureMilliseconds(kNumIterations, [&]() { checksum += kernel()->data().flat(0); });
+    if (num_threads == 1) {
+      single_thread_latency = latency;
+    }
+    DEBUG_PRINT_SCALAR(num_threads);
+    DEBUG_PRINT_SCALAR(latency);  // [ms]
+    DEBUG_PRINT_SCALAR(single_thread_latency / latency);
+    DEBUG_PRINT_SCALAR(checksum);  // Should be the same for any number of the threads.
+  }
+  std::cout << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  // Only the forward calculations are measured.
+  TW::UseConfig with(TW::Config::kDoesEnableBackpropagation, false);
+
+  const TW::TensorSharedPtr x0_ptr = TW::AsTensorSharedPtr(xt::random::randn<float>({kHeight, kWidth}));
+  const TW::TensorSharedPtr x1_ptr = TW::AsTensorSharedPtr(xt::random::randn<float>({kHeight, kWidth}));
+  const xt::xarray<float>::shape_type column_shape({1, kWidth});
+
+  // Elementwise kernels.
+  MeasureScaling("ReLU", [&] { return F::relu(x0_ptr); });
+  MeasureScaling("Sigmoid", [&] { return F::sigmoid(x0_ptr); });
+  MeasureScaling("Exp", [&] { return F::exp(x0_ptr); });
+  MeasureScaling("Pow", [&] { return F::pow(x0_ptr, 3); });
+  MeasureScaling("Add", [&] { return x0_ptr + x1_ptr; });
+  MeasureScaling("Mul", [&] { return x0_ptr * x1_ptr; });
+
+  // Reduction kernels.
+  MeasureScaling("Sum", [&] { return F::sum(x0_ptr); });
+  MeasureScaling("SumTo", [&] { return F::sum_to(x0_ptr, column_shape); });
+  MeasureScaling("Softmax", [&] { return TW::AsTensorSharedPtr(U::XtensorSoftmax(x0_ptr->data())); });
+
+  return EXIT_SUCCESS;
+}
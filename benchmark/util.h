@@ -0,0 +1,36 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+// Timing helpers shared by the benchmarks.
+
+namespace benchmark {
+
+// Gets the elapsed time in seconds since the start.
+inline const double SecondsSince(const std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Runs the given lambda once and returns the elapsed time in seconds.
+template <class Lambda>
+const double MeasureSeconds(const Lambda& lambda) {
+  const auto start = std::chrono::steady_clock::now();
+  lambda();
+  return SecondsSince(start);
+}
+
+// Runs the given lambda once to warm up (e.g. the page faults and the memory allocator), and then `num_repeats` times,
+// and returns the average elapsed time in milliseconds of the repeats.
+template <class Lambda>
+const double MeasureMilliseconds(const std::size_t num_repeats, const Lambda& lambda) {
+  lambda();
+  const double seconds = MeasureSeconds([&]() {
+    for (std::size_t i = 0; i < num_repeats; ++i) {
+      lambda();
+    }
+  });
+  return seconds * 1.0e3 / num_repeats;
+}
+
+}  // namespace benchmark
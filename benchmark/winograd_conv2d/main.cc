@@ -0,0 +1,76 @@
+#include <iostream>
+#include <vector>
+
+#include <xtensor/xarray.hpp>
+#include <xtensor/xmanipulation.hpp>
+#include <xtensor/xrandom.hpp>
+#include <xtensor-blas/xlinalg.hpp>
+
+#include "benchmark/util.h"
+#include "tensorward/util.h"
+
+#define DEBUG_PRINT_SCALAR(var) std::cout << #var << " = " << var << std::endl;
+
+namespace U = tensorward::util;
+
+namespace {
+
+// Number of the repeats of each measurement.
+constexpr std::size_t kNumRepeats = 10;
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  // MNIST-sized feature maps: a batch of 28x28 images with a 3x3 "same" convolution.
+  constexpr std::size_t kBatchSize = 100;
+  constexpr std::size_t kInChannel = 16;
+  constexpr std::size_t kOutChannel = 16;
+  constexpr std::size_t kHeight = 28;
+  constexpr std::size_t kWidth = 28;
+  constexpr std::size_t kKernelSize = 3;
+  constexpr std::size_t kPad = 1;
+
+  const xt::xarray<float> x = xt::random::randn<float>({kBatchSize, kInChannel, kHeight, kWidth});
+  const xt::xarray<float> W = xt::random::randn<float>({kOutChannel, kInChannel, kKernelSize, kKernelSize});
+
+  const std::size_t OH = U::ConvOutputSize(kHeight, kKernelSize, 1, kPad);
+  const std::size_t OW = U::ConvOutputSize(kWidth, kKernelSize, 1, kPad);
+
+  // Number of multiplications in the convolution itself (excluding the transforms).
+  const std::size_t direct_multiplications =
+      kBatchSize * kOutChannel * kInChannel * OH * OW * kKernelSize * kKernelSize;
+  const auto winograd_multiplications = [&](const std::size_t m) {
+    const std::size_t alpha = m + kKernelSize - 1;
+    const std::size_t num_tiles = kBatchSize * ((OH + m - 1) / m) * ((OW + m - 1) / m);
+    return num_tiles * kOutChannel * kInChannel * alpha * alpha;
+  };
+
+  const double im2col_milliseconds = benchmark::MeasureMilliseconds(kNumRepeats, [&]() {
+    const xt::xarray<float> col = U::XtensorIm2col(x, kKernelSize, kKernelSize, 1, kPad);
+    xt::xarray<float> W_col = W;
+    W_col.reshape({kOutChannel, kInChannel * kKernelSize * kKernelSize});
+    const xt::xarray<float> y_col = xt::linalg::dot(col, xt::transpose(W_col));
+  });
+
+  std::vector<double> winograd_milliseconds;
+  for (const std::size_t m : {2, 4}) {
+    // NOTE: The filter transform is excluded from the measurement, because it's cached per weight version.
+    const U::WinogradFilter winograd_filter = U::XtensorWinogradFilterTransform(W, m);
+    winograd_milliseconds.push_back(benchmark::MeasureMilliseconds(kNumRepeats, [&]() {
+      const xt::xarray<float> y = U::XtensorWinogradConv2d(x, winograd_filter, kPad);
+    }));
+  }
+
+  DEBUG_PRINT_SCALAR(direct_multiplications);
+  DEBUG_PRINT_SCALAR(winograd_multiplications(2));
+  DEBUG_PRINT_SCALAR(winograd_multiplications(4));
+  DEBUG_PRINT_SCALAR(static_cast<double>(direct_multiplications) / winograd_multiplications(2));
+  DEBUG_PRINT_SCALAR(static_cast<double>(direct_multiplications) / winograd_multiplications(4));
+  std::cout << std::endl;
+
+  DEBUG_PRINT_SCALAR(im2col_milliseconds);
+  DEBUG_PRINT_SCALAR(winograd_milliseconds[0]);
+  DEBUG_PRINT_SCALAR(winograd_milliseconds[1]);
+
+  return EXIT_SUCCESS;
+}
@@ -15,6 +15,7 @@
 #include "tensorward/function.h"
 #include "tensorward/model.h"
 #include "tensorward/optimizer.h"
+#include "tensorward/transforms.h"
 #include "tensorward/util.h"
 
 #define DEBUG_PRINT_SCALAR(var) std::cout << #var << " = " << var << std::endl;
@@ -25,6 +26,7 @@ namespace D = tensorward::dataset;
 namespace F = tensorward::function;
 namespace M = tensorward::model;
 namespace O = tensorward::optimizer;
+namespace TF = tensorward::transforms;
 namespace U = tensorward::util;
 
 int main(int argc, char* argv[]) {
@@ -36,26 +38,19 @@ int main(int argc, char* argv[]) {
   constexpr float kLearningRate = 0.01;
   constexpr float kMomentum = 0.9;
 
-  const tw::TransformLambda flatten_lambda = [](const xt::xarray<float>& input_data) {
-    return xt::flatten(input_data);
-  };
-  const tw::TransformLambda normalize_lambda = [](const xt::xarray<float>& input_data) {
-    const float mean = 0.0;
-    const float stddev = 255.0;
-    return (input_data - mean) / stddev;
-  };
-  const std::vector<tw::TransformLambda> data_transform_lambdas({flatten_lambda, normalize_lambda});
+  // Flattens and normalizes each batch in a single pass (instead of each sample with transform lambdas).
+  const TF::Compose data_transform({TF::Flatten(), TF::Normalize(/* mean = */ 0.0, /* stddev = */ 255.0)});
 
   // Dataset
-  const tw::DatasetSharedPtr train_dataset_ptr =
-      tw::AsDatasetSharedPtr<D::Mnist>(/* is_training_mode = */ true, data_transform_lambdas);
-  const tw::DatasetSharedPtr test_dataset_ptr =
-      tw::AsDatasetSharedPtr<D::Mnist>(/* is_training_mode = */ false, data_transform_lambdas);
+  const tw::DatasetSharedPtr train_dataset_ptr = tw::AsDatasetSharedPtr<D::Mnist>(/* is_training_mode = */ true);
+  const tw::DatasetSharedPtr test_dataset_ptr = tw::AsDatasetSharedPtr<D::Mnist>(/* is_training_mode = */ false);
 
   // Decimates the size of the dataset (to 1/10) and gets each batch of the dataset through `DataLoader` class.
   constexpr std::size_t kDecimatingScale = 10;
-  tw::DataLoader train_data_loader(train_dataset_ptr, kBatchSize, /* does_shuffle_dataset = */ true, kDecimatingScale);
-  tw::DataLoader test_data_loader(test_dataset_ptr, kBatchSize, /* does_shuffle_dataset = */ false, kDecimatingScale);
+  tw::DataLoader train_data_loader(train_dataset_ptr, kBatchSize, /* does_shuffle_dataset = */ true, kDecimatingScale,
+                                   data_transform);
+  tw::DataLoader test_data_loader(test_dataset_ptr, kBatchSize, /* does_shuffle_dataset = */ false, kDecimatingScale,
+                                  data_transform);
 
   DEBUG_PRINT_SCALAR(xt::adapt(train_data_loader.dataset_ptr()->data().shape()));
   DEBUG_PRINT_SCALAR(xt::adapt(train_data_loader.dataset_ptr()->label().shape()));
@@ -1,13 +1,21 @@
 #pragma once
 
 // Header file aggregation for users.
+#include "tensorward/core/async_checkpoint_writer.h"
+#include "tensorward/core/cached_dataset.h"
+#include "tensorward/core/checkpoint.h"
 #include "tensorward/core/config.h"
 #include "tensorward/core/dataset.h"
 #include "tensorward/core/data_loader.h"
 #include "tensorward/core/function.h"
 #include "tensorward/core/layer.h"
+#include "tensorward/core/loss_scaler.h"
 #include "tensorward/core/model.h"
 #include "tensorward/core/parameter.h"
+#include "tensorward/core/record_dataset.h"
+#include "tensorward/core/sampler.h"
+#include "tensorward/core/shared_memory_dataset.h"
+#include "tensorward/core/streaming_dataset.h"
 #include "tensorward/core/tensor.h"
 #include "tensorward/core/operator/add.h"
 #include "tensorward/core/operator/div.h"
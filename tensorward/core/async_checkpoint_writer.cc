@@ -0,0 +1,84 @@
+#include "tensorward/core/async_checkpoint_writer.h"
+
+#include <atomic>
+#include <chrono>
+#include <utility>
+
+namespace tensorward::core {
+
+AsyncCheckpointWriter::AsyncCheckpointWriter()
+    : is_writing_(false),
+      is_stopping_(false),
+      num_written_checkpoints_(0),
+      num_failed_checkpoints_(0),
+      num_dropped_checkpoints_(0),
+      last_stall_seconds_(0.0),
+      max_stall_seconds_(0.0),
+      thread_(&AsyncCheckpointWriter::Run, this) {}
+
+AsyncCheckpointWriter::~AsyncCheckpointWriter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_stopping_ = true;
+  }
+  condition_variable_.notify_all();
+  thread_.join();
+}
+
+void AsyncCheckpointWriter::Save(const std::filesystem::path& file_path, const Model& model,
+                                 const Optimizer* optimizer_ptr /* = nullptr */) {
+  const auto start = std::chrono::steady_clock::now();
+
+  CheckpointSnapshot snapshot = TakeCheckpointSnapshot(model, optimizer_ptr);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pending_snapshot_opt_.has_value()) {
+      ++num_dropped_checkpoints_;
+    }
+    pending_snapshot_opt_.emplace(file_path, std::move(snapshot));
+  }
+  condition_variable_.notify_all();
+
+  const auto end = std::chrono::steady_clock::now();
+  const double stall_seconds = std::chrono::duration<double>(end - start).count();
+  last_stall_seconds_.store(stall_seconds, std::memory_order_relaxed);
+  double max_stall_seconds = max_stall_seconds_.load(std::memory_order_relaxed);
+  while (max_stall_seconds < stall_seconds &&
+         !max_stall_seconds_.compare_exchange_weak(max_stall_seconds, stall_seconds, std::memory_order_relaxed)) {
+  }
+}
+
+void AsyncCheckpointWriter::Wait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  condition_variable_.wait(lock, [this] { return !pending_snapshot_opt_.has_value() && !is_writing_; });
+}
+
+void AsyncCheckpointWriter::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    condition_variable_.wait(lock, [this] { return pending_snapshot_opt_.has_value() || is_stopping_; });
+    if (!pending_snapshot_opt_.has_value()) {
+      // Stops only after the pending snapshot is written.
+      break;
+    }
+
+    auto [file_path, snapshot] = std::move(pending_snapshot_opt_.value());
+    pending_snapshot_opt_.reset();
+    is_writing_ = true;
+    lock.unlock();
+
+    const bool is_saved = SaveCheckpoint(file_path, snapshot, /* does_sync = */ true);
+    snapshot.clear();  // Releases the shared storages, so that the parameters are no longer copied on their update.
+    if (is_saved) {
+      ++num_written_checkpoints_;
+    } else {
+      ++num_failed_checkpoints_;
+    }
+
+    lock.lock();
+    is_writing_ = false;
+    condition_variable_.notify_all();
+  }
+}
+
+}  // namespace tensorward::core
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+#include "tensorward/core/checkpoint.h"
+#include "tensorward/core/model.h"
+#include "tensorward/core/optimizer.h"
+
+namespace tensorward::core {
+
+// Checkpoint writer running on a background thread, which blocks the training only while taking a snapshot (see
+// `TakeCheckpointSnapshot()`) instead of the whole write:
+//
+//   1. `Save()` takes a snapshot of the model (and the optimizer) at an iteration boundary without copying the data,
+//      hands it over to the background thread, and returns immediately.
+//   2. The background thread serializes the snapshot into the file and flushes it (`fsync()`).
+//
+// NOTE: At most one snapshot is being written and another one is pending at the same time, so the memory overhead is
+// NOTE: bounded by twice the size of the model (copied by copy-on-write when the parameters are updated). If `Save()`
+// NOTE: is called while a snapshot is still pending, then the pending one is dropped in favor of the new one.
+class AsyncCheckpointWriter {
+ public:
+  AsyncCheckpointWriter();
+
+  // Waits for the pending snapshot to be written, and then stops the background thread.
+  ~AsyncCheckpointWriter();
+
+  // Prevents copy construction.
+  AsyncCheckpointWriter(const AsyncCheckpointWriter&) = delete;
+
+  // Prevents copy assignment.
+  AsyncCheckpointWriter& operator=(const AsyncCheckpointWriter&) = delete;
+
+  // Takes a snapshot of the model (and the optimizer if given), and writes it into the file in the background.
+  void Save(const std::filesystem::path& file_path, const Model& model, const Optimizer* optimizer_ptr = nullptr);
+
+  // Blocks until all of the snapshots handed over by `Save()` are written.
+  void Wait();
+
+  const std::size_t num_written_checkpoints() const { return num_written_checkpoints_; }
+
+  const std::size_t num_failed_checkpoints() const { return num_failed_checkpoints_; }
+
+  const std::size_t num_dropped_checkpoints() const { return num_dropped_checkpoints_; }
+
+  // Time [s] for which the last `Save()` blocked the caller.
+  // NOTE: The stats are atomic, so that they can be read from another thread (e.g. a monitor) while `Save()` is
+  // NOTE: updating them.
+  const double last_stall_seconds() const { return last_stall_seconds_.load(std::memory_order_relaxed); }
+
+  const double max_stall_seconds() const { return max_stall_seconds_.load(std::memory_order_relaxed); }
+
+ private:
+  // Main loop of the background thread.
+  void Run();
+
+  std::mutex mutex_;
+
+  // Notified when a snapshot is handed over, when a snapshot is written and when the writer is stopped.
+  std::condition_variable condition_variable_;
+
+  std::optional<std::pair<std::filesystem::path, CheckpointSnapshot>> pending_snapshot_opt_;
+
+  bool is_writing_;
+
+  bool is_stopping_;
+
+  std::atomic<std::size_t> num_written_checkpoints_;
+
+  std::atomic<std::size_t> num_failed_checkpoints_;
+
+  std::atomic<std::size_t> num_dropped_checkpoints_;
+
+  std::atomic<double> last_stall_seconds_;
+
+  std::atomic<double> max_stall_seconds_;
+
+  // NOTE: This must be declared at the end, so that the background thread starts after all of the members above are
+  // NOTE: initialized.
+  std::thread thread_;
+};
+
+}  // namespace tensorward::core
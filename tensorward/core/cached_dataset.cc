@@ -0,0 +1,210 @@
+#include "tensorward/core/cached_dataset.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <functional>
+#include <numeric>
+
+#include <xtensor/xbuilder.hpp>
+
+#include "tensorward/util/atomic.h"
+
+namespace tensorward::core {
+
+namespace {
+
+const std::size_t AlignUp(const std::size_t size) {
+  return (size + kCacheFileAlignment - 1) / kCacheFileAlignment * kCacheFileAlignment;
+}
+
+template <class T>
+void AppendBytes(std::string& buffer, const T& value) {
+  buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// States of the flag of a slot, where only `kSlotCached` is persisted in the cache file.
+constexpr std::uint8_t kSlotEmpty = 0;
+constexpr std::uint8_t kSlotCached = 1;
+constexpr std::uint8_t kSlotWriting = 2;
+
+const std::size_t ShapeSize(const xt::xarray<float>::shape_type& shape) {
+  return std::accumulate(shape.begin(), shape.end(), std::size_t(1), std::multiplies<std::size_t>());
+}
+
+}  // namespace
+
+CachedDataset::CachedDataset(const DatasetSharedPtr dataset_ptr,
+                             const std::vector<TransformLambda>& data_transform_lambdas,
+                             const std::vector<TransformLambda>& label_transform_lambdas,
+                             const std::filesystem::path& cache_file_path /* = std::filesystem::path() */,
+                             const std::string& cache_key /* = "" */)
+    : Dataset(dataset_ptr->is_training_mode(), data_transform_lambdas, label_transform_lambdas,
+              dataset_ptr->dataset_directory_path().filename()),
+      dataset_ptr_(dataset_ptr),
+      cache_file_path_(cache_file_path),
+      cache_key_(cache_key),
+      is_valid_(false),
+      size_(0),
+      data_size_(0),
+      label_size_(0),
+      mapping_(nullptr),
+      mapping_size_(0),
+      flags_(nullptr),
+      slots_(nullptr),
+      num_cache_hits_(0),
+      num_cache_misses_(0) {
+  Init();
+}
+
+CachedDataset::~CachedDataset() { UnmapCache(); }
+
+void CachedDataset::Init() {
+  UnmapCache();
+  ResetCacheStats();
+  is_valid_ = false;
+  size_ = 0;
+
+  const std::size_t size = dataset_ptr_->size();
+  if (size == 0) {
+    return;
+  }
+
+  // Takes the shapes from the first sample.
+  const auto [first_data, first_label] = dataset_ptr_->at(0);
+  data_shape_ = first_data.shape();
+  label_shape_ = first_label.shape();
+  data_size_ = ShapeSize(data_shape_);
+  label_size_ = ShapeSize(label_shape_);
+
+  std::string header;
+  header.append(kCacheFileMagic, sizeof(kCacheFileMagic));
+  AppendBytes(header, static_cast<std::uint64_t>(size));
+  AppendBytes(header, static_cast<std::uint32_t>(data_shape_.size()));
+  AppendBytes(header, static_cast<std::uint32_t>(label_shape_.size()));
+  for (const std::size_t length : data_shape_) {
+    AppendBytes(header, static_cast<std::uint64_t>(length));
+  }
+  for (const std::size_t length : label_shape_) {
+    AppendBytes(header, static_cast<std::uint64_t>(length));
+  }
+  AppendBytes(header, static_cast<std::uint32_t>(cache_key_.size()));
+  header.append(cache_key_);
+  header.resize(AlignUp(header.size()), '\0');
+
+  const std::size_t flags_size = AlignUp(size);
+  mapping_size_ = header.size() + flags_size + size * (data_size_ + label_size_) * sizeof(float);
+  is_valid_ = MapCache(header);
+  if (!is_valid_) {
+    return;
+  }
+  flags_ = reinterpret_cast<std::uint8_t*>(mapping_ + header.size());
+  slots_ = reinterpret_cast<float*>(mapping_ + header.size() + flags_size);
+  size_ = size;
+
+  // Empties the slots being written when the previous run using the cache file was killed.
+  std::replace(flags_, flags_ + size_, kSlotWriting, kSlotEmpty);
+}
+
+const std::pair<xt::xarray<float>, xt::xarray<float>> CachedDataset::at(const std::size_t i) const {
+  assert((static_cast<void>("The index must be less than the size."), i < size_));
+
+  float* slot = slots_ + i * (data_size_ + label_size_);
+  if (util::AtomicLoad(flags_[i], std::memory_order_acquire) == kSlotCached) {
+    ++num_cache_hits_;
+    xt::xarray<float> ith_data = xt::empty<float>(data_shape_);
+    xt::xarray<float> ith_label = xt::empty<float>(label_shape_);
+    std::copy(slot, slot + data_size_, ith_data.data());
+    std::copy(slot + data_size_, slot + data_size_ + label_size_, ith_label.data());
+    return ApplyTransformLambdas(ith_data, ith_label);
+  }
+
+  ++num_cache_misses_;
+  const auto [ith_data, ith_label] = dataset_ptr_->at(i);
+  const bool is_same_shape = (ith_data.shape() == data_shape_ && ith_label.shape() == label_shape_);
+  assert((static_cast<void>("All of the samples must have the same shapes."), is_same_shape));
+  // Claims the slot before writing it, so that only one of the threads missing the same sample at the same time writes
+  // it, while the others (and the readers, which treat only `kSlotCached` as a hit) never touch it. The sample is
+  // published after it's written, so that the other threads never read a partially written one.
+  std::uint8_t expected_flag = kSlotEmpty;
+  if (is_same_shape && util::AtomicCompareExchange(flags_[i], expected_flag, kSlotWriting, std::memory_order_acquire)) {
+    std::copy(ith_data.data(), ith_data.data() + data_size_, slot);
+    std::copy(ith_label.data(), ith_label.data() + label_size_, slot + data_size_);
+    util::AtomicStore(flags_[i], kSlotCached, std::memory_order_release);
+  }
+
+  return ApplyTransformLambdas(ith_data, ith_label);
+}
+
+void CachedDataset::ResetCacheStats() {
+  num_cache_hits_ = 0;
+  num_cache_misses_ = 0;
+}
+
+const std::size_t CachedDataset::num_cached_samples() const {
+  std::size_t num_cached_samples = 0;
+  for (std::size_t i = 0; i < size_; ++i) {
+    num_cached_samples += (util::AtomicLoad(flags_[i], std::memory_order_acquire) == kSlotCached);
+  }
+  return num_cached_samples;
+}
+
+const bool CachedDataset::MapCache(const std::string& header) {
+  if (cache_file_path_.empty()) {
+    void* mapping = mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) {
+      return false;
+    }
+    mapping_ = static_cast<std::byte*>(mapping);
+    std::memcpy(mapping_, header.data(), header.size());
+    return true;
+  }
+
+  const int file_descriptor = open(cache_file_path_.c_str(), O_RDWR | O_CREAT, 0644);
+  if (file_descriptor < 0) {
+    return false;
+  }
+
+  // Reuses the cache file only if it's of the same samples, and otherwise recreates it with no samples cached (i.e.
+  // filled with zeros).
+  struct stat file_status;
+  std::string header_in_file(header.size(), '\0');
+  const bool is_reusable = fstat(file_descriptor, &file_status) == 0 &&
+                           static_cast<std::size_t>(file_status.st_size) == mapping_size_ &&
+                           pread(file_descriptor, header_in_file.data(), header_in_file.size(), 0) ==
+                               static_cast<ssize_t>(header_in_file.size()) &&
+                           header_in_file == header;
+  if (!is_reusable && (ftruncate(file_descriptor, 0) != 0 || ftruncate(file_descriptor, mapping_size_) != 0)) {
+    close(file_descriptor);
+    return false;
+  }
+
+  void* mapping = mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+  close(file_descriptor);  // The mapping remains after closing the file.
+  if (mapping == MAP_FAILED) {
+    return false;
+  }
+  mapping_ = static_cast<std::byte*>(mapping);
+  if (!is_reusable) {
+    std::memcpy(mapping_, header.data(), header.size());
+  }
+  return true;
+}
+
+void CachedDataset::UnmapCache() {
+  if (mapping_ != nullptr) {
+    munmap(mapping_, mapping_size_);
+  }
+  mapping_ = nullptr;
+  mapping_size_ = 0;
+  flags_ = nullptr;
+  slots_ = nullptr;
+}
+
+}  // namespace tensorward::core
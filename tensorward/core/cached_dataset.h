@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <xtensor/xarray.hpp>
+
+#include "tensorward/core/dataset.h"
+
+namespace tensorward::core {
+
+// Cache file format of `CachedDataset`, which stores the samples of the same shapes in the slots of their indices:
+//
+//   +-------------------------------------------------------------------------------------------------------+
+//   | magic "TWCACHE\0" (8 bytes) | number of samples (uint64) | data dimension (uint32) | label dimension     |
+//   | (uint32) | data shape (uint64 * data dimension) | label shape (uint64 * label dimension) | cache key size  |
+//   | (uint32) | cache key (char * cache key size) | zero padding                                               |
+//   +-------------------------------------------------------------------------------------------------------+
+//   | flags: whether each sample is cached (uint8 * number of samples) | zero padding                         |
+//   +-------------------------------------------------------------------------------------------------------+
+//   | slot 0: data (float * data size) | label (float * label size)                                         |
+//   | slot 1: ...                                                                                           |
+//   +-------------------------------------------------------------------------------------------------------+
+//
+// All of the integers and floats are in the native byte order, and the header and the flags are padded to
+// `kCacheFileAlignment` bytes (a page).
+
+constexpr char kCacheFileMagic[8] = {'T', 'W', 'C', 'A', 'C', 'H', 'E', '\0'};
+constexpr std::size_t kCacheFileAlignment = 4096;
+
+// Dataset which caches the samples of another dataset, so that the deterministic transform lambdas of the other
+// dataset (e.g. flattening and normalization) are applied only once per sample instead of once per epoch, and only the
+// transform lambdas of this dataset (e.g. the random augmentation) are applied at each `at()`:
+//
+//   // The deterministic transform lambdas are given to the underlying dataset, and the random ones to this dataset.
+//   const DatasetSharedPtr dataset_ptr = std::make_shared<CachedDataset>(
+//       AsDatasetSharedPtr<Mnist>(true, {flatten_lambda, normalize_lambda}), {random_noise_lambda}, {});
+//
+// The samples are cached at the first access to each of them, in an anonymous memory mapping, or in a memory-mapped
+// cache file if the path is given. The cache file is reused (with the samples cached in it) when the dataset is
+// created again with the same cache key and the same number and shapes of the samples, e.g. by the next run of the
+// training.
+//
+// NOTE: All of the samples of the underlying dataset must have the same shapes (as required by `DataLoader` anyway).
+// NOTE: The transform lambdas of the underlying dataset must not change while the cache file is reused, since the
+// NOTE: lambdas themselves can't be compared. So give a cache key identifying them (e.g. "flatten-normalize-v2"), and
+// NOTE: change it whenever they change (or delete the cache file), otherwise the stale samples are reused silently.
+// NOTE: `at()` is thread-safe and doesn't lock anything. The threads missing the same sample at the same time all read
+// NOTE: it from the underlying dataset, but only the first one writes it into the cache.
+class CachedDataset : public Dataset {
+ public:
+  CachedDataset(const DatasetSharedPtr dataset_ptr, const std::vector<TransformLambda>& data_transform_lambdas,
+                const std::vector<TransformLambda>& label_transform_lambdas,
+                const std::filesystem::path& cache_file_path = std::filesystem::path(),
+                const std::string& cache_key = "");
+
+  // Unmaps the cache.
+  ~CachedDataset();
+
+  // Prevents copy construction.
+  CachedDataset(const CachedDataset&) = delete;
+
+  // Prevents copy assignment.
+  CachedDataset& operator=(const CachedDataset&) = delete;
+
+  // Maps the cache for the samples of the underlying dataset (whose shapes are taken from the first sample).
+  void Init() override;
+
+  const std::size_t size() const override { return size_; }
+
+  const std::pair<xt::xarray<float>, xt::xarray<float>> at(const std::size_t i) const override;
+
+  // Resets the numbers of the cache hits and misses (e.g. at the beginning of each epoch).
+  void ResetCacheStats();
+
+  const bool is_valid() const { return is_valid_; }
+
+  const DatasetSharedPtr dataset_ptr() const { return dataset_ptr_; }
+
+  const std::filesystem::path& cache_file_path() const { return cache_file_path_; }
+
+  const std::string& cache_key() const { return cache_key_; }
+
+  const std::size_t num_cache_hits() const { return num_cache_hits_; }
+
+  const std::size_t num_cache_misses() const { return num_cache_misses_; }
+
+  // Number of the samples in the cache, which is `size()` after all of them have been accessed.
+  const std::size_t num_cached_samples() const;
+
+ private:
+  // Maps the cache file (or the anonymous memory) with the header, and returns false if it fails. The existing cache
+  // file is reused only if its header (including the cache key) and size match.
+  const bool MapCache(const std::string& header);
+
+  // Unmaps the cache if it's mapped.
+  void UnmapCache();
+
+  DatasetSharedPtr dataset_ptr_;
+
+  std::filesystem::path cache_file_path_;
+
+  std::string cache_key_;
+
+  bool is_valid_;
+
+  std::size_t size_;
+
+  std::size_t data_size_;
+
+  std::size_t label_size_;
+
+  xt::xarray<float>::shape_type data_shape_;
+
+  xt::xarray<float>::shape_type label_shape_;
+
+  std::byte* mapping_;
+
+  std::size_t mapping_size_;
+
+  std::uint8_t* flags_;
+
+  float* slots_;
+
+  mutable std::atomic<std::size_t> num_cache_hits_;
+
+  mutable std::atomic<std::size_t> num_cache_misses_;
+};
+
+}  // namespace tensorward::core
@@ -0,0 +1,388 @@
+#include "tensorward/core/checkpoint.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string_view>
+#include <utility>
+
+namespace tensorward::core {
+
+namespace {
+
+const std::uint64_t AlignUp(const std::uint64_t offset) {
+  return (offset + kCheckpointAlignment - 1) / kCheckpointAlignment * kCheckpointAlignment;
+}
+
+template <class T>
+void AppendBytes(std::string& buffer, const T& value) {
+  buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// Reads a value at the cursor, and advances the cursor. Returns false if it exceeds the end.
+template <class T>
+const bool ReadBytes(const std::byte*& cursor, const std::byte* end, T& value) {
+  if (end < cursor + sizeof(value)) {
+    return false;
+  }
+  std::memcpy(&value, cursor, sizeof(value));
+  cursor += sizeof(value);
+  return true;
+}
+
+// Collects the parameters of the model by the names "layer<index>/<parameter name>" in the (sorted) name order, so that
+// the same model is always saved into the same layout.
+const std::map<std::string, ParameterSharedPtr> NamedParamPtrs(const Model& model) {
+  std::map<std::string, ParameterSharedPtr> named_param_ptrs;
+  for (std::size_t i = 0; i < model.layer_ptrs().size(); ++i) {
+    for (const auto& [param_name, param_ptr] : model.layer_ptrs()[i]->param_map()) {
+      named_param_ptrs["layer" + std::to_string(i) + "/" + param_name] = param_ptr;
+    }
+  }
+  return named_param_ptrs;
+}
+
+// Flushes the directory containing the file (e.g. after renaming the file into it), so that the directory entry of the
+// file is also durable. Otherwise, the renamed file can disappear (or be the old one) after a crash even if the file
+// itself has been flushed.
+const bool SyncParentDirectory(const std::filesystem::path& file_path) {
+  const std::filesystem::path directory_path = file_path.has_parent_path() ? file_path.parent_path() : ".";
+  const int directory_descriptor = open(directory_path.c_str(), O_RDONLY | O_DIRECTORY);
+  if (directory_descriptor < 0) {
+    return false;
+  }
+  const bool is_synced = (fsync(directory_descriptor) == 0);
+  close(directory_descriptor);
+  return is_synced;
+}
+
+// Splits "layer<index>/<parameter name>" into the layer index and the parameter name.
+const bool ParseParamName(const std::string& name, std::size_t& layer_index, std::string& param_name) {
+  constexpr std::string_view kLayerPrefix = "layer";
+  const std::size_t slash_position = name.find('/');
+  if (name.rfind(kLayerPrefix, 0) != 0 || slash_position == std::string::npos ||
+      slash_position == kLayerPrefix.size()) {
+    return false;
+  }
+  // NOTE: `std::from_chars()` (unlike `std::stoul()`) reports the overflow of a corrupt index by the error code instead
+  // NOTE: of throwing, and rejects the signs and the whitespaces.
+  const char* const layer_index_begin = name.data() + kLayerPrefix.size();
+  const char* const layer_index_end = name.data() + slash_position;
+  const auto [parsed_end, error_code] = std::from_chars(layer_index_begin, layer_index_end, layer_index);
+  if (error_code != std::errc() || parsed_end != layer_index_end) {
+    return false;
+  }
+  param_name = name.substr(slash_position + 1);
+  return true;
+}
+
+// Writes all of the buffers with `writev()`, which is repeated only if the buffers are more than `IOV_MAX` or the
+// write is partial.
+const bool WriteAll(const int file_descriptor, std::vector<iovec>& iovecs) {
+  std::size_t i = 0;
+  while (i < iovecs.size()) {
+    const int num_iovecs = static_cast<int>(std::min<std::size_t>(iovecs.size() - i, IOV_MAX));
+    const ssize_t written_size = writev(file_descriptor, iovecs.data() + i, num_iovecs);
+    if (written_size < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+
+    // Skips the buffers which have been written completely, and advances the partially written buffer.
+    std::size_t remaining_size = written_size;
+    while (i < iovecs.size() && iovecs[i].iov_len <= remaining_size) {
+      remaining_size -= iovecs[i].iov_len;
+      ++i;
+    }
+    if (0 < remaining_size) {
+      iovecs[i].iov_base = static_cast<char*>(iovecs[i].iov_base) + remaining_size;
+      iovecs[i].iov_len -= remaining_size;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+const CheckpointSnapshot TakeCheckpointSnapshot(const Model& model, const Optimizer* optimizer_ptr /* = nullptr */) {
+  CheckpointSnapshot snapshot;
+  for (const auto& [name, param_ptr] : NamedParamPtrs(model)) {
+    snapshot.push_back({CheckpointEntryKind::kParameter, name, param_ptr->contiguous_data_ptr()});
+
+    if (optimizer_ptr) {
+      const auto state_map = optimizer_ptr->GetStateMap(param_ptr);
+      const std::map<std::string, std::shared_ptr<const xt::xarray<float>>> sorted_state_map(state_map.begin(),
+                                                                                              state_map.end());
+      for (const auto& [state_name, state_ptr] : sorted_state_map) {
+        snapshot.push_back({CheckpointEntryKind::kOptimizerState, name + "/" + state_name, state_ptr});
+      }
+    }
+  }
+  return snapshot;
+}
+
+const bool SaveCheckpoint(const std::filesystem::path& file_path, const CheckpointSnapshot& snapshot,
+                          const bool does_sync /* = false */) {
+  std::vector<CheckpointEntry> entries;
+  entries.reserve(snapshot.size());
+  for (const auto& [kind, name, data_ptr] : snapshot) {
+    entries.push_back({kind, name, data_ptr->shape(), 0, data_ptr->size() * sizeof(float)});
+  }
+
+  // Computes the size of the header, and then the (aligned) offsets of the payloads.
+  std::uint64_t header_size = sizeof(kCheckpointMagic) + sizeof(std::uint32_t) * 2 + sizeof(std::uint64_t);
+  for (const auto& entry : entries) {
+    header_size += sizeof(std::uint32_t) * 3 + entry.name.size() + sizeof(std::uint64_t) * (entry.shape.size() + 2);
+  }
+  std::uint64_t offset = AlignUp(header_size);
+  const std::uint64_t payload_offset = offset;
+  for (auto& entry : entries) {
+    entry.offset = offset;
+    offset = AlignUp(offset + entry.size_in_bytes);
+  }
+
+  // Serializes the header.
+  std::string header;
+  header.reserve(header_size);
+  header.append(kCheckpointMagic, sizeof(kCheckpointMagic));
+  AppendBytes(header, kCheckpointVersion);
+  AppendBytes(header, static_cast<std::uint32_t>(entries.size()));
+  AppendBytes(header, payload_offset);
+  for (const auto& entry : entries) {
+    AppendBytes(header, static_cast<std::uint32_t>(entry.kind));
+    AppendBytes(header, static_cast<std::uint32_t>(entry.name.size()));
+    header.append(entry.name);
+    AppendBytes(header, static_cast<std::uint32_t>(entry.shape.size()));
+    for (const std::size_t length : entry.shape) {
+      AppendBytes(header, static_cast<std::uint64_t>(length));
+    }
+    AppendBytes(header, entry.offset);
+    AppendBytes(header, entry.size_in_bytes);
+  }
+
+  // Gathers the header, the payloads and the paddings in between without copying the payloads.
+  static const char kPadding[kCheckpointAlignment] = {};
+  std::vector<iovec> iovecs;
+  iovecs.reserve(entries.size() * 2 + 2);
+  iovecs.push_back({header.data(), header.size()});
+  std::uint64_t written_offset = header.size();
+  for (std::size_t i = 0; i < entries.size(); ++i) {
+    if (written_offset < entries[i].offset) {
+      iovecs.push_back({const_cast<char*>(kPadding), entries[i].offset - written_offset});
+    }
+    iovecs.push_back({const_cast<float*>(snapshot[i].data_ptr->data()), entries[i].size_in_bytes});
+    written_offset = entries[i].offset + entries[i].size_in_bytes;
+  }
+
+  const std::filesystem::path temporary_file_path = file_path.string() + ".tmp";
+  const int file_descriptor = open(temporary_file_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (file_descriptor < 0) {
+    return false;
+  }
+  const bool is_written = WriteAll(file_descriptor, iovecs) && (!does_sync || fsync(file_descriptor) == 0);
+  const bool is_closed = (close(file_descriptor) == 0);
+  if (!is_written || !is_closed) {
+    std::filesystem::remove(temporary_file_path);
+    return false;
+  }
+
+  std::error_code error_code;
+  std::filesystem::rename(temporary_file_path, file_path, error_code);
+  if (error_code) {
+    return false;
+  }
+  return !does_sync || SyncParentDirectory(file_path);
+}
+
+const bool SaveCheckpoint(const std::filesystem::path& file_path, const Model& model,
+                          const Optimizer* optimizer_ptr /* = nullptr */) {
+  return SaveCheckpoint(file_path, TakeCheckpointSnapshot(model, optimizer_ptr));
+}
+
+const bool LoadCheckpoint(const std::filesystem::path& file_path, Model& model,
+                          Optimizer* optimizer_ptr /* = nullptr */) {
+  const MappedCheckpoint checkpoint(file_path);
+  if (!checkpoint.is_valid()) {
+    return false;
+  }
+
+  // Validates all of the entries before copying any of them, so that the model (and the optimizer) is left untouched
+  // (instead of half-loaded) if the checkpoint doesn't match it.
+  const std::map<std::string, ParameterSharedPtr> named_param_ptrs = NamedParamPtrs(model);
+  for (const auto& entry : checkpoint.entries()) {
+    if (entry.kind != CheckpointEntryKind::kParameter) {
+      continue;
+    }
+
+    std::size_t layer_index;
+    std::string param_name;
+    if (!ParseParamName(entry.name, layer_index, param_name) || model.layer_ptrs().size() <= layer_index) {
+      return false;
+    }
+    const auto found = named_param_ptrs.find(entry.name);
+    if (found != named_param_ptrs.end() && found->second->data().shape() != entry.shape) {
+      return false;
+    }
+
+    // The state of the optimizer (e.g. the velocity) has the same shape as the parameter.
+    if (optimizer_ptr) {
+      const std::string state_name_prefix = entry.name + "/";
+      for (const auto& state_entry : checkpoint.entries()) {
+        if (state_entry.kind == CheckpointEntryKind::kOptimizerState &&
+            state_entry.name.rfind(state_name_prefix, 0) == 0 && state_entry.shape != entry.shape) {
+          return false;
+        }
+      }
+    }
+  }
+
+  for (const auto& entry : checkpoint.entries()) {
+    if (entry.kind != CheckpointEntryKind::kParameter) {
+      continue;
+    }
+
+    std::size_t layer_index;
+    std::string param_name;
+    ParseParamName(entry.name, layer_index, param_name);
+
+    const float* payload = checkpoint.Payload(entry);
+    ParameterSharedPtr param_ptr;
+    if (named_param_ptrs.count(entry.name) == 0) {
+      // Creates the parameter, which is used instead of being initialized by the forward calculation.
+      xt::xarray<float> data = xt::adapt(payload, entry.size_in_bytes / sizeof(float), xt::no_ownership(), entry.shape);
+      param_ptr = AsParameterSharedPtr(data, param_name);
+      model.layer_ptrs()[layer_index]->SetParamPtr(param_name, param_ptr);
+    } else {
+      // Overwrites the data in place (instead of replacing the parameter), so that the pointers to the parameter held
+      // by the others (e.g. `Model::param_ptrs_` and the optimizer) are still valid.
+      param_ptr = named_param_ptrs.at(entry.name);
+      std::memcpy(param_ptr->MutableData().data(), payload, entry.size_in_bytes);
+    }
+
+    if (optimizer_ptr) {
+      std::unordered_map<std::string, xt::xarray<float>> state_map;
+      const std::string state_name_prefix = entry.name + "/";
+      for (const auto& state_entry : checkpoint.entries()) {
+        if (state_entry.kind == CheckpointEntryKind::kOptimizerState &&
+            state_entry.name.rfind(state_name_prefix, 0) == 0) {
+          state_map[state_entry.name.substr(state_name_prefix.size())] = checkpoint.Adapt(state_entry.name);
+        }
+      }
+      if (!state_map.empty()) {
+        optimizer_ptr->SetStateMap(param_ptr, state_map);
+      }
+    }
+  }
+
+  return true;
+}
+
+MappedCheckpoint::MappedCheckpoint(const std::filesystem::path& file_path)
+    : mapped_pointer_(MAP_FAILED), mapped_size_(0), is_valid_(false), version_(0) {
+  const int file_descriptor = open(file_path.c_str(), O_RDONLY);
+  if (file_descriptor < 0) {
+    return;
+  }
+
+  struct stat file_status;
+  if (fstat(file_descriptor, &file_status) == 0 && 0 < file_status.st_size) {
+    mapped_size_ = file_status.st_size;
+    mapped_pointer_ = mmap(nullptr, mapped_size_, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+  }
+  close(file_descriptor);  // The mapping is still valid after closing the file.
+
+  if (mapped_pointer_ == MAP_FAILED) {
+    return;
+  }
+  // The whole file is read sequentially (e.g. by `LoadCheckpoint()`), so the kernel can read ahead aggressively.
+  madvise(mapped_pointer_, mapped_size_, MADV_SEQUENTIAL);
+  madvise(mapped_pointer_, mapped_size_, MADV_WILLNEED);
+
+  is_valid_ = ParseHeader();
+}
+
+MappedCheckpoint::~MappedCheckpoint() {
+  if (mapped_pointer_ != MAP_FAILED) {
+    munmap(mapped_pointer_, mapped_size_);
+  }
+}
+
+const bool MappedCheckpoint::ParseHeader() {
+  const std::byte* begin = static_cast<const std::byte*>(mapped_pointer_);
+  const std::byte* end = begin + mapped_size_;
+  const std::byte* cursor = begin;
+
+  char magic[sizeof(kCheckpointMagic)];
+  if (!ReadBytes(cursor, end, magic) || std::memcmp(magic, kCheckpointMagic, sizeof(magic)) != 0) {
+    return false;
+  }
+
+  std::uint32_t num_entries;
+  std::uint64_t payload_offset;
+  if (!ReadBytes(cursor, end, version_) || version_ != kCheckpointVersion || !ReadBytes(cursor, end, num_entries) ||
+      !ReadBytes(cursor, end, payload_offset)) {
+    return false;
+  }
+
+  for (std::uint32_t i = 0; i < num_entries; ++i) {
+    CheckpointEntry entry;
+    std::uint32_t kind;
+    std::uint32_t name_size;
+    std::uint32_t dimension;
+    if (!ReadBytes(cursor, end, kind) || !ReadBytes(cursor, end, name_size) ||
+        static_cast<std::uint64_t>(end - cursor) < name_size) {
+      return false;
+    }
+    entry.kind = static_cast<CheckpointEntryKind>(kind);
+    entry.name.assign(reinterpret_cast<const char*>(cursor), name_size);
+    cursor += name_size;
+
+    if (!ReadBytes(cursor, end, dimension) ||
+        static_cast<std::uint64_t>(end - cursor) < dimension * sizeof(std::uint64_t)) {
+      return false;
+    }
+    std::uint64_t num_elements = 1;
+    entry.shape.resize(dimension);
+    for (std::uint32_t axis = 0; axis < dimension; ++axis) {
+      std::uint64_t length;
+      if (!ReadBytes(cursor, end, length)) {
+        return false;
+      }
+      // Rejects the shape whose size in bytes overflows, which would pass the size check below after wrapping around.
+      if (length != 0 && UINT64_MAX / sizeof(float) / length < num_elements) {
+        return false;
+      }
+      entry.shape[axis] = length;
+      num_elements *= length;
+    }
+
+    if (!ReadBytes(cursor, end, entry.offset) || !ReadBytes(cursor, end, entry.size_in_bytes)) {
+      return false;
+    }
+    const bool is_payload_valid = entry.offset % kCheckpointAlignment == 0 && payload_offset <= entry.offset &&
+                                  entry.size_in_bytes == num_elements * sizeof(float) &&
+                                  entry.offset <= mapped_size_ && entry.size_in_bytes <= mapped_size_ - entry.offset;
+    if (!is_payload_valid) {
+      return false;
+    }
+
+    entry_index_map_[entry.name] = entries_.size();
+    entries_.push_back(std::move(entry));
+  }
+
+  return static_cast<std::uint64_t>(cursor - begin) <= payload_offset;
+}
+
+}  // namespace tensorward::core
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <xtensor/xadapt.hpp>
+#include <xtensor/xarray.hpp>
+
+#include "tensorward/core/model.h"
+#include "tensorward/core/optimizer.h"
+
+namespace tensorward::core {
+
+// Binary checkpoint format of a model (and optionally the state of its optimizer):
+//
+//   +-------------------------------------------------------------------------------------------------------+
+//   | magic "TWCKPT\0\0" (8 bytes) | version (uint32) | number of entries (uint32) | payload offset (uint64) |
+//   +-------------------------------------------------------------------------------------------------------+
+//   | entry 0: kind (uint32) | name size (uint32) | name | dimension (uint32) | shape (uint64 * dimension) |  |
+//   |          offset (uint64) | size in bytes (uint64)                                                    |  |
+//   | entry 1: ...                                                                                          |
+//   +-------------------------------------------------------------------------------------------------------+
+//   | padding to 64 bytes | payload 0 (float) | padding to 64 bytes | payload 1 (float) | ...                |
+//   +-------------------------------------------------------------------------------------------------------+
+//
+// The parameters are named "layer<index>/<parameter name>" (e.g. "layer0/W"), and the optimizer states are named
+// "<parameter name>/<state name>" (e.g. "layer0/W/velocity"). All of the integers and floats are in the native byte
+// order, so a checkpoint is not portable between little-endian and big-endian machines.
+//
+// NOTE: Every payload starts at a multiple of 64 bytes (a cache line, and the alignment of the widest SIMD load), so
+// NOTE: that the payloads can be used in place after mapping the file into memory.
+
+constexpr char kCheckpointMagic[8] = {'T', 'W', 'C', 'K', 'P', 'T', '\0', '\0'};
+constexpr std::uint32_t kCheckpointVersion = 1;
+constexpr std::size_t kCheckpointAlignment = 64;
+
+enum class CheckpointEntryKind : std::uint32_t {
+  kParameter = 0,
+  kOptimizerState = 1,
+};
+
+struct CheckpointEntry {
+  CheckpointEntryKind kind;
+
+  std::string name;
+
+  xt::xarray<float>::shape_type shape;
+
+  // Offset of the payload from the beginning of the file, which is a multiple of `kCheckpointAlignment`.
+  std::uint64_t offset;
+
+  std::uint64_t size_in_bytes;
+};
+
+// Entry of a snapshot, whose payload shares the storage with the parameter (or the optimizer state).
+struct CheckpointSnapshotEntry {
+  CheckpointEntryKind kind;
+
+  std::string name;
+
+  std::shared_ptr<const xt::xarray<float>> data_ptr;
+};
+
+// Entries of a checkpoint in the order of the payloads in the file.
+using CheckpointSnapshot = std::vector<CheckpointSnapshotEntry>;
+
+// Takes a snapshot of the parameters of the model (and the state of the optimizer if given) without copying them.
+// NOTE: The parameters are updated by copy-on-write (see `Tensor::MutableData()`), so the snapshot keeps the data at
+// NOTE: this point even if the training goes on. Instead, each parameter is copied at its next update while the
+// NOTE: snapshot is alive.
+const CheckpointSnapshot TakeCheckpointSnapshot(const Model& model, const Optimizer* optimizer_ptr = nullptr);
+
+// Saves the snapshot into the file with a single sequential write (`writev()` of the header and all of the payloads
+// without copying them into a buffer). The file is written into a temporary file first and then renamed, so an existing
+// checkpoint is never left half-written. If `does_sync` is true, the file is also flushed to the storage (`fsync()`)
+// before being renamed, and so is the directory after renaming it.
+// Returns false if it fails to write the file.
+const bool SaveCheckpoint(const std::filesystem::path& file_path, const CheckpointSnapshot& snapshot,
+                          const bool does_sync = false);
+
+// Saves the parameters of the model (and the state of the optimizer if given) in the same way as above.
+const bool SaveCheckpoint(const std::filesystem::path& file_path, const Model& model,
+                          const Optimizer* optimizer_ptr = nullptr);
+
+// Loads the parameters of the model (and the state of the optimizer if given) from the file mapped into memory. If a
+// parameter doesn't exist yet (e.g. the layer hasn't performed the forward calculation yet), then it's created.
+// Returns false if the file is not a valid checkpoint or doesn't match the model, in which case neither the model nor
+// the optimizer is modified.
+const bool LoadCheckpoint(const std::filesystem::path& file_path, Model& model, Optimizer* optimizer_ptr = nullptr);
+
+// Checkpoint file mapped into memory (read-only), whose payloads can be accessed without copying them.
+class MappedCheckpoint {
+ public:
+  MappedCheckpoint(const std::filesystem::path& file_path);
+
+  ~MappedCheckpoint();
+
+  // Prevents copy construction.
+  MappedCheckpoint(const MappedCheckpoint&) = delete;
+
+  // Prevents copy assignment.
+  MappedCheckpoint& operator=(const MappedCheckpoint&) = delete;
+
+  // Returns the payload of the entry as a (read-only) view on the mapped memory, which is valid only while this object
+  // is alive.
+  // NOTE: This function fails if `name` doesn't exist in the entries.
+  auto Adapt(const std::string& name) const {
+    const CheckpointEntry& entry = entries_.at(entry_index_map_.at(name));
+    return xt::adapt(Payload(entry), entry.size_in_bytes / sizeof(float), xt::no_ownership(), entry.shape);
+  }
+
+  const float* Payload(const CheckpointEntry& entry) const {
+    return reinterpret_cast<const float*>(static_cast<const std::byte*>(mapped_pointer_) + entry.offset);
+  }
+
+  const bool Contains(const std::string& name) const { return entry_index_map_.count(name) != 0; }
+
+  const bool is_valid() const { return is_valid_; }
+
+  const std::uint32_t version() const { return version_; }
+
+  const std::vector<CheckpointEntry>& entries() const { return entries_; }
+
+ private:
+  // Parses the header, and returns false if the header is broken.
+  const bool ParseHeader();
+
+  void* mapped_pointer_;
+
+  std::size_t mapped_size_;
+
+  bool is_valid_;
+
+  std::uint32_t version_;
+
+  std::vector<CheckpointEntry> entries_;
+
+  std::unordered_map<std::string, std::size_t> entry_index_map_;
+};
+
+}  // namespace tensorward::core
@@ -1,11 +1,15 @@
 #pragma once
 
 #include <cassert>
+#include <optional>
 #include <string_view>
 #include <unordered_map>
 
 namespace tensorward::core {
 
+// Reduced-precision storage enabled by `Config::kDoesUseBFloat16Storage` or `Config::kDoesUseFloat16Storage`.
+enum class ReducedPrecisionStorage { kNone, kBFloat16, kFloat16 };
+
 class Config {
  public:
   // Gets the singleton instance.
@@ -26,17 +30,55 @@ class Config {
   // Prevents move assignment.
   Config& operator=(Config&&) = delete;
 
-  // Gets the config value of the queried key.
+  // Gets the config value of the queried key, which is the value overridden for the calling thread (see
+  // `UseThreadLocalConfig`) if any, or the global value otherwise.
   // NOTE: This function fails if `config_key` doesn't exist in `config_map_`.
-  const bool config_value(const std::string_view& config_key) const { return config_map_.at(config_key); }
+  const bool config_value(const std::string_view& config_key) const {
+    const std::unordered_map<std::string_view, bool>& thread_local_config_map = ThreadLocalConfigMap();
+    if (!thread_local_config_map.empty()) {
+      const auto found = thread_local_config_map.find(config_key);
+      if (found != thread_local_config_map.end()) {
+        return found->second;
+      }
+    }
+    return config_map_.at(config_key);
+  }
+
+  // Gets the reduced-precision storage, which is cached whenever its config values are set, so that every op and
+  // gradient can check it without looking up the map (i.e. it costs nothing if it's disabled).
+  const ReducedPrecisionStorage reduced_precision_storage() const {
+    if (!ThreadLocalConfigMap().empty()) {
+      return ToReducedPrecisionStorage(config_value(kDoesUseBFloat16Storage), config_value(kDoesUseFloat16Storage));
+    }
+    return reduced_precision_storage_;
+  }
 
   static constexpr std::string_view kDoesEnableBackpropagation = "does_enable_backpropagation";
   static constexpr std::string_view kIsTrainingMode = "is_training_mode";
+  static constexpr std::string_view kDoesUseWinogradConvolution = "does_use_winograd_convolution";
+  // NOTE: The reduced-precision (bfloat16 or float16) storage of the activations and the gradients is emulated by
+  // NOTE: rounding them (see `EmulateReducedPrecisionStorage()`), while the parameters are kept in float as the master
+  // NOTE: weights. Only one of them can be enabled at once.
+  static constexpr std::string_view kDoesUseBFloat16Storage = "does_use_bfloat16_storage";
+  static constexpr std::string_view kDoesUseFloat16Storage = "does_use_float16_storage";
+  // NOTE: The parallel reductions (e.g. `function::Sum`) sum up the chunks of a fixed size, so that the result doesn't
+  // NOTE: depend on the number of the threads. Otherwise, the chunks are one per thread, which is a little faster.
+  static constexpr std::string_view kDoesUseDeterministicReduction = "does_use_deterministic_reduction";
+  // NOTE: The large data copied into a tensor is placed on the nodes of the workers of the thread pool shared by the
+  // NOTE: kernels which process it (see `util::XtensorCopyNumaLocal()`), and the workers are pinned to the CPUs spread
+  // NOTE: over the NUMA nodes if the pool is created by the placement (see `util::ThreadPool::instance()`). So enable
+  // NOTE: it before running any kernel, or replace the pool by `util::ThreadPool::ResetInstance()`.
+  static constexpr std::string_view kDoesUseNumaLocalPlacement = "does_use_numa_local_placement";
 
  private:
   Config() {
     config_map_[kDoesEnableBackpropagation] = true;
     config_map_[kIsTrainingMode] = true;
+    config_map_[kDoesUseWinogradConvolution] = true;
+    config_map_[kDoesUseBFloat16Storage] = false;
+    config_map_[kDoesUseFloat16Storage] = false;
+    config_map_[kDoesUseDeterministicReduction] = true;
+    config_map_[kDoesUseNumaLocalPlacement] = false;
   }
 
   ~Config() {}
@@ -46,11 +88,36 @@ class Config {
   void SetConfigValue(const std::string_view& config_key, const bool config_value) {
     assert((static_cast<void>("`Config::config_map_` must have the value of the key."), config_map_.count(config_key)));
     config_map_[config_key] = config_value;
+
+    if (config_key == kDoesUseBFloat16Storage || config_key == kDoesUseFloat16Storage) {
+      reduced_precision_storage_ =
+          ToReducedPrecisionStorage(config_map_.at(kDoesUseBFloat16Storage), config_map_.at(kDoesUseFloat16Storage));
+    }
+  }
+
+  static const ReducedPrecisionStorage ToReducedPrecisionStorage(const bool does_use_bfloat16_storage,
+                                                                 const bool does_use_float16_storage) {
+    assert((static_cast<void>("Only one of the reduced-precision storages can be enabled."),
+            !(does_use_bfloat16_storage && does_use_float16_storage)));
+    return does_use_bfloat16_storage  ? ReducedPrecisionStorage::kBFloat16
+           : does_use_float16_storage ? ReducedPrecisionStorage::kFloat16
+                                      : ReducedPrecisionStorage::kNone;
+  }
+
+  // Config values overridden only for the calling thread, which is empty unless `UseThreadLocalConfig` is alive on the
+  // thread (so the global values are used without any lookup of this map).
+  static std::unordered_map<std::string_view, bool>& ThreadLocalConfigMap() {
+    static thread_local std::unordered_map<std::string_view, bool> thread_local_config_map;
+    return thread_local_config_map;
   }
 
   std::unordered_map<std::string_view, bool> config_map_;
 
+  ReducedPrecisionStorage reduced_precision_storage_ = ReducedPrecisionStorage::kNone;
+
   friend class UseConfig;
+
+  friend class UseThreadLocalConfig;
 };
 
 class UseConfig {
@@ -76,4 +143,42 @@ class UseConfig {
   bool new_config_value_;
 };
 
+// Same as `UseConfig`, but overrides the config value only for the calling thread, so that a thread can change it
+// (e.g. disable the backpropagation for the inference) without racing with the other threads reading the global value.
+class UseThreadLocalConfig {
+ public:
+  // Preserves the old overridden value (if any), and overrides with a new config value.
+  UseThreadLocalConfig(const std::string_view& config_key, const bool new_config_value) : config_key_(config_key) {
+    assert((static_cast<void>("`Config::config_map_` must have the value of the key."),
+            Config::instance().config_map_.count(config_key)));
+    std::unordered_map<std::string_view, bool>& thread_local_config_map = Config::ThreadLocalConfigMap();
+    const auto found = thread_local_config_map.find(config_key_);
+    if (found != thread_local_config_map.end()) {
+      old_config_value_opt_ = found->second;
+    }
+    thread_local_config_map[config_key_] = new_config_value;
+  }
+
+  // Restores the old overridden value, or removes the override.
+  ~UseThreadLocalConfig() {
+    std::unordered_map<std::string_view, bool>& thread_local_config_map = Config::ThreadLocalConfigMap();
+    if (old_config_value_opt_.has_value()) {
+      thread_local_config_map[config_key_] = old_config_value_opt_.value();
+    } else {
+      thread_local_config_map.erase(config_key_);
+    }
+  }
+
+  // Prevents copy construction.
+  UseThreadLocalConfig(const UseThreadLocalConfig&) = delete;
+
+  // Prevents copy assignment.
+  UseThreadLocalConfig& operator=(const UseThreadLocalConfig&) = delete;
+
+ private:
+  std::string_view config_key_;
+
+  std::optional<bool> old_config_value_opt_;
+};
+
 }  // namespace tensorward::core
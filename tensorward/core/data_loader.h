@@ -1,61 +1,80 @@
 #pragma once
 
-#include <cmath>
+#include <cstddef>
 #include <utility>
+#include <vector>
 
 #include <xtensor/xarray.hpp>
 
 #include "tensorward/core/dataset.h"
+#include "tensorward/core/sampler.h"
 
 namespace tensorward::core {
 
 class DataLoader {
  public:
+  // Samples every `decimating_scale`-th sample of the dataset, in a random order if `does_shuffle_dataset` is true
+  // (seeded from `xt::random::get_default_random_engine()`, so `xt::random::seed()` makes it reproducible).
+  // The batch transform lambdas (if any) are applied to each batch after the transform lambdas of the dataset are
+  // applied to each sample.
   DataLoader(const DatasetSharedPtr dataset_ptr, const std::size_t batch_size, const bool does_shuffle_dataset,
-             const std::size_t decimating_scale = 1)
+             const std::size_t decimating_scale = 1,
+             const BatchTransformLambda& batch_data_transform_lambda = BatchTransformLambda(),
+             const BatchTransformLambda& batch_label_transform_lambda = BatchTransformLambda());
+
+  // Samples the samples of the dataset by the sampler (e.g. `StratifiedSampler`). The last batch is partial if the
+  // number of the sampled indices isn't divisible by the batch size, or dropped if `does_drop_last` is true.
+  DataLoader(const DatasetSharedPtr dataset_ptr, const std::size_t batch_size, const SamplerSharedPtr sampler_ptr,
+             const bool does_drop_last = false,
+             const BatchTransformLambda& batch_data_transform_lambda = BatchTransformLambda(),
+             const BatchTransformLambda& batch_label_transform_lambda = BatchTransformLambda())
       : dataset_ptr_(dataset_ptr),
         batch_size_(batch_size),
-        does_shuffle_dataset_(does_shuffle_dataset),
-        decimating_scale_(decimating_scale) {
-    Init();
-  }
+        sampler_ptr_(sampler_ptr),
+        does_drop_last_(does_drop_last),
+        batch_data_transform_lambda_(batch_data_transform_lambda),
+        batch_label_transform_lambda_(batch_label_transform_lambda) {}
 
   ~DataLoader() {}
 
-  void Init();
+  // Samples the indices for the next epoch (which is also done after the last batch of each epoch).
+  void Init() { sampler_ptr_->Init(); }
 
   const std::pair<xt::xarray<float>, xt::xarray<float>> GetBatchAt(const std::size_t i);
 
-  const std::size_t dataset_size() const { return dataset_ptr_->size() / decimating_scale_; }
+  // Number of the samples of an epoch (including the dropped last batch if any).
+  const std::size_t dataset_size() const { return sampler_ptr_->size(); }
 
   const std::size_t max_iteration() const {
-    return std::ceil(static_cast<float>(dataset_size()) / static_cast<float>(batch_size_));
+    return does_drop_last_ ? (dataset_size() / batch_size_) : ((dataset_size() + batch_size_ - 1) / batch_size_);
   }
 
   const DatasetSharedPtr dataset_ptr() const { return dataset_ptr_; }
 
   const std::size_t batch_size() const { return batch_size_; }
 
-  const bool does_shuffle_dataset() const { return does_shuffle_dataset_; }
+  const SamplerSharedPtr sampler_ptr() const { return sampler_ptr_; }
+
+  const bool does_drop_last() const { return does_drop_last_; }
 
-  const std::size_t decimating_scale() const { return decimating_scale_; }
+  const BatchTransformLambda& batch_data_transform_lambda() const { return batch_data_transform_lambda_; }
 
-  const xt::xarray<std::size_t>& decimated_indices() const { return decimated_indices_; }
+  const BatchTransformLambda& batch_label_transform_lambda() const { return batch_label_transform_lambda_; }
 
-  const xt::xarray<std::size_t>& indices() const { return indices_; }
+  const std::vector<std::size_t>& indices() const { return sampler_ptr_->indices(); }
 
  private:
   DatasetSharedPtr dataset_ptr_;
 
   std::size_t batch_size_;
 
-  bool does_shuffle_dataset_;
+  SamplerSharedPtr sampler_ptr_;
 
-  std::size_t decimating_scale_;
+  bool does_drop_last_;
 
-  xt::xarray<std::size_t> decimated_indices_;
+  BatchTransformLambda batch_data_transform_lambda_;
 
-  xt::xarray<std::size_t> indices_;
+  BatchTransformLambda batch_label_transform_lambda_;
 };
 
 }  // namespace tensorward::core
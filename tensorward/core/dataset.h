@@ -10,9 +10,13 @@
 
 namespace tensorward::core {
 
-// TODO: Add `Compose` class that composes transform lambdas in `tensorward::transforms` namespace.
+// Transform of a sample, which is applied in `Dataset::at()`.
 using TransformLambda = std::function<xt::xarray<float>(const xt::xarray<float>&)>;
 
+// Transform of a whole batch {N, ...} in place, which is applied in `DataLoader::GetBatchAt()` (e.g.
+// `tensorward::transforms::Compose`).
+using BatchTransformLambda = std::function<void(xt::xarray<float>&)>;
+
 class Dataset {
  public:
   Dataset(const bool is_training_mode, const std::vector<TransformLambda>& data_transform_lambdas,
@@ -1,6 +1,8 @@
 #include "tensorward/core/function.h"
 
 #include <cassert>
+#include <functional>
+#include <utility>
 
 #include "tensorward/core/config.h"
 #include "tensorward/core/tensor.h"
@@ -11,17 +13,23 @@ const std::vector<TensorSharedPtr> Function::Call(const std::vector<TensorShared
   assert(input_tensor_ptrs.size() == num_inputs_);
 
   // Performs the forward calculation, and creates an output tensor (dynamically in heap memory so that it's accessible
-  // even after exiting this scope).
-  std::vector<xt::xarray<float>> xs;
-  xs.reserve(input_tensor_ptrs.size());
-  for (const auto& input_tensor_ptr : input_tensor_ptrs) {
-    xs.push_back(input_tensor_ptr->data());
-  }
-  const std::vector<xt::xarray<float>> ys = Forward(xs);
-  std::vector<TensorSharedPtr> output_tensor_ptrs;
-  output_tensor_ptrs.reserve(ys.size());
-  for (const auto& y : ys) {
-    output_tensor_ptrs.push_back(AsTensorSharedPtr(y));
+  // even after exiting this scope), unless the outputs are the views of the inputs.
+  std::vector<TensorSharedPtr> output_tensor_ptrs = ForwardViews(input_tensor_ptrs);
+  if (output_tensor_ptrs.empty()) {
+    // NOTE: The data of the input tensors are passed by reference (instead of copied).
+    std::vector<std::reference_wrapper<const xt::xarray<float>>> x_refs;
+    x_refs.reserve(input_tensor_ptrs.size());
+    for (const auto& input_tensor_ptr : input_tensor_ptrs) {
+      x_refs.push_back(std::cref(input_tensor_ptr->data()));
+    }
+    // NOTE: The outputs are moved into the output tensors (instead of copied), because they are not used anymore here.
+    std::vector<xt::xarray<float>> ys = Forward(ConstXarrayRefs(std::move(x_refs)));
+    const ReducedPrecisionStorage reduced_precision_storage = Config::instance().reduced_precision_storage();
+    output_tensor_ptrs.reserve(ys.size());
+    for (auto& y : ys) {
+      EmulateReducedPrecisionStorage(y, reduced_precision_storage);
+      output_tensor_ptrs.push_back(AsTensorSharedPtr(std::move(y)));
+    }
   }
 
   if (Config::instance().config_value(Config::kDoesEnableBackpropagation)) {
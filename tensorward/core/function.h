@@ -1,5 +1,7 @@
 #pragma once
 
+#include <functional>
+#include <initializer_list>
 #include <memory>
 #include <vector>
 
@@ -10,6 +12,26 @@
 
 namespace tensorward::core {
 
+// Read-only references to the input arrays of `Function::Forward()`, so that `Function::Call()` passes the data of the
+// input tensors without copying them. It's also implicitly constructed from a vector (or a braced list) of the arrays,
+// which must outlive it (e.g. `function_ptr->Forward(xs)` or `function_ptr->Forward({x0, x1})`).
+class ConstXarrayRefs {
+ public:
+  ConstXarrayRefs(const std::vector<xt::xarray<float>>& xs) : x_refs_(xs.begin(), xs.end()) {}
+
+  ConstXarrayRefs(std::initializer_list<std::reference_wrapper<const xt::xarray<float>>> x_refs) : x_refs_(x_refs) {}
+
+  ConstXarrayRefs(std::vector<std::reference_wrapper<const xt::xarray<float>>>&& x_refs)
+      : x_refs_(std::move(x_refs)) {}
+
+  const xt::xarray<float>& operator[](const std::size_t index) const { return x_refs_[index].get(); }
+
+  const std::size_t size() const { return x_refs_.size(); }
+
+ private:
+  std::vector<std::reference_wrapper<const xt::xarray<float>>> x_refs_;
+};
+
 class Function : public std::enable_shared_from_this<Function> {
  public:
   struct NamedArg {
@@ -31,7 +53,14 @@ class Function : public std::enable_shared_from_this<Function> {
   // NOTE: Use this fuction with initialization, instead of assignment, in order to avoid copying the returned value.
   //   * OK: `const std::vector<xt::xarray<float>> ys = Forward(xs);` ... No copy happens.
   //   * NG: `std::vector<xt::xarray<float>> ys;  ys = Forward(xs);` ... Copy happens.
-  virtual const std::vector<xt::xarray<float>> Forward(const std::vector<xt::xarray<float>>& xs) = 0;
+  virtual const std::vector<xt::xarray<float>> Forward(const ConstXarrayRefs& xs) = 0;
+
+  // Creates the output tensors viewing the data storages of the input tensors without copying them (e.g. by
+  // `function::Reshape` and `function::Transpose`), which `Call()` uses instead of `Forward()`, or returns no tensor if
+  // this function calculates the outputs by `Forward()`.
+  virtual const std::vector<TensorSharedPtr> ForwardViews(const std::vector<TensorSharedPtr>& input_tensor_ptrs) {
+    return {};
+  }
 
   // Performs the backward calculation of this function.
   // NOTE: Use this fuction with initialization, instead of assignment, in order to avoid copying the returned value.
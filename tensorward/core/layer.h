@@ -24,6 +24,11 @@ class Layer {
 
   void ClearGrads();
 
+  // Sets the parameter (e.g. loaded from a checkpoint), which is used instead of being initialized by `Forward()`.
+  void SetParamPtr(const std::string& param_name, const ParameterSharedPtr param_ptr) {
+    param_map_[param_name] = param_ptr;
+  }
+
   const std::unordered_map<std::string, ParameterSharedPtr>& param_map() const { return param_map_; }
 
   const std::vector<TensorWeakPtr>& input_tensor_ptrs() const { return input_tensor_ptrs_; }
@@ -0,0 +1,83 @@
+#include "tensorward/core/loss_scaler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include <xtensor/xarray.hpp>
+#include <xtensor/xbuilder.hpp>
+
+namespace tensorward::core {
+
+namespace {
+
+// Divides the gradient by the scale in place, and returns true if all of the elements are finite.
+const bool UnscaleInPlace(xt::xarray<float>& grad, const float inverse_scale) {
+  bool is_finite = true;
+  for (float& element : grad) {
+    element *= inverse_scale;
+    is_finite &= std::isfinite(element);
+  }
+  return is_finite;
+}
+
+}  // namespace
+
+void LossScaler::Backpropagation(const TensorSharedPtr loss_ptr, const bool does_retain_grad /* = false */) {
+  loss_ptr->SetGradOpt(xt::xarray<float>(scale_ * xt::ones_like(loss_ptr->data())));
+  loss_ptr->Backpropagation(does_retain_grad);
+}
+
+const bool LossScaler::UnscaleGrads(const std::vector<ParameterSharedPtr>& param_ptrs) {
+  const float inverse_scale = 1.0 / scale_;
+  bool are_grads_finite = true;
+
+  for (const auto& param_ptr : param_ptrs) {
+    if (param_ptr->grad_opt().has_value()) {
+      xt::xarray<float> grad = param_ptr->ReleaseGrad();
+      are_grads_finite &= UnscaleInPlace(grad, inverse_scale);
+      param_ptr->AccumulateGrad(std::move(grad));
+    }
+
+    if (param_ptr->sparse_grad_opt().has_value()) {
+      RowSparseGrad sparse_grad = param_ptr->sparse_grad();
+      are_grads_finite &= UnscaleInPlace(sparse_grad.rows, inverse_scale);
+      param_ptr->SetSparseGradOpt(std::move(sparse_grad));
+    }
+  }
+
+  return are_grads_finite;
+}
+
+const bool LossScaler::Step(Optimizer& optimizer, const std::vector<ParameterSharedPtr>& param_ptrs) {
+  const bool are_grads_finite = UnscaleGrads(param_ptrs);
+
+  // NOTE: The overflowed gradients are left as is (instead of being cleared here), because they are cleared by
+  // NOTE: `Model::ClearGrads()` before the next backpropagation anyway.
+  if (are_grads_finite) {
+    optimizer.Update(param_ptrs);
+  } else {
+    ++num_skipped_steps_;
+  }
+
+  UpdateScale(are_grads_finite);
+
+  return are_grads_finite;
+}
+
+void LossScaler::UpdateScale(const bool are_grads_finite) {
+  if (!are_grads_finite) {
+    // Keeps the scale at least 1, so that the gradients are never scaled down.
+    scale_ = std::max(scale_ * backoff_factor_, 1.0f);
+    num_good_steps_ = 0;
+    return;
+  }
+
+  ++num_good_steps_;
+  if (growth_interval_ <= num_good_steps_) {
+    scale_ *= growth_factor_;
+    num_good_steps_ = 0;
+  }
+}
+
+}  // namespace tensorward::core
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <vector>
+
+#include "tensorward/core/optimizer.h"
+#include "tensorward/core/parameter.h"
+#include "tensorward/core/tensor.h"
+
+namespace tensorward::core {
+
+// Dynamic loss scaling for the mixed-precision training, which keeps the small gradients from underflowing to zero in
+// the reduced-precision (especially float16) storage:
+//
+//   1. `Backpropagation()` starts the backpropagation with the gradient `scale` (instead of 1), so all of the
+//      gradients in the computational graph are multiplied by `scale`.
+//   2. `Step()` divides the gradients of the parameters by `scale`, and updates the parameters (the float master
+//      weights) only if all of the gradients are finite.
+//   3. If a gradient overflows to infinity (or NaN), then the update is skipped and `scale` is multiplied by
+//      `backoff_factor`. Otherwise, `scale` is multiplied by `growth_factor` after every `growth_interval` steps.
+//
+class LossScaler {
+ public:
+  LossScaler(const float initial_scale = 65536.0, const float growth_factor = 2.0, const float backoff_factor = 0.5,
+             const std::size_t growth_interval = 2000)
+      : scale_(initial_scale),
+        growth_factor_(growth_factor),
+        backoff_factor_(backoff_factor),
+        growth_interval_(growth_interval),
+        num_good_steps_(0),
+        num_skipped_steps_(0) {}
+
+  ~LossScaler() {}
+
+  // Starts the backpropagation from the loss tensor with the gradient `scale` (instead of 1).
+  void Backpropagation(const TensorSharedPtr loss_ptr, const bool does_retain_grad = false);
+
+  // Divides the (dense and row-sparse) gradients of the parameters by `scale`, and returns true if all of them are
+  // finite.
+  const bool UnscaleGrads(const std::vector<ParameterSharedPtr>& param_ptrs);
+
+  // Unscales the gradients, updates the parameters by the optimizer unless they have overflowed, and then updates
+  // `scale`. Returns true if the parameters are updated, and false if the update is skipped.
+  const bool Step(Optimizer& optimizer, const std::vector<ParameterSharedPtr>& param_ptrs);
+
+  const float scale() const { return scale_; }
+
+  const float growth_factor() const { return growth_factor_; }
+
+  const float backoff_factor() const { return backoff_factor_; }
+
+  const std::size_t growth_interval() const { return growth_interval_; }
+
+  const std::size_t num_skipped_steps() const { return num_skipped_steps_; }
+
+ private:
+  void UpdateScale(const bool are_grads_finite);
+
+  float scale_;
+
+  float growth_factor_;
+
+  float backoff_factor_;
+
+  std::size_t growth_interval_;
+
+  // Number of the consecutive steps without overflow since the last change of `scale_`.
+  std::size_t num_good_steps_;
+
+  std::size_t num_skipped_steps_;
+};
+
+}  // namespace tensorward::core
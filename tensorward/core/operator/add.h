@@ -7,6 +7,7 @@
 
 #include "tensorward/core/function.h"
 #include "tensorward/core/tensor.h"
+#include "tensorward/util/xtensor_rank.h"
 #include "tensorward/util/xtensor_sum_to.h"
 
 namespace tensorward::core {
@@ -17,9 +18,10 @@ class Add : public Function {
 
   ~Add() {}
 
-  const std::vector<xt::xarray<float>> Forward(const std::vector<xt::xarray<float>>& xs) override {
+  const std::vector<xt::xarray<float>> Forward(const ConstXarrayRefs& xs) override {
     // y = x0 + x1
-    const xt::xarray<float> y = xs[0] + xs[1];
+    const xt::xarray<float> y = util::XtensorEvaluateWithRank(
+        xs[0].shape(), [](const auto& x0, const auto& x1) { return x0 + x1; }, xs[0], xs[1]);
 
     return {y};
   }
@@ -17,7 +17,7 @@ class Div : public Function {
 
   ~Div() {}
 
-  const std::vector<xt::xarray<float>> Forward(const std::vector<xt::xarray<float>>& xs) override {
+  const std::vector<xt::xarray<float>> Forward(const ConstXarrayRefs& xs) override {
     // y = x0 / x1
     const xt::xarray<float> y = xs[0] / xs[1];
 
@@ -7,6 +7,7 @@
 
 #include "tensorward/core/function.h"
 #include "tensorward/core/tensor.h"
+#include "tensorward/util/xtensor_rank.h"
 #include "tensorward/util/xtensor_sum_to.h"
 
 namespace tensorward::core {
@@ -17,9 +18,10 @@ class Mul : public Function {
 
   ~Mul() {}
 
-  const std::vector<xt::xarray<float>> Forward(const std::vector<xt::xarray<float>>& xs) override {
+  const std::vector<xt::xarray<float>> Forward(const ConstXarrayRefs& xs) override {
     // y = x0 * x1
-    const xt::xarray<float> y = xs[0] * xs[1];
+    const xt::xarray<float> y = util::XtensorEvaluateWithRank(
+        xs[0].shape(), [](const auto& x0, const auto& x1) { return x0 * x1; }, xs[0], xs[1]);
 
     return {y};
   }
@@ -31,11 +33,13 @@ class Mul : public Function {
 
     // y = x0 * x1 ---> dy_dx0 = x1 ---> dL_dx0 = dL_dy * dy_dx0 = dL_dy * x1
     const xt::xarray<float>& dy_dx0 = x1;
-    xt::xarray<float> dL_dx0 = dL_dy * dy_dx0;
+    xt::xarray<float> dL_dx0 = util::XtensorEvaluateWithRank(
+        dL_dy.shape(), [](const auto& dL_dy, const auto& dy_dx0) { return dL_dy * dy_dx0; }, dL_dy, dy_dx0);
 
     // y = x0 * x1 ---> dy_dx1 = x0 ---> dL_dx1 = dL_dy * dy_dx1 = dL_dy * x0
     const xt::xarray<float>& dy_dx1 = x0;
-    xt::xarray<float> dL_dx1 = dL_dy * dy_dx1;
+    xt::xarray<float> dL_dx1 = util::XtensorEvaluateWithRank(
+        dL_dy.shape(), [](const auto& dL_dy, const auto& dy_dx1) { return dL_dy * dy_dx1; }, dL_dy, dy_dx1);
 
     // Reduces the shape of dL_dx0 or dL_dx1 if either x0 or x1 was broadcasted during the forward calculation.
     const xt::xarray<float>::shape_type& x0_shape = x0.shape();
@@ -16,7 +16,7 @@ class Neg : public Function {
 
   ~Neg() {}
 
-  const std::vector<xt::xarray<float>> Forward(const std::vector<xt::xarray<float>>& xs) override {
+  const std::vector<xt::xarray<float>> Forward(const ConstXarrayRefs& xs) override {
     // y = -x
     const xt::xarray<float> y = -xs[0];
 
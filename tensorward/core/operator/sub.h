@@ -17,7 +17,7 @@ class Sub : public Function {
 
   ~Sub() {}
 
-  const std::vector<xt::xarray<float>> Forward(const std::vector<xt::xarray<float>>& xs) override {
+  const std::vector<xt::xarray<float>> Forward(const ConstXarrayRefs& xs) override {
     // y = x0 - x1
     const xt::xarray<float> y = xs[0] - xs[1];
 
@@ -8,13 +8,31 @@ namespace tensorward::core {
 void Optimizer::Update(const std::vector<ParameterSharedPtr>& param_ptrs) {
   std::vector<ParameterSharedPtr> valid_param_ptrs;
   std::copy_if(param_ptrs.begin(), param_ptrs.end(), std::back_inserter(valid_param_ptrs),
-               [](const ParameterSharedPtr param_ptr) { return param_ptr->grad_opt().has_value(); });
+               [](const ParameterSharedPtr param_ptr) {
+                 return param_ptr->grad_opt().has_value() || param_ptr->sparse_grad_opt().has_value();
+               });
 
   // TODO: Implement a for-loop for preprocessing of the parameters using `preprocess_functions_`.
 
   for (const auto& valid_param_ptr : valid_param_ptrs) {
-    UpdateSingleParameter(valid_param_ptr);
+    if (!valid_param_ptr->sparse_grad_opt().has_value()) {
+      UpdateSingleParameter(valid_param_ptr);
+    } else if (!valid_param_ptr->grad_opt().has_value()) {
+      UpdateSingleParameterSparse(valid_param_ptr);
+    } else {
+      // If the parameter has both of the dense gradient and the row-sparse gradient (e.g. the lookup table is also
+      // used by a dense function), then merges the row-sparse gradient into the dense one.
+      const xt::xarray<float> dense_grad =
+          DensifyRowSparseGrad(valid_param_ptr->sparse_grad(), valid_param_ptr->data().shape());
+      valid_param_ptr->SetGradOpt(valid_param_ptr->grad() + dense_grad);
+      UpdateSingleParameter(valid_param_ptr);
+    }
   }
 }
 
+void Optimizer::UpdateSingleParameterSparse(const ParameterSharedPtr param_ptr) {
+  param_ptr->SetGradOpt(DensifyRowSparseGrad(param_ptr->sparse_grad(), param_ptr->data().shape()));
+  UpdateSingleParameter(param_ptr);
+}
+
 }  // namespace tensorward::core
@@ -1,7 +1,12 @@
 #pragma once
 
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
+#include <xtensor/xarray.hpp>
+
 #include "tensorward/core/function.h"
 #include "tensorward/core/parameter.h"
 
@@ -17,8 +22,27 @@ class Optimizer {
 
   virtual void UpdateSingleParameter(const ParameterSharedPtr param_ptr) = 0;
 
+  // Updates the parameter which has only the row-sparse gradient (e.g. the lookup table of an embedding).
+  // NOTE: By default, the row-sparse gradient is densified and then `UpdateSingleParameter()` is called. Override this
+  // NOTE: function in order to update only the touched rows lazily, whose cost scales with the number of touched rows
+  // NOTE: instead of the size of the parameter.
+  virtual void UpdateSingleParameterSparse(const ParameterSharedPtr param_ptr);
+
+  // Gets the state of the optimizer for the parameter (e.g. the velocity of the momentum) by the state name, which is
+  // saved into a checkpoint together with the parameter. It's empty if the optimizer has no state.
+  // NOTE: The state shares the storage with the optimizer instead of being copied (so that a snapshot of it is cheap),
+  // NOTE: so the optimizer must not update a shared storage in place (copy-on-write as `Tensor::MutableData()`).
+  virtual const std::unordered_map<std::string, std::shared_ptr<const xt::xarray<float>>> GetStateMap(
+      const ParameterSharedPtr param_ptr) const {
+    return {};
+  }
+
+  // Sets the state of the optimizer for the parameter (e.g. loaded from a checkpoint).
+  virtual void SetStateMap(const ParameterSharedPtr param_ptr,
+                           const std::unordered_map<std::string, xt::xarray<float>>& state_map) {}
+
  protected:
   // TODO: Add something like `preprocess_functions_`.
 };
-  
+
 }  // namespace tensorward::core
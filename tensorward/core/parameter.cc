@@ -1,7 +1,100 @@
 #include "tensorward/core/parameter.h"
 
+#include <algorithm>
+#include <numeric>
+
+#include <xtensor/xbuilder.hpp>
+
+#include "tensorward/util/xtensor_gather_scatter.h"
+
 namespace tensorward::core {
 
+const RowSparseGrad CoalesceRowSparseGrad(const RowSparseGrad& sparse_grad) {
+  const std::vector<std::size_t>& row_indices = sparse_grad.row_indices;
+  assert(sparse_grad.rows.dimension() > 0 && sparse_grad.rows.shape(0) == row_indices.size());
+
+  // Sorts the positions by the row index, keeping the order of the positions within the same row index.
+  std::vector<std::size_t> positions(row_indices.size());
+  std::iota(positions.begin(), positions.end(), 0);
+  std::stable_sort(positions.begin(), positions.end(),
+                   [&row_indices](const std::size_t lhs, const std::size_t rhs) {
+                     return row_indices[lhs] < row_indices[rhs];
+                   });
+
+  // unique_positions[i] = the position in the coalesced gradient of the i-th row.
+  RowSparseGrad coalesced_sparse_grad;
+  std::vector<std::size_t>& unique_row_indices = coalesced_sparse_grad.row_indices;
+  std::vector<std::size_t> unique_positions(row_indices.size());
+  for (const std::size_t position : positions) {
+    if (unique_row_indices.empty() || unique_row_indices.back() != row_indices[position]) {
+      unique_row_indices.push_back(row_indices[position]);
+    }
+    unique_positions[position] = unique_row_indices.size() - 1;
+  }
+
+  // Sums up the duplicated rows (which is the scatter-add into the coalesced rows).
+  xt::xarray<float>::shape_type coalesced_rows_shape = sparse_grad.rows.shape();
+  coalesced_rows_shape[0] = unique_row_indices.size();
+  coalesced_sparse_grad.rows = util::XtensorScatterAddRows(sparse_grad.rows, unique_positions, coalesced_rows_shape);
+
+  return coalesced_sparse_grad;
+}
+
+const xt::xarray<float> DensifyRowSparseGrad(const RowSparseGrad& sparse_grad,
+                                             const xt::xarray<float>::shape_type& dense_shape) {
+  return util::XtensorScatterAddRows(sparse_grad.rows, sparse_grad.row_indices, dense_shape);
+}
+
+void Parameter::AccumulateSparseGrad(const std::vector<std::size_t>& row_indices, const xt::xarray<float>& rows) {
+  assert((static_cast<void>("`rows.shape(0)` must be `row_indices.size()`."),
+          rows.dimension() > 0 && rows.shape(0) == row_indices.size()));
+
+  if (!sparse_grad_opt_.has_value()) {
+    sparse_grad_opt_ = RowSparseGrad{row_indices, rows};
+    return;
+  }
+
+  RowSparseGrad& sparse_grad = sparse_grad_opt_.value();
+  sparse_grad.row_indices.insert(sparse_grad.row_indices.end(), row_indices.begin(), row_indices.end());
+  sparse_grad.rows = xt::concatenate(xt::xtuple(sparse_grad.rows, rows), 0);
+}
+
+const Parameter::GradReadyHookId Parameter::RegisterGradReadyHook(const GradReadyHook& grad_ready_hook) {
+  if (grad_ready_hooks_.empty()) {
+    ++num_tensors_with_grad_ready_hooks_;
+  }
+  const GradReadyHookId grad_ready_hook_id = next_grad_ready_hook_id_++;
+  grad_ready_hooks_.emplace_back(grad_ready_hook_id, grad_ready_hook);
+  return grad_ready_hook_id;
+}
+
+void Parameter::RemoveGradReadyHook(const GradReadyHookId grad_ready_hook_id) {
+  const auto it = std::find_if(grad_ready_hooks_.begin(), grad_ready_hooks_.end(),
+                               [grad_ready_hook_id](const std::pair<GradReadyHookId, GradReadyHook>& id_and_hook) {
+                                 return id_and_hook.first == grad_ready_hook_id;
+                               });
+  if (it == grad_ready_hooks_.end()) {
+    return;
+  }
+  grad_ready_hooks_.erase(it);
+  if (grad_ready_hooks_.empty()) {
+    --num_tensors_with_grad_ready_hooks_;
+  }
+}
+
+void Parameter::ClearGradReadyHooks() {
+  if (!grad_ready_hooks_.empty()) {
+    --num_tensors_with_grad_ready_hooks_;
+  }
+  grad_ready_hooks_.clear();
+}
+
+void Parameter::OnGradReady() {
+  for (const auto& [grad_ready_hook_id, grad_ready_hook] : grad_ready_hooks_) {
+    grad_ready_hook(*this);
+  }
+}
+
 const ParameterSharedPtr AsParameterSharedPtr(const xt::xarray<float>& data, const std::string& name /* = "" */) {
   return std::make_shared<Parameter>(data, name);
 }
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <cassert>
+#include <functional>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <xtensor/xarray.hpp>
 #include <xtensor/xio.hpp>
@@ -11,11 +16,83 @@
 
 namespace tensorward::core {
 
+// Row-sparse gradient, which holds only the touched rows (the sub-arrays along the leading axis) of the gradient of a
+// large parameter (e.g. the lookup table of an embedding) instead of the whole dense gradient.
+//
+//   dense gradient: {R, ...} <---> row-sparse gradient: row_indices {M}, rows {M, ...}  (M << R)
+//
+// NOTE: The row indices can have duplicates (e.g. the same word appears twice in a batch), which should be summed up.
+struct RowSparseGrad {
+  std::vector<std::size_t> row_indices;
+
+  xt::xarray<float> rows;
+};
+
+// Sums up the duplicated rows, and sorts the row indices in ascending order.
+const RowSparseGrad CoalesceRowSparseGrad(const RowSparseGrad& sparse_grad);
+
+// Converts the row-sparse gradient into the dense gradient whose shape is `dense_shape`.
+const xt::xarray<float> DensifyRowSparseGrad(const RowSparseGrad& sparse_grad,
+                                             const xt::xarray<float>::shape_type& dense_shape);
+
 class Parameter : public Tensor {
  public:
+  // Hook called with this parameter once its gradient (or row-sparse gradient) is final during the backpropagation.
+  using GradReadyHook = std::function<void(Parameter&)>;
+
+  // Handle of a registered hook, which is unique in the parameter.
+  using GradReadyHookId = std::size_t;
+
   Parameter(const xt::xarray<float>& data, const std::string& name = "") : Tensor(data, name) {}
 
-  ~Parameter() {}
+  // Shares the data storage with other parameters (e.g. of the replicas of a model trained by Hogwild!).
+  Parameter(const std::shared_ptr<const xt::xarray<float>>& data_ptr, const std::string& name = "")
+      : Tensor(data_ptr, name) {}
+
+  ~Parameter() { ClearGradReadyHooks(); }
+
+  // Clears both of the dense gradient and the row-sparse gradient.
+  void ClearGrad() override {
+    Tensor::ClearGrad();
+    sparse_grad_opt_ = std::nullopt;
+  }
+
+  // Accumulates the row-sparse gradient (by appending the rows, which are summed up later by the optimizer).
+  void AccumulateSparseGrad(const std::vector<std::size_t>& row_indices, const xt::xarray<float>& rows);
+
+  // Registers the hook, which is called once per `Tensor::Backpropagation()` if this parameter is used in its
+  // computational graph as an input of a function (e.g. the gradient of a data-parallel model is all-reduced while the
+  // backward calculation of the preceding layers continues).
+  // NOTE: The parameter held as a member of a function (e.g. "W" of `function::Embedding`) isn't an input of it, so
+  // NOTE: its hooks aren't called.
+  const GradReadyHookId RegisterGradReadyHook(const GradReadyHook& grad_ready_hook);
+
+  // Removes only the hook of the handle (e.g. when its owner is destroyed), keeping the hooks registered by others.
+  void RemoveGradReadyHook(const GradReadyHookId grad_ready_hook_id);
+
+  void ClearGradReadyHooks();
+
+  void OnGradReady() override;
+
+  const bool has_grad_ready_hooks() const override { return !grad_ready_hooks_.empty(); }
+
+  void SetSparseGradOpt(const std::optional<RowSparseGrad>& sparse_grad_opt) { sparse_grad_opt_ = sparse_grad_opt; }
+
+  const RowSparseGrad& sparse_grad() const {
+    assert((static_cast<void>("`Parameter::sparse_grad_opt_` must have value to get the value."),
+            sparse_grad_opt_.has_value()));
+    return sparse_grad_opt_.value();
+  }
+
+  const std::optional<RowSparseGrad>& sparse_grad_opt() const { return sparse_grad_opt_; }
+
+ private:
+  std::optional<RowSparseGrad> sparse_grad_opt_;
+
+  // (The handle, the hook) of each registered hook, in the order of the registration.
+  std::vector<std::pair<GradReadyHookId, GradReadyHook>> grad_ready_hooks_;
+
+  GradReadyHookId next_grad_ready_hook_id_ = 0;
 };
 
 using ParameterSharedPtr = std::shared_ptr<Parameter>;
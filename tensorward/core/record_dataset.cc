@@ -0,0 +1,317 @@
+#include "tensorward/core/record_dataset.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+
+#include <xtensor/xbuilder.hpp>
+
+namespace tensorward::core {
+
+static_assert(std::endian::native == std::endian::little, "The record file format is little-endian.");
+
+namespace {
+
+// Size of each read to verify the CRC-32 of a record file.
+constexpr std::size_t kChecksumBlockSize = 1 << 20;
+
+template <class T>
+void AppendBytes(std::string& buffer, const T& value) {
+  buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// Reads a value at the cursor, and advances the cursor. Returns false if it exceeds the end.
+template <class T>
+const bool ReadBytes(const std::byte*& cursor, const std::byte* end, T& value) {
+  if (end < cursor + sizeof(value)) {
+    return false;
+  }
+  std::memcpy(&value, cursor, sizeof(value));
+  cursor += sizeof(value);
+  return true;
+}
+
+// Reads the bytes of the size at the offset, and returns false if it fails or reaches the end of the file.
+const bool ReadAll(const int file_descriptor, void* buffer, const std::size_t size, const std::uint64_t offset) {
+  std::size_t read_size = 0;
+  while (read_size < size) {
+    const ssize_t size_per_read =
+        pread(file_descriptor, static_cast<std::byte*>(buffer) + read_size, size - read_size, offset + read_size);
+    if (size_per_read < 0 && errno == EINTR) {
+      continue;
+    }
+    if (size_per_read <= 0) {
+      return false;
+    }
+    read_size += size_per_read;
+  }
+  return true;
+}
+
+// Reads the shape at the cursor, and returns false if it exceeds the end or its size doesn't fit in the rest.
+const bool ReadShape(const std::byte*& cursor, const std::byte* end, const std::uint32_t dimension,
+                     xt::xarray<float>::shape_type& shape, std::size_t& size) {
+  if (static_cast<std::size_t>(end - cursor) / sizeof(std::uint64_t) < dimension) {
+    return false;
+  }
+  shape.resize(dimension);
+  size = 1;
+  for (std::size_t& length : shape) {
+    std::uint64_t length_in_file;
+    ReadBytes(cursor, end, length_in_file);
+    if (length_in_file != 0 && static_cast<std::size_t>(end - cursor) / sizeof(float) / length_in_file < size) {
+      return false;
+    }
+    length = length_in_file;
+    size *= length;
+  }
+  return true;
+}
+
+}  // namespace
+
+RecordFileWriter::RecordFileWriter(const std::filesystem::path& file_path)
+    : ofs_(file_path, std::ios::out | std::ios::binary | std::ios::trunc),
+      is_closed_(false),
+      crc32_(::crc32(0, Z_NULL, 0)),
+      offset_(kRecordFileHeaderSize) {
+  // Reserves the header, which is written at `Close()`.
+  const std::string header(kRecordFileHeaderSize, '\0');
+  ofs_.write(header.data(), header.size());
+}
+
+RecordFileWriter::~RecordFileWriter() {
+  if (!is_closed_) {
+    Close();
+  }
+}
+
+const bool RecordFileWriter::Write(const xt::xarray<float>& data, const xt::xarray<float>& label) {
+  assert((static_cast<void>("The file must not be closed yet."), !is_closed_));
+
+  std::string record;
+  record.reserve(sizeof(std::uint32_t) * 2 + sizeof(std::uint64_t) * (data.dimension() + label.dimension()) +
+                 sizeof(float) * (data.size() + label.size()));
+  AppendBytes(record, static_cast<std::uint32_t>(data.dimension()));
+  AppendBytes(record, static_cast<std::uint32_t>(label.dimension()));
+  for (const std::size_t length : data.shape()) {
+    AppendBytes(record, static_cast<std::uint64_t>(length));
+  }
+  for (const std::size_t length : label.shape()) {
+    AppendBytes(record, static_cast<std::uint64_t>(length));
+  }
+  record.append(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(float));
+  record.append(reinterpret_cast<const char*>(label.data()), label.size() * sizeof(float));
+
+  record_offsets_.push_back(offset_);
+  WriteBytes(record);
+
+  return ofs_.good();
+}
+
+const bool RecordFileWriter::Close() {
+  if (is_closed_) {
+    return false;
+  }
+  is_closed_ = true;
+
+  const std::uint64_t index_offset = offset_;
+  std::string index;
+  index.reserve(sizeof(std::uint64_t) * (record_offsets_.size() + 1));
+  for (const std::uint64_t record_offset : record_offsets_) {
+    AppendBytes(index, record_offset);
+  }
+  AppendBytes(index, index_offset);
+  WriteBytes(index);
+
+  std::string header;
+  header.append(kRecordFileMagic, sizeof(kRecordFileMagic));
+  AppendBytes(header, kRecordFileVersion);
+  AppendBytes(header, crc32_);
+  AppendBytes(header, static_cast<std::uint64_t>(record_offsets_.size()));
+  AppendBytes(header, index_offset);
+  header.resize(kRecordFileHeaderSize, '\0');
+  ofs_.seekp(0);
+  ofs_.write(header.data(), header.size());
+  ofs_.close();
+
+  return !ofs_.fail();
+}
+
+void RecordFileWriter::WriteBytes(const std::string& bytes) {
+  ofs_.write(bytes.data(), bytes.size());
+  crc32_ = ::crc32_z(crc32_, reinterpret_cast<const Bytef*>(bytes.data()), bytes.size());
+  offset_ += bytes.size();
+}
+
+RecordDataset::RecordDataset(const bool is_training_mode, const std::vector<TransformLambda>& data_transform_lambdas,
+                             const std::vector<TransformLambda>& label_transform_lambdas,
+                             const std::filesystem::path& dataset_directory_name,
+                             const std::vector<std::filesystem::path>& record_file_paths,
+                             const bool does_verify_checksums /* = false */)
+    : Dataset(is_training_mode, data_transform_lambdas, label_transform_lambdas, dataset_directory_name),
+      record_file_paths_(record_file_paths),
+      does_verify_checksums_(does_verify_checksums),
+      is_valid_(false),
+      first_record_indices_({0}) {
+  Init();
+}
+
+RecordDataset::~RecordDataset() {
+  for (const RecordFile& record_file : record_files_) {
+    close(record_file.file_descriptor);
+  }
+}
+
+void RecordDataset::Init() {
+  for (const RecordFile& record_file : record_files_) {
+    close(record_file.file_descriptor);
+  }
+  record_files_.clear();
+  first_record_indices_.assign(1, 0);
+
+  is_valid_ = !record_file_paths_.empty();
+  for (const auto& record_file_path : record_file_paths_) {
+    if (!OpenRecordFile(record_file_path)) {
+      is_valid_ = false;
+      break;
+    }
+    first_record_indices_.push_back(first_record_indices_.back() + record_files_.back().record_offsets.size() - 1);
+  }
+  if (is_valid_ && does_verify_checksums_) {
+    is_valid_ = VerifyChecksums();
+  }
+  if (!is_valid_) {
+    first_record_indices_.assign(1, 0);
+  }
+}
+
+const std::pair<xt::xarray<float>, xt::xarray<float>> RecordDataset::at(const std::size_t i) const {
+  assert((static_cast<void>("The index must be less than the size."), i < size()));
+
+  const std::size_t file_index = std::upper_bound(first_record_indices_.begin(), first_record_indices_.end(), i) -
+                                 first_record_indices_.begin() - 1;
+  const RecordFile& record_file = record_files_[file_index];
+  const std::size_t record_index = i - first_record_indices_[file_index];
+  const std::uint64_t offset = record_file.record_offsets[record_index];
+  const std::uint64_t size_in_bytes = record_file.record_offsets[record_index + 1] - offset;
+
+  // Reads the whole record with a single read.
+  std::vector<std::byte> record(size_in_bytes);
+  const bool is_read = ReadAll(record_file.file_descriptor, record.data(), record.size(), offset);
+  assert((static_cast<void>("Failed to read the record."), is_read));
+
+  const std::byte* cursor = record.data();
+  const std::byte* end = record.data() + record.size();
+  std::uint32_t data_dimension;
+  std::uint32_t label_dimension;
+  xt::xarray<float>::shape_type data_shape;
+  xt::xarray<float>::shape_type label_shape;
+  std::size_t data_size;
+  std::size_t label_size;
+  const bool is_parsed = ReadBytes(cursor, end, data_dimension) && ReadBytes(cursor, end, label_dimension) &&
+                         ReadShape(cursor, end, data_dimension, data_shape, data_size) &&
+                         ReadShape(cursor, end, label_dimension, label_shape, label_size) &&
+                         static_cast<std::size_t>(end - cursor) == (data_size + label_size) * sizeof(float);
+  assert((static_cast<void>("The record is broken."), is_read && is_parsed));
+  if (!is_read || !is_parsed) {
+    return {};
+  }
+
+  xt::xarray<float> ith_data = xt::empty<float>(data_shape);
+  xt::xarray<float> ith_label = xt::empty<float>(label_shape);
+  std::memcpy(ith_data.data(), cursor, data_size * sizeof(float));
+  std::memcpy(ith_label.data(), cursor + data_size * sizeof(float), label_size * sizeof(float));
+
+  return ApplyTransformLambdas(ith_data, ith_label);
+}
+
+const bool RecordDataset::VerifyChecksums() const {
+  std::vector<std::byte> block(kChecksumBlockSize);
+  for (const RecordFile& record_file : record_files_) {
+    const std::uint64_t end =
+        record_file.record_offsets.back() + sizeof(std::uint64_t) * record_file.record_offsets.size();
+    uLong actual_crc32 = ::crc32(0, Z_NULL, 0);
+    for (std::uint64_t offset = kRecordFileHeaderSize; offset < end; offset += kChecksumBlockSize) {
+      const std::size_t size = std::min<std::uint64_t>(kChecksumBlockSize, end - offset);
+      if (!ReadAll(record_file.file_descriptor, block.data(), size, offset)) {
+        return false;
+      }
+      actual_crc32 = ::crc32_z(actual_crc32, reinterpret_cast<const Bytef*>(block.data()), size);
+    }
+    if (actual_crc32 != record_file.crc32) {
+      return false;
+    }
+  }
+  return true;
+}
+
+const bool RecordDataset::OpenRecordFile(const std::filesystem::path& file_path) {
+  const int file_descriptor = open(file_path.c_str(), O_RDONLY);
+  if (file_descriptor < 0) {
+    return false;
+  }
+  record_files_.push_back({file_descriptor, 0, {}});  // Closed by the caller even if the file is broken.
+  RecordFile& record_file = record_files_.back();
+
+  struct stat file_status;
+  std::byte header[kRecordFileHeaderSize];
+  if (fstat(file_descriptor, &file_status) != 0 || !ReadAll(file_descriptor, header, sizeof(header), 0)) {
+    return false;
+  }
+
+  const std::byte* cursor = header;
+  const std::byte* end = header + sizeof(header);
+  char magic[sizeof(kRecordFileMagic)];
+  std::uint32_t version;
+  std::uint64_t num_records;
+  std::uint64_t index_offset;
+  if (!ReadBytes(cursor, end, magic) || std::memcmp(magic, kRecordFileMagic, sizeof(magic)) != 0 ||
+      !ReadBytes(cursor, end, version) || version != kRecordFileVersion ||
+      !ReadBytes(cursor, end, record_file.crc32) || !ReadBytes(cursor, end, num_records) ||
+      !ReadBytes(cursor, end, index_offset)) {
+    return false;
+  }
+
+  // Checks that the index (of `num_records` + 1 offsets) fills the rest of the file exactly, before allocating it.
+  // NOTE: The index has at least one offset, and `num_records` + 1 must not overflow, so that neither side of the
+  // NOTE: comparison wraps around (e.g. a broken header of `num_records` = UINT64_MAX with an empty index).
+  const std::uint64_t file_size = file_status.st_size;
+  if (index_offset < kRecordFileHeaderSize || file_size < index_offset ||
+      file_size - index_offset < sizeof(std::uint64_t) || (file_size - index_offset) % sizeof(std::uint64_t) != 0 ||
+      std::numeric_limits<std::size_t>::max() <= num_records ||
+      (file_size - index_offset) / sizeof(std::uint64_t) != num_records + 1) {
+    return false;
+  }
+  record_file.record_offsets.resize(num_records + 1);
+  if (!ReadAll(file_descriptor, record_file.record_offsets.data(), file_size - index_offset, index_offset)) {
+    return false;
+  }
+
+  // Checks that the records are in order between the header and the index.
+  const std::vector<std::uint64_t>& offsets = record_file.record_offsets;
+  if (offsets.front() != kRecordFileHeaderSize || offsets.back() != index_offset ||
+      !std::is_sorted(offsets.begin(), offsets.end())) {
+    return false;
+  }
+
+  // Disables the read-ahead, since the records are read in random order. It's only a hint, so it's skipped if the
+  // platform doesn't support it.
+#if defined(POSIX_FADV_RANDOM)
+  posix_fadvise(file_descriptor, 0, 0, POSIX_FADV_RANDOM);
+#elif defined(F_RDAHEAD)
+  fcntl(file_descriptor, F_RDAHEAD, 0);
+#endif
+
+  return true;
+}
+
+}  // namespace tensorward::core
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <xtensor/xarray.hpp>
+
+#include "tensorward/core/dataset.h"
+
+namespace tensorward::core {
+
+// Indexed record file format, where each record can have its own shapes and is located by the index at the end:
+//
+//   +-------------------------------------------------------------------------------------------------------+
+//   | magic "TWREC\0\0\0" (8 bytes) | version (uint32) | CRC-32 (uint32) | number of records (uint64) |          |
+//   | index offset (uint64) | zero padding to `kRecordFileHeaderSize` bytes                                  |
+//   +-------------------------------------------------------------------------------------------------------+
+//   | record 0: data dimension (uint32) | label dimension (uint32) | data shape (uint64 * data dimension) |     |
+//   |           label shape (uint64 * label dimension) | data (float * data size) | label (float * label size) |
+//   | record 1: ...                                                                                         |
+//   +-------------------------------------------------------------------------------------------------------+
+//   | index: offset of record 0 (uint64) | offset of record 1 (uint64) | ... | index offset (uint64)         |
+//   +-------------------------------------------------------------------------------------------------------+
+//
+// The CRC-32 covers everything after the header (i.e. the records and the index). All of the integers and floats are
+// little-endian.
+
+constexpr char kRecordFileMagic[8] = {'T', 'W', 'R', 'E', 'C', '\0', '\0', '\0'};
+constexpr std::uint32_t kRecordFileVersion = 1;
+constexpr std::size_t kRecordFileHeaderSize = 64;
+
+// Writer of a record file, which appends the records one by one (so the whole dataset doesn't have to be in the
+// memory), and writes the index and the header at `Close()`.
+class RecordFileWriter {
+ public:
+  RecordFileWriter(const std::filesystem::path& file_path);
+
+  // Closes the file if it's not closed yet.
+  ~RecordFileWriter();
+
+  // Prevents copy construction.
+  RecordFileWriter(const RecordFileWriter&) = delete;
+
+  // Prevents copy assignment.
+  RecordFileWriter& operator=(const RecordFileWriter&) = delete;
+
+  // Appends a record of the data and the label. Returns false if it fails to write.
+  const bool Write(const xt::xarray<float>& data, const xt::xarray<float>& label);
+
+  // Writes the index and the header, and closes the file. Returns false if it fails to write the file.
+  const bool Close();
+
+  const std::size_t num_records() const { return record_offsets_.size(); }
+
+ private:
+  // Writes the bytes after the header, and updates the CRC-32 of them.
+  void WriteBytes(const std::string& bytes);
+
+  std::ofstream ofs_;
+
+  bool is_closed_;
+
+  std::uint32_t crc32_;
+
+  std::uint64_t offset_;
+
+  std::vector<std::uint64_t> record_offsets_;
+};
+
+// Dataset of the record files (see `RecordFileWriter`), which reads each record with a single `pread()` by looking up
+// its offset in the index (loaded into the memory when the files are opened). Unlike the base class, `data_` and
+// `label_` are empty, and any record can be accessed at random in the constant time without reading the others.
+//
+// NOTE: `at()` is thread-safe and doesn't lock anything, so the records can be read by multiple threads in parallel.
+class RecordDataset : public Dataset {
+ public:
+  // If `does_verify_checksums` is true, then the CRC-32 of each file is verified when it's opened (which reads the
+  // whole file).
+  RecordDataset(const bool is_training_mode, const std::vector<TransformLambda>& data_transform_lambdas,
+                const std::vector<TransformLambda>& label_transform_lambdas,
+                const std::filesystem::path& dataset_directory_name,
+                const std::vector<std::filesystem::path>& record_file_paths, const bool does_verify_checksums = false);
+
+  // Closes the record files.
+  ~RecordDataset();
+
+  // Prevents copy construction.
+  RecordDataset(const RecordDataset&) = delete;
+
+  // Prevents copy assignment.
+  RecordDataset& operator=(const RecordDataset&) = delete;
+
+  // Opens the record files, and loads their indices.
+  void Init() override;
+
+  const std::size_t size() const override { return first_record_indices_.back(); }
+
+  const std::pair<xt::xarray<float>, xt::xarray<float>> at(const std::size_t i) const override;
+
+  // Verifies the CRC-32 of all of the record files, which reads the whole files.
+  const bool VerifyChecksums() const;
+
+  const bool is_valid() const { return is_valid_; }
+
+  const std::size_t num_record_files() const { return record_files_.size(); }
+
+ private:
+  struct RecordFile {
+    int file_descriptor;
+
+    std::uint32_t crc32;
+
+    // Offsets of the records, and the end of the last record (i.e. the index offset) as the last element.
+    std::vector<std::uint64_t> record_offsets;
+  };
+
+  // Opens the record file and loads its index, and returns false if the header or the index is broken.
+  const bool OpenRecordFile(const std::filesystem::path& file_path);
+
+  std::vector<std::filesystem::path> record_file_paths_;
+
+  bool does_verify_checksums_;
+
+  bool is_valid_;
+
+  std::vector<RecordFile> record_files_;
+
+  // Index of the first record of each file over all of the files (and the total number of the records as the last
+  // element).
+  std::vector<std::size_t> first_record_indices_;
+};
+
+}  // namespace tensorward::core
@@ -0,0 +1,163 @@
+#include "tensorward/core/sampler.h"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <numeric>
+#include <utility>
+
+namespace tensorward::core {
+
+namespace {
+
+// Shuffles the indices in place by Fisher-Yates shuffle.
+void Shuffle(std::span<std::size_t> indices, util::Xoshiro256StarStar& engine) {
+  for (std::size_t i = indices.size(); 1 < i; --i) {
+    std::swap(indices[i - 1], indices[engine.UniformIndex(i)]);
+  }
+}
+
+// Fills the indices with {0, s, 2s, ...} of the decimating scale s.
+void FillDecimatedIndices(std::vector<std::size_t>& indices, const std::size_t dataset_size,
+                          const std::size_t decimating_scale) {
+  assert((static_cast<void>("`decimating_scale` must be positive."), 0 < decimating_scale));
+  indices.resize(dataset_size / decimating_scale);
+  for (std::size_t i = 0; i < indices.size(); ++i) {
+    indices[i] = decimating_scale * i;
+  }
+}
+
+}  // namespace
+
+const std::span<const std::size_t> Sampler::BatchIndicesAt(const std::size_t i, const std::size_t batch_size) const {
+  const std::size_t begin = std::min(i * batch_size, indices_.size());
+  const std::size_t end = std::min(begin + batch_size, indices_.size());
+  return std::span<const std::size_t>(indices_.data() + begin, end - begin);
+}
+
+SequentialSampler::SequentialSampler(const std::size_t dataset_size, const std::size_t decimating_scale /* = 1 */) {
+  FillDecimatedIndices(indices_, dataset_size, decimating_scale);
+}
+
+RandomSampler::RandomSampler(const std::size_t dataset_size, const std::uint64_t seed,
+                             const std::size_t decimating_scale /* = 1 */)
+    : engine_(seed) {
+  FillDecimatedIndices(indices_, dataset_size, decimating_scale);
+  Init();
+}
+
+void RandomSampler::Init() { Shuffle(indices_, engine_); }
+
+WeightedRandomSampler::WeightedRandomSampler(const std::vector<float>& weights, const std::size_t num_samples,
+                                             const std::uint64_t seed)
+    : cumulative_weights_(weights.size()), engine_(seed) {
+  assert((static_cast<void>("The weights must not be negative."),
+          std::all_of(weights.begin(), weights.end(), [](const float weight) { return 0.0 <= weight; })));
+  std::partial_sum(weights.begin(), weights.end(), cumulative_weights_.begin(), std::plus<double>());
+  assert((static_cast<void>("The sum of the weights must be positive."),
+          !cumulative_weights_.empty() && 0.0 < cumulative_weights_.back()));
+
+  indices_.resize(num_samples);
+  Init();
+}
+
+void WeightedRandomSampler::Init() {
+  const double total_weight = cumulative_weights_.back();
+  for (std::size_t& index : indices_) {
+    // The first index whose cumulative weight exceeds the random value, which never has zero weight.
+    const double value = engine_.UniformReal() * total_weight;
+    index = std::upper_bound(cumulative_weights_.begin(), cumulative_weights_.end(), value) -
+            cumulative_weights_.begin();
+    index = std::min(index, cumulative_weights_.size() - 1);  // Against the rounding error.
+  }
+}
+
+StratifiedSampler::StratifiedSampler(const std::vector<std::size_t>& class_indices, const std::uint64_t seed)
+    : class_grouped_indices_(class_indices.size()), engine_(seed) {
+  const std::size_t num_classes =
+      class_indices.empty() ? 0 : *std::max_element(class_indices.begin(), class_indices.end()) + 1;
+
+  // Groups the indices by the classes by the counting sort.
+  class_offsets_.assign(num_classes + 1, 0);
+  for (const std::size_t class_index : class_indices) {
+    ++class_offsets_[class_index + 1];
+  }
+  std::partial_sum(class_offsets_.begin(), class_offsets_.end(), class_offsets_.begin());
+  class_num_taken_.assign(num_classes, 0);
+  for (std::size_t i = 0; i < class_indices.size(); ++i) {
+    const std::size_t class_index = class_indices[i];
+    class_grouped_indices_[class_offsets_[class_index] + class_num_taken_[class_index]++] = i;
+  }
+
+  indices_.resize(class_indices.size());
+  Init();
+}
+
+void StratifiedSampler::Init() {
+  const std::size_t num_classes = class_num_taken_.size();
+  for (std::size_t c = 0; c < num_classes; ++c) {
+    Shuffle(std::span<std::size_t>(class_grouped_indices_.data() + class_offsets_[c],
+                                   class_offsets_[c + 1] - class_offsets_[c]),
+            engine_);
+  }
+
+  // Takes the next index from the class which is the most behind its proportion, i.e. of the smallest
+  // (num_taken + 0.5) / class_size, so that the classes are spread evenly over the epoch.
+  std::fill(class_num_taken_.begin(), class_num_taken_.end(), 0);
+  for (std::size_t& index : indices_) {
+    std::size_t next_class = num_classes;
+    for (std::size_t c = 0; c < num_classes; ++c) {
+      const std::size_t class_size = class_offsets_[c + 1] - class_offsets_[c];
+      if (class_num_taken_[c] == class_size) {
+        continue;
+      }
+      if (next_class == num_classes) {
+        next_class = c;
+        continue;
+      }
+      // (2 * taken_c + 1) / size_c < (2 * taken_next + 1) / size_next, without the division.
+      const std::size_t next_class_size = class_offsets_[next_class + 1] - class_offsets_[next_class];
+      if ((2 * class_num_taken_[c] + 1) * next_class_size < (2 * class_num_taken_[next_class] + 1) * class_size) {
+        next_class = c;
+      }
+    }
+    index = class_grouped_indices_[class_offsets_[next_class] + class_num_taken_[next_class]++];
+  }
+}
+
+DistributedSampler::DistributedSampler(const std::size_t dataset_size, const std::size_t num_replicas,
+                                       const std::size_t rank, const bool does_shuffle, const std::uint64_t seed)
+    : num_replicas_(num_replicas),
+      rank_(rank),
+      does_shuffle_(does_shuffle),
+      seed_(seed),
+      epoch_(0),
+      permutation_(dataset_size) {
+  assert((static_cast<void>("`rank` must be less than `num_replicas`."), rank < num_replicas));
+  indices_.resize((dataset_size + num_replicas - 1) / num_replicas);
+  Sample();
+}
+
+void DistributedSampler::Init() { SetEpoch(epoch_ + 1); }
+
+void DistributedSampler::SetEpoch(const std::size_t epoch) {
+  epoch_ = epoch;
+  Sample();
+}
+
+void DistributedSampler::Sample() {
+  if (permutation_.empty()) {
+    return;
+  }
+  std::iota(permutation_.begin(), permutation_.end(), 0);
+  if (does_shuffle_) {
+    // The engine is seeded by the seed and the epoch (whose SplitMix64 decorrelates the adjacent epochs).
+    engine_.Seed(seed_ ^ (epoch_ * 0x9E3779B97F4A7C15));
+    Shuffle(permutation_, engine_);
+  }
+  for (std::size_t i = 0; i < indices_.size(); ++i) {
+    indices_[i] = permutation_[(rank_ + i * num_replicas_) % permutation_.size()];
+  }
+}
+
+}  // namespace tensorward::core
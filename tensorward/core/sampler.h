@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "tensorward/util/random_engine.h"
+
+namespace tensorward::core {
+
+// Sampler of the indices of the samples of a dataset for each epoch, which is used by `DataLoader`. The indices are
+// sampled in place into the buffer allocated in the constructor, so `Init()` and `BatchIndicesAt()` don't allocate any
+// memory.
+class Sampler {
+ public:
+  Sampler() {}
+
+  virtual ~Sampler() {}
+
+  // Samples the indices for the next epoch.
+  virtual void Init() = 0;
+
+  // Number of the indices of an epoch.
+  const std::size_t size() const { return indices_.size(); }
+
+  // Returns the indices of the i-th batch, where the last batch is partial if `size()` isn't divisible by the batch
+  // size.
+  const std::span<const std::size_t> BatchIndicesAt(const std::size_t i, const std::size_t batch_size) const;
+
+  const std::vector<std::size_t>& indices() const { return indices_; }
+
+ protected:
+  std::vector<std::size_t> indices_;
+};
+
+using SamplerSharedPtr = std::shared_ptr<Sampler>;
+
+// Samples every `decimating_scale`-th index of the dataset in the order, i.e. {0, s, 2s, ...}.
+class SequentialSampler : public Sampler {
+ public:
+  SequentialSampler(const std::size_t dataset_size, const std::size_t decimating_scale = 1);
+
+  ~SequentialSampler() {}
+
+  void Init() override {}
+};
+
+// Samples every `decimating_scale`-th index of the dataset in a random order, which is reshuffled for each epoch.
+class RandomSampler : public Sampler {
+ public:
+  RandomSampler(const std::size_t dataset_size, const std::uint64_t seed, const std::size_t decimating_scale = 1);
+
+  ~RandomSampler() {}
+
+  // Reshuffles the indices in place (by Fisher-Yates shuffle of the previous permutation).
+  void Init() override;
+
+ private:
+  util::Xoshiro256StarStar engine_;
+};
+
+// Samples `num_samples` indices with replacement, with the probability of each index proportional to its weight (e.g.
+// the inverse of the frequency of its class for the imbalanced dataset).
+class WeightedRandomSampler : public Sampler {
+ public:
+  WeightedRandomSampler(const std::vector<float>& weights, const std::size_t num_samples, const std::uint64_t seed);
+
+  ~WeightedRandomSampler() {}
+
+  // Draws each index by the binary search in the cumulative weights.
+  void Init() override;
+
+ private:
+  std::vector<double> cumulative_weights_;
+
+  util::Xoshiro256StarStar engine_;
+};
+
+// Samples all of the indices in a random order where each class is spread evenly, so that every batch (of any size) has
+// the classes in about the same proportion as the whole dataset.
+class StratifiedSampler : public Sampler {
+ public:
+  // `class_indices[i]` is the class of the i-th sample.
+  StratifiedSampler(const std::vector<std::size_t>& class_indices, const std::uint64_t seed);
+
+  ~StratifiedSampler() {}
+
+  // Shuffles the indices of each class, and interleaves the classes.
+  void Init() override;
+
+ private:
+  // Indices of the samples grouped by the classes, where the c-th class is [class_offsets_[c], class_offsets_[c + 1]).
+  std::vector<std::size_t> class_grouped_indices_;
+
+  std::vector<std::size_t> class_offsets_;
+
+  // Number of the indices of each class taken while interleaving.
+  std::vector<std::size_t> class_num_taken_;
+
+  util::Xoshiro256StarStar engine_;
+};
+
+// Samples the shard of the indices of the replica `rank` out of `num_replicas` for the data parallel training (e.g. by
+// multiple processes on one host): each epoch permutes all of the indices, and the replica takes every
+// `num_replicas`-th index from `rank`, so the shards of the replicas are disjoint. The permutation depends only on the
+// seed and the epoch, so the replicas given the same seed agree on it without any communication, even if one of them
+// is restarted (see `SetEpoch()`). The indices wrap around so that every replica has the same number of them (i.e.
+// ceil(dataset_size / num_replicas)), and so the same number of the batches.
+class DistributedSampler : public Sampler {
+ public:
+  DistributedSampler(const std::size_t dataset_size, const std::size_t num_replicas, const std::size_t rank,
+                     const bool does_shuffle, const std::uint64_t seed);
+
+  ~DistributedSampler() {}
+
+  // Advances to the next epoch, and takes its shard.
+  void Init() override;
+
+  // Jumps to the epoch (e.g. when resuming the training), and takes its shard.
+  void SetEpoch(const std::size_t epoch);
+
+  const std::size_t num_replicas() const { return num_replicas_; }
+
+  const std::size_t rank() const { return rank_; }
+
+  const std::size_t epoch() const { return epoch_; }
+
+ private:
+  // Permutes all of the indices for the current epoch (if `does_shuffle_` is true), and takes the shard.
+  void Sample();
+
+  std::size_t num_replicas_;
+
+  std::size_t rank_;
+
+  bool does_shuffle_;
+
+  std::uint64_t seed_;
+
+  std::size_t epoch_;
+
+  std::vector<std::size_t> permutation_;
+
+  util::Xoshiro256StarStar engine_;
+};
+
+}  // namespace tensorward::core
@@ -0,0 +1,238 @@
+#include "tensorward/core/shared_memory_dataset.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <thread>
+
+#include <xtensor/xbuilder.hpp>
+
+#include "tensorward/util/atomic.h"
+
+namespace tensorward::core {
+
+namespace {
+
+// Offset of "is ready" in the header, right after the magic.
+constexpr std::size_t kIsReadyOffset = sizeof(kSharedMemoryDatasetMagic);
+
+// Interval of polling the shared memory object which isn't ready yet.
+constexpr std::chrono::milliseconds kPollingInterval(10);
+
+template <class T>
+void AppendBytes(std::string& buffer, const T& value) {
+  buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// Reads a value at the cursor, and advances the cursor. Returns false if it exceeds the end.
+template <class T>
+const bool ReadBytes(const std::byte*& cursor, const std::byte* end, T& value) {
+  if (end < cursor + sizeof(value)) {
+    return false;
+  }
+  std::memcpy(&value, cursor, sizeof(value));
+  cursor += sizeof(value);
+  return true;
+}
+
+const bool ReadShape(const std::byte*& cursor, const std::byte* end, const std::uint32_t dimension,
+                     xt::xarray<float>::shape_type& shape) {
+  shape.resize(dimension);
+  for (std::size_t& length : shape) {
+    std::uint64_t length_in_memory;
+    if (!ReadBytes(cursor, end, length_in_memory)) {
+      return false;
+    }
+    length = length_in_memory;
+  }
+  return true;
+}
+
+const std::size_t ShapeSize(const xt::xarray<float>::shape_type& shape) {
+  return std::accumulate(shape.begin(), shape.end(), std::size_t(1), std::multiplies<std::size_t>());
+}
+
+// Loads "is ready" with the acquire order, so that everything written before it's set is visible after it's seen.
+const bool IsReady(const std::byte* mapping) {
+  const std::uint32_t& is_ready = *reinterpret_cast<const std::uint32_t*>(mapping + kIsReadyOffset);
+  return util::AtomicLoad(is_ready, std::memory_order_acquire) == 1;
+}
+
+}  // namespace
+
+const bool WriteSharedMemoryDataset(const std::string& shared_memory_name, const xt::xarray<float>& data,
+                                    const xt::xarray<float>& label) {
+  assert((static_cast<void>("The data and the label must have the same number of the samples."),
+          1 <= data.dimension() && 1 <= label.dimension() && data.shape(0) == label.shape(0)));
+
+  const std::uint64_t num_samples = data.shape(0);
+  const xt::xarray<float>::shape_type data_shape(data.shape().begin() + 1, data.shape().end());
+  const xt::xarray<float>::shape_type label_shape(label.shape().begin() + 1, label.shape().end());
+
+  std::string header;
+  header.append(kSharedMemoryDatasetMagic, sizeof(kSharedMemoryDatasetMagic));
+  AppendBytes(header, std::uint32_t(0));  // Not ready yet.
+  AppendBytes(header, static_cast<std::uint32_t>(data_shape.size()));
+  AppendBytes(header, static_cast<std::uint32_t>(label_shape.size()));
+  AppendBytes(header, std::uint32_t(0));
+  AppendBytes(header, num_samples);
+  for (const std::size_t length : data_shape) {
+    AppendBytes(header, static_cast<std::uint64_t>(length));
+  }
+  for (const std::size_t length : label_shape) {
+    AppendBytes(header, static_cast<std::uint64_t>(length));
+  }
+  if (kSharedMemoryDatasetHeaderSize < header.size()) {
+    return false;
+  }
+
+  // Creates a new object instead of overwriting the existing one, which may be mapped by the other processes.
+  shm_unlink(shared_memory_name.c_str());
+  const int file_descriptor = shm_open(shared_memory_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (file_descriptor < 0) {
+    return false;
+  }
+  const std::size_t mapping_size = kSharedMemoryDatasetHeaderSize + (data.size() + label.size()) * sizeof(float);
+  if (ftruncate(file_descriptor, mapping_size) != 0) {
+    close(file_descriptor);
+    shm_unlink(shared_memory_name.c_str());
+    return false;
+  }
+  void* mapping = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+  close(file_descriptor);  // The mapping remains after closing the object.
+  if (mapping == MAP_FAILED) {
+    shm_unlink(shared_memory_name.c_str());
+    return false;
+  }
+
+  std::byte* bytes = static_cast<std::byte*>(mapping);
+  std::memcpy(bytes, header.data(), header.size());
+  float* data_in_memory = reinterpret_cast<float*>(bytes + kSharedMemoryDatasetHeaderSize);
+  std::copy(data.begin(), data.end(), data_in_memory);
+  std::copy(label.begin(), label.end(), data_in_memory + data.size());
+  util::AtomicStore(*reinterpret_cast<std::uint32_t*>(bytes + kIsReadyOffset), std::uint32_t(1),
+                    std::memory_order_release);
+
+  munmap(mapping, mapping_size);
+  return true;
+}
+
+const bool RemoveSharedMemoryDataset(const std::string& shared_memory_name) {
+  return shm_unlink(shared_memory_name.c_str()) == 0;
+}
+
+SharedMemoryDataset::SharedMemoryDataset(const bool is_training_mode,
+                                         const std::vector<TransformLambda>& data_transform_lambdas,
+                                         const std::vector<TransformLambda>& label_transform_lambdas,
+                                         const std::filesystem::path& dataset_directory_name,
+                                         const std::string& shared_memory_name,
+                                         const std::chrono::milliseconds timeout /* = std::chrono::seconds(60) */)
+    : Dataset(is_training_mode, data_transform_lambdas, label_transform_lambdas, dataset_directory_name),
+      shared_memory_name_(shared_memory_name),
+      timeout_(timeout),
+      is_valid_(false),
+      size_(0),
+      data_size_(0),
+      label_size_(0),
+      mapping_(nullptr),
+      mapping_size_(0),
+      data_in_memory_(nullptr),
+      label_in_memory_(nullptr) {
+  Init();
+}
+
+SharedMemoryDataset::~SharedMemoryDataset() { Unmap(); }
+
+void SharedMemoryDataset::Init() {
+  Unmap();
+  is_valid_ = false;
+  size_ = 0;
+
+  // Waits for the object to be created and sized, and then to be ready.
+  const auto deadline = std::chrono::steady_clock::now() + timeout_;
+  while (true) {
+    if (mapping_ == nullptr) {
+      const int file_descriptor = shm_open(shared_memory_name_.c_str(), O_RDONLY, 0);
+      struct stat object_status;
+      if (0 <= file_descriptor && fstat(file_descriptor, &object_status) == 0 &&
+          kSharedMemoryDatasetHeaderSize <= static_cast<std::size_t>(object_status.st_size)) {
+        void* mapping = mmap(nullptr, object_status.st_size, PROT_READ, MAP_SHARED, file_descriptor, 0);
+        if (mapping != MAP_FAILED) {
+          mapping_ = static_cast<const std::byte*>(mapping);
+          mapping_size_ = object_status.st_size;
+        }
+      }
+      if (0 <= file_descriptor) {
+        close(file_descriptor);  // The mapping remains after closing the object.
+      }
+    }
+    if (mapping_ != nullptr && IsReady(mapping_)) {
+      break;
+    }
+    if (deadline < std::chrono::steady_clock::now()) {
+      Unmap();
+      return;
+    }
+    std::this_thread::sleep_for(kPollingInterval);
+  }
+
+  if (std::memcmp(mapping_, kSharedMemoryDatasetMagic, sizeof(kSharedMemoryDatasetMagic)) != 0) {
+    Unmap();
+    return;
+  }
+
+  const std::byte* cursor = mapping_ + kIsReadyOffset + sizeof(std::uint32_t);
+  const std::byte* end = mapping_ + kSharedMemoryDatasetHeaderSize;
+  std::uint32_t data_dimension;
+  std::uint32_t label_dimension;
+  std::uint32_t zero;
+  std::uint64_t num_samples;
+  if (!ReadBytes(cursor, end, data_dimension) || !ReadBytes(cursor, end, label_dimension) ||
+      !ReadBytes(cursor, end, zero) || !ReadBytes(cursor, end, num_samples) ||
+      !ReadShape(cursor, end, data_dimension, data_shape_) || !ReadShape(cursor, end, label_dimension, label_shape_)) {
+    Unmap();
+    return;
+  }
+  data_size_ = ShapeSize(data_shape_);
+  label_size_ = ShapeSize(label_shape_);
+  if (mapping_size_ != kSharedMemoryDatasetHeaderSize + num_samples * (data_size_ + label_size_) * sizeof(float)) {
+    Unmap();
+    return;
+  }
+
+  data_in_memory_ = reinterpret_cast<const float*>(mapping_ + kSharedMemoryDatasetHeaderSize);
+  label_in_memory_ = data_in_memory_ + num_samples * data_size_;
+  size_ = num_samples;
+  is_valid_ = true;
+}
+
+const std::pair<xt::xarray<float>, xt::xarray<float>> SharedMemoryDataset::at(const std::size_t i) const {
+  assert((static_cast<void>("The index must be less than the size."), i < size_));
+
+  xt::xarray<float> ith_data = xt::empty<float>(data_shape_);
+  xt::xarray<float> ith_label = xt::empty<float>(label_shape_);
+  std::copy(data_in_memory_ + i * data_size_, data_in_memory_ + (i + 1) * data_size_, ith_data.data());
+  std::copy(label_in_memory_ + i * label_size_, label_in_memory_ + (i + 1) * label_size_, ith_label.data());
+
+  return ApplyTransformLambdas(ith_data, ith_label);
+}
+
+void SharedMemoryDataset::Unmap() {
+  if (mapping_ != nullptr) {
+    munmap(const_cast<std::byte*>(mapping_), mapping_size_);
+  }
+  mapping_ = nullptr;
+  mapping_size_ = 0;
+  data_in_memory_ = nullptr;
+  label_in_memory_ = nullptr;
+}
+
+}  // namespace tensorward::core
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <xtensor/xarray.hpp>
+
+#include "tensorward/core/dataset.h"
+
+namespace tensorward::core {
+
+// Shared memory format of `SharedMemoryDataset`, which stores the data and the label of all of the samples as is:
+//
+//   +-------------------------------------------------------------------------------------------------------+
+//   | magic "TWSHMEM\0" (8 bytes) | is ready (uint32) | data dimension (uint32) | label dimension (uint32)    |
+//   | zero (uint32) | number of samples (uint64) | data shape (uint64 * data dimension) |                      |
+//   | label shape (uint64 * label dimension) | zero padding                                                   |
+//   +-------------------------------------------------------------------------------------------------------+
+//   | data (float * number of samples * data size)                                                          |
+//   +-------------------------------------------------------------------------------------------------------+
+//   | label (float * number of samples * label size)                                                        |
+//   +-------------------------------------------------------------------------------------------------------+
+//
+// The data shape and the label shape are of a sample. All of the integers and floats are in the native byte order, and
+// the header is padded to `kSharedMemoryDatasetHeaderSize` bytes (a page). "is ready" is set to 1 after everything
+// else is written.
+
+constexpr char kSharedMemoryDatasetMagic[8] = {'T', 'W', 'S', 'H', 'M', 'E', 'M', '\0'};
+constexpr std::size_t kSharedMemoryDatasetHeaderSize = 4096;
+
+// Writes the data {N, ...} and the label {N, ...} (e.g. `Mnist::data()` and `Mnist::label()`) into the POSIX shared
+// memory object of the name (e.g. "/tensorward_mnist_train"), replacing the existing one if any. This is called by a
+// single process (e.g. the rank 0, or the parent before forking the others). Returns false if it fails.
+const bool WriteSharedMemoryDataset(const std::string& shared_memory_name, const xt::xarray<float>& data,
+                                    const xt::xarray<float>& label);
+
+// Removes the shared memory object of the name, where the processes which have already mapped it can still use it.
+// Returns false if it doesn't exist.
+const bool RemoveSharedMemoryDataset(const std::string& shared_memory_name);
+
+// Dataset in the POSIX shared memory object written by `WriteSharedMemoryDataset()`, which is mapped read-only, so all
+// of the processes on the host share a single copy of the dataset in the physical memory (instead of loading their own
+// copies). Unlike the base class, `data_` and `label_` are empty, and each sample is copied out of the shared memory
+// at `at()`.
+//
+// e.g. For the multi-process training on one host:
+//
+//   if (rank == 0) {
+//     const dataset::Mnist mnist(true, {}, {});
+//     WriteSharedMemoryDataset("/tensorward_mnist_train", mnist.data(), mnist.label());
+//   }
+//   const DatasetSharedPtr dataset_ptr = std::make_shared<SharedMemoryDataset>(
+//       true, data_transform_lambdas, label_transform_lambdas, "MNIST", "/tensorward_mnist_train");
+//   DataLoader data_loader(dataset_ptr, batch_size,
+//                          std::make_shared<DistributedSampler>(dataset_ptr->size(), world_size, rank, true, seed));
+//
+// NOTE: `at()` is thread-safe and doesn't lock anything.
+class SharedMemoryDataset : public Dataset {
+ public:
+  // Waits for the shared memory object to be written by another process up to `timeout`.
+  SharedMemoryDataset(const bool is_training_mode, const std::vector<TransformLambda>& data_transform_lambdas,
+                      const std::vector<TransformLambda>& label_transform_lambdas,
+                      const std::filesystem::path& dataset_directory_name, const std::string& shared_memory_name,
+                      const std::chrono::milliseconds timeout = std::chrono::seconds(60));
+
+  // Unmaps the shared memory.
+  ~SharedMemoryDataset();
+
+  // Prevents copy construction.
+  SharedMemoryDataset(const SharedMemoryDataset&) = delete;
+
+  // Prevents copy assignment.
+  SharedMemoryDataset& operator=(const SharedMemoryDataset&) = delete;
+
+  // Maps the shared memory object after it's ready.
+  void Init() override;
+
+  const std::size_t size() const override { return size_; }
+
+  const std::pair<xt::xarray<float>, xt::xarray<float>> at(const std::size_t i) const override;
+
+  const bool is_valid() const { return is_valid_; }
+
+  const std::string& shared_memory_name() const { return shared_memory_name_; }
+
+ private:
+  // Unmaps the shared memory if it's mapped.
+  void Unmap();
+
+  std::string shared_memory_name_;
+
+  std::chrono::milliseconds timeout_;
+
+  bool is_valid_;
+
+  std::size_t size_;
+
+  std::size_t data_size_;
+
+  std::size_t label_size_;
+
+  xt::xarray<float>::shape_type data_shape_;
+
+  xt::xarray<float>::shape_type label_shape_;
+
+  const std::byte* mapping_;
+
+  std::size_t mapping_size_;
+
+  // Data and label of all of the samples in the shared memory.
+  const float* data_in_memory_;
+
+  const float* label_in_memory_;
+};
+
+}  // namespace tensorward::core
@@ -0,0 +1,443 @@
+#include "tensorward/core/streaming_dataset.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+
+#include <xtensor/xbuilder.hpp>
+
+namespace tensorward::core {
+
+namespace {
+
+constexpr std::size_t kNoWindow = std::numeric_limits<std::size_t>::max();
+
+const std::uint64_t AlignDown(const std::uint64_t offset) {
+  return offset / kStreamingShardHeaderSize * kStreamingShardHeaderSize;
+}
+
+const std::uint64_t AlignUp(const std::uint64_t offset) {
+  return AlignDown(offset + kStreamingShardHeaderSize - 1);
+}
+
+template <class T>
+void AppendBytes(std::string& buffer, const T& value) {
+  buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// Reads a value at the cursor, and advances the cursor. Returns false if it exceeds the end.
+template <class T>
+const bool ReadBytes(const std::byte*& cursor, const std::byte* end, T& value) {
+  if (end < cursor + sizeof(value)) {
+    return false;
+  }
+  std::memcpy(&value, cursor, sizeof(value));
+  cursor += sizeof(value);
+  return true;
+}
+
+// Allocates a buffer aligned for `O_DIRECT`, whose size is rounded up to the alignment.
+std::unique_ptr<std::byte, void (*)(void*)> AllocateAlignedBuffer(const std::size_t size) {
+  return {static_cast<std::byte*>(std::aligned_alloc(kStreamingShardHeaderSize, AlignUp(size))), std::free};
+}
+
+// Reads the bytes of the size at the offset until at least the required size (or the end of the file), and returns
+// the size read (or -1 on failure).
+// NOTE: With `O_DIRECT`, the offset and the size must be aligned, and the read stops at the end of the file.
+const ssize_t ReadAll(const int file_descriptor, std::byte* buffer, const std::size_t size, const std::uint64_t offset,
+                      const std::size_t required_size) {
+  std::size_t read_size = 0;
+  while (read_size < required_size) {
+    const ssize_t size_per_read = pread(file_descriptor, buffer + read_size, size - read_size, offset + read_size);
+    if (size_per_read < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return -1;
+    }
+    if (size_per_read == 0) {
+      break;
+    }
+    read_size += size_per_read;
+  }
+  return read_size;
+}
+
+// Opens the file bypassing the page cache, and returns the file descriptor (or -1 if the platform or the file system
+// doesn't support it, e.g. tmpfs).
+// NOTE: macOS doesn't have `O_DIRECT`, but `F_NOCACHE` disables the page cache of the file descriptor similarly
+// NOTE: (without the alignment requirements, which the aligned reads satisfy anyway).
+const int OpenDirect(const std::filesystem::path& file_path) {
+#if defined(O_DIRECT)
+  return open(file_path.c_str(), O_RDONLY | O_DIRECT);
+#elif defined(F_NOCACHE)
+  const int file_descriptor = open(file_path.c_str(), O_RDONLY);
+  if (0 <= file_descriptor && fcntl(file_descriptor, F_NOCACHE, 1) != 0) {
+    close(file_descriptor);
+    return -1;
+  }
+  return file_descriptor;
+#else
+  return -1;
+#endif
+}
+
+// Advises the kernel that the file is read sequentially (i.e. the read-ahead can be aggressive). It's only a hint, so
+// it does nothing if the platform doesn't support it (e.g. macOS, whose read-ahead is on by default).
+void AdviseSequential(const int file_descriptor) {
+#if defined(POSIX_FADV_SEQUENTIAL)
+  posix_fadvise(file_descriptor, 0, 0, POSIX_FADV_SEQUENTIAL);
+#else
+  static_cast<void>(file_descriptor);
+#endif
+}
+
+// Advises the kernel to read the bytes [offset, offset + size) of the file into the page cache in the background. It's
+// only a hint, so it does nothing if the platform doesn't support it.
+void AdviseWillNeed(const int file_descriptor, const std::uint64_t offset, const std::uint64_t size) {
+#if defined(POSIX_FADV_WILLNEED)
+  posix_fadvise(file_descriptor, offset, size, POSIX_FADV_WILLNEED);
+#elif defined(F_RDADVISE)
+  // NOTE: `radvisory::ra_count` is an int, so the size is advised in the pieces up to its max.
+  for (std::uint64_t advised_size = 0; advised_size < size;) {
+    const std::uint64_t size_per_advice = std::min<std::uint64_t>(size - advised_size, std::numeric_limits<int>::max());
+    struct radvisory advisory = {static_cast<off_t>(offset + advised_size), static_cast<int>(size_per_advice)};
+    if (fcntl(file_descriptor, F_RDADVISE, &advisory) != 0) {
+      return;
+    }
+    advised_size += size_per_advice;
+  }
+#else
+  static_cast<void>(file_descriptor);
+  static_cast<void>(offset);
+  static_cast<void>(size);
+#endif
+}
+
+const bool ReadShape(const std::byte*& cursor, const std::byte* end, const std::uint32_t dimension,
+                     xt::xarray<float>::shape_type& shape) {
+  shape.resize(dimension);
+  for (std::size_t& length : shape) {
+    std::uint64_t length_in_file;
+    if (!ReadBytes(cursor, end, length_in_file)) {
+      return false;
+    }
+    length = length_in_file;
+  }
+  return true;
+}
+
+const std::size_t ShapeSize(const xt::xarray<float>::shape_type& shape) {
+  return std::accumulate(shape.begin(), shape.end(), std::size_t(1), std::multiplies<std::size_t>());
+}
+
+}  // namespace
+
+const bool WriteStreamingShard(const std::filesystem::path& file_path, const xt::xarray<float>& data,
+                               const xt::xarray<float>& label) {
+  assert((static_cast<void>("The data and the label must have the same number of the records."),
+          1 <= data.dimension() && 1 <= label.dimension() && data.shape(0) == label.shape(0)));
+
+  const std::uint64_t num_records = data.shape(0);
+  const xt::xarray<float>::shape_type data_shape(data.shape().begin() + 1, data.shape().end());
+  const xt::xarray<float>::shape_type label_shape(label.shape().begin() + 1, label.shape().end());
+
+  std::string header;
+  header.append(kStreamingShardMagic, sizeof(kStreamingShardMagic));
+  AppendBytes(header, num_records);
+  AppendBytes(header, static_cast<std::uint32_t>(data_shape.size()));
+  AppendBytes(header, static_cast<std::uint32_t>(label_shape.size()));
+  for (const std::size_t length : data_shape) {
+    AppendBytes(header, static_cast<std::uint64_t>(length));
+  }
+  for (const std::size_t length : label_shape) {
+    AppendBytes(header, static_cast<std::uint64_t>(length));
+  }
+  if (kStreamingShardHeaderSize < header.size()) {
+    return false;
+  }
+  header.resize(kStreamingShardHeaderSize, '\0');
+
+  std::ofstream ofs(file_path, std::ios::out | std::ios::binary | std::ios::trunc);
+  ofs.write(header.data(), header.size());
+
+  // Interleaves the data and the label of each record.
+  const std::size_t data_size = ShapeSize(data_shape);
+  const std::size_t label_size = ShapeSize(label_shape);
+  for (std::size_t i = 0; i < num_records; ++i) {
+    ofs.write(reinterpret_cast<const char*>(data.data() + i * data_size), data_size * sizeof(float));
+    ofs.write(reinterpret_cast<const char*>(label.data() + i * label_size), label_size * sizeof(float));
+  }
+  ofs.close();
+
+  return !ofs.fail();
+}
+
+StreamingDataset::StreamingDataset(const bool is_training_mode,
+                                   const std::vector<TransformLambda>& data_transform_lambdas,
+                                   const std::vector<TransformLambda>& label_transform_lambdas,
+                                   const std::filesystem::path& dataset_directory_name,
+                                   const std::vector<std::filesystem::path>& shard_file_paths, const NamedArg& arg)
+    : Dataset(is_training_mode, data_transform_lambdas, label_transform_lambdas, dataset_directory_name),
+      shard_file_paths_(shard_file_paths),
+      arg_(arg),
+      is_valid_(false),
+      size_(0),
+      data_size_(0),
+      label_size_(0),
+      epoch_(0),
+      current_window_index_(kNoWindow),
+      num_read_chunks_(0) {
+  assert((static_cast<void>("`chunk_size` must be positive."), 0 < arg_.chunk_size));
+  assert((static_cast<void>("`max_num_cached_chunks` must be at least `shuffle_buffer_size` (and 1)."),
+          std::max<std::size_t>(arg_.shuffle_buffer_size, 1) <= arg_.max_num_cached_chunks));
+  Init();
+}
+
+StreamingDataset::~StreamingDataset() {
+  for (const Shard& shard : shards_) {
+    close(shard.file_descriptor);
+  }
+}
+
+void StreamingDataset::Init() {
+  const std::lock_guard<std::mutex> lock(mutex_);
+
+  for (const Shard& shard : shards_) {
+    close(shard.file_descriptor);
+  }
+  shards_.clear();
+  chunks_.clear();
+  cached_chunk_map_.clear();
+  lru_chunk_indices_.clear();
+  size_ = 0;
+
+  is_valid_ = !shard_file_paths_.empty();
+  for (const auto& shard_file_path : shard_file_paths_) {
+    if (!is_valid_ || !OpenShard(shard_file_path)) {
+      is_valid_ = false;
+      break;
+    }
+  }
+  if (!is_valid_) {
+    size_ = 0;
+    chunks_.clear();
+  }
+
+  epoch_ = 0;
+  ShuffleChunks();
+}
+
+void StreamingDataset::Shuffle() {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  ++epoch_;
+  ShuffleChunks();
+}
+
+const std::pair<xt::xarray<float>, xt::xarray<float>> StreamingDataset::at(const std::size_t i) const {
+  assert((static_cast<void>("The index must be less than the size."), i < size_));
+
+  xt::xarray<float> ith_data = xt::empty<float>(data_shape_);
+  xt::xarray<float> ith_label = xt::empty<float>(label_shape_);
+  {
+    const std::lock_guard<std::mutex> lock(mutex_);
+
+    const std::size_t window_index =
+        std::upper_bound(window_begins_.begin(), window_begins_.end(), i) - window_begins_.begin() - 1;
+    if (window_index != current_window_index_) {
+      EnterWindow(window_index);
+    }
+
+    const auto [chunk_index, record_index] = current_window_records_[i - window_begins_[window_index]];
+    const float* record = LoadChunk(chunk_index).records + record_index * (data_size_ + label_size_);
+    std::copy(record, record + data_size_, ith_data.data());
+    std::copy(record + data_size_, record + data_size_ + label_size_, ith_label.data());
+  }
+
+  return ApplyTransformLambdas(ith_data, ith_label);
+}
+
+const bool StreamingDataset::OpenShard(const std::filesystem::path& file_path) {
+  Shard shard = {-1, false, 0};
+  if (arg_.does_use_direct_io) {
+    // Falls back to the buffered I/O if the platform or the file system doesn't support the direct I/O (e.g. tmpfs).
+    shard.file_descriptor = OpenDirect(file_path);
+    shard.is_direct_io = (0 <= shard.file_descriptor);
+  }
+  if (shard.file_descriptor < 0) {
+    shard.file_descriptor = open(file_path.c_str(), O_RDONLY);
+  }
+  if (shard.file_descriptor < 0) {
+    return false;
+  }
+  if (!shard.is_direct_io) {
+    AdviseSequential(shard.file_descriptor);
+  }
+  shards_.push_back(shard);  // Closed by the caller even if the header is broken.
+
+  struct stat file_status;
+  const auto header = AllocateAlignedBuffer(kStreamingShardHeaderSize);
+  if (fstat(shard.file_descriptor, &file_status) != 0 ||
+      ReadAll(shard.file_descriptor, header.get(), kStreamingShardHeaderSize, 0, kStreamingShardHeaderSize) <
+          static_cast<ssize_t>(kStreamingShardHeaderSize)) {
+    return false;
+  }
+
+  // Parses the header, where the dimensions are bounded by the header size before the shapes are allocated.
+  const std::byte* cursor = header.get();
+  const std::byte* end = header.get() + kStreamingShardHeaderSize;
+  char magic[sizeof(kStreamingShardMagic)];
+  std::uint64_t num_records;
+  std::uint32_t data_dimension;
+  std::uint32_t label_dimension;
+  if (!ReadBytes(cursor, end, magic) || std::memcmp(magic, kStreamingShardMagic, sizeof(magic)) != 0 ||
+      !ReadBytes(cursor, end, num_records) || !ReadBytes(cursor, end, data_dimension) ||
+      !ReadBytes(cursor, end, label_dimension) ||
+      kStreamingShardHeaderSize / sizeof(std::uint64_t) < std::uint64_t(data_dimension) + label_dimension) {
+    return false;
+  }
+  xt::xarray<float>::shape_type data_shape;
+  xt::xarray<float>::shape_type label_shape;
+  if (!ReadShape(cursor, end, data_dimension, data_shape) || !ReadShape(cursor, end, label_dimension, label_shape)) {
+    return false;
+  }
+
+  // Checks that all of the shards have the same shapes.
+  if (shards_.size() == 1) {
+    data_shape_ = data_shape;
+    label_shape_ = label_shape;
+    data_size_ = ShapeSize(data_shape_);
+    label_size_ = ShapeSize(label_shape_);
+  } else if (data_shape != data_shape_ || label_shape != label_shape_) {
+    return false;
+  }
+
+  // Checks that the file contains all of the records.
+  const std::uint64_t record_size_in_bytes = (data_size_ + label_size_) * sizeof(float);
+  const std::uint64_t file_size = file_status.st_size;
+  if (record_size_in_bytes == 0 || file_size < kStreamingShardHeaderSize ||
+      (file_size - kStreamingShardHeaderSize) / record_size_in_bytes < num_records) {
+    return false;
+  }
+
+  shards_.back().num_records = num_records;
+  for (std::uint64_t first_record_index = 0; first_record_index < num_records;
+       first_record_index += arg_.chunk_size) {
+    chunks_.push_back({shards_.size() - 1, first_record_index,
+                       std::min<std::uint64_t>(arg_.chunk_size, num_records - first_record_index)});
+  }
+  size_ += num_records;
+
+  return true;
+}
+
+void StreamingDataset::ShuffleChunks() {
+  chunk_order_.resize(chunks_.size());
+  std::iota(chunk_order_.begin(), chunk_order_.end(), 0);
+  if (0 < arg_.shuffle_buffer_size) {
+    std::seed_seq seed_sequence({arg_.seed, epoch_});
+    std::mt19937 engine(seed_sequence);
+    std::shuffle(chunk_order_.begin(), chunk_order_.end(), engine);
+  }
+
+  const std::size_t window_size = std::max<std::size_t>(arg_.shuffle_buffer_size, 1);
+  window_begins_.assign(1, 0);
+  for (std::size_t i = 0; i < chunk_order_.size(); i += window_size) {
+    std::size_t num_window_records = 0;
+    for (std::size_t j = i; j < std::min(i + window_size, chunk_order_.size()); ++j) {
+      num_window_records += chunks_[chunk_order_[j]].num_records;
+    }
+    window_begins_.push_back(window_begins_.back() + num_window_records);
+  }
+
+  current_window_index_ = kNoWindow;
+  current_window_records_.clear();
+}
+
+void StreamingDataset::EnterWindow(const std::size_t window_index) const {
+  const std::size_t window_size = std::max<std::size_t>(arg_.shuffle_buffer_size, 1);
+  const std::size_t first_order = window_index * window_size;
+  const std::size_t last_order = std::min(first_order + window_size, chunk_order_.size());
+
+  current_window_records_.clear();
+  for (std::size_t order = first_order; order < last_order; ++order) {
+    const std::size_t chunk_index = chunk_order_[order];
+    LoadChunk(chunk_index);
+    for (std::size_t record_index = 0; record_index < chunks_[chunk_index].num_records; ++record_index) {
+      current_window_records_.emplace_back(chunk_index, record_index);
+    }
+  }
+  if (0 < arg_.shuffle_buffer_size) {
+    std::seed_seq seed_sequence({arg_.seed, epoch_, static_cast<unsigned int>(window_index)});
+    std::mt19937 engine(seed_sequence);
+    std::shuffle(current_window_records_.begin(), current_window_records_.end(), engine);
+  }
+  current_window_index_ = window_index;
+
+  PrefetchWindow(window_index + 1);
+}
+
+const StreamingDataset::CachedChunk& StreamingDataset::LoadChunk(const std::size_t chunk_index) const {
+  const auto found_iterator = cached_chunk_map_.find(chunk_index);
+  if (found_iterator != cached_chunk_map_.end()) {
+    lru_chunk_indices_.splice(lru_chunk_indices_.begin(), lru_chunk_indices_, found_iterator->second.lru_iterator);
+    return found_iterator->second;
+  }
+
+  if (arg_.max_num_cached_chunks <= cached_chunk_map_.size()) {
+    cached_chunk_map_.erase(lru_chunk_indices_.back());
+    lru_chunk_indices_.pop_back();
+  }
+
+  // Reads the whole chunk with a single (aligned) read.
+  const Chunk& chunk = chunks_[chunk_index];
+  const Shard& shard = shards_[chunk.shard_index];
+  const std::uint64_t record_size_in_bytes = (data_size_ + label_size_) * sizeof(float);
+  const std::uint64_t begin = kStreamingShardHeaderSize + chunk.first_record_index * record_size_in_bytes;
+  const std::uint64_t end = begin + chunk.num_records * record_size_in_bytes;
+  const std::uint64_t aligned_begin = AlignDown(begin);
+  const std::uint64_t aligned_size = AlignUp(end) - aligned_begin;
+
+  auto buffer = AllocateAlignedBuffer(aligned_size);
+  const ssize_t read_size =
+      ReadAll(shard.file_descriptor, buffer.get(), aligned_size, aligned_begin, end - aligned_begin);
+  assert((static_cast<void>("Failed to read the chunk."),
+          0 <= read_size && end - aligned_begin <= static_cast<std::uint64_t>(read_size)));
+  ++num_read_chunks_;
+
+  lru_chunk_indices_.push_front(chunk_index);
+  const float* records = reinterpret_cast<const float*>(buffer.get() + (begin - aligned_begin));
+  const auto inserted_iterator =
+      cached_chunk_map_.emplace(chunk_index, CachedChunk{std::move(buffer), records, lru_chunk_indices_.begin()}).first;
+
+  return inserted_iterator->second;
+}
+
+void StreamingDataset::PrefetchWindow(const std::size_t window_index) const {
+  const std::size_t window_size = std::max<std::size_t>(arg_.shuffle_buffer_size, 1);
+  const std::size_t first_order = window_index * window_size;
+  const std::size_t last_order = std::min(first_order + window_size, chunk_order_.size());
+
+  const std::uint64_t record_size_in_bytes = (data_size_ + label_size_) * sizeof(float);
+  for (std::size_t order = first_order; order < last_order; ++order) {
+    const Chunk& chunk = chunks_[chunk_order_[order]];
+    const Shard& shard = shards_[chunk.shard_index];
+    if (!shard.is_direct_io) {
+      AdviseWillNeed(shard.file_descriptor, kStreamingShardHeaderSize + chunk.first_record_index * record_size_in_bytes,
+                     chunk.num_records * record_size_in_bytes);
+    }
+  }
+}
+
+}  // namespace tensorward::core
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <xtensor/xarray.hpp>
+
+#include "tensorward/core/dataset.h"
+
+namespace tensorward::core {
+
+// Shard file format of `StreamingDataset`, which stores records of the same shapes back to back:
+//
+//   +-------------------------------------------------------------------------------------------------------+
+//   | magic "TWSHARD\0" (8 bytes) | number of records (uint64) | data dimension (uint32) | label dimension     |
+//   | (uint32) | data shape (uint64 * data dimension) | label shape (uint64 * label dimension) | zero padding    |
+//   +-------------------------------------------------------------------------------------------------------+
+//   | record 0: data (float * data size) | label (float * label size)                                       |
+//   | record 1: ...                                                                                         |
+//   +-------------------------------------------------------------------------------------------------------+
+//
+// All of the integers and floats are in the native byte order (i.e. little-endian on the supported machines).
+//
+// NOTE: The header is padded to `kStreamingShardHeaderSize` bytes (a page, and the block size of `O_DIRECT`), so that
+// NOTE: the records start at an aligned offset.
+
+constexpr char kStreamingShardMagic[8] = {'T', 'W', 'S', 'H', 'A', 'R', 'D', '\0'};
+constexpr std::size_t kStreamingShardHeaderSize = 4096;
+
+// Writes the data {N, ...} and the label {N, ...} into the shard file as N records.
+// Returns false if it fails to write the file.
+const bool WriteStreamingShard(const std::filesystem::path& file_path, const xt::xarray<float>& data,
+                               const xt::xarray<float>& label);
+
+// Dataset streamed from the shard files on the disk (see `WriteStreamingShard()`), which can be much larger than the
+// memory. Unlike the base class, `data_` and `label_` are empty, and the records are read by chunks (a fixed number of
+// consecutive records in a shard) with a large sequential read per chunk, and kept in a bounded cache of chunks.
+//
+// The order of the records is shuffled approximately in the same way as a shuffle buffer: the order of the chunks is
+// shuffled, and then the records are shuffled within each window of `shuffle_buffer_size` consecutive chunks (in the
+// shuffled order). So iterating the indices in order reads each chunk only once per epoch, and the whole window is
+// read at once when it's entered, while the next window is prefetched by the kernel (`posix_fadvise()`).
+//
+// NOTE: Use this with `DataLoader` without shuffling (`does_shuffle_dataset` = false), because the random access over
+// NOTE: the whole dataset reads a whole window for almost every record. Call `Shuffle()` to reshuffle at each epoch.
+// NOTE: `at()` is thread-safe, but it serializes the accesses.
+class StreamingDataset : public Dataset {
+ public:
+  struct NamedArg {
+    // Number of the records in a chunk, which is the unit of the reads and the cache.
+    std::size_t chunk_size = 1024;
+
+    // Number of the chunks shuffled together, where 0 means no shuffling (i.e. the records are in the order of the
+    // shards).
+    std::size_t shuffle_buffer_size = 0;
+
+    // Max number of the chunks in the cache, which must be at least `shuffle_buffer_size`.
+    std::size_t max_num_cached_chunks = 4;
+
+    // If true, the shards are read with `O_DIRECT` (or `F_NOCACHE` on macOS) bypassing the page cache (if the file
+    // system supports it), which avoids the double buffering of the data read only once per epoch.
+    bool does_use_direct_io = false;
+
+    unsigned int seed = 0;
+  };
+
+  StreamingDataset(const bool is_training_mode, const std::vector<TransformLambda>& data_transform_lambdas,
+                   const std::vector<TransformLambda>& label_transform_lambdas,
+                   const std::filesystem::path& dataset_directory_name,
+                   const std::vector<std::filesystem::path>& shard_file_paths, const NamedArg& arg);
+
+  // Closes the shard files.
+  ~StreamingDataset();
+
+  // Prevents copy construction.
+  StreamingDataset(const StreamingDataset&) = delete;
+
+  // Prevents copy assignment.
+  StreamingDataset& operator=(const StreamingDataset&) = delete;
+
+  // Opens the shard files, reads their headers, and then shuffles the order of the records.
+  void Init() override;
+
+  const std::size_t size() const override { return size_; }
+
+  const std::pair<xt::xarray<float>, xt::xarray<float>> at(const std::size_t i) const override;
+
+  // Reshuffles the order of the records with the next seed (e.g. at the beginning of each epoch).
+  void Shuffle();
+
+  const bool is_valid() const { return is_valid_; }
+
+  const std::size_t num_shards() const { return shards_.size(); }
+
+  const std::size_t num_chunks() const { return chunks_.size(); }
+
+  const xt::xarray<float>::shape_type& data_shape() const { return data_shape_; }
+
+  const xt::xarray<float>::shape_type& label_shape() const { return label_shape_; }
+
+  // Number of the chunks read from the disk so far, which is `num_chunks()` per epoch if the cache is large enough.
+  const std::size_t num_read_chunks() const { return num_read_chunks_; }
+
+ private:
+  struct Shard {
+    int file_descriptor;
+
+    bool is_direct_io;
+
+    std::uint64_t num_records;
+  };
+
+  struct Chunk {
+    std::size_t shard_index;
+
+    std::uint64_t first_record_index;
+
+    std::uint64_t num_records;
+  };
+
+  struct CachedChunk {
+    // Buffer aligned for `O_DIRECT`, which may start before the first record of the chunk.
+    std::unique_ptr<std::byte, void (*)(void*)> buffer;
+
+    // Pointer to the first record in the buffer.
+    const float* records;
+
+    std::list<std::size_t>::iterator lru_iterator;
+  };
+
+  // Opens the shard file and parses its header, and returns false if the header is broken or doesn't match the
+  // shapes of the other shards.
+  const bool OpenShard(const std::filesystem::path& file_path);
+
+  // Shuffles the order of the chunks with the current epoch, and then splits them into the windows.
+  void ShuffleChunks();
+
+  // Makes the records of the window (and the chunks of it) available in the cache.
+  void EnterWindow(const std::size_t window_index) const;
+
+  // Returns the chunk from the cache, or reads it from the disk into the cache (evicting the least recently used one).
+  const CachedChunk& LoadChunk(const std::size_t chunk_index) const;
+
+  // Hints the kernel to read the chunks of the window ahead.
+  void PrefetchWindow(const std::size_t window_index) const;
+
+  std::vector<std::filesystem::path> shard_file_paths_;
+
+  NamedArg arg_;
+
+  bool is_valid_;
+
+  std::size_t size_;
+
+  std::size_t data_size_;
+
+  std::size_t label_size_;
+
+  xt::xarray<float>::shape_type data_shape_;
+
+  xt::xarray<float>::shape_type label_shape_;
+
+  std::vector<Shard> shards_;
+
+  std::vector<Chunk> chunks_;
+
+  // Shuffled order of the chunks.
+  std::vector<std::size_t> chunk_order_;
+
+  // Position of the first record of each window (and the end as the last element) in the shuffled order.
+  std::vector<std::size_t> window_begins_;
+
+  unsigned int epoch_;
+
+  mutable std::mutex mutex_;
+
+  mutable std::size_t current_window_index_;
+
+  // Shuffled records of the current window as pairs of the chunk index and the record index in the chunk.
+  mutable std::vector<std::pair<std::size_t, std::size_t>> current_window_records_;
+
+  mutable std::unordered_map<std::size_t, CachedChunk> cached_chunk_map_;
+
+  // Indices of the cached chunks from the most recently used one.
+  mutable std::list<std::size_t> lru_chunk_indices_;
+
+  mutable std::size_t num_read_chunks_;
+};
+
+}  // namespace tensorward::core
@@ -1,25 +1,76 @@
 #include "tensorward/core/tensor.h"
 
+#include <atomic>
 #include <list>
 #include <set>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include <xtensor/xadapt.hpp>
+
+#include "tensorward/core/config.h"
 #include "tensorward/core/function.h"
+#include "tensorward/util/reduced_precision.h"
+#include "tensorward/util/xtensor_numa_local.h"
 
 namespace tensorward::core {
 
+namespace {
+
+// Copies the data into a new storage, which is placed on the NUMA nodes of the threads processing it if
+// `Config::kDoesUseNumaLocalPlacement` is true.
+const std::shared_ptr<xt::xarray<float>> CopyIntoStorage(const xt::xarray<float>& data) {
+  return std::make_shared<xt::xarray<float>>(
+      util::XtensorCopyNumaLocal(data, Config::instance().config_value(Config::kDoesUseNumaLocalPlacement)));
+}
+
+}  // namespace
+
+Tensor::Tensor(const xt::xarray<float>& data, const std::string& name /* = "" */)
+    : data_ptr_(CopyIntoStorage(data)), name_(name), generation_(0), version_(0) {}
+
 void Tensor::Backpropagation(const bool does_retain_grad /* = false */) {
   // Sets the gradient as a tensor of ones if the gradient is none (e.g. loss function output).
   if (!grad_opt_.has_value()) {
-    grad_opt_ = xt::ones_like(data_);
+    grad_opt_ = xt::ones_like(data());
   }
 
   // If there doesn't exit a parent function, then it means this tensor is created by an user (not by a function).
   // So no need to continue the backward calculation.
   if (!parent_function_ptr_) {
+    if (has_grad_ready_hooks()) {
+      OnGradReady();
+    }
     return;
   }
 
+  // Counts the uses of the tensors with the grad-ready hooks in the computational graph, so that each of them is
+  // notified as soon as its last use has been processed (e.g. to start communicating its gradient while the rest of
+  // the backward calculation continues).
+  std::unordered_map<Tensor*, std::size_t> num_pending_uses;
+  if (0 < num_tensors_with_grad_ready_hooks_.load(std::memory_order_relaxed)) {
+    std::vector<FunctionSharedPtr> function_ptrs_stack = {parent_function_ptr_};
+    std::set<FunctionSharedPtr> visited_function_ptrs = {parent_function_ptr_};
+    while (!function_ptrs_stack.empty()) {
+      const FunctionSharedPtr function_ptr = function_ptrs_stack.back();
+      function_ptrs_stack.pop_back();
+      for (const TensorSharedPtr& input_tensor_ptr : function_ptr->input_tensor_ptrs()) {
+        const FunctionSharedPtr input_parent_function_ptr = input_tensor_ptr->parent_function_ptr();
+        if (input_parent_function_ptr) {
+          if (visited_function_ptrs.insert(input_parent_function_ptr).second) {
+            function_ptrs_stack.push_back(input_parent_function_ptr);
+          }
+        } else if (input_tensor_ptr->has_grad_ready_hooks()) {
+          ++num_pending_uses[input_tensor_ptr.get()];
+        }
+      }
+    }
+  }
+
+  // Reads the config once for all of the gradients (instead of once per gradient).
+  const ReducedPrecisionStorage reduced_precision_storage = Config::instance().reduced_precision_storage();
+
   // Data structure for the backward queue.
   // TODO: Make it more efficient than `std::list` + `std::set` (maybe by `std::priority_queue` + `std::set`)
   std::list<FunctionSharedPtr> parent_function_ptrs_list;
@@ -50,10 +101,20 @@ void Tensor::Backpropagation(const bool does_retain_grad /* = false */) {
     assert(output_tensor_ptrs.size() == parent_function_ptr->num_outputs());
     assert(input_tensor_ptrs.size() == parent_function_ptr->num_inputs());
 
+    // Moves the gradients out of the output tensors (instead of copying them) if they are cleared afterwards anyway.
     std::vector<xt::xarray<float>> dL_dys;
     dL_dys.reserve(output_tensor_ptrs.size());
     for (const auto& output_tensor_ptr : output_tensor_ptrs) {
-      dL_dys.push_back(output_tensor_ptr.lock()->grad());
+      if (does_retain_grad) {
+        dL_dys.push_back(output_tensor_ptr.lock()->grad());
+      } else {
+        dL_dys.push_back(output_tensor_ptr.lock()->ReleaseGrad());
+      }
+    }
+    if (reduced_precision_storage != ReducedPrecisionStorage::kNone) {
+      for (auto& dL_dy : dL_dys) {
+        EmulateReducedPrecisionStorage(dL_dy, reduced_precision_storage);
+      }
     }
 
     //
@@ -61,20 +122,21 @@ void Tensor::Backpropagation(const bool does_retain_grad /* = false */) {
     //    dL_dx      <---  Function::Backward()  <---      dL_dy
     //
     assert(dL_dys.size() == output_tensor_ptrs.size());
-    const std::vector<xt::xarray<float>> dL_dxs = parent_function_ptr->Backward(dL_dys);
+    std::vector<xt::xarray<float>> dL_dxs = parent_function_ptr->Backward(dL_dys);
     assert(dL_dxs.size() == input_tensor_ptrs.size());
 
     for (std::size_t i = 0; i < dL_dxs.size(); ++i) {
-      if (!input_tensor_ptrs[i]->grad_opt().has_value()) {
-        input_tensor_ptrs[i]->SetGradOpt(dL_dxs[i]);
-      } else {
-        input_tensor_ptrs[i]->SetGradOpt(input_tensor_ptrs[i]->grad() + dL_dxs[i]);
-      }
+      input_tensor_ptrs[i]->AccumulateGrad(std::move(dL_dxs[i]));
       assert(input_tensor_ptrs[i]->grad().shape() == input_tensor_ptrs[i]->data().shape());
 
       // If the parent function exists and hasn't been appended before, then appends it into the backward queue.
       if (input_tensor_ptrs[i]->parent_function_ptr()) {
         append_parent_function_ptr_if_unique(input_tensor_ptrs[i]->parent_function_ptr());
+      } else if (!num_pending_uses.empty()) {
+        const auto it = num_pending_uses.find(input_tensor_ptrs[i].get());
+        if (it != num_pending_uses.end() && --it->second == 0) {
+          input_tensor_ptrs[i]->OnGradReady();
+        }
       }
     }
 
@@ -88,13 +150,98 @@ void Tensor::Backpropagation(const bool does_retain_grad /* = false */) {
   }
 }
 
+void Tensor::AccumulateGrad(xt::xarray<float>&& grad) {
+  if (!grad_opt_.has_value()) {
+    grad_opt_ = std::move(grad);
+  } else {
+    grad_opt_.value() += grad;
+  }
+}
+
+xt::xarray<float> Tensor::ReleaseGrad() {
+  assert((static_cast<void>("`Tensor::grad_opt_` must have value to release the value."), grad_opt_.has_value()));
+  xt::xarray<float> grad = std::move(grad_opt_.value());
+  grad_opt_ = std::nullopt;
+  return grad;
+}
+
+const std::shared_ptr<const xt::xarray<float>> Tensor::contiguous_data_ptr() const {
+  if (!view_opt_.has_value()) {
+    return data_ptr_;
+  }
+  std::call_once(view_cache_ptr_->once_flag, [this] {
+    const TensorView& view = view_opt_.value();
+    view_cache_ptr_->data_ptr = std::make_shared<const xt::xarray<float>>(
+        xt::adapt(data_ptr_->data() + view.offset, data_ptr_->size() - view.offset, xt::no_ownership(), view.shape,
+                  view.strides));
+  });
+  return view_cache_ptr_->data_ptr;
+}
+
+void Tensor::SeData(const xt::xarray<float>& data) {
+  data_ptr_ = CopyIntoStorage(data);
+  ClearView();
+  ++version_;
+}
+
+xt::xarray<float>& Tensor::MutableData() {
+  // The view is evaluated into its own data storage, since the data storage viewed is shared with the other tensor.
+  if (view_opt_.has_value()) {
+    data_ptr_ = std::make_shared<xt::xarray<float>>(data());
+    ClearView();
+  } else if (data_ptr_.use_count() > 1) {
+    data_ptr_ = CopyIntoStorage(*data_ptr_);
+  } else {
+    // NOTE: `use_count()` is a relaxed load, so observing that the other sharer (e.g. the snapshot being written by
+    // NOTE: `AsyncCheckpointWriter` on another thread) has released the storage doesn't order its reads before the
+    // NOTE: writes below by itself. The acquire fence synchronizes with the release of the reference count decrement,
+    // NOTE: so all of the reads by the sharer happen before the writes in place.
+    std::atomic_thread_fence(std::memory_order_acquire);
+  }
+  ++version_;
+  return *data_ptr_;
+}
+
 void Tensor::SetParentFunctionPtr(const FunctionSharedPtr parent_function_ptr) {
   parent_function_ptr_ = parent_function_ptr;
   generation_ = parent_function_ptr->generation() + 1;
 }
 
+const xt::xarray<float>::strides_type RowMajorStrides(const xt::xarray<float>::shape_type& shape) {
+  xt::xarray<float>::strides_type strides(shape.size());
+  std::ptrdiff_t stride = 1;
+  for (std::size_t i = shape.size(); 0 < i; --i) {
+    strides[i - 1] = stride;
+    stride *= shape[i - 1];
+  }
+  return strides;
+}
+
+const bool IsContiguousView(const TensorView& view) {
+  // The strides of the axes of the size 1 don't matter.
+  const xt::xarray<float>::strides_type row_major_strides = RowMajorStrides(view.shape);
+  for (std::size_t i = 0; i < view.shape.size(); ++i) {
+    if (view.shape[i] != 1 && view.strides[i] != row_major_strides[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
 const TensorSharedPtr AsTensorSharedPtr(const xt::xarray<float>& data, const std::string& name /* = "" */) {
   return std::make_shared<Tensor>(data, name);
 }
 
+void EmulateReducedPrecisionStorage(xt::xarray<float>& data, const ReducedPrecisionStorage storage) {
+  if (storage == ReducedPrecisionStorage::kBFloat16) {
+    util::XtensorRoundToBFloat16(data);
+  } else if (storage == ReducedPrecisionStorage::kFloat16) {
+    util::XtensorRoundToFloat16(data);
+  }
+}
+
+const TensorSharedPtr AsTensorSharedPtr(xt::xarray<float>&& data, const std::string& name /* = "" */) {
+  return std::make_shared<Tensor>(std::move(data), name);
+}
+
 }  // namespace tensorward::core
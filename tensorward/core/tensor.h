@@ -1,22 +1,69 @@
 #pragma once
 
+#include <atomic>
 #include <cassert>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <utility>
 
 #include <xtensor/xarray.hpp>
 #include <xtensor/xio.hpp>
 
+#include "tensorward/core/config.h"
 #include "tensorward/core/function_fwd.h"
 #include "tensorward/core/tensor_fwd.h"
 
 namespace tensorward::core {
 
+// Strided view of a data storage (e.g. the output of `function::Reshape` or `function::Transpose` sharing the data
+// storage of the input), whose element at the index (i0, i1, ...) is `storage.data()[offset + i0 * strides[0] + ...]`.
+struct TensorView {
+  xt::xarray<float>::shape_type shape;
+
+  xt::xarray<float>::strides_type strides;
+
+  std::size_t offset = 0;
+};
+
+// Strides of the contiguous row-major array of the shape (e.g. {2, 3, 4} ---> {12, 4, 1}).
+const xt::xarray<float>::strides_type RowMajorStrides(const xt::xarray<float>::shape_type& shape);
+
+// Whether the view is of the contiguous row-major elements, i.e. it can be reshaped by only replacing its shape and
+// strides.
+const bool IsContiguousView(const TensorView& view);
+
 class Tensor {
  public:
-  Tensor(const xt::xarray<float>& data, const std::string& name = "") : data_(data), name_(name), generation_(0) {}
+  // Copies the data (placed on the NUMA nodes of the threads processing it if `Config::kDoesUseNumaLocalPlacement`).
+  Tensor(const xt::xarray<float>& data, const std::string& name = "");
+
+  // Takes over the data without copying it (e.g. the output of `Function::Forward()`).
+  Tensor(xt::xarray<float>&& data, const std::string& name = "")
+      : data_ptr_(std::make_shared<xt::xarray<float>>(std::move(data))), name_(name), generation_(0), version_(0) {}
+
+  // Shares the data storage (obtained by `data_ptr()`) with other tensors (or snapshots) without copying it.
+  // NOTE: The data storage isn't immutable (the pointee is non-const inside the tensor), but the sharers don't observe
+  // NOTE: the updates of each other: `SeData()` replaces the storage, and `MutableData()` copies it first if it's
+  // NOTE: shared (copy-on-write), so only the callers of `MutableData()` (e.g. the optimizers and the all-reduce) write
+  // NOTE: it in place, and only while they own it exclusively. The only exception is
+  // NOTE: `optimizer::HogwildStochasticGradientDescent`, which deliberately writes the storage shared by the replicas
+  // NOTE: in place without locking (so the replicas observe the updates racily, which is the point of Hogwild).
+  Tensor(const std::shared_ptr<const xt::xarray<float>>& data_ptr, const std::string& name = "")
+      : data_ptr_(std::const_pointer_cast<xt::xarray<float>>(data_ptr)), name_(name), generation_(0), version_(0) {}
+
+  // Views the data storage (obtained by `data_ptr()` of another tensor) through the strided view without copying it
+  // (e.g. the output of `function::Reshape`). The viewed elements are evaluated into a contiguous array only when
+  // `data()` is called first, so a chain of the views (e.g. reshape ---> transpose) costs O(1) until it's read.
+  Tensor(const std::shared_ptr<const xt::xarray<float>>& data_ptr, const TensorView& view, const std::string& name = "")
+      : data_ptr_(std::const_pointer_cast<xt::xarray<float>>(data_ptr)),
+        view_opt_(view),
+        view_cache_ptr_(std::make_shared<ViewCache>()),
+        name_(name),
+        generation_(0),
+        version_(0) {}
 
   virtual ~Tensor() {}
 
@@ -24,7 +71,20 @@ class Tensor {
   void Backpropagation(const bool does_retain_grad = false);
 
   // Clears the gradient.
-  void ClearGrad() { grad_opt_ = std::nullopt; }
+  virtual void ClearGrad() { grad_opt_ = std::nullopt; }
+
+  // Accumulates the gradient in place, or takes over the gradient without copying it if there is no gradient yet.
+  void AccumulateGrad(xt::xarray<float>&& grad);
+
+  // Moves the gradient out of this tensor (instead of copying it), which leaves this tensor without gradient.
+  xt::xarray<float> ReleaseGrad();
+
+  // Called by `Backpropagation()` once the gradient of this tensor, which has no parent function (e.g. a parameter), is
+  // final, i.e. all of the functions using it in the computational graph have been processed. It's called only if
+  // `has_grad_ready_hooks()` is true (see `Parameter::RegisterGradReadyHook()`).
+  virtual void OnGradReady() {}
+
+  virtual const bool has_grad_ready_hooks() const { return false; }
 
   // TODO: Implement `Reshape(output_shape)` by calling `tensorward::function::reshape(this, output_shape)`.
 
@@ -34,7 +94,21 @@ class Tensor {
 
   // TODO: Maybe implement `shape()`, `dimension()` , `size()`, ... etc. by delegating to `xt::xarray<>` functions?
 
-  void SeData(const xt::xarray<float>& data) { data_ = data; }
+  // Replaces the data with a new storage instead of overwriting the current one (copy-on-write), so that the other
+  // tensors (or snapshots) sharing the current storage keep seeing the old data. Also increments the version so that
+  // caches derived from the data (e.g. transformed filters) can tell that they are outdated.
+  void SeData(const xt::xarray<float>& data);
+
+  void SeData(xt::xarray<float>&& data) {
+    data_ptr_ = std::make_shared<xt::xarray<float>>(std::move(data));
+    ClearView();
+    ++version_;
+  }
+
+  // Returns the data to be updated in place (e.g. only the touched rows by an optimizer), which avoids allocating and
+  // writing the whole data like `SeData()` does. The data storage is copied first only if it's shared with other
+  // tensors (or snapshots) (copy-on-write). Also increments the version in the same way as `SeData()`.
+  xt::xarray<float>& MutableData();
 
   // TODO: Maybe add `void SetGrad(xt::xarray<float>& grad)` ?
   void SetGradOpt(const std::optional<xt::xarray<float>>& grad_opt) { grad_opt_ = grad_opt; }
@@ -43,7 +117,30 @@ class Tensor {
 
   void SetParentFunctionPtr(const FunctionSharedPtr parent_function_ptr);
 
-  const xt::xarray<float>& data() const { return data_; }
+  // Gets the data, which is evaluated from the data storage first if this tensor is a view (see `view_opt()`).
+  const xt::xarray<float>& data() const { return view_opt_.has_value() ? *contiguous_data_ptr() : *data_ptr_; }
+
+  // Gets the data storage, which is shared with the other tensors viewing it (e.g. the outputs of `function::Reshape`
+  // and `function::Transpose`) and the snapshots.
+  // NOTE: If this tensor is a view, then the data storage can have a different shape from `data()`. Use
+  // NOTE: `contiguous_data_ptr()` to share the data itself.
+  const std::shared_ptr<const xt::xarray<float>> data_ptr() const { return data_ptr_; }
+
+  // Gets the storage of `data()`, which is the data storage itself unless this tensor is a view.
+  const std::shared_ptr<const xt::xarray<float>> contiguous_data_ptr() const;
+
+  // Gets the shape without evaluating the view.
+  const xt::xarray<float>::shape_type& shape() const {
+    return view_opt_.has_value() ? view_opt_.value().shape : data_ptr_->shape();
+  }
+
+  // Gets the view of the data storage, which is the contiguous row-major view of the whole storage unless this tensor
+  // is a view.
+  const TensorView view() const {
+    return view_opt_.value_or(TensorView{.shape = data_ptr_->shape(), .strides = RowMajorStrides(data_ptr_->shape())});
+  }
+
+  const std::optional<TensorView>& view_opt() const { return view_opt_; }
 
   const xt::xarray<float>& grad() const {
     assert((static_cast<void>("`Tensor::grad_opt_` must have value to get the value."), grad_opt_.has_value()));
@@ -58,8 +155,27 @@ class Tensor {
 
   const int generation() const { return generation_; }
 
+  const std::size_t version() const { return version_; }
+
  protected:
-  xt::xarray<float> data_;
+  // Contiguous array evaluated from the view, once.
+  struct ViewCache {
+    std::once_flag once_flag;
+
+    std::shared_ptr<const xt::xarray<float>> data_ptr;
+  };
+
+  // Makes this tensor not a view anymore (e.g. when the data is replaced).
+  void ClearView() {
+    view_opt_ = std::nullopt;
+    view_cache_ptr_ = nullptr;
+  }
+
+  std::shared_ptr<xt::xarray<float>> data_ptr_;
+
+  std::optional<TensorView> view_opt_;
+
+  std::shared_ptr<ViewCache> view_cache_ptr_;
 
   std::optional<xt::xarray<float>> grad_opt_;
 
@@ -68,10 +184,26 @@ class Tensor {
   FunctionSharedPtr parent_function_ptr_;
 
   int generation_;
+
+  std::size_t version_;
+
+  // Number of the tensors whose `has_grad_ready_hooks()` is true, so that `Backpropagation()` counts the uses of the
+  // tensors in the computational graph only if it's positive.
+  inline static std::atomic<std::size_t> num_tensors_with_grad_ready_hooks_ = 0;
 };
 
 const TensorSharedPtr AsTensorSharedPtr(const xt::xarray<float>& data, const std::string& name = "");
 
+const TensorSharedPtr AsTensorSharedPtr(xt::xarray<float>&& data, const std::string& name = "");
+
+// Rounds the data in place to the nearest bfloat16 (or float16) value if `Config::kDoesUseBFloat16Storage` (or
+// `Config::kDoesUseFloat16Storage`) is enabled, which emulates storing the data in the reduced precision. The
+// arithmetic itself (e.g. the accumulation in GEMM and reductions) is still performed in float.
+// NOTE: The callers processing many arrays at once (e.g. `Function::Call()`) read the storage once by
+// NOTE: `Config::reduced_precision_storage()`, and pass it.
+void EmulateReducedPrecisionStorage(
+    xt::xarray<float>& data, const ReducedPrecisionStorage storage = Config::instance().reduced_precision_storage());
+
 inline std::ostream& operator<<(std::ostream& os, const Tensor& tensor) {
   !tensor.name().empty() ? (os << std::endl << "'" << tensor.name() << "'") : (os << std::endl << "(No name)");
   os << std::endl << "data:" << std::endl << tensor.data();
@@ -0,0 +1,97 @@
+#include "tensorward/core/async_checkpoint_writer.h"
+
+#include <filesystem>
+
+#include <gtest/gtest.h>
+#include <xtensor/xarray.hpp>
+#include <xtensor/xrandom.hpp>
+
+#include "tensorward/core/checkpoint.h"
+#include "tensorward/core/config.h"
+#include "tensorward/function/sigmoid.h"
+#include "tensorward/model/multi_layer_perceptron.h"
+#include "tensorward/optimizer/momentum_stochastic_gradient_descent.h"
+
+namespace tensorward::core {
+
+namespace {
+
+constexpr int kDataSize = 10;
+constexpr int kInSize = 2;
+constexpr int kHiddenSize = 5;
+constexpr int kOutSize = 3;
+constexpr float kLearningRate = 0.01;
+constexpr float kMomentum = 0.9;
+constexpr int kIteration = 10;
+
+}  // namespace
+
+class AsyncCheckpointWriterTest : public ::testing::Test {
+ protected:
+  AsyncCheckpointWriterTest()
+      : input_tensor_ptr_(AsTensorSharedPtr(xt::random::rand<float>({kDataSize, kInSize}))),
+        model_({kHiddenSize, kOutSize}, AsFunctionSharedPtr<function::Sigmoid>()),
+        optimizer_(kLearningRate, kMomentum),
+        file_path_(std::filesystem::temp_directory_path() /
+                   (::testing::UnitTest::GetInstance()->current_test_info()->name() + std::string(".ckpt"))) {}
+
+  ~AsyncCheckpointWriterTest() { std::filesystem::remove(file_path_); }
+
+  void Train() {
+    model_.ClearGrads();
+    model_.Predict({input_tensor_ptr_})[0]->Backpropagation();
+    optimizer_.Update(model_.GetParamPtrs());
+  }
+
+  const xt::xarray<float> PredictWithoutBackpropagation(const model::MultiLayerPerceptron& model) const {
+    UseConfig with(Config::kDoesEnableBackpropagation, false);
+    return model.Predict({input_tensor_ptr_})[0]->data();
+  }
+
+  const TensorSharedPtr input_tensor_ptr_;
+  model::MultiLayerPerceptron model_;
+  optimizer::MomentumStochasticGradientDescent optimizer_;
+  const std::filesystem::path file_path_;
+};
+
+TEST_F(AsyncCheckpointWriterTest, SaveTest) {
+  Train();
+  const xt::xarray<float> expected_y = PredictWithoutBackpropagation(model_);
+
+  // Checks that the checkpoint keeps the parameters at the time of `Save()` even if the training goes on while it's
+  // written in the background.
+  AsyncCheckpointWriter checkpoint_writer;
+  checkpoint_writer.Save(file_path_, model_, &optimizer_);
+  for (std::size_t i = 0; i < kIteration; ++i) {
+    Train();
+  }
+  checkpoint_writer.Wait();
+  ASSERT_EQ(checkpoint_writer.num_written_checkpoints(), 1);
+  EXPECT_EQ(checkpoint_writer.num_failed_checkpoints(), 0);
+  EXPECT_LE(0.0, checkpoint_writer.last_stall_seconds());
+  EXPECT_LE(checkpoint_writer.last_stall_seconds(), checkpoint_writer.max_stall_seconds());
+
+  model::MultiLayerPerceptron loaded_model({kHiddenSize, kOutSize}, AsFunctionSharedPtr<function::Sigmoid>());
+  ASSERT_TRUE(LoadCheckpoint(file_path_, loaded_model));
+  EXPECT_EQ(PredictWithoutBackpropagation(loaded_model), expected_y);
+}
+
+TEST_F(AsyncCheckpointWriterTest, SaveRepeatedlyTest) {
+  // Checks that every snapshot is either written or dropped (in favor of the newer one), and the file has the last one.
+  {
+    AsyncCheckpointWriter checkpoint_writer;
+    for (std::size_t i = 0; i < kIteration; ++i) {
+      Train();
+      checkpoint_writer.Save(file_path_, model_, &optimizer_);
+    }
+    checkpoint_writer.Wait();
+    EXPECT_EQ(checkpoint_writer.num_written_checkpoints() + checkpoint_writer.num_dropped_checkpoints(), kIteration);
+    EXPECT_EQ(checkpoint_writer.num_failed_checkpoints(), 0);
+  }
+
+  model::MultiLayerPerceptron loaded_model({kHiddenSize, kOutSize}, AsFunctionSharedPtr<function::Sigmoid>());
+  ASSERT_TRUE(LoadCheckpoint(file_path_, loaded_model));
+  EXPECT_EQ(PredictWithoutBackpropagation(loaded_model), PredictWithoutBackpropagation(model_));
+}
+
+}  // namespace tensorward::core
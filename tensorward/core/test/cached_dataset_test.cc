@@ -0,0 +1,152 @@
+#include "tensorward/core/cached_dataset.h"
+
+#include <cassert>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <xtensor/xbuilder.hpp>
+#include <xtensor/xview.hpp>
+
+#include "tensorward/dataset/spiral.h"
+
+namespace tensorward::core {
+
+namespace {
+
+constexpr std::size_t kClassSize = 3;
+constexpr bool kIsTrainingMode = true;
+
+}  // namespace
+
+class CachedDatasetTest : public ::testing::Test {
+ protected:
+  CachedDatasetTest()
+      : num_transforms_(0),
+        // Deterministic transform, which counts the number of the calls.
+        transform_to_half_lambda_([this](const xt::xarray<float>& input_data) {
+          ++num_transforms_;
+          return input_data / 2.0;
+        }),
+        transform_to_onehot_lambda_([](const xt::xarray<float>& input_data) {
+          const std::size_t class_index = static_cast<std::size_t>(input_data(0));
+          assert(class_index < kClassSize);
+          xt::xarray<float> output_data = xt::zeros<float>({kClassSize});
+          xt::view(output_data, class_index) = 1.0;
+          return output_data;
+        }),
+        // Stands for the random transform, which must be applied at each access.
+        transform_to_next_lambda_([](const xt::xarray<float>& input_data) { return input_data + 1.0; }),
+        spiral_dataset_ptr_(std::make_shared<dataset::Spiral>(kIsTrainingMode, std::vector<TransformLambda>(),
+                                                              std::vector<TransformLambda>())),
+        directory_path_(std::filesystem::temp_directory_path() /
+                        ("tensorward_" + std::to_string(getpid()) + "_" +
+                         ::testing::UnitTest::GetInstance()->current_test_info()->name())) {
+    std::filesystem::create_directories(directory_path_);
+  }
+
+  ~CachedDatasetTest() { std::filesystem::remove_all(directory_path_); }
+
+  // Returns the dataset of the deterministic transforms to be cached.
+  const DatasetSharedPtr DeterministicDatasetPtr(const bool is_onehot) const {
+    return std::make_shared<dataset::Spiral>(
+        kIsTrainingMode, std::vector<TransformLambda>({transform_to_half_lambda_}),
+        is_onehot ? std::vector<TransformLambda>({transform_to_onehot_lambda_}) : std::vector<TransformLambda>());
+  }
+
+  // Iterates the dataset once, and checks that each sample is transformed by both of the transforms.
+  void Iterate(const CachedDataset& cached_dataset) const {
+    for (std::size_t i = 0; i < cached_dataset.size(); ++i) {
+      const auto [actual_data, actual_label] = cached_dataset.at(i);
+      const auto [data, label] = spiral_dataset_ptr_->at(i);
+      EXPECT_TRUE(xt::allclose(actual_data, data / 2.0 + 1.0));
+      EXPECT_EQ(actual_label, label);
+    }
+  }
+
+  std::size_t num_transforms_;
+  const TransformLambda transform_to_half_lambda_;
+  const TransformLambda transform_to_onehot_lambda_;
+  const TransformLambda transform_to_next_lambda_;
+  const DatasetSharedPtr spiral_dataset_ptr_;
+  const std::filesystem::path directory_path_;
+};
+
+TEST_F(CachedDatasetTest, InMemoryTest) {
+  CachedDataset cached_dataset(DeterministicDatasetPtr(false), {transform_to_next_lambda_}, {});
+  ASSERT_TRUE(cached_dataset.is_valid());
+  ASSERT_EQ(cached_dataset.size(), spiral_dataset_ptr_->size());
+  EXPECT_EQ(cached_dataset.num_cached_samples(), 0);
+
+  // The first epoch transforms all of the samples, and caches them.
+  const std::size_t num_transforms = num_transforms_;
+  Iterate(cached_dataset);
+  EXPECT_EQ(num_transforms_ - num_transforms, cached_dataset.size());
+  EXPECT_EQ(cached_dataset.num_cache_hits(), 0);
+  EXPECT_EQ(cached_dataset.num_cache_misses(), cached_dataset.size());
+  EXPECT_EQ(cached_dataset.num_cached_samples(), cached_dataset.size());
+
+  // The second epoch never transforms them again, and only the transform of the cached dataset is applied.
+  cached_dataset.ResetCacheStats();
+  Iterate(cached_dataset);
+  EXPECT_EQ(num_transforms_ - num_transforms, cached_dataset.size());
+  EXPECT_EQ(cached_dataset.num_cache_hits(), cached_dataset.size());
+  EXPECT_EQ(cached_dataset.num_cache_misses(), 0);
+}
+
+TEST_F(CachedDatasetTest, CacheFileTest) {
+  const std::filesystem::path cache_file_path = directory_path_ / "cache";
+  const std::size_t num_samples = spiral_dataset_ptr_->size() / 2;
+  {
+    // Caches the first half of the samples in the file.
+    const CachedDataset cached_dataset(DeterministicDatasetPtr(false), {transform_to_next_lambda_}, {},
+                                       cache_file_path);
+    ASSERT_TRUE(cached_dataset.is_valid());
+    for (std::size_t i = 0; i < num_samples; ++i) {
+      cached_dataset.at(i);
+    }
+    EXPECT_EQ(cached_dataset.num_cached_samples(), num_samples);
+  }
+
+  // Reuses the cache file, where the first half of the samples are hits.
+  const CachedDataset cached_dataset(DeterministicDatasetPtr(false), {transform_to_next_lambda_}, {},
+                                     cache_file_path);
+  ASSERT_TRUE(cached_dataset.is_valid());
+  EXPECT_EQ(cached_dataset.num_cached_samples(), num_samples);
+  Iterate(cached_dataset);
+  EXPECT_EQ(cached_dataset.num_cache_hits(), num_samples);
+  EXPECT_EQ(cached_dataset.num_cache_misses(), cached_dataset.size() - num_samples);
+  EXPECT_EQ(cached_dataset.num_cached_samples(), cached_dataset.size());
+
+  // Recreates the cache file for the different cache key (e.g. the transform lambdas have changed).
+  {
+    const CachedDataset keyed_cached_dataset(DeterministicDatasetPtr(false), {transform_to_next_lambda_}, {},
+                                             cache_file_path, "v2");
+    ASSERT_TRUE(keyed_cached_dataset.is_valid());
+    EXPECT_EQ(keyed_cached_dataset.cache_key(), "v2");
+    EXPECT_EQ(keyed_cached_dataset.num_cached_samples(), 0);
+    keyed_cached_dataset.at(0);
+  }
+  const CachedDataset same_keyed_cached_dataset(DeterministicDatasetPtr(false), {transform_to_next_lambda_}, {},
+                                                cache_file_path, "v2");
+  ASSERT_TRUE(same_keyed_cached_dataset.is_valid());
+  EXPECT_EQ(same_keyed_cached_dataset.num_cached_samples(), 1);
+
+  // Recreates the cache file for the samples of the different shapes (i.e. the one-hot labels).
+  const CachedDataset onehot_cached_dataset(DeterministicDatasetPtr(true), {}, {}, cache_file_path);
+  ASSERT_TRUE(onehot_cached_dataset.is_valid());
+  EXPECT_EQ(onehot_cached_dataset.num_cached_samples(), 0);
+  const auto [data, label] = onehot_cached_dataset.at(0);
+  EXPECT_EQ(label.shape(), xt::xarray<float>::shape_type({kClassSize}));
+  EXPECT_EQ(onehot_cached_dataset.num_cached_samples(), 1);
+
+  // Fails for the file which can't be created.
+  const CachedDataset invalid_cached_dataset(DeterministicDatasetPtr(false), {}, {},
+                                             directory_path_ / "nonexistent" / "cache");
+  EXPECT_FALSE(invalid_cached_dataset.is_valid());
+  EXPECT_EQ(invalid_cached_dataset.size(), 0);
+}
+
+}  // namespace tensorward::core
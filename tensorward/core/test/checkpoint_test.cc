@@ -0,0 +1,146 @@
+#include "tensorward/core/checkpoint.h"
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+
+#include <gtest/gtest.h>
+#include <xtensor/xarray.hpp>
+#include <xtensor/xbuilder.hpp>
+#include <xtensor/xrandom.hpp>
+
+#include "tensorward/core/config.h"
+#include "tensorward/function/sigmoid.h"
+#include "tensorward/model/multi_layer_perceptron.h"
+#include "tensorward/optimizer/momentum_stochastic_gradient_descent.h"
+
+namespace tensorward::core {
+
+namespace {
+
+constexpr int kDataSize = 10;
+constexpr int kInSize = 2;
+constexpr int kHiddenSize = 5;
+constexpr int kOutSize = 3;
+constexpr float kLearningRate = 0.01;
+constexpr float kMomentum = 0.9;
+
+}  // namespace
+
+class CheckpointTest : public ::testing::Test {
+ protected:
+  CheckpointTest()
+      : input_tensor_ptr_(AsTensorSharedPtr(xt::random::rand<float>({kDataSize, kInSize}))),
+        model_({kHiddenSize, kOutSize}, AsFunctionSharedPtr<function::Sigmoid>()),
+        optimizer_(kLearningRate, kMomentum),
+        file_path_(std::filesystem::temp_directory_path() /
+                   (::testing::UnitTest::GetInstance()->current_test_info()->name() + std::string(".ckpt"))) {
+    // Trains a single step, so that the parameters and the velocity of the momentum exist.
+    model_.Predict({input_tensor_ptr_})[0]->Backpropagation();
+    optimizer_.Update(model_.GetParamPtrs());
+  }
+
+  ~CheckpointTest() { std::filesystem::remove(file_path_); }
+
+  const xt::xarray<float> PredictWithoutBackpropagation(const model::MultiLayerPerceptron& model) const {
+    UseConfig with(Config::kDoesEnableBackpropagation, false);
+    return model.Predict({input_tensor_ptr_})[0]->data();
+  }
+
+  const TensorSharedPtr input_tensor_ptr_;
+  model::MultiLayerPerceptron model_;
+  optimizer::MomentumStochasticGradientDescent optimizer_;
+  const std::filesystem::path file_path_;
+};
+
+TEST_F(CheckpointTest, LoadIntoFreshModelTest) {
+  ASSERT_TRUE(SaveCheckpoint(file_path_, model_));
+
+  // Checks that the parameters are created in the model which hasn't performed the forward calculation yet.
+  model::MultiLayerPerceptron loaded_model({kHiddenSize, kOutSize}, AsFunctionSharedPtr<function::Sigmoid>());
+  ASSERT_TRUE(LoadCheckpoint(file_path_, loaded_model));
+  ASSERT_EQ(loaded_model.GetParamPtrs().size(), model_.GetParamPtrs().size());
+
+  EXPECT_EQ(PredictWithoutBackpropagation(loaded_model), PredictWithoutBackpropagation(model_));
+}
+
+TEST_F(CheckpointTest, LoadIntoExistingModelTest) {
+  ASSERT_TRUE(SaveCheckpoint(file_path_, model_));
+  const xt::xarray<float> expected_y = PredictWithoutBackpropagation(model_);
+
+  // Checks that the parameters are overwritten in place, so that the parameter pointers are still the same.
+  model::MultiLayerPerceptron loaded_model({kHiddenSize, kOutSize}, AsFunctionSharedPtr<function::Sigmoid>());
+  loaded_model.Predict({input_tensor_ptr_});
+  const std::vector<ParameterSharedPtr> param_ptrs = loaded_model.GetParamPtrs();
+  ASSERT_TRUE(LoadCheckpoint(file_path_, loaded_model));
+  EXPECT_EQ(loaded_model.GetParamPtrs(), param_ptrs);
+
+  EXPECT_EQ(PredictWithoutBackpropagation(loaded_model), expected_y);
+}
+
+TEST_F(CheckpointTest, LoadOptimizerStateTest) {
+  ASSERT_TRUE(SaveCheckpoint(file_path_, model_, &optimizer_));
+
+  model::MultiLayerPerceptron loaded_model({kHiddenSize, kOutSize}, AsFunctionSharedPtr<function::Sigmoid>());
+  optimizer::MomentumStochasticGradientDescent loaded_optimizer(kLearningRate, kMomentum);
+  ASSERT_TRUE(LoadCheckpoint(file_path_, loaded_model, &loaded_optimizer));
+
+  // Checks that the next step of the training is the same as the one without saving and loading.
+  model_.ClearGrads();
+  model_.Predict({input_tensor_ptr_})[0]->Backpropagation();
+  optimizer_.Update(model_.GetParamPtrs());
+  loaded_model.Predict({input_tensor_ptr_})[0]->Backpropagation();
+  loaded_optimizer.Update(loaded_model.GetParamPtrs());
+
+  EXPECT_EQ(PredictWithoutBackpropagation(loaded_model), PredictWithoutBackpropagation(model_));
+}
+
+TEST_F(CheckpointTest, MappedCheckpointTest) {
+  ASSERT_TRUE(SaveCheckpoint(file_path_, model_, &optimizer_));
+
+  const MappedCheckpoint checkpoint(file_path_);
+  ASSERT_TRUE(checkpoint.is_valid());
+  EXPECT_EQ(checkpoint.version(), kCheckpointVersion);
+
+  // There should exist 4 parameters and their velocities.
+  ASSERT_EQ(checkpoint.entries().size(), 8);
+  for (const auto& entry : checkpoint.entries()) {
+    EXPECT_EQ(entry.offset % kCheckpointAlignment, 0);
+  }
+
+  const ParameterSharedPtr W0_ptr = model_.layer_ptrs()[0]->param_map().at("W");
+  ASSERT_TRUE(checkpoint.Contains("layer0/W"));
+  ASSERT_TRUE(checkpoint.Contains("layer0/W/velocity"));
+  EXPECT_EQ(xt::xarray<float>(checkpoint.Adapt("layer0/W")), W0_ptr->data());
+  EXPECT_EQ(xt::xarray<float>(checkpoint.Adapt("layer0/W/velocity")), *optimizer_.GetStateMap(W0_ptr).at("velocity"));
+}
+
+TEST_F(CheckpointTest, MismatchedModelTest) {
+  ASSERT_TRUE(SaveCheckpoint(file_path_, model_));
+
+  // The first layer matches the checkpoint, but the last layer doesn't.
+  model::MultiLayerPerceptron mismatched_model({kHiddenSize, kOutSize + 1}, AsFunctionSharedPtr<function::Sigmoid>());
+  mismatched_model.Predict({input_tensor_ptr_});
+  const xt::xarray<float> W0 = mismatched_model.layer_ptrs()[0]->param_map().at("W")->data();
+
+  // Checks that the checkpoint is rejected without overwriting even the parameters of the matching layer.
+  EXPECT_FALSE(LoadCheckpoint(file_path_, mismatched_model));
+  EXPECT_EQ(mismatched_model.layer_ptrs()[0]->param_map().at("W")->data(), W0);
+}
+
+TEST_F(CheckpointTest, InvalidFileTest) {
+  // Checks that a missing file and a broken file are rejected.
+  EXPECT_FALSE(LoadCheckpoint(file_path_, model_));
+
+  std::ofstream(file_path_) << "This is not a checkpoint.";
+  EXPECT_FALSE(MappedCheckpoint(file_path_).is_valid());
+  EXPECT_FALSE(LoadCheckpoint(file_path_, model_));
+
+  // Checks that the parameter of a layer index overflowing `std::size_t` is rejected (instead of throwing).
+  const CheckpointSnapshot snapshot = {{CheckpointEntryKind::kParameter, "layer99999999999999999999999/W",
+                                        std::make_shared<const xt::xarray<float>>(xt::zeros<float>({kInSize}))}};
+  ASSERT_TRUE(SaveCheckpoint(file_path_, snapshot));
+  EXPECT_FALSE(LoadCheckpoint(file_path_, model_));
+}
+
+}  // namespace tensorward::core
@@ -1,5 +1,7 @@
 #include "tensorward/core/config.h"
 
+#include <thread>
+
 #include <gtest/gtest.h>
 #include <xtensor/xrandom.hpp>
 
@@ -47,4 +49,43 @@ TEST_F(ConfigTest, UseConfigTest) {
   EXPECT_EQ(Config::instance().config_value(Config::kDoesEnableBackpropagation), kExpectedValueOutsideScope);
 }
 
+TEST_F(ConfigTest, ReducedPrecisionStorageTest) {
+  // Checks that the cached reduced-precision storage follows the config values set by the UseConfig instances.
+  EXPECT_EQ(Config::instance().reduced_precision_storage(), ReducedPrecisionStorage::kNone);
+  {
+    UseConfig with(Config::kDoesUseBFloat16Storage, true);
+    EXPECT_EQ(Config::instance().reduced_precision_storage(), ReducedPrecisionStorage::kBFloat16);
+  }
+  {
+    UseConfig with(Config::kDoesUseFloat16Storage, true);
+    EXPECT_EQ(Config::instance().reduced_precision_storage(), ReducedPrecisionStorage::kFloat16);
+  }
+  EXPECT_EQ(Config::instance().reduced_precision_storage(), ReducedPrecisionStorage::kNone);
+}
+
+TEST_F(ConfigTest, UseThreadLocalConfigTest) {
+  {
+    UseThreadLocalConfig with(Config::kDoesEnableBackpropagation, false);
+
+    // Checks that the config value is overridden for this thread, but not for the other thread.
+    EXPECT_FALSE(Config::instance().config_value(Config::kDoesEnableBackpropagation));
+    bool other_thread_config_value = false;
+    std::thread([&other_thread_config_value] {
+      other_thread_config_value = Config::instance().config_value(Config::kDoesEnableBackpropagation);
+    }).join();
+    EXPECT_TRUE(other_thread_config_value);
+
+    // Checks that the computational graph is not created in this thread.
+    const TensorSharedPtr output_tensor_ptr = function::exp(function::square(input_tensor_ptr_));
+    EXPECT_EQ(output_tensor_ptr->parent_function_ptr(), nullptr);
+
+    // Checks that the thread-local value takes precedence over the global value.
+    UseConfig with_global(Config::kDoesEnableBackpropagation, true);
+    EXPECT_FALSE(Config::instance().config_value(Config::kDoesEnableBackpropagation));
+  }
+
+  // Checks that the override is removed after exiting the scope.
+  EXPECT_TRUE(Config::instance().config_value(Config::kDoesEnableBackpropagation));
+}
+
 }  // namespace tensorward::core
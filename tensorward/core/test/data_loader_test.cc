@@ -1,5 +1,10 @@
 #include "tensorward/core/data_loader.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
 #include <gtest/gtest.h>
 #include <xtensor/xview.hpp>
 
@@ -14,6 +19,8 @@ constexpr std::size_t kBatchSize = 10;
 constexpr bool kDoesShuffleDataset = true;
 constexpr bool kDoesNotShuffleDataset = false;
 constexpr std::size_t kDecimatingScale = 10;
+constexpr std::size_t kPartialBatchSize = 7;
+constexpr std::uint64_t kSeed = 1234;
 
 }  // namespace
 
@@ -27,7 +34,7 @@ class DataLoaderTest : public ::testing::Test {
     const xt::xarray<std::size_t> full_indices_without_shuffle = xt::arange(full_dataset_size);
 
     const std::size_t decimated_dataset_size = full_dataset_size / kDecimatingScale;
-    decimated_indices_without_shuffle_ = xt::zeros<std::size_t>({decimated_dataset_size});
+    decimated_indices_without_shuffle_.resize(decimated_dataset_size);
 
     xt::xarray<float>::shape_type decimated_data_shape = spiral_dataset_ptr_->data().shape();
     decimated_data_shape[0] = decimated_dataset_size;
@@ -38,7 +45,7 @@ class DataLoaderTest : public ::testing::Test {
     decimated_spiral_dataset_label_without_shuffle_ = xt::zeros<std::size_t>(decimated_label_shape);
 
     for (std::size_t i = 0; i < decimated_dataset_size; ++i) {
-      xt::view(decimated_indices_without_shuffle_, i) = xt::view(full_indices_without_shuffle, kDecimatingScale * i);
+      decimated_indices_without_shuffle_[i] = full_indices_without_shuffle(kDecimatingScale * i);
 
       xt::view(decimated_spiral_dataset_data_without_shuffle_, i) =
           xt::view(spiral_dataset_ptr_->data(), kDecimatingScale * i);
@@ -50,7 +57,7 @@ class DataLoaderTest : public ::testing::Test {
   const DatasetSharedPtr spiral_dataset_ptr_;
   DataLoader spiral_data_loader_with_shuffle_;
   DataLoader spiral_data_loader_without_shuffle_;
-  xt::xarray<std::size_t> decimated_indices_without_shuffle_;
+  std::vector<std::size_t> decimated_indices_without_shuffle_;
   xt::xarray<float> decimated_spiral_dataset_data_without_shuffle_;
   xt::xarray<float> decimated_spiral_dataset_label_without_shuffle_;
 };
@@ -90,4 +97,69 @@ TEST_F(DataLoaderTest, GetBatchAtTest) {
   }
 }
 
+TEST_F(DataLoaderTest, BatchTransformLambdaTest) {
+  const BatchTransformLambda double_lambda = [](xt::xarray<float>& batch) { batch *= 2.0; };
+  const BatchTransformLambda flatten_lambda = [](xt::xarray<float>& batch) { batch.reshape({batch.shape(0), 1}); };
+  DataLoader data_loader(spiral_dataset_ptr_, kBatchSize, kDoesNotShuffleDataset, kDecimatingScale, double_lambda,
+                         flatten_lambda);
+
+  for (std::size_t i = 0; i < data_loader.max_iteration(); ++i) {
+    const auto [actual_batch_data, actual_batch_label] = data_loader.GetBatchAt(i);
+
+    // Checks that the batch transform lambdas are applied to the whole batch data and label respectively.
+    const xt::xarray<float> expected_batch_data =
+        2.0 * xt::view(decimated_spiral_dataset_data_without_shuffle_, xt::range(i * kBatchSize, (i + 1) * kBatchSize));
+    xt::xarray<float> expected_batch_label =
+        xt::view(decimated_spiral_dataset_label_without_shuffle_, xt::range(i * kBatchSize, (i + 1) * kBatchSize));
+    expected_batch_label.reshape({kBatchSize, 1});
+    EXPECT_EQ(actual_batch_data, expected_batch_data);
+    EXPECT_EQ(actual_batch_label, expected_batch_label);
+  }
+}
+
+TEST_F(DataLoaderTest, PartialLastBatchTest) {
+  // 30 samples of the decimated dataset are 4 full batches of 7 samples and a partial batch of 2 samples.
+  const std::size_t decimated_dataset_size = decimated_indices_without_shuffle_.size();
+  DataLoader data_loader(spiral_dataset_ptr_, kPartialBatchSize,
+                         std::make_shared<SequentialSampler>(spiral_dataset_ptr_->size(), kDecimatingScale));
+  ASSERT_EQ(data_loader.max_iteration(), (decimated_dataset_size + kPartialBatchSize - 1) / kPartialBatchSize);
+
+  for (std::size_t i = 0; i < data_loader.max_iteration(); ++i) {
+    const auto [actual_batch_data, actual_batch_label] = data_loader.GetBatchAt(i);
+
+    const std::size_t end = std::min((i + 1) * kPartialBatchSize, decimated_dataset_size);
+    const xt::xarray<float> expected_batch_data =
+        xt::view(decimated_spiral_dataset_data_without_shuffle_, xt::range(i * kPartialBatchSize, end));
+    const xt::xarray<float> expected_batch_label =
+        xt::view(decimated_spiral_dataset_label_without_shuffle_, xt::range(i * kPartialBatchSize, end));
+    EXPECT_EQ(actual_batch_data, expected_batch_data);
+    EXPECT_EQ(actual_batch_label, expected_batch_label);
+  }
+
+  // Drops the partial batch.
+  DataLoader drop_last_data_loader(spiral_dataset_ptr_, kPartialBatchSize,
+                                   std::make_shared<SequentialSampler>(spiral_dataset_ptr_->size(), kDecimatingScale),
+                                   /* does_drop_last = */ true);
+  EXPECT_EQ(drop_last_data_loader.max_iteration(), decimated_dataset_size / kPartialBatchSize);
+  EXPECT_EQ(drop_last_data_loader.dataset_size(), decimated_dataset_size);
+}
+
+TEST_F(DataLoaderTest, SamplerTest) {
+  const SamplerSharedPtr sampler_ptr = std::make_shared<RandomSampler>(spiral_dataset_ptr_->size(), kSeed);
+  DataLoader data_loader(spiral_dataset_ptr_, kBatchSize, sampler_ptr);
+  ASSERT_EQ(data_loader.dataset_size(), spiral_dataset_ptr_->size());
+
+  // The batches are of the indices of the sampler, which are reshuffled in place after the last batch.
+  const std::vector<std::size_t> indices = sampler_ptr->indices();
+  const std::size_t* indices_data = sampler_ptr->indices().data();
+  for (std::size_t i = 0; i < data_loader.max_iteration(); ++i) {
+    const auto [actual_batch_data, actual_batch_label] = data_loader.GetBatchAt(i);
+    for (std::size_t j = 0; j < kBatchSize; ++j) {
+      EXPECT_EQ(actual_batch_label(j), spiral_dataset_ptr_->label()(indices[i * kBatchSize + j]));
+    }
+  }
+  EXPECT_NE(sampler_ptr->indices(), indices);
+  EXPECT_EQ(sampler_ptr->indices().data(), indices_data);
+}
+
 }  // namespace tensorward::core
@@ -13,6 +13,35 @@ namespace {
 constexpr int kHeight = 2;
 constexpr int kWidth = 3;
 
+// Identity function which records the addresses of its input and output data, in order to check whether they are
+// copied.
+class RecordingIdentity : public Function {
+ public:
+  RecordingIdentity()
+      : Function({.num_inputs = 1, .num_outputs = 1}), input_data_pointer_(nullptr), output_data_pointer_(nullptr) {}
+
+  const std::vector<xt::xarray<float>> Forward(const ConstXarrayRefs& xs) override {
+    input_data_pointer_ = xs[0].data();
+    std::vector<xt::xarray<float>> ys;
+    ys.push_back(xs[0]);
+    output_data_pointer_ = ys[0].data();
+    return ys;
+  }
+
+  const std::vector<xt::xarray<float>> Backward(const std::vector<xt::xarray<float>>& dL_dys) override {
+    return dL_dys;
+  }
+
+  const float* input_data_pointer() const { return input_data_pointer_; }
+
+  const float* output_data_pointer() const { return output_data_pointer_; }
+
+ private:
+  const float* input_data_pointer_;
+
+  const float* output_data_pointer_;
+};
+
 }  // namespace
 
 class FunctionTest : public ::testing::Test {
@@ -53,4 +82,17 @@ TEST_F(FunctionTest, CallTest) {
   EXPECT_EQ(add_function_ptr->output_tensor_ptrs()[0].lock(), output_tensor_ptrs[0]);
 }
 
+TEST_F(FunctionTest, CallWithoutCopyingOutputTest) {
+  const std::shared_ptr<RecordingIdentity> identity_function_ptr = std::make_shared<RecordingIdentity>();
+  const std::vector<TensorSharedPtr> output_tensor_ptrs = identity_function_ptr->Call({input_tensor_ptr0_});
+  ASSERT_EQ(output_tensor_ptrs.size(), 1);
+
+  // Checks that `Forward()` reads the data of the input tensor without copying it.
+  EXPECT_EQ(identity_function_ptr->input_data_pointer(), input_tensor_ptr0_->data().data());
+
+  // Checks that the output tensor takes over the data returned by `Forward()` without copying it.
+  EXPECT_EQ(output_tensor_ptrs[0]->data().data(), identity_function_ptr->output_data_pointer());
+  EXPECT_EQ(output_tensor_ptrs[0]->data(), input_tensor_ptr0_->data());
+}
+
 }  // namespace tensorward::core
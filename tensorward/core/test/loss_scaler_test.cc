@@ -0,0 +1,167 @@
+#include "tensorward/core/loss_scaler.h"
+
+#include <limits>
+#include <optional>
+
+#include <gtest/gtest.h>
+#include <xtensor/xarray.hpp>
+#include <xtensor/xrandom.hpp>
+
+#include "tensorward/core/config.h"
+#include "tensorward/core/data_loader.h"
+#include "tensorward/dataset/spiral.h"
+#include "tensorward/function/sigmoid.h"
+#include "tensorward/function/softmax_cross_entropy_error.h"
+#include "tensorward/model/multi_layer_perceptron.h"
+#include "tensorward/optimizer/stochastic_gradient_descent.h"
+#include "tensorward/util/accuracy.h"
+
+namespace tensorward::core {
+
+namespace {
+
+constexpr int kInSize = 2;
+constexpr int kOutSize = 3;
+constexpr float kLearningRate = 0.01;
+
+constexpr float kInitialScale = 1024.0;
+constexpr float kGrowthFactor = 2.0;
+constexpr float kBackoffFactor = 0.5;
+constexpr std::size_t kGrowthInterval = 2;
+
+// Training setting for the accuracy parity between the float training and the mixed-precision training.
+constexpr std::size_t kHiddenSize = 10;
+constexpr std::size_t kMaxEpoch = 100;
+constexpr std::size_t kBatchSize = 30;
+constexpr float kSpiralLearningRate = 1.0;
+constexpr float kAccuracyTolerance = 0.1;
+constexpr int kSeed = 0;
+
+// Trains the MLP with the spiral dataset, and returns the accuracy of the test dataset.
+const float TrainSpiralAndTest(std::optional<LossScaler>& loss_scaler_opt) {
+  const DatasetSharedPtr train_dataset_ptr = AsDatasetSharedPtr<dataset::Spiral>(/* is_training_mode = */ true);
+  const DatasetSharedPtr test_dataset_ptr = AsDatasetSharedPtr<dataset::Spiral>(/* is_training_mode = */ false);
+  DataLoader train_data_loader(train_dataset_ptr, kBatchSize, /* does_shuffle_dataset = */ true);
+
+  xt::random::seed(kSeed);  // For the same initial parameters and the same shuffling.
+  model::MultiLayerPerceptron model({kHiddenSize, kOutSize}, AsFunctionSharedPtr<function::Sigmoid>());
+  optimizer::StochasticGradientDescent optimizer(kSpiralLearningRate);
+
+  for (std::size_t epoch = 0; epoch < kMaxEpoch; ++epoch) {
+    for (std::size_t i = 0; i < train_data_loader.max_iteration(); ++i) {
+      const auto [batch_x, batch_t] = train_data_loader.GetBatchAt(i);
+      const TensorSharedPtr batch_y_pred_ptr = model.Predict({AsTensorSharedPtr(batch_x)})[0];
+      const TensorSharedPtr batch_loss_ptr =
+          function::softmax_cross_entropy_error(batch_y_pred_ptr, AsTensorSharedPtr(batch_t));
+
+      model.ClearGrads();
+      if (loss_scaler_opt.has_value()) {
+        loss_scaler_opt->Backpropagation(batch_loss_ptr);
+        loss_scaler_opt->Step(optimizer, model.GetParamPtrs());
+      } else {
+        batch_loss_ptr->Backpropagation();
+        optimizer.Update(model.GetParamPtrs());
+      }
+    }
+  }
+
+  UseConfig with(Config::kDoesEnableBackpropagation, false);
+  const TensorSharedPtr y_pred_ptr = model.Predict({AsTensorSharedPtr(test_dataset_ptr->data())})[0];
+  return util::Accuracy(y_pred_ptr->data(), test_dataset_ptr->label());
+}
+
+}  // namespace
+
+class LossScalerTest : public ::testing::Test {
+ protected:
+  LossScalerTest()
+      : W_ptr_(AsParameterSharedPtr(xt::random::rand<float>({kInSize, kOutSize}))),
+        b_ptr_(AsParameterSharedPtr(xt::random::rand<float>({kOutSize}))),
+        parameter_ptrs_({W_ptr_, b_ptr_}),
+        loss_scaler_(kInitialScale, kGrowthFactor, kBackoffFactor, kGrowthInterval),
+        stochastic_gradient_descent_optimizer_(kLearningRate) {}
+
+  const ParameterSharedPtr W_ptr_;
+  const ParameterSharedPtr b_ptr_;
+  const std::vector<ParameterSharedPtr> parameter_ptrs_;
+  LossScaler loss_scaler_;
+  optimizer::StochasticGradientDescent stochastic_gradient_descent_optimizer_;
+};
+
+TEST_F(LossScalerTest, BackpropagationTest) {
+  const TensorSharedPtr loss_ptr = W_ptr_;
+  loss_scaler_.Backpropagation(loss_ptr);
+
+  // Checks that the backpropagation starts with the gradient `scale` (instead of 1).
+  const xt::xarray<float> expected_grad = kInitialScale * xt::ones_like(W_ptr_->data());
+  EXPECT_EQ(W_ptr_->grad(), expected_grad);
+}
+
+TEST_F(LossScalerTest, StepTest) {
+  std::vector<xt::xarray<float>> expected_parameter_datas;
+  for (const auto& parameter_ptr : parameter_ptrs_) {
+    // Sets a pseudo (scaled) gradient.
+    const xt::xarray<float> dL_dp = xt::ones_like(parameter_ptr->data());
+    parameter_ptr->SetGradOpt(xt::xarray<float>(kInitialScale * dL_dp));
+
+    // p <--- p - lr * dL_dp (with the unscaled gradient)
+    expected_parameter_datas.push_back(parameter_ptr->data() - kLearningRate * dL_dp);
+  }
+
+  EXPECT_TRUE(loss_scaler_.Step(stochastic_gradient_descent_optimizer_, parameter_ptrs_));
+
+  for (std::size_t i = 0; i < parameter_ptrs_.size(); ++i) {
+    EXPECT_EQ(parameter_ptrs_[i]->data(), expected_parameter_datas[i]);
+  }
+  EXPECT_EQ(loss_scaler_.scale(), kInitialScale);
+  EXPECT_EQ(loss_scaler_.num_skipped_steps(), 0);
+}
+
+TEST_F(LossScalerTest, SkipStepTest) {
+  const xt::xarray<float> old_W_data = W_ptr_->data();
+  xt::xarray<float> overflowed_grad = xt::ones_like(W_ptr_->data());
+  overflowed_grad(0, 0) = std::numeric_limits<float>::infinity();
+  W_ptr_->SetGradOpt(overflowed_grad);
+
+  EXPECT_FALSE(loss_scaler_.Step(stochastic_gradient_descent_optimizer_, parameter_ptrs_));
+
+  // Checks that the parameter is not updated, and the scale is backed off.
+  EXPECT_EQ(W_ptr_->data(), old_W_data);
+  EXPECT_EQ(loss_scaler_.scale(), kInitialScale * kBackoffFactor);
+  EXPECT_EQ(loss_scaler_.num_skipped_steps(), 1);
+}
+
+TEST_F(LossScalerTest, GrowScaleTest) {
+  for (std::size_t step = 0; step < kGrowthInterval; ++step) {
+    W_ptr_->SetGradOpt(xt::ones_like(W_ptr_->data()));
+    EXPECT_TRUE(loss_scaler_.Step(stochastic_gradient_descent_optimizer_, parameter_ptrs_));
+  }
+
+  // Checks that the scale grows after `kGrowthInterval` steps without overflow.
+  EXPECT_EQ(loss_scaler_.scale(), kInitialScale * kGrowthFactor);
+}
+
+TEST_F(LossScalerTest, UnscaleSparseGradTest) {
+  W_ptr_->AccumulateSparseGrad({1}, kInitialScale * xt::ones<float>({1, kOutSize}));
+
+  EXPECT_TRUE(loss_scaler_.UnscaleGrads(parameter_ptrs_));
+
+  const xt::xarray<float> expected_rows = xt::ones<float>({1, kOutSize});
+  EXPECT_EQ(W_ptr_->sparse_grad().rows, expected_rows);
+}
+
+TEST_F(LossScalerTest, MixedPrecisionAccuracyParityTest) {
+  std::optional<LossScaler> no_loss_scaler_opt = std::nullopt;
+  const float float_accuracy = TrainSpiralAndTest(no_loss_scaler_opt);
+
+  for (const auto config_key : {Config::kDoesUseBFloat16Storage, Config::kDoesUseFloat16Storage}) {
+    UseConfig with(config_key, true);
+    std::optional<LossScaler> loss_scaler_opt = LossScaler();
+    const float mixed_precision_accuracy = TrainSpiralAndTest(loss_scaler_opt);
+
+    // Checks that the mixed-precision training reaches (almost) the same accuracy as the float training.
+    EXPECT_NEAR(mixed_precision_accuracy, float_accuracy, kAccuracyTolerance) << config_key;
+  }
+}
+
+}  // namespace tensorward::core
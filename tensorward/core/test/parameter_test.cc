@@ -1,5 +1,7 @@
 #include "tensorward/core/parameter.h"
 
+#include <vector>
+
 #include <gtest/gtest.h>
 #include <xtensor/xrandom.hpp>
 
@@ -81,4 +83,78 @@ TEST_F(ParameterTest, AsParameterSharedPtr) {
   EXPECT_EQ(bar_parameter_ptr->generation(), 0);
 }
 
+TEST_F(ParameterTest, SparseGradTest) {
+  ASSERT_TRUE(!parameter_ptr_->sparse_grad_opt().has_value());
+  EXPECT_DEATH(parameter_ptr_->sparse_grad(), "");
+
+  // clang-format off
+  // Accumulates the gradient of the 2nd row twice, and of the 1st row once.
+  parameter_ptr_->AccumulateSparseGrad({1}, xt::xarray<float>({{1.0, 2.0, 3.0}}));
+  parameter_ptr_->AccumulateSparseGrad({0, 1}, xt::xarray<float>({{4.0, 5.0, 6.0},
+                                                                  {7.0, 8.0, 9.0}}));
+  const xt::xarray<float> expected_dense_grad({{4.0, 5.0, 6.0},
+                                               {8.0, 10.0, 12.0}});
+  // clang-format on
+
+  // Checks that the accumulated rows are appended (without summing up the duplicated rows).
+  ASSERT_TRUE(parameter_ptr_->sparse_grad_opt().has_value());
+  EXPECT_EQ(parameter_ptr_->sparse_grad().row_indices, std::vector<std::size_t>({1, 0, 1}));
+  EXPECT_EQ(parameter_ptr_->sparse_grad().rows.shape(0), 3);
+
+  // Checks that the coalesced gradient has the sorted unique rows whose duplicates are summed up.
+  const RowSparseGrad coalesced_sparse_grad = CoalesceRowSparseGrad(parameter_ptr_->sparse_grad());
+  EXPECT_EQ(coalesced_sparse_grad.row_indices, std::vector<std::size_t>({0, 1}));
+  EXPECT_EQ(coalesced_sparse_grad.rows, expected_dense_grad);
+
+  // Checks that the densified gradient is correct.
+  EXPECT_EQ(DensifyRowSparseGrad(parameter_ptr_->sparse_grad(), parameter_ptr_->data().shape()), expected_dense_grad);
+
+  // Checks that `ClearGrad()` clears the row-sparse gradient as well.
+  parameter_ptr_->ClearGrad();
+  EXPECT_TRUE(!parameter_ptr_->sparse_grad_opt().has_value());
+}
+
+TEST_F(ParameterTest, GradReadyHookTest) {
+  const ParameterSharedPtr unused_parameter_ptr = AsParameterSharedPtr(xt::random::rand<float>({kHeight, kWidth}));
+  std::vector<xt::xarray<float>> ready_grads;
+  const Parameter::GradReadyHook grad_ready_hook = [&ready_grads](Parameter& parameter) {
+    ready_grads.push_back(parameter.grad());
+  };
+  parameter_ptr_->RegisterGradReadyHook(grad_ready_hook);
+  unused_parameter_ptr->RegisterGradReadyHook(grad_ready_hook);
+  ASSERT_TRUE(parameter_ptr_->has_grad_ready_hooks());
+
+  // The parameter is used twice, so its hook is called only once after both of the uses have been backpropagated.
+  const TensorSharedPtr y_ptr = tensor_ptr_ * parameter_ptr_ + parameter_ptr_;
+  y_ptr->Backpropagation();
+  ASSERT_EQ(ready_grads.size(), 1);
+  EXPECT_EQ(ready_grads[0], xt::xarray<float>(tensor_ptr_->data() + 1.0));
+  EXPECT_EQ(ready_grads[0], parameter_ptr_->grad());
+
+  // The hook is called again for each backpropagation, and no more after it's cleared.
+  parameter_ptr_->ClearGrad();
+  (parameter_ptr_ * tensor_ptr_)->Backpropagation();
+  EXPECT_EQ(ready_grads.size(), 2);
+
+  // Removing a hook by its handle keeps the other hooks.
+  std::size_t num_other_hook_calls = 0;
+  const Parameter::GradReadyHookId other_hook_id =
+      parameter_ptr_->RegisterGradReadyHook([&num_other_hook_calls](Parameter&) { ++num_other_hook_calls; });
+  parameter_ptr_->ClearGrad();
+  (parameter_ptr_ * tensor_ptr_)->Backpropagation();
+  EXPECT_EQ(ready_grads.size(), 3);
+  EXPECT_EQ(num_other_hook_calls, 1);
+  parameter_ptr_->RemoveGradReadyHook(other_hook_id);
+  ASSERT_TRUE(parameter_ptr_->has_grad_ready_hooks());
+  parameter_ptr_->ClearGrad();
+  (parameter_ptr_ * tensor_ptr_)->Backpropagation();
+  EXPECT_EQ(ready_grads.size(), 4);
+  EXPECT_EQ(num_other_hook_calls, 1);
+
+  parameter_ptr_->ClearGradReadyHooks();
+  EXPECT_FALSE(parameter_ptr_->has_grad_ready_hooks());
+  (parameter_ptr_ * tensor_ptr_)->Backpropagation();
+  EXPECT_EQ(ready_grads.size(), 4);
+}
+
 }  // namespace tensorward::core
@@ -0,0 +1,158 @@
+#include "tensorward/core/record_dataset.h"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <xtensor/xarray.hpp>
+#include <xtensor/xrandom.hpp>
+#include <xtensor/xview.hpp>
+
+#include "tensorward/core/data_loader.h"
+
+namespace tensorward::core {
+
+namespace {
+
+constexpr std::size_t kNumRecordFiles = 2;
+constexpr std::size_t kNumRecordsPerFile = 6;
+constexpr std::size_t kWidth = 3;
+constexpr std::size_t kBatchSize = 4;
+constexpr std::size_t kNumThreads = 4;
+constexpr bool kIsTrainingMode = true;
+
+}  // namespace
+
+class RecordDatasetTest : public ::testing::Test {
+ protected:
+  RecordDatasetTest()
+      : directory_path_(std::filesystem::temp_directory_path() /
+                        ("tensorward_" + std::to_string(getpid()) + "_" +
+                         ::testing::UnitTest::GetInstance()->current_test_info()->name())) {
+    std::filesystem::create_directories(directory_path_);
+
+    // Writes the records of the different heights (i.e. the variable shapes), labeled by their indices.
+    for (std::size_t f = 0; f < kNumRecordFiles; ++f) {
+      record_file_paths_.push_back(directory_path_ / ("record" + std::to_string(f) + ".twrec"));
+      RecordFileWriter writer(record_file_paths_.back());
+      for (std::size_t i = 0; i < kNumRecordsPerFile; ++i) {
+        const std::size_t index = f * kNumRecordsPerFile + i;
+        datas_.push_back(xt::random::randn<float>({i + 1, kWidth}));
+        EXPECT_TRUE(writer.Write(datas_.back(), xt::xarray<float>(static_cast<float>(index))));
+      }
+      EXPECT_EQ(writer.num_records(), kNumRecordsPerFile);
+      EXPECT_TRUE(writer.Close());
+    }
+  }
+
+  ~RecordDatasetTest() { std::filesystem::remove_all(directory_path_); }
+
+  const std::filesystem::path directory_path_;
+  std::vector<std::filesystem::path> record_file_paths_;
+  std::vector<xt::xarray<float>> datas_;
+};
+
+TEST_F(RecordDatasetTest, AtTest) {
+  const RecordDataset dataset(kIsTrainingMode, {}, {}, "Record", record_file_paths_, true);
+  ASSERT_TRUE(dataset.is_valid());
+  EXPECT_EQ(dataset.size(), kNumRecordFiles * kNumRecordsPerFile);
+  EXPECT_EQ(dataset.num_record_files(), kNumRecordFiles);
+
+  // Checks the records in the reverse order (i.e. at random, not in the order of the files).
+  for (std::size_t i = dataset.size(); 0 < i--;) {
+    const auto [actual_data, actual_label] = dataset.at(i);
+    EXPECT_EQ(actual_data, datas_[i]);
+    EXPECT_EQ(actual_label, xt::xarray<float>(static_cast<float>(i)));
+  }
+}
+
+TEST_F(RecordDatasetTest, ConcurrentAtTest) {
+  const RecordDataset dataset(kIsTrainingMode, {}, {}, "Record", record_file_paths_);
+  ASSERT_TRUE(dataset.is_valid());
+
+  // Reads all of the records from each thread at the same time.
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([this, &dataset] {
+      for (std::size_t i = 0; i < dataset.size(); ++i) {
+        ASSERT_EQ(dataset.at(i).first, datas_[i]);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+TEST_F(RecordDatasetTest, DataLoaderTest) {
+  // Uses the records of the same shape.
+  const std::filesystem::path record_file_path = directory_path_ / "same_shape.twrec";
+  const xt::xarray<float> data = xt::random::randn<float>({kNumRecordFiles * kNumRecordsPerFile, kWidth});
+  {
+    RecordFileWriter writer(record_file_path);
+    for (std::size_t i = 0; i < data.shape(0); ++i) {
+      writer.Write(xt::view(data, i), xt::xarray<float>(static_cast<float>(i)));
+    }
+  }
+
+  const DatasetSharedPtr dataset_ptr = std::make_shared<RecordDataset>(
+      kIsTrainingMode, std::vector<TransformLambda>(), std::vector<TransformLambda>(), "Record",
+      std::vector<std::filesystem::path>({record_file_path}));
+  DataLoader data_loader(dataset_ptr, kBatchSize, true);
+
+  for (std::size_t i = 0; i < data_loader.max_iteration(); ++i) {
+    const auto [batch_data, batch_label] = data_loader.GetBatchAt(i);
+    for (std::size_t n = 0; n < kBatchSize; ++n) {
+      const std::size_t index = static_cast<std::size_t>(batch_label(n));
+      EXPECT_EQ(xt::xarray<float>(xt::view(batch_data, n)), xt::xarray<float>(xt::view(data, index)));
+    }
+  }
+}
+
+TEST_F(RecordDatasetTest, BrokenRecordFileTest) {
+  // Corrupts a byte of the records, which is detected only by the checksum.
+  {
+    std::fstream fs(record_file_paths_[1], std::ios::in | std::ios::out | std::ios::binary);
+    fs.seekp(kRecordFileHeaderSize + 1);
+    fs.put('\x7f');
+  }
+  const RecordDataset unverified_dataset(kIsTrainingMode, {}, {}, "Record", record_file_paths_);
+  EXPECT_TRUE(unverified_dataset.is_valid());
+  EXPECT_FALSE(unverified_dataset.VerifyChecksums());
+  const RecordDataset verified_dataset(kIsTrainingMode, {}, {}, "Record", record_file_paths_, true);
+  EXPECT_FALSE(verified_dataset.is_valid());
+  EXPECT_EQ(verified_dataset.size(), 0);
+
+  // Truncates the index.
+  std::filesystem::resize_file(record_file_paths_[0], std::filesystem::file_size(record_file_paths_[0]) - 1);
+  const RecordDataset truncated_dataset(kIsTrainingMode, {}, {}, "Record", record_file_paths_);
+  EXPECT_FALSE(truncated_dataset.is_valid());
+  EXPECT_EQ(truncated_dataset.size(), 0);
+
+  // Writes the header of the max number of the records without the index, whose size (number of the records + 1)
+  // wraps around to 0.
+  {
+    std::string header(kRecordFileHeaderSize, '\0');
+    const std::uint32_t version = kRecordFileVersion;
+    const std::uint64_t num_records = std::numeric_limits<std::uint64_t>::max();
+    const std::uint64_t index_offset = kRecordFileHeaderSize;
+    std::memcpy(header.data(), kRecordFileMagic, sizeof(kRecordFileMagic));
+    std::memcpy(header.data() + 8, &version, sizeof(version));
+    std::memcpy(header.data() + 16, &num_records, sizeof(num_records));
+    std::memcpy(header.data() + 24, &index_offset, sizeof(index_offset));
+    std::ofstream(record_file_paths_[0], std::ios::binary | std::ios::trunc) << header;
+  }
+  const RecordDataset overflowed_dataset(kIsTrainingMode, {}, {}, "Record", {record_file_paths_[0]});
+  EXPECT_FALSE(overflowed_dataset.is_valid());
+  EXPECT_EQ(overflowed_dataset.size(), 0);
+}
+
+}  // namespace tensorward::core
@@ -0,0 +1,149 @@
+#include "tensorward/core/sampler.h"
+
+#include <algorithm>
+#include <numeric>
+#include <set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace tensorward::core {
+
+namespace {
+
+constexpr std::size_t kDatasetSize = 100;
+constexpr std::size_t kDecimatingScale = 3;
+constexpr std::size_t kBatchSize = 8;
+constexpr std::size_t kNumReplicas = 3;
+constexpr std::uint64_t kSeed = 1234;
+
+// Returns {0, 1, ..., size - 1}.
+const std::vector<std::size_t> Iota(const std::size_t size) {
+  std::vector<std::size_t> indices(size);
+  std::iota(indices.begin(), indices.end(), 0);
+  return indices;
+}
+
+// Returns the indices sorted.
+const std::vector<std::size_t> Sorted(std::vector<std::size_t> indices) {
+  std::sort(indices.begin(), indices.end());
+  return indices;
+}
+
+}  // namespace
+
+class SamplerTest : public ::testing::Test {};
+
+TEST_F(SamplerTest, SequentialSamplerTest) {
+  SequentialSampler sampler(kDatasetSize, kDecimatingScale);
+  ASSERT_EQ(sampler.size(), kDatasetSize / kDecimatingScale);
+  for (std::size_t i = 0; i < sampler.size(); ++i) {
+    EXPECT_EQ(sampler.indices()[i], kDecimatingScale * i);
+  }
+
+  // 33 indices are 4 full batches of 8 indices and a partial batch of 1 index.
+  const std::span<const std::size_t> batch_indices = sampler.BatchIndicesAt(1, kBatchSize);
+  EXPECT_EQ(std::vector<std::size_t>(batch_indices.begin(), batch_indices.end()),
+            std::vector<std::size_t>(sampler.indices().begin() + kBatchSize,
+                                     sampler.indices().begin() + 2 * kBatchSize));
+  EXPECT_EQ(sampler.BatchIndicesAt(4, kBatchSize).size(), 1);
+  EXPECT_EQ(sampler.BatchIndicesAt(5, kBatchSize).size(), 0);
+}
+
+TEST_F(SamplerTest, RandomSamplerTest) {
+  RandomSampler sampler(kDatasetSize, kSeed);
+  const std::vector<std::size_t> indices = sampler.indices();
+  const std::size_t* indices_data = sampler.indices().data();
+  EXPECT_NE(indices, Iota(kDatasetSize));
+  EXPECT_EQ(Sorted(indices), Iota(kDatasetSize));
+
+  // Reshuffles in place.
+  sampler.Init();
+  EXPECT_NE(sampler.indices(), indices);
+  EXPECT_EQ(Sorted(sampler.indices()), Iota(kDatasetSize));
+  EXPECT_EQ(sampler.indices().data(), indices_data);
+
+  // The same seed gives the same order.
+  EXPECT_EQ(RandomSampler(kDatasetSize, kSeed).indices(), indices);
+}
+
+TEST_F(SamplerTest, WeightedRandomSamplerTest) {
+  // The index 1 is 3 times as likely as the index 2, and the index 0 is never sampled.
+  const std::vector<float> weights({0.0, 3.0, 1.0});
+  const std::size_t num_samples = 10000;
+  WeightedRandomSampler sampler(weights, num_samples, kSeed);
+  ASSERT_EQ(sampler.size(), num_samples);
+
+  std::vector<std::size_t> counts(weights.size(), 0);
+  for (const std::size_t index : sampler.indices()) {
+    ASSERT_LT(index, weights.size());
+    ++counts[index];
+  }
+  EXPECT_EQ(counts[0], 0);
+  EXPECT_NEAR(static_cast<double>(counts[1]) / num_samples, 0.75, 0.02);
+}
+
+TEST_F(SamplerTest, StratifiedSamplerTest) {
+  // Imbalanced classes: 60% of the class 0, 30% of the class 1, and 10% of the class 2.
+  std::vector<std::size_t> class_indices(kDatasetSize);
+  for (std::size_t i = 0; i < kDatasetSize; ++i) {
+    class_indices[i] = (i % 10 < 6) ? 0 : ((i % 10 < 9) ? 1 : 2);
+  }
+  StratifiedSampler sampler(class_indices, kSeed);
+
+  for (std::size_t epoch = 0; epoch < 2; ++epoch) {
+    EXPECT_EQ(Sorted(sampler.indices()), Iota(kDatasetSize));
+
+    // Each batch of 10 indices has exactly the same proportion of the classes as the whole dataset.
+    for (std::size_t i = 0; i < kDatasetSize / 10; ++i) {
+      std::vector<std::size_t> counts(3, 0);
+      for (const std::size_t index : sampler.BatchIndicesAt(i, 10)) {
+        ++counts[class_indices[index]];
+      }
+      EXPECT_EQ(counts, std::vector<std::size_t>({6, 3, 1}));
+    }
+    sampler.Init();
+  }
+}
+
+TEST_F(SamplerTest, DistributedSamplerTest) {
+  for (const bool does_shuffle : {false, true}) {
+    std::vector<DistributedSampler> samplers;
+    for (std::size_t rank = 0; rank < kNumReplicas; ++rank) {
+      samplers.emplace_back(kDatasetSize, kNumReplicas, rank, does_shuffle, kSeed);
+    }
+
+    for (std::size_t epoch = 0; epoch < 2; ++epoch) {
+      // The shards of all of the replicas cover the whole dataset, and are of the same size (where 2 indices are
+      // wrapped around).
+      std::multiset<std::size_t> all_indices;
+      for (const DistributedSampler& sampler : samplers) {
+        EXPECT_EQ(sampler.size(), (kDatasetSize + kNumReplicas - 1) / kNumReplicas);
+        all_indices.insert(sampler.indices().begin(), sampler.indices().end());
+      }
+      EXPECT_EQ(std::set<std::size_t>(all_indices.begin(), all_indices.end()).size(), kDatasetSize);
+      EXPECT_EQ(all_indices.size(), kDatasetSize + 2);
+
+      for (DistributedSampler& sampler : samplers) {
+        sampler.Init();
+      }
+    }
+  }
+}
+
+TEST_F(SamplerTest, DistributedSamplerEpochTest) {
+  DistributedSampler sampler(kDatasetSize, kNumReplicas, 1, true, kSeed);
+  const std::vector<std::size_t> first_epoch_indices = sampler.indices();
+  sampler.Init();
+  sampler.Init();
+  EXPECT_EQ(sampler.epoch(), 2);
+
+  // A new replica (e.g. restarted) jumps to the same epoch, and agrees on the indices.
+  DistributedSampler restarted_sampler(kDatasetSize, kNumReplicas, 1, true, kSeed);
+  EXPECT_EQ(restarted_sampler.indices(), first_epoch_indices);
+  restarted_sampler.SetEpoch(2);
+  EXPECT_EQ(restarted_sampler.indices(), sampler.indices());
+  EXPECT_NE(restarted_sampler.indices(), first_epoch_indices);
+}
+
+}  // namespace tensorward::core
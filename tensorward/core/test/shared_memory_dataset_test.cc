@@ -0,0 +1,100 @@
+#include "tensorward/core/shared_memory_dataset.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <xtensor/xrandom.hpp>
+#include <xtensor/xview.hpp>
+
+namespace tensorward::core {
+
+namespace {
+
+constexpr std::size_t kNumSamples = 10;
+constexpr std::size_t kHeight = 2;
+constexpr std::size_t kWidth = 3;
+constexpr bool kIsTrainingMode = true;
+constexpr std::chrono::milliseconds kShortTimeout(100);
+
+}  // namespace
+
+class SharedMemoryDatasetTest : public ::testing::Test {
+ protected:
+  SharedMemoryDatasetTest()
+      : shared_memory_name_("/tensorward_" + std::to_string(getpid()) + "_" +
+                            ::testing::UnitTest::GetInstance()->current_test_info()->name()),
+        data_(xt::random::randn<float>({kNumSamples, kHeight, kWidth})),
+        label_(xt::arange<float>(kNumSamples)) {}
+
+  ~SharedMemoryDatasetTest() { RemoveSharedMemoryDataset(shared_memory_name_); }
+
+  // Checks that each sample of the dataset is the same as the original one (transformed by the lambda to half).
+  void CheckSamples(const SharedMemoryDataset& dataset) const {
+    ASSERT_TRUE(dataset.is_valid());
+    ASSERT_EQ(dataset.size(), kNumSamples);
+    for (std::size_t i = 0; i < kNumSamples; ++i) {
+      const auto [data, label] = dataset.at(i);
+      EXPECT_EQ(data, xt::xarray<float>(xt::view(data_, i) / 2.0));
+      EXPECT_EQ(label, xt::xarray<float>(xt::view(label_, i)));
+    }
+  }
+
+  const std::string shared_memory_name_;
+  const xt::xarray<float> data_;
+  const xt::xarray<float> label_;
+  const TransformLambda transform_to_half_lambda_ = [](const xt::xarray<float>& input_data) {
+    return xt::xarray<float>(input_data / 2.0);
+  };
+};
+
+TEST_F(SharedMemoryDatasetTest, AtTest) {
+  ASSERT_TRUE(WriteSharedMemoryDataset(shared_memory_name_, data_, label_));
+
+  // Two datasets share the same object.
+  const SharedMemoryDataset dataset(kIsTrainingMode, {transform_to_half_lambda_}, {}, "SharedMemory",
+                                    shared_memory_name_);
+  const SharedMemoryDataset other_dataset(kIsTrainingMode, {transform_to_half_lambda_}, {}, "SharedMemory",
+                                          shared_memory_name_);
+  CheckSamples(dataset);
+  CheckSamples(other_dataset);
+
+  // The mapped object can be still used after it's removed.
+  EXPECT_TRUE(RemoveSharedMemoryDataset(shared_memory_name_));
+  EXPECT_FALSE(RemoveSharedMemoryDataset(shared_memory_name_));
+  CheckSamples(dataset);
+}
+
+TEST_F(SharedMemoryDatasetTest, MultiProcessTest) {
+  // The child process waits for the object written by the parent process after forking.
+  const pid_t pid = fork();
+  ASSERT_LE(0, pid);
+  if (pid == 0) {
+    const SharedMemoryDataset dataset(kIsTrainingMode, {transform_to_half_lambda_}, {}, "SharedMemory",
+                                      shared_memory_name_);
+    const bool is_same = dataset.is_valid() && dataset.size() == kNumSamples &&
+                         dataset.at(kNumSamples - 1).first == xt::xarray<float>(xt::view(data_, kNumSamples - 1) / 2.0);
+    _exit(is_same ? EXIT_SUCCESS : EXIT_FAILURE);
+  }
+
+  std::this_thread::sleep_for(kShortTimeout);
+  ASSERT_TRUE(WriteSharedMemoryDataset(shared_memory_name_, data_, label_));
+  int status;
+  ASSERT_EQ(waitpid(pid, &status, 0), pid);
+  EXPECT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(WEXITSTATUS(status), EXIT_SUCCESS);
+}
+
+TEST_F(SharedMemoryDatasetTest, TimeoutTest) {
+  const auto start = std::chrono::steady_clock::now();
+  const SharedMemoryDataset dataset(kIsTrainingMode, {}, {}, "SharedMemory", shared_memory_name_, kShortTimeout);
+  EXPECT_LE(kShortTimeout, std::chrono::steady_clock::now() - start);
+  EXPECT_FALSE(dataset.is_valid());
+  EXPECT_EQ(dataset.size(), 0);
+}
+
+}  // namespace tensorward::core
@@ -0,0 +1,154 @@
+#include "tensorward/core/streaming_dataset.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <xtensor/xarray.hpp>
+#include <xtensor/xrandom.hpp>
+#include <xtensor/xview.hpp>
+
+#include "tensorward/core/data_loader.h"
+
+namespace tensorward::core {
+
+namespace {
+
+constexpr std::size_t kNumShards = 3;
+constexpr std::size_t kHeight = 2;
+constexpr std::size_t kWidth = 3;
+constexpr std::size_t kChunkSize = 4;
+constexpr std::size_t kShuffleBufferSize = 2;
+constexpr std::size_t kBatchSize = 2;
+constexpr bool kIsTrainingMode = true;
+
+}  // namespace
+
+class StreamingDatasetTest : public ::testing::Test {
+ protected:
+  StreamingDatasetTest()
+      : shard_sizes_({10, 7, 5}),
+        directory_path_(std::filesystem::temp_directory_path() /
+                        ("tensorward_" + std::to_string(getpid()) + "_" +
+                         ::testing::UnitTest::GetInstance()->current_test_info()->name())) {
+    std::filesystem::create_directories(directory_path_);
+
+    // Labels each record by its index over all of the shards.
+    std::size_t first_index = 0;
+    for (std::size_t s = 0; s < kNumShards; ++s) {
+      const xt::xarray<float> data = xt::random::randn<float>({shard_sizes_[s], kHeight, kWidth});
+      const xt::xarray<float> label = xt::arange<float>(first_index, first_index + shard_sizes_[s]);
+      shard_file_paths_.push_back(directory_path_ / ("shard" + std::to_string(s)));
+      EXPECT_TRUE(WriteStreamingShard(shard_file_paths_.back(), data, label));
+      datas_.push_back(data);
+      first_index += shard_sizes_[s];
+    }
+  }
+
+  ~StreamingDatasetTest() { std::filesystem::remove_all(directory_path_); }
+
+  const std::size_t num_records() const { return datas_[0].shape(0) + datas_[1].shape(0) + datas_[2].shape(0); }
+
+  // Returns the data of the record of the index over all of the shards.
+  const xt::xarray<float> ExpectedData(std::size_t index) const {
+    std::size_t s = 0;
+    while (datas_[s].shape(0) <= index) {
+      index -= datas_[s].shape(0);
+      ++s;
+    }
+    return xt::view(datas_[s], index);
+  }
+
+  // Iterates the dataset once, checks each record, and returns the indices of the records in the order.
+  const std::vector<std::size_t> Iterate(const StreamingDataset& dataset) const {
+    std::vector<std::size_t> indices;
+    for (std::size_t i = 0; i < dataset.size(); ++i) {
+      const auto [data, label] = dataset.at(i);
+      const std::size_t index = static_cast<std::size_t>(label());
+      EXPECT_EQ(data, ExpectedData(index));
+      indices.push_back(index);
+    }
+    return indices;
+  }
+
+  const std::vector<std::size_t> shard_sizes_;
+  const std::filesystem::path directory_path_;
+  std::vector<std::filesystem::path> shard_file_paths_;
+  std::vector<xt::xarray<float>> datas_;
+};
+
+TEST_F(StreamingDatasetTest, SequentialTest) {
+  const StreamingDataset dataset(kIsTrainingMode, {}, {}, "Streaming", shard_file_paths_, {.chunk_size = kChunkSize});
+  ASSERT_TRUE(dataset.is_valid());
+  EXPECT_EQ(dataset.size(), num_records());
+  EXPECT_EQ(dataset.num_shards(), kNumShards);
+  EXPECT_EQ(dataset.num_chunks(), 3 + 2 + 2);
+  EXPECT_EQ(dataset.data_shape(), xt::xarray<float>::shape_type({kHeight, kWidth}));
+  EXPECT_EQ(dataset.label_shape(), xt::xarray<float>::shape_type({}));
+
+  // Checks that the records are in the order of the shards, and each chunk is read only once.
+  const std::vector<std::size_t> actual_indices = Iterate(dataset);
+  std::vector<std::size_t> expected_indices(num_records());
+  std::iota(expected_indices.begin(), expected_indices.end(), 0);
+  EXPECT_EQ(actual_indices, expected_indices);
+  EXPECT_EQ(dataset.num_read_chunks(), dataset.num_chunks());
+}
+
+TEST_F(StreamingDatasetTest, ShuffleTest) {
+  for (const bool does_use_direct_io : {false, true}) {
+    StreamingDataset dataset(kIsTrainingMode, {}, {}, "Streaming", shard_file_paths_,
+                             {.chunk_size = kChunkSize,
+                              .shuffle_buffer_size = kShuffleBufferSize,
+                              .max_num_cached_chunks = kShuffleBufferSize,
+                              .does_use_direct_io = does_use_direct_io});
+    ASSERT_TRUE(dataset.is_valid());
+
+    // Checks that each epoch is a permutation of all of the records, and each chunk is read only once per epoch.
+    const std::vector<std::size_t> first_epoch_indices = Iterate(dataset);
+    std::vector<std::size_t> sorted_indices = first_epoch_indices;
+    std::sort(sorted_indices.begin(), sorted_indices.end());
+    std::vector<std::size_t> expected_indices(num_records());
+    std::iota(expected_indices.begin(), expected_indices.end(), 0);
+    EXPECT_EQ(sorted_indices, expected_indices);
+    EXPECT_NE(first_epoch_indices, expected_indices);
+    EXPECT_EQ(dataset.num_read_chunks(), dataset.num_chunks());
+
+    // Checks that the next epoch is shuffled differently.
+    dataset.Shuffle();
+    const std::vector<std::size_t> second_epoch_indices = Iterate(dataset);
+    EXPECT_NE(second_epoch_indices, first_epoch_indices);
+    EXPECT_EQ(dataset.num_read_chunks(), 2 * dataset.num_chunks());
+  }
+}
+
+TEST_F(StreamingDatasetTest, DataLoaderTest) {
+  const DatasetSharedPtr dataset_ptr = std::make_shared<StreamingDataset>(
+      kIsTrainingMode, std::vector<TransformLambda>({[](const xt::xarray<float>& data) { return data / 2.0; }}),
+      std::vector<TransformLambda>(), "Streaming", shard_file_paths_,
+      StreamingDataset::NamedArg({.chunk_size = kChunkSize, .shuffle_buffer_size = kShuffleBufferSize}));
+  DataLoader data_loader(dataset_ptr, kBatchSize, false);
+
+  for (std::size_t i = 0; i < data_loader.max_iteration(); ++i) {
+    const auto [batch_data, batch_label] = data_loader.GetBatchAt(i);
+    ASSERT_EQ(batch_data.shape(), xt::xarray<float>::shape_type({kBatchSize, kHeight, kWidth}));
+    for (std::size_t n = 0; n < kBatchSize; ++n) {
+      const std::size_t index = static_cast<std::size_t>(batch_label(n));
+      EXPECT_EQ(xt::xarray<float>(xt::view(batch_data, n)), xt::xarray<float>(ExpectedData(index) / 2.0));
+    }
+  }
+}
+
+TEST_F(StreamingDatasetTest, BrokenShardTest) {
+  // Truncates the records of a shard.
+  std::filesystem::resize_file(shard_file_paths_[1], kStreamingShardHeaderSize + 1);
+  const StreamingDataset dataset(kIsTrainingMode, {}, {}, "Streaming", shard_file_paths_, {.chunk_size = kChunkSize});
+  EXPECT_FALSE(dataset.is_valid());
+  EXPECT_EQ(dataset.size(), 0);
+}
+
+}  // namespace tensorward::core
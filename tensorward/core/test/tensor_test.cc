@@ -147,4 +147,46 @@ TEST_F(TensorTest, AsTensorSharedPtrTest) {
   EXPECT_EQ(bar_tensor_ptr->generation(), 0);
 }
 
+TEST_F(TensorTest, SharedDataTest) {
+  const TensorSharedPtr foo_tensor_ptr = AsTensorSharedPtr(xt::random::rand<float>({kHeight, kWidth}));
+  const TensorSharedPtr bar_tensor_ptr = std::make_shared<Tensor>(foo_tensor_ptr->data_ptr());
+
+  // Checks that the tensor constructed from the data storage shares it without copying the data.
+  EXPECT_EQ(bar_tensor_ptr->data_ptr(), foo_tensor_ptr->data_ptr());
+  EXPECT_EQ(bar_tensor_ptr->data().data(), foo_tensor_ptr->data().data());
+
+  // Checks that updating the data doesn't overwrite the shared data storage (copy-on-write), so that the other tensor
+  // still sees the old data.
+  const xt::xarray<float> old_data = foo_tensor_ptr->data();
+  const std::size_t old_version = foo_tensor_ptr->version();
+  foo_tensor_ptr->SeData(foo_tensor_ptr->data() + 1.0);
+  EXPECT_NE(bar_tensor_ptr->data_ptr(), foo_tensor_ptr->data_ptr());
+  EXPECT_EQ(bar_tensor_ptr->data(), old_data);
+  EXPECT_EQ(foo_tensor_ptr->data(), old_data + 1.0);
+  EXPECT_EQ(foo_tensor_ptr->version(), old_version + 1);
+  EXPECT_EQ(bar_tensor_ptr->version(), 0);
+}
+
+TEST_F(TensorTest, MutableDataTest) {
+  const TensorSharedPtr foo_tensor_ptr = AsTensorSharedPtr(xt::random::rand<float>({kHeight, kWidth}));
+  const xt::xarray<float> old_data = foo_tensor_ptr->data();
+
+  // Checks that the data storage is updated in place if it's not shared.
+  const float* old_data_pointer = foo_tensor_ptr->data().data();
+  foo_tensor_ptr->MutableData()(0, 0) += 1.0;
+  EXPECT_EQ(foo_tensor_ptr->data().data(), old_data_pointer);
+  EXPECT_EQ(foo_tensor_ptr->data()(0, 0), old_data(0, 0) + 1.0);
+  EXPECT_EQ(foo_tensor_ptr->version(), 1);
+
+  // Checks that the data storage is copied first if it's shared (copy-on-write), so that the other tensor still sees
+  // the data before the update.
+  const TensorSharedPtr bar_tensor_ptr = std::make_shared<Tensor>(foo_tensor_ptr->data_ptr());
+  const xt::xarray<float> shared_data = bar_tensor_ptr->data();
+  foo_tensor_ptr->MutableData()(0, 0) += 1.0;
+  EXPECT_NE(foo_tensor_ptr->data_ptr(), bar_tensor_ptr->data_ptr());
+  EXPECT_EQ(bar_tensor_ptr->data(), shared_data);
+  EXPECT_EQ(foo_tensor_ptr->data()(0, 0), shared_data(0, 0) + 1.0);
+  EXPECT_EQ(foo_tensor_ptr->version(), 2);
+}
+
 }  // namespace tensorward::core
@@ -3,19 +3,19 @@
 #include <cassert>
 #include <cstddef>
 #include <filesystem>
-#include <fstream>
+#include <future>
 #include <iostream>
 #include <string>
 #include <vector>
 
 #include <curl/curl.h>
-#include <gzip/decompress.hpp>
-#include <gzip/utils.hpp>
 #include <xtensor/xarray.hpp>
+#include <xtensor/xbuilder.hpp>
 #include <xtensor/xio.hpp>
 #include <xtensor/xview.hpp>
 
 #include "tensorward/core/dataset.h"
+#include "tensorward/util/idx_file.h"
 
 namespace tensorward::dataset {
 
@@ -55,71 +55,26 @@ void DownloadFileFromURLToPath(const char* input_url, const char* output_file_pa
   std::cout << std::endl << std::endl;
 }
 
-std::stringstream DecompressFile(const std::filesystem::path& file_path) {
-  const std::size_t file_size = std::filesystem::file_size(file_path);
-  char* file_pointer = new char[file_size];
-
-  std::ifstream ifs(file_path, std::ios::in | std::ios::binary);
-  ifs.read(file_pointer, file_size);
-  ifs.close();
-
-  assert(gzip::is_compressed(file_pointer, file_size));
-  const std::string decompressed_data = gzip::decompress(file_pointer, file_size);
-  delete[] file_pointer;
-
-  return std::stringstream(decompressed_data);
-}
-
-int ReverseEndian(const int integer) {
-  const std::byte byte0 = static_cast<std::byte>((integer >> 0) & 255);
-  const std::byte byte1 = static_cast<std::byte>((integer >> 8) & 255);
-  const std::byte byte2 = static_cast<std::byte>((integer >> 16) & 255);
-  const std::byte byte3 = static_cast<std::byte>((integer >> 24) & 255);
-
-  const int reversed_integer = (static_cast<int>(byte0) << 24) + (static_cast<int>(byte1) << 16) +
-                               (static_cast<int>(byte2) << 8) + (static_cast<int>(byte3) << 0);
-
-  return reversed_integer;
-}
-
 xt::xarray<float> ReadDataFile(const std::filesystem::path& data_file_path, const bool is_verbose = false) {
-  std::stringstream ss = DecompressFile(data_file_path);
+  util::IdxFile idx_file;
+  const bool is_read = util::ReadIdxFile(data_file_path, idx_file);
+  assert((static_cast<void>("Failed to read the data file."), is_read));
+  assert(idx_file.data_type == util::IdxDataType::kUnsignedByte);
+  assert(idx_file.shape.size() == 3);  // {N, H, W}
 
-  int magic_number;
-  ss.read((char*)&magic_number, sizeof(magic_number));
-  magic_number = ReverseEndian(magic_number);
-
-  int data_size;
-  ss.read((char*)&data_size, sizeof(data_size));
-  data_size = ReverseEndian(data_size);
-
-  const int channel = 1;  // Because each image is gray-scale.
-
-  int height;
-  ss.read((char*)&height, sizeof(height));
-  height = ReverseEndian(height);
-
-  int width;
-  ss.read((char*)&width, sizeof(width));
-  width = ReverseEndian(width);
+  const std::size_t data_size = idx_file.shape[0];
+  const std::size_t channel = 1;  // Because each image is gray-scale.
+  const std::size_t height = idx_file.shape[1];
+  const std::size_t width = idx_file.shape[2];
 
   if (is_verbose) {
-    std::cout << "[ReadDataFile()] magic_number = " << magic_number << ", data_size = " << data_size
-              << ", height = " << height << ", width = " << width << std::endl;
+    std::cout << "[ReadDataFile()] data_size = " << data_size << ", height = " << height << ", width = " << width
+              << std::endl;
   }
 
-  xt::xarray<float> data = xt::zeros<float>({data_size, channel, height, width});
-  for (std::size_t i = 0; i < data_size; ++i) {
-    xt::xarray<float> ith_data = xt::zeros<float>({channel, height, width});
-    for (std::size_t h = 0; h < height; ++h) {
-      for (std::size_t w = 0; w < width; ++w) {
-        std::byte one_byte;
-        ss.read((char*)&one_byte, sizeof(one_byte));
-        ith_data(h, w) = static_cast<float>(one_byte);
-      }
-    }
-    xt::view(data, i) = ith_data;
-  }
+  // Converts the pixels (which are read into the uint8 buffer at once) into float in a single pass.
+  xt::xarray<float> data = xt::empty<float>({data_size, channel, height, width});
+  util::ConvertIdxFileToFloat(idx_file, 0, idx_file.size, data.data());
 
   assert(data.dimension() == 4);  // {N, C, H, W}
   assert(data.shape(0) == data_size);
@@ -131,26 +86,19 @@ xt::xarray<float> ReadDataFile(const std::filesystem::path& data_file_path, cons
 }
 
 xt::xarray<float> ReadLabelFile(const std::filesystem::path& label_file_path, const bool is_verbose = false) {
-  std::stringstream ss = DecompressFile(label_file_path);
+  util::IdxFile idx_file;
+  const bool is_read = util::ReadIdxFile(label_file_path, idx_file);
+  assert((static_cast<void>("Failed to read the label file."), is_read));
+  assert(idx_file.data_type == util::IdxDataType::kUnsignedByte);
+  assert(idx_file.shape.size() == 1);  // {N}
 
-  int magic_number;
-  ss.read((char*)&magic_number, sizeof(magic_number));
-  magic_number = ReverseEndian(magic_number);
-
-  int label_size;
-  ss.read((char*)&label_size, sizeof(label_size));
-  label_size = ReverseEndian(label_size);
+  const std::size_t label_size = idx_file.shape[0];
 
   if (is_verbose) {
-    std::cout << "[ReadLabelFile()] magic_number = " << magic_number << ", label_size = " << label_size << std::endl;
+    std::cout << "[ReadLabelFile()] label_size = " << label_size << std::endl;
   }
 
-  xt::xarray<float> label = xt::zeros<float>({label_size});
-  for (std::size_t i = 0; i < label_size; ++i) {
-    std::byte one_byte;
-    ss.read((char*)&one_byte, sizeof(one_byte));
-    label(i) = static_cast<float>(one_byte);
-  }
+  const xt::xarray<float> label = util::XtensorFromIdxFile(idx_file);
 
   assert(label.dimension() == 1);  // {N}
   assert(label.shape(0) == label_size);
@@ -190,8 +138,11 @@ class Mnist : public core::Dataset {
       DownloadFileFromURLToPath(label_file_url.c_str(), label_file_path.c_str());
     }
 
+    // Decompresses the data file and the label file in parallel.
+    std::future<xt::xarray<float>> label_future =
+        std::async(std::launch::async, [&label_file_path] { return ReadLabelFile(label_file_path); });
     data_ = ReadDataFile(data_file_path);
-    label_ = ReadLabelFile(label_file_path);
+    label_ = label_future.get();
 
     std::cout << "[Mnist::Init()] xt::view(data_, 0) =" << std::endl
               << xt::print_options::line_width(1000) << xt::view(data_, 0) << std::endl << std::endl;
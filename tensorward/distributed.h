@@ -0,0 +1,6 @@
+#pragma once
+
+// Header file aggregation for users.
+#include "tensorward/distributed/bucketed_all_reduce.h"
+#include "tensorward/distributed/launcher.h"
+#include "tensorward/distributed/shared_memory_all_reduce.h"
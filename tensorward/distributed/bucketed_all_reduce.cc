@@ -0,0 +1,144 @@
+#include "tensorward/distributed/bucketed_all_reduce.h"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+
+#include <xtensor/xbuilder.hpp>
+
+namespace tensorward::distributed {
+
+BucketedAllReduce::BucketedAllReduce(SharedMemoryAllReduce& all_reduce,
+                                     const std::vector<core::ParameterSharedPtr>& param_ptrs,
+                                     const std::size_t bucket_capacity /* = kDefaultBucketCapacity */)
+    : all_reduce_(all_reduce),
+      param_ptrs_(param_ptrs),
+      param_locations_(param_ptrs.size()),
+      is_param_ready_(param_ptrs.size(), false),
+      num_reduced_buckets_(0),
+      is_stopping_(false) {
+  // Fills the buckets from the last parameter, where a parameter larger than the capacity has its own bucket.
+  for (std::size_t i = param_ptrs_.size(); 0 < i--;) {
+    const std::size_t param_size = param_ptrs_[i]->data().size();
+    if (buckets_.empty() || bucket_capacity < buckets_.back().grads.size() + param_size) {
+      buckets_.push_back({.param_indices = {}, .grads = {}, .num_ready_params = 0});
+    }
+    Bucket& bucket = buckets_.back();
+    param_locations_[i] = {buckets_.size() - 1, bucket.grads.size()};
+    bucket.param_indices.push_back(i);
+    bucket.grads.resize(bucket.grads.size() + param_size);
+  }
+  is_bucket_ready_.assign(buckets_.size(), false);
+
+  grad_ready_hook_ids_.reserve(param_ptrs_.size());
+  for (std::size_t i = 0; i < param_ptrs_.size(); ++i) {
+    grad_ready_hook_ids_.push_back(
+        param_ptrs_[i]->RegisterGradReadyHook([this, i](core::Parameter&) { MarkParamReady(i); }));
+  }
+
+  thread_ = std::thread(&BucketedAllReduce::Run, this);
+}
+
+BucketedAllReduce::~BucketedAllReduce() {
+  for (std::size_t i = 0; i < param_ptrs_.size(); ++i) {
+    param_ptrs_[i]->RemoveGradReadyHook(grad_ready_hook_ids_[i]);
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_stopping_ = true;
+  }
+  condition_variable_.notify_all();
+  thread_.join();
+}
+
+void BucketedAllReduce::Wait() {
+  // Hands over the rest of the buckets, whose parameters didn't get their gradients in the backpropagation.
+  for (std::size_t i = 0; i < param_ptrs_.size(); ++i) {
+    if (!is_param_ready_[i]) {
+      MarkParamReady(i);
+    }
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_variable_.wait(lock, [this] { return num_reduced_buckets_ == buckets_.size(); });
+    num_reduced_buckets_ = 0;
+    std::fill(is_bucket_ready_.begin(), is_bucket_ready_.end(), false);
+  }
+
+  // Writes the averaged gradients back, reusing the storages of the gradients if any.
+  for (std::size_t i = 0; i < param_ptrs_.size(); ++i) {
+    const core::ParameterSharedPtr& param_ptr = param_ptrs_[i];
+    const auto [bucket_index, offset] = param_locations_[i];
+    const float* averaged_grad = buckets_[bucket_index].grads.data() + offset;
+
+    xt::xarray<float> grad;
+    if (param_ptr->grad_opt().has_value()) {
+      grad = param_ptr->ReleaseGrad();
+    } else {
+      grad = xt::empty<float>(param_ptr->data().shape());
+    }
+    std::copy(averaged_grad, averaged_grad + grad.size(), grad.data());
+    param_ptr->SetSparseGradOpt(std::nullopt);
+    param_ptr->AccumulateGrad(std::move(grad));
+    is_param_ready_[i] = false;
+  }
+  for (Bucket& bucket : buckets_) {
+    bucket.num_ready_params = 0;
+  }
+}
+
+void BucketedAllReduce::MarkParamReady(const std::size_t param_index) {
+  if (is_param_ready_[param_index]) {
+    return;
+  }
+  is_param_ready_[param_index] = true;
+
+  const core::ParameterSharedPtr& param_ptr = param_ptrs_[param_index];
+  const auto [bucket_index, offset] = param_locations_[param_index];
+  Bucket& bucket = buckets_[bucket_index];
+  float* grad_in_bucket = bucket.grads.data() + offset;
+  const std::size_t param_size = param_ptr->data().size();
+  if (param_ptr->grad_opt().has_value()) {
+    const xt::xarray<float>& grad = param_ptr->grad();
+    std::copy(grad.data(), grad.data() + param_size, grad_in_bucket);
+  } else {
+    std::fill_n(grad_in_bucket, param_size, 0.0f);
+  }
+  if (param_ptr->sparse_grad_opt().has_value()) {
+    const xt::xarray<float> dense_grad =
+        core::DensifyRowSparseGrad(param_ptr->sparse_grad(), param_ptr->data().shape());
+    std::transform(grad_in_bucket, grad_in_bucket + param_size, dense_grad.data(), grad_in_bucket, std::plus<float>());
+  }
+
+  if (++bucket.num_ready_params == bucket.param_indices.size()) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      is_bucket_ready_[bucket_index] = true;
+    }
+    condition_variable_.notify_all();
+  }
+}
+
+void BucketedAllReduce::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    // All-reduces the buckets in the order of the buckets, so that all of the ranks agree on it.
+    condition_variable_.wait(lock, [this] {
+      return is_stopping_ || (num_reduced_buckets_ < buckets_.size() && is_bucket_ready_[num_reduced_buckets_]);
+    });
+    if (is_stopping_) {
+      break;
+    }
+
+    Bucket& bucket = buckets_[num_reduced_buckets_];
+    lock.unlock();
+    all_reduce_.AllReduce(bucket.grads);
+    lock.lock();
+
+    ++num_reduced_buckets_;
+    condition_variable_.notify_all();
+  }
+}
+
+}  // namespace tensorward::distributed
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "tensorward/core/parameter.h"
+#include "tensorward/distributed/shared_memory_all_reduce.h"
+
+namespace tensorward::distributed {
+
+// Default number of the floats in each bucket (1 MB).
+constexpr std::size_t kDefaultBucketCapacity = 1 << 18;
+
+// Averages the gradients of the parameters of all of the ranks like `SharedMemoryAllReduce::AllReduceGrads()`, but
+// overlaps the all-reduce with the backward calculation:
+//
+//   1. The parameters are grouped into the buckets of about `bucket_capacity` floats, in the reverse order of the
+//      parameters (i.e. from the last layer, whose gradient is ready first in the backpropagation).
+//   2. During `Tensor::Backpropagation()`, the grad-ready hook of each parameter (see
+//      `Parameter::RegisterGradReadyHook()`) copies its gradient into its bucket, and once all of the gradients of the
+//      bucket are ready, the bucket is handed over to the communication thread.
+//   3. The communication thread all-reduces the buckets one by one in the order of the buckets (which is the same on
+//      all of the ranks, regardless of the order in which they got ready), while the backpropagation continues.
+//   4. `Wait()` hands over the rest of the buckets (e.g. of the parameters not used in the computational graph),
+//      waits for all of them to be all-reduced, and writes the averaged gradients back into the parameters.
+//
+// e.g.
+//
+//   BucketedAllReduce bucketed_all_reduce(all_reduce, model.GetParamPtrs());
+//   for (...) {
+//     model.ClearGrads();
+//     loss_ptr->Backpropagation();  // The all-reduce of the buckets starts here.
+//     bucketed_all_reduce.Wait();
+//     optimizer.Update(model.GetParamPtrs());
+//   }
+//
+// NOTE: Construct this after the parameters are initialized (e.g. after the first forward calculation), and don't
+// NOTE: use the `SharedMemoryAllReduce` from the other threads until `Wait()` returns.
+class BucketedAllReduce {
+ public:
+  BucketedAllReduce(SharedMemoryAllReduce& all_reduce, const std::vector<core::ParameterSharedPtr>& param_ptrs,
+                    const std::size_t bucket_capacity = kDefaultBucketCapacity);
+
+  // Removes the grad-ready hooks registered by this (keeping the ones registered by others), and stops the
+  // communication thread.
+  ~BucketedAllReduce();
+
+  // Prevents copy construction.
+  BucketedAllReduce(const BucketedAllReduce&) = delete;
+
+  // Prevents copy assignment.
+  BucketedAllReduce& operator=(const BucketedAllReduce&) = delete;
+
+  // Blocks until the gradients of all of the parameters are averaged, and then writes them back into the parameters.
+  void Wait();
+
+  const std::size_t num_buckets() const { return buckets_.size(); }
+
+ private:
+  struct Bucket {
+    // Indices of the parameters in this bucket.
+    std::vector<std::size_t> param_indices;
+
+    // Flattened gradients of the parameters.
+    std::vector<float> grads;
+
+    // Number of the parameters whose gradients have been copied into this bucket.
+    std::size_t num_ready_params;
+  };
+
+  // Copies the gradient of the parameter (or zeros if it has no gradient) into its bucket, and hands over the bucket
+  // to the communication thread if it's complete.
+  void MarkParamReady(const std::size_t param_index);
+
+  // Main loop of the communication thread.
+  void Run();
+
+  SharedMemoryAllReduce& all_reduce_;
+
+  std::vector<core::ParameterSharedPtr> param_ptrs_;
+
+  // Handles of the grad-ready hooks registered on the parameters by this.
+  std::vector<core::Parameter::GradReadyHookId> grad_ready_hook_ids_;
+
+  std::vector<Bucket> buckets_;
+
+  // (The index of the bucket, the offset in it) of each parameter.
+  std::vector<std::pair<std::size_t, std::size_t>> param_locations_;
+
+  std::vector<bool> is_param_ready_;
+
+  std::mutex mutex_;
+
+  // Notified when a bucket is handed over, when a bucket is all-reduced and when the thread is stopped.
+  std::condition_variable condition_variable_;
+
+  std::vector<bool> is_bucket_ready_;
+
+  // Number of the buckets all-reduced in the current iteration.
+  std::size_t num_reduced_buckets_;
+
+  bool is_stopping_;
+
+  // Communication thread, which is started at the end of the constructor, after the buckets are built.
+  std::thread thread_;
+};
+
+}  // namespace tensorward::distributed
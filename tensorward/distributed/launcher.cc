@@ -0,0 +1,115 @@
+#include "tensorward/distributed/launcher.h"
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <xtensor/xrandom.hpp>
+
+namespace tensorward::distributed {
+
+namespace {
+
+// Interval [ms] of polling the workers, which is short enough to kill the others soon after a worker fails.
+constexpr int kWaitIntervalInMilliseconds = 10;
+
+// Runs the worker function in the child process, and returns its exit status.
+// NOTE: An exception must not escape the worker function, since it would unwind through the stack frames of the parent
+// NOTE: copied into the child (e.g. the test framework would go on running the other tests in the child).
+const int RunWorker(const WorkerFunction& worker_function, const WorkerContext& context) {
+  try {
+    return worker_function(context);
+  } catch (const std::exception& exception) {
+    std::cerr << "[LaunchWorkers()] The worker " << context.rank << " threw: " << exception.what() << std::endl;
+  } catch (...) {
+    std::cerr << "[LaunchWorkers()] The worker " << context.rank << " threw an unknown exception." << std::endl;
+  }
+  return EXIT_FAILURE;
+}
+
+}  // namespace
+
+const bool LaunchWorkers(const std::size_t world_size, const WorkerFunction& worker_function,
+                         const std::filesystem::path& rendezvous_file_path, const std::uint64_t seed /* = 0 */) {
+  std::error_code error_code;
+  std::filesystem::remove(rendezvous_file_path, error_code);
+
+  // Flushes the buffered output, which would be otherwise written by every child too.
+  std::cout.flush();
+  std::cerr.flush();
+  std::fflush(nullptr);
+
+  std::vector<pid_t> pids;
+  bool is_success = true;
+  for (std::size_t rank = 0; rank < world_size; ++rank) {
+    const pid_t pid = fork();
+    if (pid == 0) {
+      xt::random::seed(seed);
+      const int status = RunWorker(
+          worker_function, {.rank = rank, .world_size = world_size, .rendezvous_file_path = rendezvous_file_path});
+      std::cout.flush();
+      std::cerr.flush();
+      std::fflush(nullptr);
+      // Exits without the destructors of the static objects of the parent (e.g. of the test framework).
+      _exit(status);
+    }
+    if (pid < 0) {
+      is_success = false;
+      break;
+    }
+    pids.push_back(pid);
+  }
+
+  // Waits for all of the workers, and kills the running ones once any of them fails.
+  std::vector<bool> is_running(pids.size(), true);
+  const auto kill_running_workers = [&]() {
+    for (std::size_t i = 0; i < pids.size(); ++i) {
+      if (is_running[i]) {
+        kill(pids[i], SIGKILL);
+      }
+    }
+  };
+  if (!is_success) {
+    kill_running_workers();
+  }
+  // NOTE: Each worker is waited for by its own pid (instead of `waitpid(-1, ...)`), so that the other children of the
+  // NOTE: calling process (not forked by this) are neither reaped nor lose their exit statuses.
+  std::size_t num_running_workers = pids.size();
+  while (0 < num_running_workers) {
+    for (std::size_t i = 0; i < pids.size(); ++i) {
+      if (!is_running[i]) {
+        continue;
+      }
+      int status;
+      const pid_t pid = waitpid(pids[i], &status, WNOHANG);
+      if (pid == 0 || (pid < 0 && errno == EINTR)) {
+        continue;  // Still running.
+      }
+      is_running[i] = false;
+      --num_running_workers;
+      if (pid < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+        if (is_success) {
+          kill_running_workers();
+        }
+        is_success = false;
+      }
+    }
+    if (0 < num_running_workers) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(kWaitIntervalInMilliseconds));
+    }
+  }
+
+  std::filesystem::remove(rendezvous_file_path, error_code);
+  return is_success;
+}
+
+}  // namespace tensorward::distributed
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+
+namespace tensorward::distributed {
+
+// Context of a worker process launched by `LaunchWorkers()`.
+struct WorkerContext {
+  std::size_t rank;
+
+  std::size_t world_size;
+
+  // Local file where the workers meet each other (e.g. for `SharedMemoryAllReduce`), which doesn't exist at the start.
+  std::filesystem::path rendezvous_file_path;
+};
+
+// Function run by each worker process, which returns the exit status of the process (e.g. `EXIT_SUCCESS`).
+using WorkerFunction = std::function<int(const WorkerContext&)>;
+
+// Forks `world_size` worker processes on this host and waits for all of them, where each of them seeds
+// `xt::random` with the seed (the same for all of the ranks, so that e.g. the parameters of the models are initialized
+// in the same way), runs the worker function, and exits with its return value. Returns true if all of the workers
+// succeed. If any of them fails (or is killed), the others are killed, so that they don't wait for it forever.
+//
+// e.g. Data parallel training with 4 processes:
+//
+//   LaunchWorkers(4, [&](const WorkerContext& context) {
+//     SharedMemoryAllReduce all_reduce(context.rendezvous_file_path, context.rank, context.world_size);
+//     ...  // The training loop with `all_reduce.AllReduceGrads(model.GetParamPtrs())` before `optimizer.Update()`.
+//     return EXIT_SUCCESS;
+//   }, "/dev/shm/tensorward_rendezvous");
+//
+// NOTE: Call this before starting any thread, because only the calling thread is forked. The only exception is the
+// NOTE: thread pool shared by the kernels, which the workers replace with the one of no workers after the fork (see
+// NOTE: `util::ThreadPool::instance()`), so call `util::ThreadPool::ResetInstance()` in the worker function to run the
+// NOTE: kernels in parallel.
+// NOTE: The rendezvous file is removed before and after the workers run.
+const bool LaunchWorkers(const std::size_t world_size, const WorkerFunction& worker_function,
+                         const std::filesystem::path& rendezvous_file_path, const std::uint64_t seed = 0);
+
+}  // namespace tensorward::distributed
@@ -0,0 +1,314 @@
+#include "tensorward/distributed/shared_memory_all_reduce.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <xtensor/xbuilder.hpp>
+
+#include "tensorward/util/atomic.h"
+
+namespace tensorward::distributed {
+
+namespace {
+
+// Interval of polling the rendezvous file which isn't created yet.
+constexpr std::chrono::milliseconds kPollingInterval(10);
+
+// Number of the times of spinning on a step counter before yielding the CPU to the other processes.
+constexpr std::size_t kNumSpins = 1024;
+
+// Rounds up the number to a multiple of the alignment.
+constexpr std::size_t RoundUp(const std::size_t number, const std::size_t alignment) {
+  return (number + alignment - 1) / alignment * alignment;
+}
+
+const std::size_t StepCountersSize(const std::size_t world_size) {
+  return RoundUp(world_size * kCacheLineSize, kRendezvousFileAlignment);
+}
+
+// Capacity of the buffer of each rank, rounded up so that each buffer starts at a cache line.
+const std::size_t AlignedCapacity(const std::size_t capacity) {
+  return RoundUp(capacity, kCacheLineSize / sizeof(float));
+}
+
+const std::size_t RendezvousFileSize(const std::size_t world_size, const std::size_t capacity) {
+  return kRendezvousFileAlignment + StepCountersSize(world_size) +
+         world_size * AlignedCapacity(capacity) * sizeof(float);
+}
+
+// [begin, end) of the c-th chunk out of `num_chunks` chunks of the data of the size.
+const std::pair<std::size_t, std::size_t> ChunkRange(const std::size_t c, const std::size_t num_chunks,
+                                                     const std::size_t size) {
+  return {c * size / num_chunks, (c + 1) * size / num_chunks};
+}
+
+}  // namespace
+
+SharedMemoryAllReduce::SharedMemoryAllReduce(const std::filesystem::path& rendezvous_file_path,
+                                             const std::size_t rank, const std::size_t world_size,
+                                             const std::size_t capacity /* = kDefaultAllReduceCapacity */,
+                                             const std::chrono::milliseconds timeout /* = std::chrono::seconds(60) */)
+    : rendezvous_file_path_(rendezvous_file_path),
+      rank_(rank),
+      world_size_(world_size),
+      capacity_(capacity),
+      is_valid_(false),
+      mapping_(nullptr),
+      mapping_size_(RendezvousFileSize(world_size, capacity)),
+      step_(0) {
+  assert((static_cast<void>("The rank must be less than the world size."), rank < world_size));
+  assert((static_cast<void>("The capacity must be positive."), 0 < capacity));
+
+  if (rank_ == 0) {
+    // Creates the whole file under a temporary name, and renames it, so that the other ranks never see it half-made.
+    const std::string temporary_file_path =
+        rendezvous_file_path_.string() + ".tmp." + std::to_string(static_cast<long>(getpid()));
+    const int file_descriptor = open(temporary_file_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (file_descriptor < 0) {
+      return;
+    }
+    // The file is zero-filled, i.e. all of the step counters start from 0.
+    if (ftruncate(file_descriptor, mapping_size_) != 0) {
+      close(file_descriptor);
+      unlink(temporary_file_path.c_str());
+      return;
+    }
+    void* mapping = mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+    close(file_descriptor);  // The mapping remains after closing the file.
+    if (mapping == MAP_FAILED) {
+      unlink(temporary_file_path.c_str());
+      return;
+    }
+    mapping_ = static_cast<std::byte*>(mapping);
+    const std::uint64_t header_values[2] = {world_size_, capacity_};
+    std::memcpy(mapping_, kRendezvousFileMagic, sizeof(kRendezvousFileMagic));
+    std::memcpy(mapping_ + sizeof(kRendezvousFileMagic), header_values, sizeof(header_values));
+    if (rename(temporary_file_path.c_str(), rendezvous_file_path_.c_str()) != 0) {
+      munmap(mapping_, mapping_size_);
+      mapping_ = nullptr;
+      unlink(temporary_file_path.c_str());
+      return;
+    }
+  } else {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (true) {
+      const int file_descriptor = open(rendezvous_file_path_.c_str(), O_RDWR);
+      if (0 <= file_descriptor) {
+        struct stat file_status;
+        if (fstat(file_descriptor, &file_status) == 0 &&
+            static_cast<std::size_t>(file_status.st_size) == mapping_size_) {
+          void* mapping = mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+          if (mapping != MAP_FAILED) {
+            mapping_ = static_cast<std::byte*>(mapping);
+          }
+        }
+        close(file_descriptor);  // The mapping remains after closing the file.
+        break;  // The file is renamed only after it's complete, so it's never retried once opened.
+      }
+      if (deadline < std::chrono::steady_clock::now()) {
+        return;
+      }
+      std::this_thread::sleep_for(kPollingInterval);
+    }
+    if (mapping_ == nullptr) {
+      return;
+    }
+    std::uint64_t header_values[2];
+    std::memcpy(header_values, mapping_ + sizeof(kRendezvousFileMagic), sizeof(header_values));
+    if (std::memcmp(mapping_, kRendezvousFileMagic, sizeof(kRendezvousFileMagic)) != 0 ||
+        header_values[0] != world_size_ || header_values[1] != capacity_) {
+      munmap(mapping_, mapping_size_);
+      mapping_ = nullptr;
+      return;
+    }
+  }
+
+  is_valid_ = true;
+}
+
+SharedMemoryAllReduce::~SharedMemoryAllReduce() {
+  if (mapping_ != nullptr) {
+    munmap(mapping_, mapping_size_);
+  }
+}
+
+void SharedMemoryAllReduce::AllReduce(std::span<float> data, const bool does_average /* = true */) {
+  AllReduceSpans({data}, does_average ? 1.0f / world_size_ : 1.0f, false);
+}
+
+void SharedMemoryAllReduce::AllReduceGrads(const std::vector<core::ParameterSharedPtr>& param_ptrs) {
+  // Moves the gradients out of the parameters, all-reduces them in place, and moves them back.
+  std::vector<xt::xarray<float>> grads;
+  grads.reserve(param_ptrs.size());
+  for (const core::ParameterSharedPtr& param_ptr : param_ptrs) {
+    xt::xarray<float> grad;
+    if (param_ptr->grad_opt().has_value()) {
+      grad = param_ptr->ReleaseGrad();
+    } else {
+      grad = xt::zeros<float>(param_ptr->data().shape());
+    }
+    if (param_ptr->sparse_grad_opt().has_value()) {
+      grad += core::DensifyRowSparseGrad(param_ptr->sparse_grad(), param_ptr->data().shape());
+      param_ptr->SetSparseGradOpt(std::nullopt);
+    }
+    grads.push_back(std::move(grad));
+  }
+
+  std::vector<std::span<float>> spans;
+  spans.reserve(grads.size());
+  for (xt::xarray<float>& grad : grads) {
+    spans.emplace_back(grad.data(), grad.size());
+  }
+  AllReduceSpans(spans, 1.0f / world_size_, false);
+
+  for (std::size_t i = 0; i < param_ptrs.size(); ++i) {
+    param_ptrs[i]->AccumulateGrad(std::move(grads[i]));
+  }
+}
+
+void SharedMemoryAllReduce::BroadcastParams(const std::vector<core::ParameterSharedPtr>& param_ptrs,
+                                            const std::size_t root_rank /* = 0 */) {
+  assert((static_cast<void>("The root rank must be less than the world size."), root_rank < world_size_));
+
+  // Sums up the data of the root rank and the zeros of the others, which is exactly the data of the root rank.
+  std::vector<std::span<float>> spans;
+  spans.reserve(param_ptrs.size());
+  for (const core::ParameterSharedPtr& param_ptr : param_ptrs) {
+    xt::xarray<float>& data = param_ptr->MutableData();
+    spans.emplace_back(data.data(), data.size());
+  }
+  AllReduceSpans(spans, 1.0f, rank_ != root_rank);
+}
+
+void SharedMemoryAllReduce::AllReduceSpans(const std::vector<std::span<float>>& spans, const float scale,
+                                           const bool does_fill_zeros) {
+  assert((static_cast<void>("`SharedMemoryAllReduce` must be valid to all-reduce."), is_valid_));
+
+  std::size_t total_size = 0;
+  for (const std::span<float>& span : spans) {
+    total_size += span.size();
+  }
+
+  // Cursors of the spans: (the index of the span, the offset in it).
+  std::size_t fill_span_index = 0;
+  std::size_t fill_offset = 0;
+  std::size_t drain_span_index = 0;
+  std::size_t drain_offset = 0;
+  float* buffer = Buffer(rank_);
+  for (std::size_t round_offset = 0; round_offset < total_size; round_offset += capacity_) {
+    const std::size_t round_size = std::min(capacity_, total_size - round_offset);
+
+    // Fills the buffer of this rank with the data of this round, after the right neighbor has finished all of its
+    // previous steps, which read the buffer of this rank.
+    WaitForStep((rank_ + 1) % world_size_, step_);
+    for (std::size_t i = 0; i < round_size;) {
+      const std::span<float>& span = spans[fill_span_index];
+      const std::size_t size = std::min(round_size - i, span.size() - fill_offset);
+      if (does_fill_zeros) {
+        std::fill_n(buffer + i, size, 0.0f);
+      } else {
+        std::copy_n(span.data() + fill_offset, size, buffer + i);
+      }
+      i += size;
+      fill_offset += size;
+      if (fill_offset == span.size()) {
+        ++fill_span_index;
+        fill_offset = 0;
+      }
+    }
+    // Skips the empty spans, which the loop above doesn't reach at the end of the round.
+    while (fill_span_index < spans.size() && spans[fill_span_index].empty()) {
+      ++fill_span_index;
+    }
+
+    RingAllReduce(round_size);
+
+    // Copies the result back into the spans.
+    for (std::size_t i = 0; i < round_size;) {
+      const std::span<float>& span = spans[drain_span_index];
+      const std::size_t size = std::min(round_size - i, span.size() - drain_offset);
+      if (scale == 1.0f) {
+        std::copy_n(buffer + i, size, span.data() + drain_offset);
+      } else {
+        std::transform(buffer + i, buffer + i + size, span.data() + drain_offset,
+                       [scale](const float x) { return x * scale; });
+      }
+      i += size;
+      drain_offset += size;
+      if (drain_offset == span.size()) {
+        ++drain_span_index;
+        drain_offset = 0;
+      }
+    }
+    while (drain_span_index < spans.size() && spans[drain_span_index].empty()) {
+      ++drain_span_index;
+    }
+  }
+}
+
+void SharedMemoryAllReduce::RingAllReduce(const std::size_t size) {
+  const std::size_t n = world_size_;
+  const std::size_t left_rank = (rank_ + n - 1) % n;
+  const std::size_t right_rank = (rank_ + 1) % n;
+  float* buffer = Buffer(rank_);
+  const float* left_buffer = Buffer(left_rank);
+
+  // Step 0 is filling the buffer of this rank (done by the caller). Before each of the other steps, waits for the left
+  // neighbor to finish its previous step (so its chunk to read is ready), and for the right neighbor to finish its
+  // previous step (so it has read the chunk of this rank which this step overwrites).
+  const std::uint64_t base_step = step_;
+  for (std::size_t t = 0; t < 2 * n - 1; ++t) {
+    if (1 <= t) {
+      WaitForStep(left_rank, base_step + t);
+      WaitForStep(right_rank, base_step + t);
+    }
+    if (1 <= t && t < n) {
+      // Reduce-scatter: adds the partial sum of a chunk from the left neighbor.
+      const std::size_t s = t - 1;
+      const auto [begin, end] = ChunkRange((rank_ + 2 * n - 1 - s) % n, n, size);
+      for (std::size_t i = begin; i < end; ++i) {
+        buffer[i] += left_buffer[i];
+      }
+    } else if (n <= t) {
+      // All-gather: copies a fully reduced chunk from the left neighbor.
+      const std::size_t s = t - n;
+      const auto [begin, end] = ChunkRange((rank_ + n - s) % n, n, size);
+      std::copy(left_buffer + begin, left_buffer + end, buffer + begin);
+    }
+    FinishStep();
+  }
+}
+
+void SharedMemoryAllReduce::WaitForStep(const std::size_t rank, const std::uint64_t step) const {
+  const std::uint64_t& step_counter = StepCounter(rank);
+  for (std::size_t i = 0; util::AtomicLoad(step_counter, std::memory_order_acquire) < step; ++i) {
+    if (kNumSpins <= i) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void SharedMemoryAllReduce::FinishStep() {
+  ++step_;
+  util::AtomicStore(StepCounter(rank_), step_, std::memory_order_release);
+}
+
+std::uint64_t& SharedMemoryAllReduce::StepCounter(const std::size_t rank) const {
+  return *reinterpret_cast<std::uint64_t*>(mapping_ + kRendezvousFileAlignment + rank * kCacheLineSize);
+}
+
+float* SharedMemoryAllReduce::Buffer(const std::size_t rank) const {
+  return reinterpret_cast<float*>(mapping_ + kRendezvousFileAlignment + StepCountersSize(world_size_)) +
+         rank * AlignedCapacity(capacity_);
+}
+
+}  // namespace tensorward::distributed
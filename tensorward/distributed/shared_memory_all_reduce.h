@@ -0,0 +1,123 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+#include "tensorward/core/parameter.h"
+
+namespace tensorward::distributed {
+
+// Rendezvous file format of `SharedMemoryAllReduce`, which is mapped by all of the ranks:
+//
+//   +-------------------------------------------------------------------------------------------------------+
+//   | magic "TWRING\0\0" (8 bytes) | world size (uint64) | capacity (uint64) | zero padding                    |
+//   +-------------------------------------------------------------------------------------------------------+
+//   | step counter of rank 0 (uint64) | zero padding to `kCacheLineSize` bytes | step counter of rank 1 | ... |
+//   +-------------------------------------------------------------------------------------------------------+
+//   | buffer of rank 0 (float * capacity) | buffer of rank 1 (float * capacity) | ...                         |
+//   +-------------------------------------------------------------------------------------------------------+
+//
+// The header and the step counters are padded to `kRendezvousFileAlignment` bytes (a page).
+
+constexpr char kRendezvousFileMagic[8] = {'T', 'W', 'R', 'I', 'N', 'G', '\0', '\0'};
+constexpr std::size_t kRendezvousFileAlignment = 4096;
+constexpr std::size_t kCacheLineSize = 64;
+
+// Default number of the floats in the buffer of each rank (4 MB).
+constexpr std::size_t kDefaultAllReduceCapacity = 1 << 20;
+
+// All-reduce among the processes on one host (e.g. launched by `LaunchWorkers()`) through the shared memory of the
+// rendezvous file, without any network stack or lock.
+//
+// It's the ring all-reduce over the buffers of the ranks: the data is split into `world_size` chunks, and in each of
+// the `world_size - 1` steps of the reduce-scatter, each rank adds a chunk of the buffer of its left neighbor into its
+// own buffer, and then in each of the `world_size - 1` steps of the all-gather, it copies a fully reduced chunk from
+// its left neighbor. So each rank reads and writes only about 2x the data regardless of the number of the ranks, and
+// each step waits only for the step counters (atomics with the acquire/release orders) of its two neighbors instead
+// of all of the ranks. The data larger than the capacity of the buffers is all-reduced in multiple rounds.
+//
+// The result is deterministic (the chunks are always summed up in the same order), and exactly the same on all of the
+// ranks, so the replicas of the model stay identical.
+//
+// NOTE: All of the ranks must call the same functions with the same sizes in the same order. A rank waits (spinning
+// NOTE: and yielding) for its neighbors at each step, so it never returns if any of them dies (`LaunchWorkers()` kills
+// NOTE: all of the workers in that case).
+class SharedMemoryAllReduce {
+ public:
+  // The rank 0 creates the rendezvous file, and the other ranks wait for it to be created up to `timeout`.
+  // NOTE: The rendezvous file must not exist before the rank 0 creates it (e.g. the one of the previous run).
+  SharedMemoryAllReduce(const std::filesystem::path& rendezvous_file_path, const std::size_t rank,
+                        const std::size_t world_size, const std::size_t capacity = kDefaultAllReduceCapacity,
+                        const std::chrono::milliseconds timeout = std::chrono::seconds(60));
+
+  // Unmaps the rendezvous file.
+  ~SharedMemoryAllReduce();
+
+  // Prevents copy construction.
+  SharedMemoryAllReduce(const SharedMemoryAllReduce&) = delete;
+
+  // Prevents copy assignment.
+  SharedMemoryAllReduce& operator=(const SharedMemoryAllReduce&) = delete;
+
+  // Sums up (or averages if `does_average` is true) the data of all of the ranks in place.
+  void AllReduce(std::span<float> data, const bool does_average = true);
+
+  // Averages the gradients of the parameters of all of the ranks in place (i.e. between `Tensor::Backpropagation()` and
+  // `Optimizer::Update()`), where the missing gradient is regarded as zeros and the row-sparse gradient is densified.
+  // NOTE: The parameters (e.g. `Model::GetParamPtrs()`) must be in the same order on all of the ranks.
+  void AllReduceGrads(const std::vector<core::ParameterSharedPtr>& param_ptrs);
+
+  // Copies the data of the parameters of the root rank into those of the other ranks (e.g. after the first forward
+  // calculation, which initializes the parameters).
+  void BroadcastParams(const std::vector<core::ParameterSharedPtr>& param_ptrs, const std::size_t root_rank = 0);
+
+  const bool is_valid() const { return is_valid_; }
+
+  const std::size_t rank() const { return rank_; }
+
+  const std::size_t world_size() const { return world_size_; }
+
+  const std::size_t capacity() const { return capacity_; }
+
+ private:
+  // All-reduces the spans as if they were concatenated, where the spans of the non-root ranks are regarded as zeros if
+  // `does_fill_zeros` is true (for the broadcast). The result is multiplied by the scale.
+  void AllReduceSpans(const std::vector<std::span<float>>& spans, const float scale, const bool does_fill_zeros);
+
+  // Runs the ring all-reduce of the first `size` floats in the buffer of this rank, after this rank has filled it (once
+  // the right neighbor has finished all of the previous steps).
+  void RingAllReduce(const std::size_t size);
+
+  // Waits until the step counter of the rank reaches the step.
+  void WaitForStep(const std::size_t rank, const std::uint64_t step) const;
+
+  // Publishes that this rank has finished the step.
+  void FinishStep();
+
+  std::uint64_t& StepCounter(const std::size_t rank) const;
+
+  float* Buffer(const std::size_t rank) const;
+
+  std::filesystem::path rendezvous_file_path_;
+
+  std::size_t rank_;
+
+  std::size_t world_size_;
+
+  std::size_t capacity_;
+
+  bool is_valid_;
+
+  std::byte* mapping_;
+
+  std::size_t mapping_size_;
+
+  // Number of the steps finished by this rank, which is also written into its step counter.
+  std::uint64_t step_;
+};
+
+}  // namespace tensorward::distributed
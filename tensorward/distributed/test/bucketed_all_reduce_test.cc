@@ -0,0 +1,85 @@
+#include "tensorward/distributed/bucketed_all_reduce.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <xtensor/xarray.hpp>
+#include <xtensor/xbuilder.hpp>
+
+#include "tensorward/core/tensor.h"
+#include "tensorward/core/operator/add.h"
+#include "tensorward/core/operator/mul.h"
+#include "tensorward/distributed/launcher.h"
+
+namespace tensorward::distributed {
+
+namespace {
+
+constexpr std::size_t kWorldSize = 3;
+constexpr std::size_t kHeight = 2;
+constexpr std::size_t kWidth = 3;
+constexpr std::size_t kNumParams = 4;
+
+// Two parameters {H, W} fit in a bucket.
+constexpr std::size_t kBucketCapacity = 2 * kHeight * kWidth + 1;
+
+constexpr std::size_t kNumIterations = 5;
+
+}  // namespace
+
+class BucketedAllReduceTest : public ::testing::Test {
+ protected:
+  BucketedAllReduceTest()
+      : rendezvous_file_path_(std::filesystem::temp_directory_path() /
+                              ("tensorward_" + std::to_string(getpid()) + "_" +
+                               ::testing::UnitTest::GetInstance()->current_test_info()->name())) {}
+
+  ~BucketedAllReduceTest() { std::filesystem::remove(rendezvous_file_path_); }
+
+  const std::filesystem::path rendezvous_file_path_;
+};
+
+TEST_F(BucketedAllReduceTest, WaitTest) {
+  EXPECT_TRUE(LaunchWorkers(
+      kWorldSize,
+      [&](const WorkerContext& context) {
+        SharedMemoryAllReduce all_reduce(context.rendezvous_file_path, context.rank, context.world_size);
+        std::vector<core::ParameterSharedPtr> param_ptrs;
+        for (std::size_t i = 0; i < kNumParams; ++i) {
+          param_ptrs.push_back(core::AsParameterSharedPtr(xt::zeros<float>({kHeight, kWidth})));
+        }
+        BucketedAllReduce bucketed_all_reduce(all_reduce, param_ptrs, kBucketCapacity);
+        if (bucketed_all_reduce.num_buckets() != kNumParams / 2) {
+          return EXIT_FAILURE;
+        }
+
+        // The gradient of each used parameter is (rank + 1) * (i + 1), whose average is 2 * (i + 1), and the last
+        // parameter isn't used, whose gradient is regarded as zeros.
+        for (std::size_t iteration = 0; iteration < kNumIterations; ++iteration) {
+          core::TensorSharedPtr y_ptr = core::AsTensorSharedPtr(xt::zeros<float>({kHeight, kWidth}));
+          for (std::size_t i = 0; i + 1 < kNumParams; ++i) {
+            param_ptrs[i]->ClearGrad();
+            const float scale = (context.rank + 1.0f) * (i + 1.0f);
+            y_ptr = y_ptr + param_ptrs[i] * xt::xarray<float>({scale});
+          }
+          param_ptrs.back()->ClearGrad();
+          y_ptr->Backpropagation();
+          bucketed_all_reduce.Wait();
+
+          for (std::size_t i = 0; i < kNumParams; ++i) {
+            const float expected_grad = i + 1 < kNumParams ? 2.0f * (i + 1.0f) : 0.0f;
+            if (param_ptrs[i]->grad() != xt::xarray<float>(xt::ones<float>({kHeight, kWidth}) * expected_grad)) {
+              return EXIT_FAILURE;
+            }
+          }
+        }
+        return EXIT_SUCCESS;
+      },
+      rendezvous_file_path_));
+}
+
+}  // namespace tensorward::distributed
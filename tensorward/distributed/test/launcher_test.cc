@@ -0,0 +1,89 @@
+#include "tensorward/distributed/launcher.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <xtensor/xarray.hpp>
+#include <xtensor/xrandom.hpp>
+
+namespace tensorward::distributed {
+
+namespace {
+
+constexpr std::size_t kWorldSize = 3;
+constexpr std::uint64_t kSeed = 42;
+
+}  // namespace
+
+class LauncherTest : public ::testing::Test {
+ protected:
+  LauncherTest()
+      : temporary_directory_path_(std::filesystem::temp_directory_path() /
+                                  ("tensorward_" + std::to_string(getpid()) + "_" +
+                                   ::testing::UnitTest::GetInstance()->current_test_info()->name())) {
+    std::filesystem::create_directories(temporary_directory_path_);
+  }
+
+  ~LauncherTest() { std::filesystem::remove_all(temporary_directory_path_); }
+
+  const std::filesystem::path temporary_directory_path_;
+};
+
+TEST_F(LauncherTest, SuccessTest) {
+  const std::filesystem::path rendezvous_file_path = temporary_directory_path_ / "rendezvous";
+
+  // Each worker leaves a file named after its rank.
+  EXPECT_TRUE(LaunchWorkers(
+      kWorldSize,
+      [&](const WorkerContext& context) {
+        const bool is_valid_context = context.rank < kWorldSize && context.world_size == kWorldSize &&
+                                      context.rendezvous_file_path == rendezvous_file_path;
+        std::filesystem::create_directory(temporary_directory_path_ / std::to_string(context.rank));
+        return is_valid_context ? EXIT_SUCCESS : EXIT_FAILURE;
+      },
+      rendezvous_file_path));
+
+  for (std::size_t rank = 0; rank < kWorldSize; ++rank) {
+    EXPECT_TRUE(std::filesystem::exists(temporary_directory_path_ / std::to_string(rank)));
+  }
+  EXPECT_FALSE(std::filesystem::exists(rendezvous_file_path));
+}
+
+TEST_F(LauncherTest, SeedTest) {
+  // All of the workers draw the same random numbers as the parent seeded in the same way.
+  xt::random::seed(kSeed);
+  const xt::xarray<float> expected_random_numbers = xt::random::randn<float>({4});
+
+  EXPECT_TRUE(LaunchWorkers(
+      kWorldSize,
+      [&](const WorkerContext& context) {
+        const xt::xarray<float> random_numbers = xt::random::randn<float>({4});
+        return random_numbers == expected_random_numbers ? EXIT_SUCCESS : EXIT_FAILURE;
+      },
+      temporary_directory_path_ / "rendezvous", kSeed));
+}
+
+TEST_F(LauncherTest, FailureTest) {
+  // The rank 1 fails, and the others, which would wait forever otherwise, are killed.
+  const auto start_time = std::chrono::steady_clock::now();
+  EXPECT_FALSE(LaunchWorkers(
+      kWorldSize,
+      [](const WorkerContext& context) {
+        if (context.rank == 1) {
+          return EXIT_FAILURE;
+        }
+        while (true) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return EXIT_SUCCESS;
+      },
+      temporary_directory_path_ / "rendezvous"));
+  EXPECT_LT(std::chrono::steady_clock::now() - start_time, std::chrono::seconds(10));
+}
+
+}  // namespace tensorward::distributed
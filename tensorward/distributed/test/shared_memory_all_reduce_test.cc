@@ -0,0 +1,128 @@
+#include "tensorward/distributed/shared_memory_all_reduce.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <xtensor/xarray.hpp>
+#include <xtensor/xbuilder.hpp>
+
+#include "tensorward/distributed/launcher.h"
+
+namespace tensorward::distributed {
+
+namespace {
+
+constexpr std::size_t kWorldSize = 3;
+
+// Small capacity so that the larger data is all-reduced in multiple rounds.
+constexpr std::size_t kCapacity = 7;
+
+constexpr std::size_t kNumIterations = 10;
+
+// Value of the i-th element of the data of the rank, whose sum over the ranks is exact in float.
+const float ValueAt(const std::size_t rank, const std::size_t i, const std::size_t iteration) {
+  return rank * 100.0f + i + iteration;
+}
+
+}  // namespace
+
+class SharedMemoryAllReduceTest : public ::testing::Test {
+ protected:
+  SharedMemoryAllReduceTest()
+      : rendezvous_file_path_(std::filesystem::temp_directory_path() /
+                              ("tensorward_" + std::to_string(getpid()) + "_" +
+                               ::testing::UnitTest::GetInstance()->current_test_info()->name())) {}
+
+  ~SharedMemoryAllReduceTest() { std::filesystem::remove(rendezvous_file_path_); }
+
+  const std::filesystem::path rendezvous_file_path_;
+};
+
+TEST_F(SharedMemoryAllReduceTest, AllReduceTest) {
+  // The sizes which aren't divisible by the world size, smaller than it, and larger than the capacity.
+  const std::vector<std::size_t> sizes = {0, 1, 2, kWorldSize, kCapacity, 2 * kCapacity + 1, 100};
+
+  EXPECT_TRUE(LaunchWorkers(
+      kWorldSize,
+      [&](const WorkerContext& context) {
+        SharedMemoryAllReduce all_reduce(context.rendezvous_file_path, context.rank, context.world_size, kCapacity);
+        if (!all_reduce.is_valid()) {
+          return EXIT_FAILURE;
+        }
+        for (std::size_t iteration = 0; iteration < kNumIterations; ++iteration) {
+          for (const std::size_t size : sizes) {
+            std::vector<float> data(size);
+            for (std::size_t i = 0; i < size; ++i) {
+              data[i] = ValueAt(context.rank, i, iteration);
+            }
+            std::vector<float> averaged_data = data;
+            all_reduce.AllReduce(data, false);
+            all_reduce.AllReduce(averaged_data);
+
+            for (std::size_t i = 0; i < size; ++i) {
+              float sum = 0.0f;
+              for (std::size_t rank = 0; rank < kWorldSize; ++rank) {
+                sum += ValueAt(rank, i, iteration);
+              }
+              if (data[i] != sum || averaged_data[i] != sum * (1.0f / kWorldSize)) {
+                return EXIT_FAILURE;
+              }
+            }
+          }
+        }
+        return EXIT_SUCCESS;
+      },
+      rendezvous_file_path_));
+}
+
+TEST_F(SharedMemoryAllReduceTest, AllReduceGradsTest) {
+  EXPECT_TRUE(LaunchWorkers(
+      kWorldSize,
+      [&](const WorkerContext& context) {
+        SharedMemoryAllReduce all_reduce(context.rendezvous_file_path, context.rank, context.world_size, kCapacity);
+        const core::ParameterSharedPtr param_ptr = core::AsParameterSharedPtr(xt::zeros<float>({4, 5}));
+        const core::ParameterSharedPtr param_without_grad_ptr = core::AsParameterSharedPtr(xt::zeros<float>({3}));
+        const core::ParameterSharedPtr sparse_param_ptr = core::AsParameterSharedPtr(xt::zeros<float>({3, 2}));
+
+        // The gradients are (rank + 1), whose average is 2, and the row-sparse gradient has only the row of the rank.
+        param_ptr->AccumulateGrad(xt::xarray<float>(xt::ones<float>({4, 5}) * (context.rank + 1.0f)));
+        sparse_param_ptr->AccumulateSparseGrad({context.rank}, xt::ones<float>({1, 2}) * 3.0f);
+        all_reduce.AllReduceGrads({param_ptr, param_without_grad_ptr, sparse_param_ptr});
+
+        const bool is_success = param_ptr->grad() == xt::xarray<float>(xt::ones<float>({4, 5}) * 2.0f) &&
+                                param_without_grad_ptr->grad() == xt::xarray<float>(xt::zeros<float>({3})) &&
+                                sparse_param_ptr->grad() == xt::xarray<float>(xt::ones<float>({3, 2})) &&
+                                !sparse_param_ptr->sparse_grad_opt().has_value();
+        return is_success ? EXIT_SUCCESS : EXIT_FAILURE;
+      },
+      rendezvous_file_path_));
+}
+
+TEST_F(SharedMemoryAllReduceTest, BroadcastParamsTest) {
+  constexpr std::size_t kRootRank = 1;
+
+  EXPECT_TRUE(LaunchWorkers(
+      kWorldSize,
+      [&](const WorkerContext& context) {
+        SharedMemoryAllReduce all_reduce(context.rendezvous_file_path, context.rank, context.world_size, kCapacity);
+        const core::ParameterSharedPtr param_ptr =
+            core::AsParameterSharedPtr(xt::xarray<float>(xt::arange<float>(10) * (context.rank + 1.0f)));
+        all_reduce.BroadcastParams({param_ptr}, kRootRank);
+        return param_ptr->data() == xt::xarray<float>(xt::arange<float>(10) * (kRootRank + 1.0f)) ? EXIT_SUCCESS
+                                                                                                  : EXIT_FAILURE;
+      },
+      rendezvous_file_path_));
+}
+
+TEST_F(SharedMemoryAllReduceTest, TimeoutTest) {
+  // The rank 1 gives up if the rank 0 never creates the rendezvous file.
+  const SharedMemoryAllReduce all_reduce(rendezvous_file_path_, 1, kWorldSize, kCapacity,
+                                         std::chrono::milliseconds(100));
+  EXPECT_FALSE(all_reduce.is_valid());
+}
+
+}  // namespace tensorward::distributed
@@ -2,6 +2,8 @@
 
 // Header file aggregation for users.
 #include "tensorward/function/broadcast_to.h"
+#include "tensorward/function/conv2d.h"
+#include "tensorward/function/embedding.h"
 #include "tensorward/function/exp.h"
 #include "tensorward/function/get_item.h"
 #include "tensorward/function/linear.h"
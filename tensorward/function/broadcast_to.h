@@ -18,7 +18,7 @@ class BroadcastTo : public core::Function {
 
   ~BroadcastTo() {}
 
-  const std::vector<xt::xarray<float>> Forward(const std::vector<xt::xarray<float>>& xs) override {
+  const std::vector<xt::xarray<float>> Forward(const core::ConstXarrayRefs& xs) override {
     const xt::xarray<float> y = xt::broadcast(xs[0], output_shape_);
 
     return {y};
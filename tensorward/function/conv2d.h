@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cassert>
+#include <memory>
+#include <vector>
+
+#include <xtensor/xarray.hpp>
+#include <xtensor/xmanipulation.hpp>
+#include <xtensor-blas/xlinalg.hpp>
+
+#include "tensorward/core/config.h"
+#include "tensorward/core/function.h"
+#include "tensorward/core/tensor.h"
+#include "tensorward/util/xtensor_im2col.h"
+#include "tensorward/util/xtensor_winograd.h"
+
+namespace tensorward::function {
+
+class Conv2d : public core::Function {
+ public:
+  // NOTE: `winograd_filter_ptr` is the transformed filter cached by the caller (e.g. `layer::Conv2d`), which is used
+  // NOTE: instead of transforming the filter again in the Winograd path. It's shared in order to avoid copying it.
+  Conv2d(const std::size_t stride = 1, const std::size_t pad = 0,
+         const std::shared_ptr<const util::WinogradFilter>& winograd_filter_ptr = nullptr)
+      : core::Function({.num_inputs = 3, .num_outputs = 1}),
+        stride_(stride),
+        pad_(pad),
+        winograd_filter_ptr_(winograd_filter_ptr) {}
+
+  ~Conv2d() {}
+
+  const std::vector<xt::xarray<float>> Forward(const core::ConstXarrayRefs& xs) override {
+    const xt::xarray<float>& x = xs[0];  // {N, C, H, W}
+    const xt::xarray<float>& W = xs[1];  // {K, C, KH, KW}
+    const xt::xarray<float>& b = xs[2];  // {K}
+    assert((static_cast<void>("`x.dimension()` must be 4 {N, C, H, W}."), x.dimension() == 4));
+    assert((static_cast<void>("`W.dimension()` must be 4 {K, C, KH, KW}."), W.dimension() == 4));
+    assert((static_cast<void>("The input channels of `x` and `W` must be equal."), x.shape(1) == W.shape(1)));
+
+    const std::size_t N = x.shape(0);
+    const std::size_t K = W.shape(0);
+    const std::size_t OH = util::ConvOutputSize(x.shape(2), W.shape(2), stride_, pad_);
+    const std::size_t OW = util::ConvOutputSize(x.shape(3), W.shape(3), stride_, pad_);
+
+    // y = conv(x, W)
+    xt::xarray<float> y;
+    if (IsWinogradPath(W.shape())) {
+      const std::size_t output_tile_size = util::SelectWinogradOutputTileSize(OH, OW);
+      const bool is_cache_valid = winograd_filter_ptr_ && winograd_filter_ptr_->output_tile_size == output_tile_size;
+      if (is_cache_valid) {
+        y = util::XtensorWinogradConv2d(x, *winograd_filter_ptr_, pad_);
+      } else {
+        y = util::XtensorWinogradConv2d(x, util::XtensorWinogradFilterTransform(W, output_tile_size), pad_);
+      }
+    } else {
+      // {N * OH * OW, C * KH * KW} x {C * KH * KW, K} ---> {N * OH * OW, K} ---> {N, OH, OW, K} ---> {N, K, OH, OW}
+      const xt::xarray<float> col = util::XtensorIm2col(x, W.shape(2), W.shape(3), stride_, pad_);
+      xt::xarray<float> W_col = W;
+      W_col.reshape({K, W.size() / K});
+      xt::xarray<float> y_col = xt::linalg::dot(col, xt::transpose(W_col));
+      y_col.reshape({N, OH, OW, K});
+      y = xt::transpose(y_col, {0, 3, 1, 2});
+    }
+
+    // y = conv(x, W) + b
+    xt::xarray<float> b_4D = b;
+    b_4D.reshape({1, K, 1, 1});
+    y += b_4D;
+
+    return {y};
+  }
+
+  // NOTE: The backward calculation always uses the im2col formulation (in both of the paths of the forward
+  // NOTE: calculation), because the Winograd transforms are only cheaper for the small 3x3 filter.
+  const std::vector<xt::xarray<float>> Backward(const std::vector<xt::xarray<float>>& dL_dys) override {
+    const xt::xarray<float>& dL_dy = dL_dys[0];  // {N, K, OH, OW}
+    const xt::xarray<float>& x = input_tensor_ptrs_[0]->data();
+    const xt::xarray<float>& W = input_tensor_ptrs_[1]->data();
+
+    const std::size_t K = W.shape(0);
+
+    const xt::xarray<float> col = util::XtensorIm2col(x, W.shape(2), W.shape(3), stride_, pad_);
+    xt::xarray<float> W_col = W;
+    W_col.reshape({K, W.size() / K});
+
+    // {N, K, OH, OW} ---> {N, OH, OW, K} ---> {N * OH * OW, K}
+    xt::xarray<float> dL_dy_col = xt::transpose(dL_dy, {0, 2, 3, 1});
+    dL_dy_col.reshape({dL_dy.size() / K, K});
+
+    // y_col = col W_col.T ---> dL_dcol = dL_dy_col W_col ---> dL_dx = col2im(dL_dcol)
+    const xt::xarray<float> dL_dcol = xt::linalg::dot(dL_dy_col, W_col);
+    const xt::xarray<float> dL_dx = util::XtensorCol2im(dL_dcol, x.shape(), W.shape(2), W.shape(3), stride_, pad_);
+
+    // y_col = col W_col.T ---> dL_dW_col = dL_dy_col.T col
+    xt::xarray<float> dL_dW = xt::linalg::dot(xt::transpose(dL_dy_col), col);
+    dL_dW.reshape(W.shape());
+
+    // y = conv(x, W) + b ---> dL_db = sum(dL_dy) along with all of the axes except the output channel axis.
+    const xt::xarray<float> dL_db = xt::sum(dL_dy, {0, 2, 3});
+
+    return {dL_dx, dL_dW, dL_db};
+  }
+
+  const std::size_t stride() const { return stride_; }
+
+  const std::size_t pad() const { return pad_; }
+
+  const std::shared_ptr<const util::WinogradFilter> winograd_filter_ptr() const { return winograd_filter_ptr_; }
+
+ private:
+  const bool IsWinogradPath(const xt::xarray<float>::shape_type& W_shape) const {
+    return core::Config::instance().config_value(core::Config::kDoesUseWinogradConvolution) &&
+           util::IsWinogradEligible(W_shape, stride_);
+  }
+
+  std::size_t stride_;
+
+  std::size_t pad_;
+
+  std::shared_ptr<const util::WinogradFilter> winograd_filter_ptr_;
+};
+
+const core::TensorSharedPtr conv2d(const core::TensorSharedPtr input_tensor_ptr0,
+                                   const core::TensorSharedPtr input_tensor_ptr1,
+                                   const core::TensorSharedPtr input_tensor_ptr2, const std::size_t stride = 1,
+                                   const std::size_t pad = 0,
+                                   const std::shared_ptr<const util::WinogradFilter>& winograd_filter_ptr = nullptr) {
+  // Creates an function (dynamically in heap memory so that it's accessible even after exiting this scope), and
+  // performs the forward calculation and the computational graph growth.
+  const core::FunctionSharedPtr conv2d_function_ptr = std::make_shared<Conv2d>(stride, pad, winograd_filter_ptr);
+  const std::vector<core::TensorSharedPtr> output_tensor_ptrs =
+      conv2d_function_ptr->Call({input_tensor_ptr0, input_tensor_ptr1, input_tensor_ptr2});
+
+  return output_tensor_ptrs[0];
+}
+
+}  // namespace tensorward::function
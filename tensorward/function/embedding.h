@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <xtensor/xarray.hpp>
+
+#include "tensorward/core/function.h"
+#include "tensorward/core/parameter.h"
+#include "tensorward/core/tensor.h"
+#include "tensorward/util/xtensor_gather_scatter.h"
+
+namespace tensorward::function {
+
+// Looks up the rows of the lookup table "W" at the ids, and accumulates the row-sparse gradient into "W" in backward.
+//
+//   ids: {...} (integral values stored as float), W: {V, D} ---> y: {..., D}
+//
+// NOTE: "W" is held as a member (instead of an input) of this function, because the backpropagation would accumulate
+// NOTE: a dense gradient as big as the whole lookup table into an input. The gradient of the ids is always zero.
+class Embedding : public core::Function {
+ public:
+  Embedding(const core::ParameterSharedPtr W_ptr)
+      : core::Function({.num_inputs = 1, .num_outputs = 1}), W_ptr_(W_ptr) {}
+
+  ~Embedding() {}
+
+  const std::vector<xt::xarray<float>> Forward(const core::ConstXarrayRefs& xs) override {
+    const xt::xarray<float>& ids = xs[0];
+    const xt::xarray<float>& W = W_ptr_->data();
+    assert((static_cast<void>("`W.dimension()` must be 2 {V, D}."), W.dimension() == 2));
+
+    // {M, D} ---> {..., D}
+    xt::xarray<float> y = util::XtensorGatherRows(W, ToRowIndices(ids));
+    xt::xarray<float>::shape_type y_shape = ids.shape();
+    y_shape.push_back(W.shape(1));
+    y.reshape(y_shape);
+
+    std::vector<xt::xarray<float>> ys;
+    ys.push_back(std::move(y));
+    return ys;
+  }
+
+  const std::vector<xt::xarray<float>> Backward(const std::vector<xt::xarray<float>>& dL_dys) override {
+    const xt::xarray<float>& dL_dy = dL_dys[0];
+    const xt::xarray<float>& ids = input_tensor_ptrs_[0]->data();
+    const std::size_t D = W_ptr_->data().shape(1);
+
+    // {..., D} ---> {M, D}
+    xt::xarray<float> dL_dW_rows = dL_dy;
+    dL_dW_rows.reshape({ids.size(), D});
+    W_ptr_->AccumulateSparseGrad(ToRowIndices(ids), dL_dW_rows);
+
+    const xt::xarray<float> dL_dids = xt::zeros_like(ids);
+
+    return {dL_dids};
+  }
+
+  const core::ParameterSharedPtr W_ptr() const { return W_ptr_; }
+
+ private:
+  const std::vector<std::size_t> ToRowIndices(const xt::xarray<float>& ids) const {
+    std::vector<std::size_t> row_indices;
+    row_indices.reserve(ids.size());
+    for (const float id : ids) {
+      assert((static_cast<void>("Each id must be a non-negative integer."), 0.0 <= id && std::floor(id) == id));
+      row_indices.push_back(static_cast<std::size_t>(id));
+    }
+    return row_indices;
+  }
+
+  core::ParameterSharedPtr W_ptr_;
+};
+
+const core::TensorSharedPtr embedding(const core::TensorSharedPtr input_tensor_ptr,
+                                      const core::ParameterSharedPtr W_ptr) {
+  // Creates an function (dynamically in heap memory so that it's accessible even after exiting this scope), and
+  // performs the forward calculation and the computational graph growth.
+  const core::FunctionSharedPtr embedding_function_ptr = std::make_shared<Embedding>(W_ptr);
+  const std::vector<core::TensorSharedPtr> output_tensor_ptrs = embedding_function_ptr->Call({input_tensor_ptr});
+
+  return output_tensor_ptrs[0];
+}
+
+}  // namespace tensorward::function
@@ -2,54 +2,83 @@
 
 #include <cassert>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include <xtensor/xarray.hpp>
-#include <xtensor/xindex_view.hpp>
 
 #include "tensorward/core/function.h"
 #include "tensorward/core/tensor.h"
+#include "tensorward/util/xtensor_gather_scatter.h"
 
 namespace tensorward::function {
 
 class GetItem : public core::Function {
  public:
+  // Extracts the elements at the (full) multi-dimensional indices, e.g. `{{0, 0}, {1, 2}}` ---> {2}
   GetItem(const std::vector<xt::xindex>& indices)
-      : core::Function({.num_inputs = 1, .num_outputs = 1}), indices_(indices) {}
+      : core::Function({.num_inputs = 1, .num_outputs = 1}), indices_(indices), row_indices_opt_(std::nullopt) {}
+
+  // Extracts the rows (the sub-arrays along the leading axis) at the row indices, e.g. `{0, 2}` ---> {2, ...}
+  GetItem(const std::vector<std::size_t>& row_indices)
+      : core::Function({.num_inputs = 1, .num_outputs = 1}), row_indices_opt_(row_indices) {}
 
   ~GetItem() {}
 
-  const std::vector<xt::xarray<float>> Forward(const std::vector<xt::xarray<float>>& xs) override {
-    const xt::xarray<float> y = xt::index_view(xs[0], indices_);
+  const std::vector<xt::xarray<float>> Forward(const core::ConstXarrayRefs& xs) override {
+    const xt::xarray<float>& x = xs[0];
+
+    std::vector<xt::xarray<float>> ys;
+    if (row_indices_opt_.has_value()) {
+      ys.push_back(util::XtensorGatherRows(x, row_indices_opt_.value()));
+    } else {
+      ys.push_back(util::XtensorGather(x, util::XtensorFlatOffsets(x.shape(), indices_)));
+    }
 
-    return {y};
+    return ys;
   }
 
   const std::vector<xt::xarray<float>> Backward(const std::vector<xt::xarray<float>>& dL_dys) override {
     const xt::xarray<float>& dL_dy = dL_dys[0];
     const xt::xarray<float>& x = input_tensor_ptrs_[0]->data();
 
-    xt::xarray<float> dL_dx = xt::zeros_like(x);
-    for (std::size_t i = 0; i < indices_.size(); ++i) {
-      const std::vector<xt::xindex> ith_index_vector({indices_[i]});
-      xt::index_view(dL_dx, ith_index_vector) += dL_dy[i];
+    // Accumulates the gradient into the extracted positions (duplicated positions are accumulated multiple times).
+    std::vector<xt::xarray<float>> dL_dxs;
+    if (row_indices_opt_.has_value()) {
+      dL_dxs.push_back(util::XtensorScatterAddRows(dL_dy, row_indices_opt_.value(), x.shape()));
+    } else {
+      dL_dxs.push_back(util::XtensorScatterAdd(dL_dy, util::XtensorFlatOffsets(x.shape(), indices_), x.shape()));
     }
 
-    return {dL_dx};
+    return dL_dxs;
   }
 
   const std::vector<xt::xindex>& indices() const { return indices_; }
 
+  const std::optional<std::vector<std::size_t>>& row_indices_opt() const { return row_indices_opt_; }
+
  private:
   std::vector<xt::xindex> indices_;
+
+  std::optional<std::vector<std::size_t>> row_indices_opt_;
 };
 
 const core::TensorSharedPtr get_item(const core::TensorSharedPtr input_tensor_ptr,
                                      const std::vector<xt::xindex>& indices) {
   // Creates an function (dynamically in heap memory so that it's accessible even after exiting this scope), and
   // performs the forward calculation and the computational graph growth.
-  const core::FunctionSharedPtr transpose_function_ptr = std::make_shared<GetItem>(indices);
-  const std::vector<core::TensorSharedPtr> output_tensor_ptrs = transpose_function_ptr->Call({input_tensor_ptr});
+  const core::FunctionSharedPtr get_item_function_ptr = std::make_shared<GetItem>(indices);
+  const std::vector<core::TensorSharedPtr> output_tensor_ptrs = get_item_function_ptr->Call({input_tensor_ptr});
+
+  return output_tensor_ptrs[0];
+}
+
+const core::TensorSharedPtr get_item(const core::TensorSharedPtr input_tensor_ptr,
+                                     const std::vector<std::size_t>& row_indices) {
+  // Creates an function (dynamically in heap memory so that it's accessible even after exiting this scope), and
+  // performs the forward calculation and the computational graph growth.
+  const core::FunctionSharedPtr get_item_function_ptr = std::make_shared<GetItem>(row_indices);
+  const std::vector<core::TensorSharedPtr> output_tensor_ptrs = get_item_function_ptr->Call({input_tensor_ptr});
 
   return output_tensor_ptrs[0];
 }
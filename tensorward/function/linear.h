@@ -18,7 +18,7 @@ class Linear : public core::Function {
 
   ~Linear() {}
 
-  const std::vector<xt::xarray<float>> Forward(const std::vector<xt::xarray<float>>& xs) override {
+  const std::vector<xt::xarray<float>> Forward(const core::ConstXarrayRefs& xs) override {
     const xt::xarray<float>& x = xs[0];
     const xt::xarray<float>& W = xs[1];
     const xt::xarray<float>& b = xs[2];
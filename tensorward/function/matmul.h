@@ -17,7 +17,7 @@ class Matmul : public core::Function {
 
   ~Matmul() {}
 
-  const std::vector<xt::xarray<float>> Forward(const std::vector<xt::xarray<float>>& xs) override {
+  const std::vector<xt::xarray<float>> Forward(const core::ConstXarrayRefs& xs) override {
     const xt::xarray<float>& x = xs[0];
     const xt::xarray<float>& W = xs[1];
 
@@ -17,7 +17,7 @@ class MeanSquaredError : public core::Function {
 
   ~MeanSquaredError() {}
 
-  const std::vector<xt::xarray<float>> Forward(const std::vector<xt::xarray<float>>& xs) override {
+  const std::vector<xt::xarray<float>> Forward(const core::ConstXarrayRefs& xs) override {
     assert(xs[0].shape() == xs[1].shape());
     const std::size_t& num_data = xs[0].shape(0);
 
@@ -7,6 +7,7 @@
 
 #include "tensorward/core/function.h"
 #include "tensorward/core/tensor.h"
+#include "tensorward/util/xtensor_rank.h"
 
 namespace tensorward::function {
 
@@ -16,9 +17,10 @@ class Pow : public core::Function {
 
   ~Pow() {}
 
-  const std::vector<xt::xarray<float>> Forward(const std::vector<xt::xarray<float>>& xs) override {
+  const std::vector<xt::xarray<float>> Forward(const core::ConstXarrayRefs& xs) override {
     // y = x^e
-    const xt::xarray<float> y = xt::pow(xs[0], exponent_);
+    const xt::xarray<float> y = util::XtensorEvaluateWithRank(
+        xs[0].shape(), [exponent = exponent_](const auto& x) { return xt::pow(x, exponent); }, xs[0]);
 
     return {y};
   }
@@ -28,8 +30,12 @@ class Pow : public core::Function {
     const xt::xarray<float>& x = input_tensor_ptrs_[0]->data();
 
     // y = x^e ---> dy_dx = e * x^(e - 1) ---> dL_dx = dL_dy * dy_dx = dL_dy * (e * x^(e - 1))
-    const xt::xarray<float> dy_dx = static_cast<float>(exponent_) * xt::pow(x, exponent_ - 1);
-    const xt::xarray<float> dL_dx = dL_dy * dy_dx;
+    const xt::xarray<float> dL_dx = util::XtensorEvaluateWithRank(
+        dL_dy.shape(),
+        [exponent = exponent_](const auto& dL_dy, const auto& x) {
+          return dL_dy * (static_cast<float>(exponent) * xt::pow(x, exponent - 1));
+        },
+        dL_dy, x);
 
     return {dL_dx};
   }
@@ -7,6 +7,7 @@
 
 #include "tensorward/core/function.h"
 #include "tensorward/core/tensor.h"
+#include "tensorward/util/xtensor_rank.h"
 
 namespace tensorward::function {
 
@@ -16,9 +17,10 @@ class ReLU : public core::Function {
 
   ~ReLU() {}
 
-  const std::vector<xt::xarray<float>> Forward(const std::vector<xt::xarray<float>>& xs) override {
+  const std::vector<xt::xarray<float>> Forward(const core::ConstXarrayRefs& xs) override {
     // y = x (if 0 < x), y = 0 (if x <= 0) ---> y = max(0, x)
-    const xt::xarray<float> y = xt::maximum(xt::zeros_like(xs[0]), xs[0]);
+    const xt::xarray<float> y =
+        util::XtensorEvaluateWithRank(xs[0].shape(), [](const auto& x) { return xt::maximum(x, 0.0f); }, xs[0]);
 
     return {y};
   }
@@ -28,8 +30,8 @@ class ReLU : public core::Function {
     const xt::xarray<float>& x = input_tensor_ptrs_[0]->data();
 
     // y = x (if 0 < x), y = 0 (if x <= 0) ---> dy_dx = 1 (if 0 < x), dy_dx = 0 (if x <= 0) ---> dy_dx is like a mask.
-    const xt::xarray<float> dy_dx = (0.0 < x);
-    const xt::xarray<float> dL_dx = dL_dy * dy_dx;
+    const xt::xarray<float> dL_dx = util::XtensorEvaluateWithRank(
+        dL_dy.shape(), [](const auto& dL_dy, const auto& x) { return dL_dy * xt::cast<float>(0.0 < x); }, dL_dy, x);
 
     return {dL_dx};
   }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include <xtensor/xarray.hpp>
@@ -17,33 +18,60 @@ class Reshape : public core::Function {
 
   ~Reshape() {}
 
-  const std::vector<xt::xarray<float>> Forward(const std::vector<xt::xarray<float>>& xs) override {
+  const std::vector<xt::xarray<float>> Forward(const core::ConstXarrayRefs& xs) override {
+    // NOTE: The reshaped copy is moved into the returned vector, because `return {y};` copies it again.
     xt::xarray<float> y = xs[0];
     y.reshape(output_shape_);
 
-    return {y};
+    std::vector<xt::xarray<float>> ys;
+    ys.push_back(std::move(y));
+    return ys;
+  }
+
+  // Views the data storage of the input in the output shape without copying it. Only if the input is a non-contiguous
+  // view (e.g. the output of `Transpose`), its elements are evaluated into a contiguous array first.
+  const std::vector<core::TensorSharedPtr> ForwardViews(
+      const std::vector<core::TensorSharedPtr>& input_tensor_ptrs) override {
+    const core::TensorSharedPtr& x = input_tensor_ptrs[0];
+    input_shape_ = x->shape();
+
+    const core::TensorView x_view = x->view();
+    const bool is_contiguous = core::IsContiguousView(x_view);
+    const std::shared_ptr<const xt::xarray<float>> data_ptr = is_contiguous ? x->data_ptr() : x->contiguous_data_ptr();
+    const core::TensorView y_view{.shape = output_shape_,
+                                  .strides = core::RowMajorStrides(output_shape_),
+                                  .offset = is_contiguous ? x_view.offset : 0};
+
+    return {std::make_shared<core::Tensor>(data_ptr, y_view)};
   }
 
   const std::vector<xt::xarray<float>> Backward(const std::vector<xt::xarray<float>>& dL_dys) override {
     const xt::xarray<float>& dL_dy = dL_dys[0];
-    const xt::xarray<float>::shape_type& x_shape = input_tensor_ptrs_[0]->data().shape();
+    // NOTE: `input_shape_` is used instead of the shape of the input data, so as not to evaluate the input if it's a
+    // NOTE: view. It's empty if only `Forward()` is called (e.g. in the tests), where the input is never a view.
+    const xt::xarray<float>::shape_type& x_shape =
+        input_shape_.empty() ? input_tensor_ptrs_[0]->data().shape() : input_shape_;
 
     xt::xarray<float> dL_dx = dL_dy;
     dL_dx.reshape(x_shape);
 
-    return {dL_dx};
+    std::vector<xt::xarray<float>> dL_dxs;
+    dL_dxs.push_back(std::move(dL_dx));
+    return dL_dxs;
   }
 
   const xt::xarray<float>::shape_type& output_shape() const { return output_shape_; }
 
  private:
   xt::xarray<float>::shape_type output_shape_;
+
+  xt::xarray<float>::shape_type input_shape_;
 };
 
 const core::TensorSharedPtr reshape(const core::TensorSharedPtr input_tensor_ptr,
                                     const xt::xarray<float>::shape_type& output_shape) {
   // If the input shape is the same as the output shape, then no need to reshape.
-  if (input_tensor_ptr->data().shape() == output_shape) {
+  if (input_tensor_ptr->shape() == output_shape) {
     return input_tensor_ptr;
   }
 
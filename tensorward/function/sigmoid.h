@@ -7,6 +7,7 @@
 
 #include "tensorward/core/function.h"
 #include "tensorward/core/tensor.h"
+#include "tensorward/util/xtensor_rank.h"
 
 namespace tensorward::function {
 
@@ -16,9 +17,10 @@ class Sigmoid : public core::Function {
 
   ~Sigmoid() {}
 
-  const std::vector<xt::xarray<float>> Forward(const std::vector<xt::xarray<float>>& xs) override {
+  const std::vector<xt::xarray<float>> Forward(const core::ConstXarrayRefs& xs) override {
     // y = 1 / (1 + exp(-x))
-    const xt::xarray<float> y = 1.0 / (1.0 + xt::exp(-xs[0]));
+    const xt::xarray<float> y = util::XtensorEvaluateWithRank(
+        xs[0].shape(), [](const auto& x) { return 1.0 / (1.0 + xt::exp(-x)); }, xs[0]);
 
     return {y};
   }
@@ -28,8 +30,8 @@ class Sigmoid : public core::Function {
     const xt::xarray<float>& y = output_tensor_ptrs_[0].lock()->data();
 
     // y = 1 / (1 + exp(-x)) ---> dy_dx = y * (1 - y) ---> dL_dx = dL_dy * dy_dx = dL_dy * y * (1 - y)
-    const xt::xarray<float> dy_dx = y * (1.0 - y);
-    const xt::xarray<float> dL_dx = dL_dy * dy_dx;
+    const xt::xarray<float> dL_dx = util::XtensorEvaluateWithRank(
+        dL_dy.shape(), [](const auto& dL_dy, const auto& y) { return dL_dy * (y * (1.0 - y)); }, dL_dy, y);
 
     return {dL_dx};
   }
@@ -19,7 +19,7 @@ class SoftmaxCrossEntropyError : public core::Function {
 
   ~SoftmaxCrossEntropyError() {}
 
-  const std::vector<xt::xarray<float>> Forward(const std::vector<xt::xarray<float>>& xs) override {
+  const std::vector<xt::xarray<float>> Forward(const core::ConstXarrayRefs& xs) override {
     const xt::xarray<float>& x = xs[0];  // score
     const xt::xarray<float>& t = xs[1];  // label
 
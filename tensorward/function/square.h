@@ -7,6 +7,7 @@
 
 #include "tensorward/core/function.h"
 #include "tensorward/core/tensor.h"
+#include "tensorward/util/xtensor_rank.h"
 
 namespace tensorward::function {
 
@@ -16,9 +17,10 @@ class Square : public core::Function {
 
   ~Square() {}
 
-  const std::vector<xt::xarray<float>> Forward(const std::vector<xt::xarray<float>>& xs) override {
+  const std::vector<xt::xarray<float>> Forward(const core::ConstXarrayRefs& xs) override {
     // y = x^2
-    const xt::xarray<float> y = xt::square(xs[0]);
+    const xt::xarray<float> y =
+        util::XtensorEvaluateWithRank(xs[0].shape(), [](const auto& x) { return xt::square(x); }, xs[0]);
 
     return {y};
   }
@@ -28,8 +30,8 @@ class Square : public core::Function {
     const xt::xarray<float>& x = input_tensor_ptrs_[0]->data();
 
     // y = x^2 ---> dy_dx = 2x ---> dL_dx = dL_dy * dy_dx = dL_dy * 2x
-    const xt::xarray<float> dy_dx = 2 * x;
-    const xt::xarray<float> dL_dx = dL_dy * dy_dx;
+    const xt::xarray<float> dL_dx = util::XtensorEvaluateWithRank(
+        dL_dy.shape(), [](const auto& dL_dy, const auto& x) { return dL_dy * (2 * x); }, dL_dy, x);
 
     return {dL_dx};
   }
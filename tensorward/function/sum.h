@@ -1,14 +1,18 @@
 #pragma once
 
+#include <functional>
 #include <list>
 #include <memory>
+#include <numeric>
 #include <optional>
 #include <vector>
 
 #include <xtensor/xarray.hpp>
 
+#include "tensorward/core/config.h"
 #include "tensorward/core/function.h"
 #include "tensorward/core/tensor.h"
+#include "tensorward/util/thread_pool.h"
 
 namespace tensorward::function {
 
@@ -19,11 +23,27 @@ class Sum : public core::Function {
 
   ~Sum() {}
 
-  const std::vector<xt::xarray<float>> Forward(const std::vector<xt::xarray<float>>& xs) override {
+  const std::vector<xt::xarray<float>> Forward(const core::ConstXarrayRefs& xs) override {
     // NOTE: Ternary operator like `y = does_keep_dims_ ? xt::sum(x, xt::keep_dims) : xt::sum(x);` doesn't work,
     // NOTE: so we use if-else statement instead. 
     xt::xarray<float> y;
-    if (axes_opt_.has_value()) {
+    if (!axes_opt_.has_value() && 2 * util::kDefaultGrainSize <= xs[0].size()) {
+      // Sums up the chunks in parallel, and then their partial sums in the order of the chunks (see
+      // `Config::kDoesUseDeterministicReduction`).
+      const float* x_data = xs[0].data();
+      const float sum = util::ThreadPool::instance().ParallelReduce(
+          std::size_t(0), xs[0].size(), util::kDefaultGrainSize, 0.0f,
+          [x_data](const std::size_t begin, const std::size_t end) {
+            return std::accumulate(x_data + begin, x_data + end, 0.0f);
+          },
+          std::plus<float>(), core::Config::instance().config_value(core::Config::kDoesUseDeterministicReduction));
+      if (does_keep_dims_) {
+        y = xt::xarray<float>::from_shape(xt::xarray<float>::shape_type(xs[0].dimension(), 1));
+        y.fill(sum);
+      } else {
+        y = xt::xarray<float>(sum);
+      }
+    } else if (axes_opt_.has_value()) {
       if (does_keep_dims_) {
         y = xt::sum(xs[0], axes_opt_.value(), xt::keep_dims);
       } else {
@@ -0,0 +1,130 @@
+#include "tensorward/function/conv2d.h"
+
+#include <gtest/gtest.h>
+#include <xtensor/xrandom.hpp>
+
+#include "tensorward/core/config.h"
+
+namespace tensorward::function {
+
+namespace {
+
+constexpr int kDataSize = 2;
+constexpr int kInChannel = 3;
+constexpr int kOutChannel = 4;
+constexpr int kHeight = 10;
+constexpr int kWidth = 10;
+constexpr int kKernelSize = 3;
+constexpr int kStride = 1;
+constexpr int kPad = 1;
+
+constexpr float kRelativeTolerance = 1.0e-4;
+constexpr float kAbsoluteTolerance = 1.0e-4;
+
+}  // namespace
+
+class Conv2dTest : public ::testing::Test {
+ protected:
+  Conv2dTest()
+      : input_data0_(xt::random::randn<float>({kDataSize, kInChannel, kHeight, kWidth})),            // x
+        input_data1_(xt::random::randn<float>({kOutChannel, kInChannel, kKernelSize, kKernelSize})),  // W
+        input_data2_(xt::random::randn<float>({kOutChannel})),                                        // b
+        conv2d_function_ptr_(std::make_shared<Conv2d>(kStride, kPad)) {}
+
+  const xt::xarray<float> input_data0_;
+  const xt::xarray<float> input_data1_;
+  const xt::xarray<float> input_data2_;
+  const core::FunctionSharedPtr conv2d_function_ptr_;
+};
+
+TEST_F(Conv2dTest, ForwardTest) {
+  const std::vector<xt::xarray<float>> actual_input_datas({input_data0_, input_data1_, input_data2_});
+
+  // The 3x3 kernel with stride 1 is eligible for the Winograd path (enabled by default).
+  const std::vector<xt::xarray<float>> actual_output_datas = conv2d_function_ptr_->Forward(actual_input_datas);
+  ASSERT_EQ(actual_output_datas.size(), 1);
+
+  // The im2col path (the Winograd path disabled).
+  std::vector<xt::xarray<float>> expected_output_datas;
+  {
+    core::UseConfig with(core::Config::kDoesUseWinogradConvolution, false);
+    expected_output_datas = conv2d_function_ptr_->Forward(actual_input_datas);
+  }
+  ASSERT_EQ(expected_output_datas.size(), 1);
+
+  // Checks that the output shape is {N, K, OH, OW}.
+  const xt::xarray<float>::shape_type expected_output_shape({kDataSize, kOutChannel, kHeight, kWidth});
+  EXPECT_EQ(actual_output_datas[0].shape(), expected_output_shape);
+
+  // Checks that the Winograd path matches the im2col path within the numeric tolerance.
+  EXPECT_TRUE(xt::allclose(actual_output_datas[0], expected_output_datas[0], kRelativeTolerance, kAbsoluteTolerance));
+}
+
+TEST_F(Conv2dTest, BackwardTest) {
+  // NOTE: Need to use `Call()` instead of `Forward()` in order to create the computational graph for `Backward()`.
+  const std::vector<core::TensorSharedPtr> actual_input_tensors({core::AsTensorSharedPtr(input_data0_),
+                                                                 core::AsTensorSharedPtr(input_data1_),
+                                                                 core::AsTensorSharedPtr(input_data2_)});
+  const std::vector<core::TensorSharedPtr> actual_output_tensors = conv2d_function_ptr_->Call(actual_input_tensors);
+  ASSERT_EQ(actual_output_tensors.size(), 1);
+
+  const xt::xarray<float> output_grad = xt::random::randn<float>(actual_output_tensors[0]->data().shape());
+  const std::vector<xt::xarray<float>> actual_output_grads({output_grad});
+  const std::vector<xt::xarray<float>> actual_input_grads = conv2d_function_ptr_->Backward(actual_output_grads);
+  ASSERT_EQ(actual_input_grads.size(), 3);
+
+  // Checks that the shape of the gradient is the same as the shape of the corresponding data.
+  ASSERT_EQ(actual_input_grads.size(), actual_input_tensors.size());
+  for (std::size_t i = 0; i < actual_input_grads.size(); ++i) {
+    EXPECT_EQ(actual_input_grads[i].shape(), actual_input_tensors[i]->data().shape());
+  }
+
+  // Because y = conv(x, W) + b is linear in each of x and W, the gradients satisfy the adjoint identities:
+  //   <dL_dy, conv(x, W)> = <dL_dx, x> = <dL_dW, W>
+  xt::xarray<float> b_4D = input_data2_;
+  b_4D.reshape({1, kOutChannel, 1, 1});
+  const xt::xarray<float> conv_output_data = actual_output_tensors[0]->data() - b_4D;
+  const float expected_inner_product = xt::sum(output_grad * conv_output_data)();
+  const float actual_inner_product_x = xt::sum(actual_input_grads[0] * input_data0_)();
+  const float actual_inner_product_W = xt::sum(actual_input_grads[1] * input_data1_)();
+
+  // Checks that the backward calculation is correct (analytically).
+  EXPECT_NEAR(actual_inner_product_x, expected_inner_product, 1.0e-2);
+  EXPECT_NEAR(actual_inner_product_W, expected_inner_product, 1.0e-2);
+  const xt::xarray<float> expected_input_grad2 = xt::sum(output_grad, {0, 2, 3});
+  EXPECT_TRUE(xt::allclose(actual_input_grads[2], expected_input_grad2));
+}
+
+TEST_F(Conv2dTest, CallWrapperTest) {
+  const core::TensorSharedPtr input_tensor_ptr0 = core::AsTensorSharedPtr(input_data0_);
+  const core::TensorSharedPtr input_tensor_ptr1 = core::AsTensorSharedPtr(input_data1_);
+  const core::TensorSharedPtr input_tensor_ptr2 = core::AsTensorSharedPtr(input_data2_);
+
+  // `conv2d()` is a `Function::Call()` wrapper.
+  const core::TensorSharedPtr output_tensor_ptr =
+      conv2d(input_tensor_ptr0, input_tensor_ptr1, input_tensor_ptr2, kStride, kPad);
+
+  // Checks that the output data is correct.
+  const std::vector<xt::xarray<float>> expected_output_datas =
+      conv2d_function_ptr_->Forward({input_data0_, input_data1_, input_data2_});
+  EXPECT_EQ(output_tensor_ptr->data(), expected_output_datas[0]);
+
+  // Checks that the computational graph is correct.
+  //
+  // The correct computational graph is:
+  //    input_tensors <--- this_function <==> output_tensors
+  //
+  // The code below checks it with the following order:
+  // 1. input_tensors      this_function <--- output_tensors
+  // 2. input_tensors <--- this_function      output_tensors
+  // 3. input_tensors      this_function ---> output_tensors
+  //
+  ASSERT_TRUE(output_tensor_ptr->parent_function_ptr());
+  const core::FunctionSharedPtr parent_function_ptr = output_tensor_ptr->parent_function_ptr();
+  EXPECT_EQ(parent_function_ptr->input_tensor_ptrs()[0], input_tensor_ptr0);
+  EXPECT_EQ(parent_function_ptr->input_tensor_ptrs()[1], input_tensor_ptr1);
+  EXPECT_EQ(parent_function_ptr->input_tensor_ptrs()[2], input_tensor_ptr2);
+  EXPECT_EQ(parent_function_ptr->output_tensor_ptrs()[0].lock(), output_tensor_ptr);
+}
+
+}  // namespace tensorward::function
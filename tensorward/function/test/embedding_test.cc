@@ -0,0 +1,106 @@
+#include "tensorward/function/embedding.h"
+
+#include <gtest/gtest.h>
+#include <xtensor/xrandom.hpp>
+#include <xtensor/xview.hpp>
+
+#include "tensorward/core/parameter.h"
+
+namespace tensorward::function {
+
+namespace {
+
+constexpr int kNumEmbeddings = 5;
+constexpr int kEmbeddingSize = 3;
+
+}  // namespace
+
+class EmbeddingTest : public ::testing::Test {
+ protected:
+  EmbeddingTest()
+      : W_ptr_(core::AsParameterSharedPtr(xt::random::rand<float>({kNumEmbeddings, kEmbeddingSize}))),
+        ids_({{1.0, 3.0, 1.0},
+              {0.0, 4.0, 1.0}}),  // Looks up the 2nd row three times.
+        embedding_function_ptr_(std::make_shared<Embedding>(W_ptr_)) {}
+
+  const core::ParameterSharedPtr W_ptr_;
+  const xt::xarray<float> ids_;
+  const core::FunctionSharedPtr embedding_function_ptr_;
+};
+
+TEST_F(EmbeddingTest, ForwardTest) {
+  const std::vector<xt::xarray<float>> actual_input_datas({ids_});
+  const std::vector<xt::xarray<float>> actual_output_datas = embedding_function_ptr_->Forward(actual_input_datas);
+  ASSERT_EQ(actual_output_datas.size(), 1);
+
+  // Checks that the output shape is the ids shape followed by the embedding size.
+  const xt::xarray<float>& actual_output_data = actual_output_datas[0];
+  const xt::xarray<float>::shape_type expected_output_shape({ids_.shape(0), ids_.shape(1), kEmbeddingSize});
+  ASSERT_EQ(actual_output_data.shape(), expected_output_shape);
+
+  // Checks that the forward calculation is correct.
+  for (std::size_t i = 0; i < ids_.shape(0); ++i) {
+    for (std::size_t j = 0; j < ids_.shape(1); ++j) {
+      const std::size_t id = static_cast<std::size_t>(ids_(i, j));
+      EXPECT_EQ(xt::xarray<float>(xt::view(actual_output_data, i, j)), xt::xarray<float>(xt::view(W_ptr_->data(), id)));
+    }
+  }
+}
+
+TEST_F(EmbeddingTest, BackwardTest) {
+  // NOTE: Need to use `Call()` instead of `Forward()` in order to create the computational graph for `Backward()`.
+  const std::vector<core::TensorSharedPtr> actual_input_tensors({core::AsTensorSharedPtr(ids_)});
+  const std::vector<core::TensorSharedPtr> actual_output_tensors = embedding_function_ptr_->Call(actual_input_tensors);
+  ASSERT_EQ(actual_output_tensors.size(), 1);
+
+  const std::vector<xt::xarray<float>> actual_output_grads({xt::ones_like(actual_output_tensors[0]->data())});
+  const std::vector<xt::xarray<float>> actual_input_grads = embedding_function_ptr_->Backward(actual_output_grads);
+  ASSERT_EQ(actual_input_grads.size(), 1);
+
+  // Checks that the gradient of the ids is zero.
+  EXPECT_EQ(actual_input_grads[0], xt::zeros_like(ids_));
+
+  // Checks that only the row-sparse gradient (not the dense one) is accumulated into the lookup table.
+  ASSERT_FALSE(W_ptr_->grad_opt().has_value());
+  ASSERT_TRUE(W_ptr_->sparse_grad_opt().has_value());
+  EXPECT_EQ(W_ptr_->sparse_grad().row_indices, std::vector<std::size_t>({1, 3, 1, 0, 4, 1}));
+
+  // clang-format off
+  // Because we looked up the 2nd row three times, the 2nd row of the expected gradient is all 3.0 (= 1.0 * 3).
+  const xt::xarray<float> expected_W_grad({{1.0, 1.0, 1.0},
+                                           {3.0, 3.0, 3.0},
+                                           {0.0, 0.0, 0.0},
+                                           {1.0, 1.0, 1.0},
+                                           {1.0, 1.0, 1.0}});
+  // clang-format on
+
+  // Checks that the backward calculation is correct (analytically).
+  EXPECT_EQ(core::DensifyRowSparseGrad(W_ptr_->sparse_grad(), W_ptr_->data().shape()), expected_W_grad);
+}
+
+TEST_F(EmbeddingTest, CallWrapperTest) {
+  const core::TensorSharedPtr input_tensor_ptr = core::AsTensorSharedPtr(ids_);
+
+  // `embedding()` is a `Function::Call()` wrapper.
+  const core::TensorSharedPtr output_tensor_ptr = embedding(input_tensor_ptr, W_ptr_);
+
+  // Checks that the output data is correct.
+  EXPECT_EQ(output_tensor_ptr->data(), embedding_function_ptr_->Forward({ids_})[0]);
+
+  // Checks that the computational graph is correct.
+  //
+  // The correct computational graph is:
+  //    input_tensors <--- this_function <==> output_tensors
+  //
+  // The code below checks it with the following order:
+  // 1. input_tensors      this_function <--- output_tensors
+  // 2. input_tensors <--- this_function      output_tensors
+  // 3. input_tensors      this_function ---> output_tensors
+  //
+  ASSERT_TRUE(output_tensor_ptr->parent_function_ptr());
+  const core::FunctionSharedPtr parent_function_ptr = output_tensor_ptr->parent_function_ptr();
+  EXPECT_EQ(parent_function_ptr->input_tensor_ptrs()[0], input_tensor_ptr);
+  EXPECT_EQ(parent_function_ptr->output_tensor_ptrs()[0].lock(), output_tensor_ptr);
+}
+
+}  // namespace tensorward::function
@@ -1,7 +1,10 @@
 #include "tensorward/function/get_item.h"
 
 #include <gtest/gtest.h>
+#include <xtensor/xbuilder.hpp>
+#include <xtensor/xindex_view.hpp>
 #include <xtensor/xrandom.hpp>
+#include <xtensor/xview.hpp>
 
 namespace tensorward::function {
 
@@ -18,12 +21,18 @@ class GetItemTest : public ::testing::Test {
       : input_data_(xt::random::rand<float>({kHeight, kWidth})),
         indices_({{0, 0}, {0, 1}, {0, 2}, {0, 0}, {0, 1}, {0, 2}}),  // Extracts the 1st row twice.
         expected_output_data_(xt::index_view(input_data_, indices_)),
-        get_item_function_ptr_(std::make_shared<GetItem>(indices_)) {}
+        get_item_function_ptr_(std::make_shared<GetItem>(indices_)),
+        row_indices_({0, 0}),  // Extracts the 1st row twice (with the leading-axis indexing).
+        expected_row_output_data_(xt::stack(xt::xtuple(xt::view(input_data_, 0), xt::view(input_data_, 0)))),
+        get_rows_function_ptr_(std::make_shared<GetItem>(row_indices_)) {}
 
   const xt::xarray<float> input_data_;
   const std::vector<xt::xindex> indices_;
   const xt::xarray<float> expected_output_data_;
   const core::FunctionSharedPtr get_item_function_ptr_;
+  const std::vector<std::size_t> row_indices_;
+  const xt::xarray<float> expected_row_output_data_;
+  const core::FunctionSharedPtr get_rows_function_ptr_;
 };
 
 TEST_F(GetItemTest, ForwardTest) {
@@ -86,4 +95,33 @@ TEST_F(GetItemTest, CallWrapperTest) {
   EXPECT_EQ(parent_function_ptr->output_tensor_ptrs()[0].lock(), output_tensor_ptr);
 }
 
+TEST_F(GetItemTest, RowForwardTest) {
+  const std::vector<xt::xarray<float>> actual_input_datas({input_data_});
+  const std::vector<xt::xarray<float>> actual_output_datas = get_rows_function_ptr_->Forward(actual_input_datas);
+  ASSERT_EQ(actual_output_datas.size(), 1);
+
+  // Checks that the forward calculation is correct.
+  EXPECT_EQ(actual_output_datas[0], expected_row_output_data_);
+}
+
+TEST_F(GetItemTest, RowBackwardTest) {
+  // NOTE: Need to use `Call()` instead of `Forward()` in order to create the computational graph for `Backward()`.
+  const std::vector<core::TensorSharedPtr> actual_input_tensors({core::AsTensorSharedPtr(input_data_)});
+  const std::vector<core::TensorSharedPtr> actual_output_tensors = get_rows_function_ptr_->Call(actual_input_tensors);
+  ASSERT_EQ(actual_output_tensors.size(), 1);
+
+  const std::vector<xt::xarray<float>> actual_output_grads({xt::ones_like(actual_output_tensors[0]->data())});
+  const std::vector<xt::xarray<float>> actual_input_grads = get_rows_function_ptr_->Backward(actual_output_grads);
+  ASSERT_EQ(actual_input_grads.size(), 1);
+
+  // clang-format off
+  // Because we extracted the 1st row twice, the 1st row of the expected input gradient is all 2.0 (= 1.0 * 2).
+  const xt::xarray<float> expected_input_grad({{2.0, 2.0, 2.0},
+                                               {0.0, 0.0, 0.0}});
+  // clang-format on
+
+  // Checks that the backward calculation is correct (analytically).
+  EXPECT_EQ(actual_input_grads[0], expected_input_grad);
+}
+
 }  // namespace tensorward::function
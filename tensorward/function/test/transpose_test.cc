@@ -1,8 +1,11 @@
 #include "tensorward/function/transpose.h"
 
 #include <gtest/gtest.h>
+#include <xtensor/xmanipulation.hpp>
 #include <xtensor/xrandom.hpp>
 
+#include "tensorward/function/reshape.h"
+
 namespace tensorward::function {
 
 namespace {
@@ -80,4 +83,34 @@ TEST_F(TransposeTest, CallWrapperTest) {
   EXPECT_EQ(parent_function_ptr->output_tensor_ptrs()[0].lock(), output_tensor_ptr);
 }
 
+TEST_F(TransposeTest, ReshapeTransposeViewTest) {
+  const core::TensorSharedPtr input_tensor_ptr = core::AsTensorSharedPtr(input_data_);
+
+  // Reshapes the input into the vector and back, and then transposes it, and reshapes the transpose again.
+  const core::TensorSharedPtr vector_tensor_ptr = reshape(input_tensor_ptr, {kHeight * kWidth});
+  const core::TensorSharedPtr matrix_tensor_ptr = reshape(vector_tensor_ptr, {kHeight, kWidth});
+  const core::TensorSharedPtr transposed_tensor_ptr = transpose(matrix_tensor_ptr);
+
+  // Checks that none of the outputs copies the data storage of the input.
+  EXPECT_EQ(vector_tensor_ptr->data_ptr(), input_tensor_ptr->data_ptr());
+  EXPECT_EQ(matrix_tensor_ptr->data_ptr(), input_tensor_ptr->data_ptr());
+  EXPECT_EQ(transposed_tensor_ptr->data_ptr(), input_tensor_ptr->data_ptr());
+
+  // Checks that the shapes are correct without evaluating the views, and the data is correct.
+  EXPECT_EQ(transposed_tensor_ptr->shape(), xt::xarray<float>::shape_type({kWidth, kHeight}));
+  EXPECT_EQ(vector_tensor_ptr->data(), xt::flatten(input_data_));
+  EXPECT_EQ(matrix_tensor_ptr->data(), input_data_);
+  EXPECT_EQ(transposed_tensor_ptr->data(), expected_output_data_);
+
+  // The transpose isn't contiguous, so reshaping it evaluates it into a contiguous array (only once).
+  const core::TensorSharedPtr flattened_tensor_ptr = reshape(transposed_tensor_ptr, {kHeight * kWidth});
+  EXPECT_EQ(flattened_tensor_ptr->data_ptr(), transposed_tensor_ptr->contiguous_data_ptr());
+  EXPECT_EQ(flattened_tensor_ptr->data(), xt::flatten(expected_output_data_));
+
+  // Checks that the gradient flows back through the views in the original shape.
+  flattened_tensor_ptr->Backpropagation();
+  ASSERT_TRUE(input_tensor_ptr->grad_opt().has_value());
+  EXPECT_EQ(input_tensor_ptr->grad(), xt::ones_like(input_data_));
+}
+
 }  // namespace tensorward::function
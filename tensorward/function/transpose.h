@@ -1,6 +1,8 @@
 #pragma once
 
+#include <algorithm>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include <xtensor/xarray.hpp>
@@ -18,24 +20,45 @@ class Transpose : public core::Function {
 
   ~Transpose() {}
 
-  const std::vector<xt::xarray<float>> Forward(const std::vector<xt::xarray<float>>& xs) override {
-    const xt::xarray<float> y = xt::transpose(xs[0]);
+  const std::vector<xt::xarray<float>> Forward(const core::ConstXarrayRefs& xs) override {
+    xt::xarray<float> y = xt::transpose(xs[0]);
 
-    return {y};
+    std::vector<xt::xarray<float>> ys;
+    ys.push_back(std::move(y));
+    return ys;
+  }
+
+  // Views the data storage of the input with the reversed shape and strides without copying it.
+  const std::vector<core::TensorSharedPtr> ForwardViews(
+      const std::vector<core::TensorSharedPtr>& input_tensor_ptrs) override {
+    const core::TensorSharedPtr& x = input_tensor_ptrs[0];
+
+    core::TensorView y_view = x->view();
+    std::reverse(y_view.shape.begin(), y_view.shape.end());
+    std::reverse(y_view.strides.begin(), y_view.strides.end());
+
+    return {std::make_shared<core::Tensor>(x->data_ptr(), y_view)};
   }
 
   const std::vector<xt::xarray<float>> Backward(const std::vector<xt::xarray<float>>& dL_dys) override {
     const xt::xarray<float>& dL_dy = dL_dys[0];
 
-    const xt::xarray<float> dL_dx = xt::transpose(dL_dy);
+    xt::xarray<float> dL_dx = xt::transpose(dL_dy);
 
-    return {dL_dx};
+    std::vector<xt::xarray<float>> dL_dxs;
+    dL_dxs.push_back(std::move(dL_dx));
+    return dL_dxs;
   }
 };
 
 // TODO: Extend `transpose()` function to accept optional `permutation` as an input argument.
 // TODO: e.g. `transpose(..., xt::xarray<float>::shape_type& permutation = None) { ... }`
 const core::TensorSharedPtr transpose(const core::TensorSharedPtr input_tensor_ptr) {
+  // If the input is a scalar or a vector, then the transpose is the same as the input, so no need to transpose.
+  if (input_tensor_ptr->shape().size() <= 1) {
+    return input_tensor_ptr;
+  }
+
   // Creates an function (dynamically in heap memory so that it's accessible even after exiting this scope), and
   // performs the forward calculation and the computational graph growth.
   const core::FunctionSharedPtr transpose_function_ptr = std::make_shared<Transpose>();
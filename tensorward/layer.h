@@ -1,4 +1,6 @@
 #pragma once
 
 // Header file aggregation for users.
+#include "tensorward/layer/conv2d.h"
+#include "tensorward/layer/embedding.h"
 #include "tensorward/layer/linear.h"
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <xtensor/xarray.hpp>
+#include <xtensor/xrandom.hpp>
+
+#include "tensorward/core/config.h"
+#include "tensorward/core/layer.h"
+#include "tensorward/core/parameter.h"
+#include "tensorward/core/tensor.h"
+#include "tensorward/function/conv2d.h"
+#include "tensorward/util/xtensor_im2col.h"
+#include "tensorward/util/xtensor_winograd.h"
+
+namespace tensorward::layer {
+
+class Conv2d : public core::Layer {
+ public:
+  Conv2d(const std::size_t out_channels, const std::size_t kernel_size, const std::size_t stride = 1,
+         const std::size_t pad = 0)
+      : out_channels_(out_channels),
+        kernel_size_(kernel_size),
+        stride_(stride),
+        pad_(pad),
+        W_name_("W"),
+        b_name_("b"),
+        winograd_filter_version_(0) {}
+
+  ~Conv2d() {}
+
+  const std::vector<core::TensorSharedPtr> Forward(
+      const std::vector<core::TensorSharedPtr>& input_tensor_ptrs) override {
+    const core::TensorSharedPtr x_ptr = input_tensor_ptrs[0];
+
+    if (param_map_.count(W_name_) == 0) {
+      // Initializes the weight "W".
+      const std::size_t in_channels = x_ptr->data().shape(1);
+      const float scale = std::sqrt(1.0 / (in_channels * kernel_size_ * kernel_size_));  // Xavier initialization.
+      const core::ParameterSharedPtr W_ptr = core::AsParameterSharedPtr(
+          scale * xt::random::randn<float>({out_channels_, in_channels, kernel_size_, kernel_size_}), W_name_);
+      param_map_[W_name_] = W_ptr;
+    }
+
+    if (param_map_.count(b_name_) == 0) {
+      // Initializes the bias "b".
+      const core::ParameterSharedPtr b_ptr = core::AsParameterSharedPtr(xt::zeros<float>({out_channels_}), b_name_);
+      param_map_[b_name_] = b_ptr;
+    }
+
+    UpdateWinogradFilterCacheIfNeeded(x_ptr->data().shape());
+
+    const core::TensorSharedPtr output_tensor_ptr = function::conv2d(
+        x_ptr, param_map_.at(W_name_), param_map_.at(b_name_), stride_, pad_, winograd_filter_cache_ptr_);
+
+    return {output_tensor_ptr};
+  }
+
+  const std::size_t out_channels() const { return out_channels_; }
+
+  const std::size_t kernel_size() const { return kernel_size_; }
+
+  const std::size_t stride() const { return stride_; }
+
+  const std::size_t pad() const { return pad_; }
+
+  const std::string W_name() const { return W_name_; }
+
+  const std::string b_name() const { return b_name_; }
+
+  const std::shared_ptr<const util::WinogradFilter> winograd_filter_cache_ptr() const {
+    return winograd_filter_cache_ptr_;
+  }
+
+ private:
+  // Transforms the weight "W" for the Winograd path only when the weight has been updated (e.g. by an optimizer) since
+  // the last transform, so that the filter transform is amortized over all of the forward calculations in between.
+  void UpdateWinogradFilterCacheIfNeeded(const xt::xarray<float>::shape_type& x_shape) {
+    const core::ParameterSharedPtr W_ptr = param_map_.at(W_name_);
+
+    const bool is_winograd_path = core::Config::instance().config_value(core::Config::kDoesUseWinogradConvolution) &&
+                                  util::IsWinogradEligible(W_ptr->data().shape(), stride_);
+    if (!is_winograd_path) {
+      winograd_filter_cache_ptr_ = nullptr;
+      return;
+    }
+
+    const std::size_t OH = util::ConvOutputSize(x_shape[2], kernel_size_, stride_, pad_);
+    const std::size_t OW = util::ConvOutputSize(x_shape[3], kernel_size_, stride_, pad_);
+    const std::size_t output_tile_size = util::SelectWinogradOutputTileSize(OH, OW);
+
+    const bool is_cache_valid = winograd_filter_cache_ptr_ &&
+                                winograd_filter_cache_ptr_->output_tile_size == output_tile_size &&
+                                winograd_filter_version_ == W_ptr->version();
+    if (!is_cache_valid) {
+      winograd_filter_cache_ptr_ = std::make_shared<const util::WinogradFilter>(
+          util::XtensorWinogradFilterTransform(W_ptr->data(), output_tile_size));
+      winograd_filter_version_ = W_ptr->version();
+    }
+  }
+
+  std::size_t out_channels_;
+
+  std::size_t kernel_size_;
+
+  std::size_t stride_;
+
+  std::size_t pad_;
+
+  std::string W_name_;
+
+  std::string b_name_;
+
+  std::shared_ptr<const util::WinogradFilter> winograd_filter_cache_ptr_;
+
+  std::size_t winograd_filter_version_;
+};
+
+}  // namespace tensorward::layer
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <xtensor/xarray.hpp>
+#include <xtensor/xrandom.hpp>
+
+#include "tensorward/core/layer.h"
+#include "tensorward/core/parameter.h"
+#include "tensorward/core/tensor.h"
+#include "tensorward/function/embedding.h"
+
+namespace tensorward::layer {
+
+// Lookup table whose gradient is row-sparse, so that an optimizer can update only the rows looked up in the batch.
+class Embedding : public core::Layer {
+ public:
+  Embedding(const std::size_t num_embeddings, const std::size_t embedding_size)
+      : num_embeddings_(num_embeddings), embedding_size_(embedding_size), W_name_("W") {
+    // Initializes the lookup table "W" (eagerly, because its shape doesn't depend on the input).
+    const core::ParameterSharedPtr W_ptr =
+        core::AsParameterSharedPtr(xt::random::randn<float>({num_embeddings_, embedding_size_}), W_name_);
+    param_map_[W_name_] = W_ptr;
+  }
+
+  ~Embedding() {}
+
+  const std::vector<core::TensorSharedPtr> Forward(
+      const std::vector<core::TensorSharedPtr>& input_tensor_ptrs) override {
+    const core::TensorSharedPtr ids_ptr = input_tensor_ptrs[0];
+
+    const core::TensorSharedPtr output_tensor_ptr = function::embedding(ids_ptr, param_map_.at(W_name_));
+
+    return {output_tensor_ptr};
+  }
+
+  const std::size_t num_embeddings() const { return num_embeddings_; }
+
+  const std::size_t embedding_size() const { return embedding_size_; }
+
+  const std::string W_name() const { return W_name_; }
+
+ private:
+  std::size_t num_embeddings_;
+
+  std::size_t embedding_size_;
+
+  std::string W_name_;
+};
+
+}  // namespace tensorward::layer
@@ -0,0 +1,71 @@
+#include "tensorward/layer/conv2d.h"
+
+#include <gtest/gtest.h>
+#include <xtensor/xrandom.hpp>
+
+#include "tensorward/core/config.h"
+
+namespace tensorward::layer {
+
+namespace {
+
+constexpr int kDataSize = 2;
+constexpr int kInChannel = 3;
+constexpr int kOutChannel = 4;
+constexpr int kHeight = 10;
+constexpr int kWidth = 10;
+constexpr int kKernelSize = 3;
+constexpr int kStride = 1;
+constexpr int kPad = 1;
+
+constexpr float kRelativeTolerance = 1.0e-4;
+constexpr float kAbsoluteTolerance = 1.0e-4;
+
+}  // namespace
+
+class Conv2dTest : public ::testing::Test {
+ protected:
+  Conv2dTest()
+      : input_tensor_ptr_(core::AsTensorSharedPtr(xt::random::randn<float>({kDataSize, kInChannel, kHeight, kWidth}))),
+        conv2d_layer_ptr_(std::make_shared<layer::Conv2d>(kOutChannel, kKernelSize, kStride, kPad)) {}
+
+  const core::TensorSharedPtr input_tensor_ptr_;
+  const std::shared_ptr<layer::Conv2d> conv2d_layer_ptr_;
+};
+
+TEST_F(Conv2dTest, ForwardTest) {
+  const std::vector<core::TensorSharedPtr> actual_output_tensor_ptrs = conv2d_layer_ptr_->Forward({input_tensor_ptr_});
+  ASSERT_EQ(actual_output_tensor_ptrs.size(), 1);
+
+  // There should exist 2 parameters: weight "W", bias "b".
+  ASSERT_EQ(conv2d_layer_ptr_->param_map().size(), 2);
+
+  // Checks that the output shape is {N, K, OH, OW}.
+  const xt::xarray<float>::shape_type expected_output_shape({kDataSize, kOutChannel, kHeight, kWidth});
+  EXPECT_EQ(actual_output_tensor_ptrs[0]->data().shape(), expected_output_shape);
+
+  // Checks that the Winograd path (with the cached filter) matches the im2col path within the numeric tolerance.
+  core::UseConfig with(core::Config::kDoesUseWinogradConvolution, false);
+  const std::vector<core::TensorSharedPtr> expected_output_tensor_ptrs =
+      conv2d_layer_ptr_->Forward({input_tensor_ptr_});
+  EXPECT_TRUE(xt::allclose(actual_output_tensor_ptrs[0]->data(), expected_output_tensor_ptrs[0]->data(),
+                           kRelativeTolerance, kAbsoluteTolerance));
+}
+
+TEST_F(Conv2dTest, WinogradFilterCacheTest) {
+  conv2d_layer_ptr_->Forward({input_tensor_ptr_});
+  const std::shared_ptr<const util::WinogradFilter> first_cache_ptr = conv2d_layer_ptr_->winograd_filter_cache_ptr();
+  ASSERT_TRUE(first_cache_ptr);
+
+  // Checks that the cached filter is reused as long as the weight "W" is not updated.
+  conv2d_layer_ptr_->Forward({input_tensor_ptr_});
+  EXPECT_EQ(conv2d_layer_ptr_->winograd_filter_cache_ptr(), first_cache_ptr);
+
+  // Checks that the cached filter is transformed again once the weight "W" is updated (e.g. by an optimizer).
+  const core::ParameterSharedPtr W_ptr = conv2d_layer_ptr_->param_map().at(conv2d_layer_ptr_->W_name());
+  W_ptr->SeData(W_ptr->data() * 2.0);
+  conv2d_layer_ptr_->Forward({input_tensor_ptr_});
+  EXPECT_NE(conv2d_layer_ptr_->winograd_filter_cache_ptr(), first_cache_ptr);
+}
+
+}  // namespace tensorward::layer
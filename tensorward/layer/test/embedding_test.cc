@@ -0,0 +1,108 @@
+#include "tensorward/layer/embedding.h"
+
+#include <gtest/gtest.h>
+#include <xtensor/xmath.hpp>
+#include <xtensor/xrandom.hpp>
+#include <xtensor/xview.hpp>
+
+#include "tensorward/core/parameter.h"
+#include "tensorward/core/tensor.h"
+#include "tensorward/optimizer/momentum_stochastic_gradient_descent.h"
+#include "tensorward/optimizer/stochastic_gradient_descent.h"
+
+namespace tensorward::layer {
+
+namespace {
+
+constexpr int kNumEmbeddings = 6;
+constexpr int kEmbeddingSize = 4;
+constexpr float kLearningRate = 0.1;
+constexpr float kMomentum = 0.9;
+
+}  // namespace
+
+class EmbeddingTest : public ::testing::Test {
+ protected:
+  EmbeddingTest()
+      : embedding_layer_ptr_(std::make_shared<layer::Embedding>(kNumEmbeddings, kEmbeddingSize)),
+        ids_tensor_ptr_(core::AsTensorSharedPtr(xt::xarray<float>({2.0, 5.0, 2.0}))),  // Looks up the 3rd row twice.
+        touched_rows_({2, 5}),
+        untouched_rows_({0, 1, 3, 4}) {}
+
+  // Performs the forward and backward calculation with the sum of the looked up rows as the loss, so that the
+  // gradient of each looked up row is all 1.0 (per lookup).
+  const core::ParameterSharedPtr ForwardBackward() {
+    embedding_layer_ptr_->ClearGrads();
+    const core::TensorSharedPtr output_tensor_ptr = embedding_layer_ptr_->Call({ids_tensor_ptr_})[0];
+    output_tensor_ptr->SetGradOpt(xt::ones_like(output_tensor_ptr->data()));
+    output_tensor_ptr->Backpropagation();
+    return embedding_layer_ptr_->param_map().at(embedding_layer_ptr_->W_name());
+  }
+
+  const std::shared_ptr<layer::Embedding> embedding_layer_ptr_;
+  const core::TensorSharedPtr ids_tensor_ptr_;
+  const std::vector<std::size_t> touched_rows_;
+  const std::vector<std::size_t> untouched_rows_;
+};
+
+TEST_F(EmbeddingTest, ForwardTest) {
+  const std::vector<core::TensorSharedPtr> actual_output_tensor_ptrs = embedding_layer_ptr_->Call({ids_tensor_ptr_});
+  ASSERT_EQ(actual_output_tensor_ptrs.size(), 1);
+
+  // There should exist 1 parameter: lookup table "W".
+  ASSERT_EQ(embedding_layer_ptr_->param_map().size(), 1);
+  const xt::xarray<float>& W_data = embedding_layer_ptr_->param_map().at(embedding_layer_ptr_->W_name())->data();
+  ASSERT_EQ(W_data.shape(), xt::xarray<float>::shape_type({kNumEmbeddings, kEmbeddingSize}));
+
+  // Checks that the forward calculation is correct.
+  const xt::xarray<float>& actual_output_data = actual_output_tensor_ptrs[0]->data();
+  const xt::xarray<float>& ids_data = ids_tensor_ptr_->data();
+  for (std::size_t i = 0; i < ids_data.size(); ++i) {
+    EXPECT_EQ(xt::xarray<float>(xt::view(actual_output_data, i)),
+              xt::xarray<float>(xt::view(W_data, static_cast<std::size_t>(ids_data(i)))));
+  }
+}
+
+TEST_F(EmbeddingTest, SparseStochasticGradientDescentTest) {
+  const core::ParameterSharedPtr W_ptr = ForwardBackward();
+  ASSERT_FALSE(W_ptr->grad_opt().has_value());
+  ASSERT_TRUE(W_ptr->sparse_grad_opt().has_value());
+
+  // Expects the same result as the dense update.
+  const xt::xarray<float> dense_grad = core::DensifyRowSparseGrad(W_ptr->sparse_grad(), W_ptr->data().shape());
+  const xt::xarray<float> expected_W_data = W_ptr->data() - kLearningRate * dense_grad;
+
+  optimizer::StochasticGradientDescent stochastic_gradient_descent_optimizer(kLearningRate);
+  stochastic_gradient_descent_optimizer.Update({W_ptr});
+
+  // Checks that the lazy update is correct.
+  EXPECT_TRUE(xt::allclose(W_ptr->data(), expected_W_data));
+}
+
+TEST_F(EmbeddingTest, SparseMomentumStochasticGradientDescentTest) {
+  optimizer::MomentumStochasticGradientDescent momentum_stochastic_gradient_descent_optimizer(kLearningRate, kMomentum);
+
+  const core::ParameterSharedPtr W_ptr = ForwardBackward();
+  const xt::xarray<float> initial_W_data = W_ptr->data();
+  const xt::xarray<float> dense_grad = core::DensifyRowSparseGrad(W_ptr->sparse_grad(), W_ptr->data().shape());
+
+  // Two steps with the same ids, so that the velocity of the touched rows is accumulated.
+  momentum_stochastic_gradient_descent_optimizer.Update({W_ptr});
+  ForwardBackward();
+  momentum_stochastic_gradient_descent_optimizer.Update({W_ptr});
+
+  // v1 = - lr * g,  v2 = m * v1 - lr * g,  p2 = p0 + v1 + v2
+  const xt::xarray<float> v1 = -kLearningRate * dense_grad;
+  const xt::xarray<float> v2 = kMomentum * v1 - kLearningRate * dense_grad;
+  const xt::xarray<float> expected_W_data = initial_W_data + v1 + v2;
+
+  // Checks that the touched rows are updated with the momentum, and the untouched rows are not updated at all.
+  for (const std::size_t row : touched_rows_) {
+    EXPECT_TRUE(xt::allclose(xt::view(W_ptr->data(), row), xt::view(expected_W_data, row)));
+  }
+  for (const std::size_t row : untouched_rows_) {
+    EXPECT_EQ(xt::xarray<float>(xt::view(W_ptr->data(), row)), xt::xarray<float>(xt::view(initial_W_data, row)));
+  }
+}
+
+}  // namespace tensorward::layer
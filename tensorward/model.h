@@ -2,3 +2,6 @@
 
 // Header file aggregation for users.
 #include "tensorward/model/multi_layer_perceptron.h"
+#include "tensorward/model/pipeline_multi_layer_perceptron.h"
+#include "tensorward/model/quantized_multi_layer_perceptron.h"
+#include "tensorward/model/static_multi_layer_perceptron.h"
@@ -0,0 +1,350 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <xtensor/xarray.hpp>
+#include <xtensor/xbuilder.hpp>
+#include <xtensor/xview.hpp>
+
+#include "tensorward/core/layer.h"
+#include "tensorward/core/tensor.h"
+#include "tensorward/function/relu.h"
+#include "tensorward/function/sigmoid.h"
+#include "tensorward/model/multi_layer_perceptron.h"
+#include "tensorward/util/numa.h"
+#include "tensorward/util/spsc_queue.h"
+
+namespace tensorward::model {
+
+// Pipeline-parallel training of `MultiLayerPerceptron` across the cores: the layers are partitioned into the stages of
+// about the same number of the parameters, each stage runs on its own thread (pinned to its own core), and each batch
+// is split into the micro-batches which flow through the stages. The stages pass the activations forward and the
+// gradients backward through the lock-free SPSC queues (see `util::SpscQueue`), sharing the data storages instead of
+// copying them.
+//
+// Each stage runs the 1F1B (one forward, one backward) schedule: the stage s runs the forward calculations of the first
+// (num_stages - 1 - s) micro-batches to fill the pipeline, then alternates the forward calculation of the next
+// micro-batch and the backward calculation of the oldest one, and finally drains the backward calculations. So at most
+// (num_stages - s) micro-batches are in flight at the stage s (instead of all of them), which bounds the memory of the
+// stashed activations, while all of the stages are busy in the steady state.
+//
+//   stage 0: F0 F1 F2 F3 B0 F4 B1 F5 B2 ...
+//   stage 1:    F0 F1 F2 B0 F3 B1 F4 B2 ...
+//   stage 2:       F0 F1 B0 F2 B1 F3 B2 ...
+//   stage 3:          F0 B0 F1 B1 F2 B2 ...
+//
+// The gradients of the micro-batches are accumulated into the parameters of the model, scaled so that their sum is the
+// gradient of the mean loss of the whole batch (i.e. the same as without the pipeline up to the rounding errors).
+//
+// e.g.
+//
+//   model.Predict({first_batch_x_ptr});  // Initializes the parameters.
+//   PipelineMultiLayerPerceptron pipeline(model, 4, 8, function::softmax_cross_entropy_error);
+//   for (...) {
+//     model.ClearGrads();
+//     const float loss = pipeline.ForwardBackward(batch_x, batch_t);
+//     optimizer.Update(model.GetParamPtrs());
+//   }
+//
+// NOTE: The model must have performed the forward calculation (to initialize the parameters), and the activation
+// NOTE: function must be either `function::ReLU` or `function::Sigmoid`, which is created for each call instead of
+// NOTE: being shared by the stages. Don't change `core::Config` while `ForwardBackward()` is running, because the
+// NOTE: stages read it concurrently.
+class PipelineMultiLayerPerceptron {
+ public:
+  // Loss function of (the prediction, the label), e.g. `function::softmax_cross_entropy_error`.
+  using LossLambda = std::function<core::TensorSharedPtr(const core::TensorSharedPtr, const core::TensorSharedPtr)>;
+
+  // If `does_pin_threads` is true, then the thread of the stage s is pinned to `stage_cpus[s]`. By default (if
+  // `stage_cpus` is empty), the stages take the CPUs from the end of `util::CpusSpreadOverNumaNodes()`, while the
+  // pinned workers of `util::ThreadPool` take the ones from its beginning, so they don't share a CPU as long as the
+  // pool leaves enough CPUs (e.g. `util::ThreadPool::ResetInstance(num_cores - 1 - num_stages, true)`).
+  PipelineMultiLayerPerceptron(const MultiLayerPerceptron& model, const std::size_t num_stages,
+                               const std::size_t num_micro_batches, const LossLambda& loss_lambda,
+                               const bool does_pin_threads = true, const std::vector<int>& stage_cpus = {})
+      : num_micro_batches_(num_micro_batches),
+        loss_lambda_(loss_lambda),
+        batch_x_ptr_(nullptr),
+        batch_t_ptr_(nullptr),
+        loss_(0.0),
+        step_(0),
+        num_finished_stages_(0),
+        is_stopping_(false) {
+    const std::vector<core::LayerSharedPtr>& layer_ptrs = model.layer_ptrs();
+    assert((static_cast<void>("The number of the stages must be in [1, the number of the layers]."),
+            1 <= num_stages && num_stages <= layer_ptrs.size()));
+    assert((static_cast<void>("The number of the micro-batches must be positive."), 1 <= num_micro_batches));
+
+    const bool does_use_relu = std::dynamic_pointer_cast<function::ReLU>(model.activation_function_ptr()) != nullptr;
+    assert((static_cast<void>("The activation function must be either `function::ReLU` or `function::Sigmoid`."),
+            does_use_relu || std::dynamic_pointer_cast<function::Sigmoid>(model.activation_function_ptr())));
+    activation_ = does_use_relu ? function::relu : function::sigmoid;
+
+    // Partitions the layers at the boundaries where the cumulative number of the parameters crosses each 1/num_stages
+    // of the total, leaving at least one layer for each stage.
+    std::vector<std::size_t> cumulative_num_params(layer_ptrs.size() + 1, 0);
+    for (std::size_t i = 0; i < layer_ptrs.size(); ++i) {
+      assert((static_cast<void>("The model must have performed the forward calculation."),
+              !layer_ptrs[i]->param_map().empty()));
+      std::size_t num_params = 0;
+      for (const auto& [param_name, param_ptr] : layer_ptrs[i]->param_map()) {
+        num_params += param_ptr->data().size();
+      }
+      cumulative_num_params[i + 1] = cumulative_num_params[i] + num_params;
+    }
+    std::vector<std::size_t> boundaries = {0};
+    for (std::size_t s = 1; s < num_stages; ++s) {
+      const std::size_t target_num_params = cumulative_num_params.back() * s / num_stages;
+      std::size_t boundary = boundaries.back() + 1;
+      while (boundary < layer_ptrs.size() - (num_stages - s) && cumulative_num_params[boundary] < target_num_params) {
+        ++boundary;
+      }
+      boundaries.push_back(boundary);
+    }
+    boundaries.push_back(layer_ptrs.size());
+
+    stages_.resize(num_stages);
+    for (std::size_t s = 0; s < num_stages; ++s) {
+      stages_[s].layer_ptrs.assign(layer_ptrs.begin() + boundaries[s], layer_ptrs.begin() + boundaries[s + 1]);
+    }
+    // The queues never block, because they can hold all of the micro-batches.
+    for (std::size_t s = 0; s + 1 < num_stages; ++s) {
+      forward_queue_ptrs_.push_back(std::make_unique<Queue>(num_micro_batches));
+      backward_queue_ptrs_.push_back(std::make_unique<Queue>(num_micro_batches));
+    }
+
+    assert((static_cast<void>("The CPUs of the stages must be given for each stage (or none)."),
+            stage_cpus.empty() || stage_cpus.size() == num_stages));
+    if (does_pin_threads) {
+      stage_cpus_ = stage_cpus;
+      const std::vector<int> cpus = util::CpusSpreadOverNumaNodes();
+      for (std::size_t s = 0; stage_cpus.empty() && !cpus.empty() && s < num_stages; ++s) {
+        stage_cpus_.push_back(cpus[cpus.size() - 1 - s % cpus.size()]);
+      }
+    }
+    for (std::size_t s = 0; s < num_stages; ++s) {
+      threads_.emplace_back(&PipelineMultiLayerPerceptron::Run, this, s);
+      if (!stage_cpus_.empty()) {
+        util::PinThreadToCpu(threads_.back().native_handle(), stage_cpus_[s]);
+      }
+    }
+  }
+
+  // Stops the threads of the stages.
+  ~PipelineMultiLayerPerceptron() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      is_stopping_ = true;
+    }
+    condition_variable_.notify_all();
+    for (std::thread& thread : threads_) {
+      thread.join();
+    }
+  }
+
+  // Prevents copy construction.
+  PipelineMultiLayerPerceptron(const PipelineMultiLayerPerceptron&) = delete;
+
+  // Prevents copy assignment.
+  PipelineMultiLayerPerceptron& operator=(const PipelineMultiLayerPerceptron&) = delete;
+
+  // Performs the forward and the backward calculations of the batch through the pipeline, accumulates the gradients
+  // into the parameters of the model, and returns the mean loss of the batch.
+  //
+  //   batch_x: {N, ...}, batch_t: {N, ...}  (N >= the number of the micro-batches)
+  //
+  const float ForwardBackward(const xt::xarray<float>& batch_x, const xt::xarray<float>& batch_t) {
+    assert((static_cast<void>("The batch must have at least one sample for each micro-batch."),
+            num_micro_batches_ <= batch_x.shape(0) && batch_x.shape(0) == batch_t.shape(0)));
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    batch_x_ptr_ = &batch_x;
+    batch_t_ptr_ = &batch_t;
+    loss_ = 0.0;
+    num_finished_stages_ = 0;
+    ++step_;
+    condition_variable_.notify_all();
+    condition_variable_.wait(lock, [this] { return num_finished_stages_ == stages_.size(); });
+    batch_x_ptr_ = nullptr;
+    batch_t_ptr_ = nullptr;
+    return loss_;
+  }
+
+  const std::size_t num_stages() const { return stages_.size(); }
+
+  const std::size_t num_micro_batches() const { return num_micro_batches_; }
+
+  // Layers of each stage.
+  const std::vector<core::LayerSharedPtr>& stage_layer_ptrs(const std::size_t s) const {
+    return stages_[s].layer_ptrs;
+  }
+
+  // CPU which the thread of each stage is pinned to, which is empty if the threads aren't pinned.
+  const std::vector<int>& stage_cpus() const { return stage_cpus_; }
+
+ private:
+  // Data passed between the stages, which shares the storage of the tensor (never modified in place).
+  using Queue = util::SpscQueue<std::shared_ptr<const xt::xarray<float>>>;
+
+  // Micro-batch whose forward calculation is done but backward calculation isn't.
+  struct StashedMicroBatch {
+    std::size_t micro_batch_index;
+
+    core::TensorSharedPtr input_tensor_ptr;
+
+    // Output of the stage, which is the loss at the last stage.
+    core::TensorSharedPtr output_tensor_ptr;
+  };
+
+  struct Stage {
+    std::vector<core::LayerSharedPtr> layer_ptrs;
+
+    // In the order of the micro-batches.
+    std::deque<StashedMicroBatch> stashed_micro_batches;
+  };
+
+  // Main loop of the thread of the stage, which runs the schedule once for each `ForwardBackward()`.
+  void Run(const std::size_t s) {
+    std::size_t last_step = 0;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_variable_.wait(lock, [this, last_step] { return step_ != last_step || is_stopping_; });
+        if (is_stopping_) {
+          break;
+        }
+        last_step = step_;
+      }
+
+      // 1F1B schedule.
+      const std::size_t num_warmup_micro_batches = std::min(stages_.size() - 1 - s, num_micro_batches_);
+      std::size_t num_forward_micro_batches = 0;
+      while (num_forward_micro_batches < num_warmup_micro_batches) {
+        Forward(s, num_forward_micro_batches++);
+      }
+      while (num_forward_micro_batches < num_micro_batches_) {
+        Forward(s, num_forward_micro_batches++);
+        Backward(s);
+      }
+      while (!stages_[s].stashed_micro_batches.empty()) {
+        Backward(s);
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++num_finished_stages_;
+      }
+      condition_variable_.notify_all();
+    }
+  }
+
+  // [begin, end) of the samples of the micro-batch in the batch.
+  const std::pair<std::size_t, std::size_t> MicroBatchRange(const std::size_t m) const {
+    const std::size_t batch_size = batch_x_ptr_->shape(0);
+    return {m * batch_size / num_micro_batches_, (m + 1) * batch_size / num_micro_batches_};
+  }
+
+  void Forward(const std::size_t s, const std::size_t m) {
+    Stage& stage = stages_[s];
+    const bool is_first_stage = s == 0;
+    const bool is_last_stage = s + 1 == stages_.size();
+    const auto [begin, end] = MicroBatchRange(m);
+
+    const core::TensorSharedPtr x_ptr =
+        is_first_stage ? core::AsTensorSharedPtr(xt::xarray<float>(xt::view(*batch_x_ptr_, xt::range(begin, end))))
+                       : std::make_shared<core::Tensor>(forward_queue_ptrs_[s - 1]->Pop());
+    core::TensorSharedPtr y_ptr = x_ptr;
+    for (std::size_t i = 0; i < stage.layer_ptrs.size(); ++i) {
+      y_ptr = stage.layer_ptrs[i]->Call({y_ptr})[0];
+      if (!is_last_stage || i + 1 < stage.layer_ptrs.size()) {
+        y_ptr = activation_(y_ptr);
+      }
+    }
+
+    if (is_last_stage) {
+      const core::TensorSharedPtr t_ptr =
+          core::AsTensorSharedPtr(xt::xarray<float>(xt::view(*batch_t_ptr_, xt::range(begin, end))));
+      const core::TensorSharedPtr loss_ptr = loss_lambda_(y_ptr, t_ptr);
+      // Only the last stage writes the loss while the pipeline is running.
+      loss_ += loss_ptr->data()(0) * LossScale(m);
+      stage.stashed_micro_batches.push_back({m, x_ptr, loss_ptr});
+    } else {
+      forward_queue_ptrs_[s]->Push(y_ptr->contiguous_data_ptr());
+      stage.stashed_micro_batches.push_back({m, x_ptr, y_ptr});
+    }
+  }
+
+  // Runs the backward calculation of the oldest micro-batch in flight.
+  void Backward(const std::size_t s) {
+    Stage& stage = stages_[s];
+    const bool is_first_stage = s == 0;
+    const bool is_last_stage = s + 1 == stages_.size();
+    const auto [m, x_ptr, y_ptr] = std::move(stage.stashed_micro_batches.front());
+    stage.stashed_micro_batches.pop_front();
+
+    if (is_last_stage) {
+      // Scales the gradient of the mean loss of the micro-batch into that of the mean loss of the batch.
+      y_ptr->SetGradOpt(xt::xarray<float>(xt::full_like(y_ptr->data(), LossScale(m))));
+    } else {
+      y_ptr->SetGradOpt(*backward_queue_ptrs_[s]->Pop());
+    }
+    y_ptr->Backpropagation();
+
+    if (!is_first_stage) {
+      backward_queue_ptrs_[s - 1]->Push(std::make_shared<const xt::xarray<float>>(x_ptr->ReleaseGrad()));
+    }
+  }
+
+  // Ratio of the size of the micro-batch to that of the batch.
+  const float LossScale(const std::size_t m) const {
+    const auto [begin, end] = MicroBatchRange(m);
+    return static_cast<float>(end - begin) / batch_x_ptr_->shape(0);
+  }
+
+  std::size_t num_micro_batches_;
+
+  LossLambda loss_lambda_;
+
+  std::function<core::TensorSharedPtr(const core::TensorSharedPtr)> activation_;
+
+  std::vector<Stage> stages_;
+
+  // Activations from the stage s to the stage s + 1.
+  std::vector<std::unique_ptr<Queue>> forward_queue_ptrs_;
+
+  // Gradients of the activations from the stage s + 1 to the stage s.
+  std::vector<std::unique_ptr<Queue>> backward_queue_ptrs_;
+
+  const xt::xarray<float>* batch_x_ptr_;
+
+  const xt::xarray<float>* batch_t_ptr_;
+
+  float loss_;
+
+  std::mutex mutex_;
+
+  // Notified when a step is started, when a stage has finished the step and when the threads are stopped.
+  std::condition_variable condition_variable_;
+
+  // Number of the calls of `ForwardBackward()`.
+  std::size_t step_;
+
+  std::size_t num_finished_stages_;
+
+  bool is_stopping_;
+
+  std::vector<int> stage_cpus_;
+
+  std::vector<std::thread> threads_;
+};
+
+}  // namespace tensorward::model
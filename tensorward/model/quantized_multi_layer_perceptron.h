@@ -0,0 +1,125 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <xtensor/xarray.hpp>
+#include <xtensor/xmath.hpp>
+
+#include "tensorward/core/config.h"
+#include "tensorward/core/data_loader.h"
+#include "tensorward/core/function.h"
+#include "tensorward/core/tensor.h"
+#include "tensorward/function/relu.h"
+#include "tensorward/layer/linear.h"
+#include "tensorward/model/multi_layer_perceptron.h"
+#include "tensorward/util/xtensor_quantization.h"
+
+namespace tensorward::model {
+
+// Int8 inference version of `MultiLayerPerceptron` by the post-training quantization:
+//
+//   1. Calibration: runs the float model over the calibration dataset, and collects the range (the max absolute
+//      value) of the input of each linear layer, which determines the scale of the quantized activation.
+//   2. Conversion: quantizes the weight of each linear layer per output channel.
+//   3. Inference: runs the int8 GEMM (with int32 accumulation) for each linear layer. If the activation function is
+//      ReLU, then it's fused into the requantization for the next layer, so the activation stays in int8 between the
+//      layers. Otherwise, the output is dequantized into float, passed through the activation function, and quantized
+//      again. The output of the last layer is dequantized into float.
+//
+// NOTE: This is only for the inference (e.g. serving), so it doesn't grow the computational graph nor have gradients.
+class QuantizedMultiLayerPerceptron {
+ public:
+  QuantizedMultiLayerPerceptron(const MultiLayerPerceptron& model, core::DataLoader& calibration_data_loader)
+      : activation_function_ptr_(model.activation_function_ptr()),
+        does_fuse_relu_(std::dynamic_pointer_cast<function::ReLU>(model.activation_function_ptr()) != nullptr) {
+    Calibrate(model, calibration_data_loader);
+
+    for (const auto& layer_ptr : model.layer_ptrs()) {
+      const std::shared_ptr<layer::Linear> linear_layer_ptr = std::dynamic_pointer_cast<layer::Linear>(layer_ptr);
+      assert((static_cast<void>("All of the layers must be `layer::Linear`."), linear_layer_ptr));
+
+      const xt::xarray<float>& W = linear_layer_ptr->param_map().at(linear_layer_ptr->W_name())->data();
+      const std::optional<xt::xarray<float>> b_opt =
+          linear_layer_ptr->does_use_bias()
+              ? std::make_optional(linear_layer_ptr->param_map().at(linear_layer_ptr->b_name())->data())
+              : std::nullopt;
+      int8_linears_.push_back(util::XtensorQuantizeLinear(W, b_opt));
+    }
+  }
+
+  ~QuantizedMultiLayerPerceptron() {}
+
+  // Performs the int8 inference.
+  //
+  //   x: {N, in_size} ---> y: {N, out_size}
+  //
+  const xt::xarray<float> Predict(const xt::xarray<float>& x) const {
+    assert((static_cast<void>("`x.dimension()` must be 2 {N, in_size}."), x.dimension() == 2));
+
+    std::vector<std::int8_t> h_q = util::XtensorQuantizeInt8(x, input_scales_[0]);
+    for (std::size_t i = 0; i < int8_linears_.size() - 1; ++i) {
+      if (does_fuse_relu_) {
+        h_q = util::Int8LinearRequantize(h_q, input_scales_[i], int8_linears_[i], input_scales_[i + 1],
+                                         /* does_apply_relu = */ true);
+      } else {
+        const xt::xarray<float> h = util::Int8LinearDequantize(h_q, input_scales_[i], int8_linears_[i]);
+        const std::vector<xt::xarray<float>> activated_hs = activation_function_ptr_->Forward({h});
+        h_q = util::XtensorQuantizeInt8(activated_hs[0], input_scales_[i + 1]);
+      }
+    }
+    const xt::xarray<float> y = util::Int8LinearDequantize(h_q, input_scales_.back(), int8_linears_.back());
+
+    return y;
+  }
+
+  const std::vector<util::Int8Linear>& int8_linears() const { return int8_linears_; }
+
+  const std::vector<float>& input_scales() const { return input_scales_; }
+
+  const bool does_fuse_relu() const { return does_fuse_relu_; }
+
+ private:
+  // Collects the max absolute value of the input of each linear layer over all of the batches of the calibration
+  // dataset, and converts them into the scales of the quantized activations.
+  void Calibrate(const MultiLayerPerceptron& model, core::DataLoader& calibration_data_loader) {
+    core::UseConfig with(core::Config::kDoesEnableBackpropagation, false);
+
+    const std::vector<core::LayerSharedPtr>& layer_ptrs = model.layer_ptrs();
+    std::vector<float> max_abs_values(layer_ptrs.size(), 0.0);
+
+    for (std::size_t iteration = 0; iteration < calibration_data_loader.max_iteration(); ++iteration) {
+      const auto [batch_x, batch_t] = calibration_data_loader.GetBatchAt(iteration);
+
+      std::vector<core::TensorSharedPtr> h_ptrs({core::AsTensorSharedPtr(batch_x)});
+      for (std::size_t i = 0; i < layer_ptrs.size(); ++i) {
+        if (0 < i) {
+          h_ptrs = activation_function_ptr_->Call(h_ptrs);
+        }
+        const xt::xarray<float>& h = h_ptrs[0]->data();
+        max_abs_values[i] = std::max<float>(max_abs_values[i], xt::amax(xt::abs(h))());
+        h_ptrs = layer_ptrs[i]->Call(h_ptrs);
+      }
+    }
+
+    input_scales_.reserve(max_abs_values.size());
+    for (const float max_abs_value : max_abs_values) {
+      input_scales_.push_back(util::Int8Scale(max_abs_value));
+    }
+  }
+
+  core::FunctionSharedPtr activation_function_ptr_;
+
+  bool does_fuse_relu_;
+
+  std::vector<util::Int8Linear> int8_linears_;
+
+  // Scale of the (quantized) input of each linear layer.
+  std::vector<float> input_scales_;
+};
+
+}  // namespace tensorward::model
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+#include <xtensor/xfixed.hpp>
+
+#include "tensorward/function/relu.h"
+#include "tensorward/function/sigmoid.h"
+#include "tensorward/layer/linear.h"
+#include "tensorward/model/multi_layer_perceptron.h"
+
+namespace tensorward::model {
+
+// Linear layer whose sizes are compile-time constants.
+template <std::size_t InSize, std::size_t OutSize>
+struct StaticLinear {
+  xt::xtensor_fixed<float, xt::xshape<InSize, OutSize>> W;
+
+  xt::xtensor_fixed<float, xt::xshape<OutSize>> b;
+};
+
+// Fixed-shape inference version of `MultiLayerPerceptron`, whose sizes (including the input size) are given as the
+// template parameters (e.g. `StaticMultiLayerPerceptron<784, 1000, 1000, 10>`), and the batch size is given as the
+// template parameter of `Predict()`. So all of the loop bounds, the strides and the buffer sizes are compile-time
+// constants, which lets the compiler unroll and vectorize the loops, and the inference doesn't allocate any memory (the
+// intermediate activations are on the stack).
+//
+// NOTE: This is only for the inference (e.g. serving), so it doesn't grow the computational graph nor have gradients.
+// NOTE: The activation function must be either `function::ReLU` or `function::Sigmoid`.
+template <std::size_t... Sizes>
+class StaticMultiLayerPerceptron {
+ public:
+  static constexpr std::array<std::size_t, sizeof...(Sizes)> kSizes = {Sizes...};
+  static constexpr std::size_t kNumLayers = sizeof...(Sizes) - 1;
+  static constexpr std::size_t kInSize = kSizes.front();
+  static constexpr std::size_t kOutSize = kSizes.back();
+
+  static_assert(1 <= kNumLayers, "There must be at least the input size and the output size.");
+
+  // Max size [bytes] of the intermediate activations on the stack, which are all alive at once during the (recursive)
+  // forward calculation. It's far below the default stack size of the threads (e.g. 512 KiB on macOS), so that
+  // `Predict()` can run on any thread. A larger batch must be split by the caller.
+  static constexpr std::size_t kMaxActivationBytes = 256 * 1024;
+
+  // Size [bytes] of the intermediate activations on the stack for the batch size.
+  template <std::size_t BatchSize>
+  static constexpr std::size_t kActivationBytes = [] {
+    std::size_t num_hidden_units = 0;
+    for (std::size_t i = 1; i < kNumLayers; ++i) {
+      num_hidden_units += kSizes[i];
+    }
+    return BatchSize * num_hidden_units * sizeof(float);
+  }();
+
+  template <std::size_t BatchSize>
+  using Input = xt::xtensor_fixed<float, xt::xshape<BatchSize, kInSize>>;
+
+  template <std::size_t BatchSize>
+  using Output = xt::xtensor_fixed<float, xt::xshape<BatchSize, kOutSize>>;
+
+  // Copies the parameters of the (trained) model, which must have performed the forward calculation.
+  // NOTE: The parameters are on the heap, because they don't fit in the stack.
+  StaticMultiLayerPerceptron(const MultiLayerPerceptron& model)
+      : layers_ptr_(std::make_unique<Layers>()),
+        does_use_relu_(std::dynamic_pointer_cast<function::ReLU>(model.activation_function_ptr()) != nullptr) {
+    assert((static_cast<void>("The activation function must be either `function::ReLU` or `function::Sigmoid`."),
+            does_use_relu_ || std::dynamic_pointer_cast<function::Sigmoid>(model.activation_function_ptr())));
+    assert((static_cast<void>("The number of the layers must be the same."), model.layer_ptrs().size() == kNumLayers));
+    CopyParams(model, std::make_index_sequence<kNumLayers>());
+  }
+
+  ~StaticMultiLayerPerceptron() {}
+
+  // Performs the inference.
+  //
+  //   x: {BatchSize, kInSize} ---> y: {BatchSize, kOutSize}
+  //
+  template <std::size_t BatchSize>
+  void Predict(const Input<BatchSize>& x, Output<BatchSize>& y) const {
+    static_assert(kActivationBytes<BatchSize> <= kMaxActivationBytes,
+                  "The intermediate activations of the batch size don't fit in the stack. Split the batch.");
+    Forward<0, BatchSize>(x, y);
+  }
+
+  template <std::size_t BatchSize>
+  const Output<BatchSize> Predict(const Input<BatchSize>& x) const {
+    static_assert(kActivationBytes<BatchSize> <= kMaxActivationBytes,
+                  "The intermediate activations of the batch size don't fit in the stack. Split the batch.");
+    Output<BatchSize> y;
+    Forward<0, BatchSize>(x, y);
+    return y;
+  }
+
+  // Gets the linear layer of the index.
+  template <std::size_t LayerIndex>
+  const auto& linear() const {
+    return std::get<LayerIndex>(*layers_ptr_);
+  }
+
+  const bool does_use_relu() const { return does_use_relu_; }
+
+ private:
+  template <std::size_t... LayerIndices>
+  static auto MakeLayers(std::index_sequence<LayerIndices...>)
+      -> std::tuple<StaticLinear<kSizes[LayerIndices], kSizes[LayerIndices + 1]>...>;
+
+  using Layers = decltype(MakeLayers(std::make_index_sequence<kNumLayers>()));
+
+  template <std::size_t... LayerIndices>
+  void CopyParams(const MultiLayerPerceptron& model, std::index_sequence<LayerIndices...>) {
+    (CopyParam<LayerIndices>(model), ...);
+  }
+
+  template <std::size_t LayerIndex>
+  void CopyParam(const MultiLayerPerceptron& model) {
+    const std::shared_ptr<layer::Linear> linear_layer_ptr =
+        std::dynamic_pointer_cast<layer::Linear>(model.layer_ptrs()[LayerIndex]);
+    assert((static_cast<void>("All of the layers must be `layer::Linear`."), linear_layer_ptr));
+    assert((static_cast<void>("The parameters must be initialized by the forward calculation."),
+            linear_layer_ptr->param_map().count(linear_layer_ptr->W_name()) != 0));
+
+    auto& [W, b] = std::get<LayerIndex>(*layers_ptr_);
+    const xt::xarray<float>& src_W = linear_layer_ptr->param_map().at(linear_layer_ptr->W_name())->data();
+    assert((static_cast<void>("The shape of the weight must be the same."),
+            src_W.dimension() == 2 && src_W.shape(0) == kSizes[LayerIndex] &&
+                src_W.shape(1) == kSizes[LayerIndex + 1]));
+    std::copy(src_W.data(), src_W.data() + W.size(), W.data());
+    if (linear_layer_ptr->does_use_bias()) {
+      const xt::xarray<float>& src_b = linear_layer_ptr->param_map().at(linear_layer_ptr->b_name())->data();
+      assert((static_cast<void>("The size of the bias must be the same."), src_b.size() == kSizes[LayerIndex + 1]));
+      std::copy(src_b.data(), src_b.data() + b.size(), b.data());
+    } else {
+      b.fill(0.0);
+    }
+  }
+
+  // Performs the forward calculation from the layer of the index to the last layer.
+  template <std::size_t LayerIndex, std::size_t BatchSize>
+  void Forward(const xt::xtensor_fixed<float, xt::xshape<BatchSize, kSizes[LayerIndex]>>& x, Output<BatchSize>& y)
+      const {
+    if constexpr (LayerIndex + 1 == kNumLayers) {
+      LinearForward<LayerIndex, BatchSize>(x.data(), y.data());
+    } else {
+      xt::xtensor_fixed<float, xt::xshape<BatchSize, kSizes[LayerIndex + 1]>> h;
+      LinearForward<LayerIndex, BatchSize>(x.data(), h.data());
+      Activate(h.data(), h.size());
+      Forward<LayerIndex + 1, BatchSize>(h, y);
+    }
+  }
+
+  // y = x W + b
+  template <std::size_t LayerIndex, std::size_t BatchSize>
+  void LinearForward(const float* __restrict x, float* __restrict y) const {
+    constexpr std::size_t kLayerInSize = kSizes[LayerIndex];
+    constexpr std::size_t kLayerOutSize = kSizes[LayerIndex + 1];
+    const float* __restrict W = std::get<LayerIndex>(*layers_ptr_).W.data();
+    const float* __restrict b = std::get<LayerIndex>(*layers_ptr_).b.data();
+
+    // NOTE: The innermost loop runs along the (contiguous) output axis of the weight, so that it's vectorized.
+    for (std::size_t n = 0; n < BatchSize; ++n) {
+      float* __restrict y_row = y + n * kLayerOutSize;
+      std::copy(b, b + kLayerOutSize, y_row);
+      for (std::size_t i = 0; i < kLayerInSize; ++i) {
+        const float x_value = x[n * kLayerInSize + i];
+        const float* __restrict W_row = W + i * kLayerOutSize;
+        for (std::size_t o = 0; o < kLayerOutSize; ++o) {
+          y_row[o] += x_value * W_row[o];
+        }
+      }
+    }
+  }
+
+  void Activate(float* h, const std::size_t size) const {
+    if (does_use_relu_) {
+      for (std::size_t i = 0; i < size; ++i) {
+        h[i] = std::max(h[i], 0.0f);
+      }
+    } else {
+      for (std::size_t i = 0; i < size; ++i) {
+        h[i] = 1.0f / (1.0f + std::exp(-h[i]));
+      }
+    }
+  }
+
+  std::unique_ptr<Layers> layers_ptr_;
+
+  bool does_use_relu_;
+};
+
+}  // namespace tensorward::model
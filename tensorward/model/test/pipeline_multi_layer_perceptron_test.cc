@@ -0,0 +1,130 @@
+#include "tensorward/model/pipeline_multi_layer_perceptron.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <xtensor/xarray.hpp>
+#include <xtensor/xbuilder.hpp>
+#include <xtensor/xmath.hpp>
+#include <xtensor/xrandom.hpp>
+
+#include "tensorward/core/parameter.h"
+#include "tensorward/function/relu.h"
+#include "tensorward/function/softmax_cross_entropy_error.h"
+#include "tensorward/model/multi_layer_perceptron.h"
+#include "tensorward/util/numa.h"
+
+namespace tensorward::model {
+
+namespace {
+
+constexpr std::size_t kBatchSize = 10;
+constexpr std::size_t kInSize = 3;
+constexpr std::size_t kHiddenSize = 6;
+constexpr std::size_t kOutSize = 4;
+constexpr std::size_t kNumMicroBatches = 4;
+
+}  // namespace
+
+class PipelineMultiLayerPerceptronTest : public ::testing::Test {
+ protected:
+  PipelineMultiLayerPerceptronTest()
+      : model_({kHiddenSize, kHiddenSize, kHiddenSize, kOutSize}, core::AsFunctionSharedPtr<function::ReLU>()),
+        batch_x_(xt::random::randn<float>({kBatchSize, kInSize})),
+        batch_t_(xt::zeros<float>({kBatchSize, kOutSize})) {
+    for (std::size_t n = 0; n < kBatchSize; ++n) {
+      batch_t_(n, n % kOutSize) = 1.0;
+    }
+
+    // Calculates the expected loss and gradients without the pipeline, creating the activation function for each layer.
+    core::TensorSharedPtr y_ptr = core::AsTensorSharedPtr(batch_x_);
+    for (std::size_t i = 0; i < model_.layer_ptrs().size(); ++i) {
+      y_ptr = model_.layer_ptrs()[i]->Call({y_ptr})[0];
+      if (i + 1 < model_.layer_ptrs().size()) {
+        y_ptr = function::relu(y_ptr);
+      }
+    }
+    const core::TensorSharedPtr loss_ptr =
+        function::softmax_cross_entropy_error(y_ptr, core::AsTensorSharedPtr(batch_t_));
+    loss_ptr->Backpropagation();
+
+    expected_loss_ = loss_ptr->data()(0);
+    for (const core::ParameterSharedPtr& param_ptr : model_.GetParamPtrs()) {
+      expected_grads_.push_back(param_ptr->grad());
+    }
+    model_.ClearGrads();
+  }
+
+  // Checks that the loss and the gradients of the pipeline are the same as the expected ones.
+  void ExpectSameAsSerial(const std::size_t num_stages) {
+    PipelineMultiLayerPerceptron pipeline(model_, num_stages, kNumMicroBatches, function::softmax_cross_entropy_error);
+    ASSERT_EQ(pipeline.num_stages(), num_stages);
+
+    std::size_t num_layers = 0;
+    for (std::size_t s = 0; s < num_stages; ++s) {
+      EXPECT_GE(pipeline.stage_layer_ptrs(s).size(), 1);
+      num_layers += pipeline.stage_layer_ptrs(s).size();
+    }
+    EXPECT_EQ(num_layers, model_.layer_ptrs().size());
+
+    // Runs twice, so that the threads are reused and the gradients are accumulated.
+    for (std::size_t step = 1; step <= 2; ++step) {
+      EXPECT_NEAR(pipeline.ForwardBackward(batch_x_, batch_t_), expected_loss_, 1.0e-5);
+
+      const std::vector<core::ParameterSharedPtr>& param_ptrs = model_.GetParamPtrs();
+      ASSERT_EQ(param_ptrs.size(), expected_grads_.size());
+      for (std::size_t i = 0; i < param_ptrs.size(); ++i) {
+        ASSERT_TRUE(param_ptrs[i]->grad_opt().has_value());
+        EXPECT_TRUE(xt::allclose(param_ptrs[i]->grad(), static_cast<float>(step) * expected_grads_[i], 1.0e-4, 1.0e-6));
+      }
+    }
+    model_.ClearGrads();
+  }
+
+  MultiLayerPerceptron model_;
+  const xt::xarray<float> batch_x_;
+  xt::xarray<float> batch_t_;
+  float expected_loss_;
+  std::vector<xt::xarray<float>> expected_grads_;
+};
+
+TEST_F(PipelineMultiLayerPerceptronTest, SingleStageTest) {
+  ExpectSameAsSerial(1);
+}
+
+TEST_F(PipelineMultiLayerPerceptronTest, MultipleStagesTest) {
+  ExpectSameAsSerial(2);
+  ExpectSameAsSerial(4);
+}
+
+TEST_F(PipelineMultiLayerPerceptronTest, PartitionTest) {
+  // The first layer has far fewer parameters than the others, so it shares a stage with the second one.
+  PipelineMultiLayerPerceptron pipeline(model_, 3, kNumMicroBatches, function::softmax_cross_entropy_error,
+                                        /* does_pin_threads = */ false);
+  ASSERT_EQ(pipeline.num_stages(), 3);
+  EXPECT_EQ(pipeline.stage_layer_ptrs(0).size(), 2);
+  EXPECT_EQ(pipeline.stage_layer_ptrs(1).size(), 1);
+  EXPECT_EQ(pipeline.stage_layer_ptrs(2).size(), 1);
+}
+
+TEST_F(PipelineMultiLayerPerceptronTest, StageCpusTest) {
+  // The stages take the CPUs from the end of the list, whose beginning is taken by the workers of the thread pool.
+  const std::vector<int> cpus = util::CpusSpreadOverNumaNodes();
+  if (!cpus.empty()) {
+    const PipelineMultiLayerPerceptron pipeline(model_, 2, kNumMicroBatches, function::softmax_cross_entropy_error);
+    EXPECT_EQ(pipeline.stage_cpus(),
+              std::vector<int>({cpus[cpus.size() - 1], cpus[cpus.size() - 1 - 1 % cpus.size()]}));
+  }
+
+  // The CPUs can be given for each stage.
+  const PipelineMultiLayerPerceptron given_cpus_pipeline(model_, 2, kNumMicroBatches,
+                                                         function::softmax_cross_entropy_error, true, {0, 0});
+  EXPECT_EQ(given_cpus_pipeline.stage_cpus(), std::vector<int>({0, 0}));
+
+  // No CPU is taken without the pinning.
+  const PipelineMultiLayerPerceptron unpinned_pipeline(model_, 2, kNumMicroBatches,
+                                                       function::softmax_cross_entropy_error, false, {0, 0});
+  EXPECT_TRUE(unpinned_pipeline.stage_cpus().empty());
+}
+
+}  // namespace tensorward::model
@@ -0,0 +1,75 @@
+#include "tensorward/model/quantized_multi_layer_perceptron.h"
+
+#include <gtest/gtest.h>
+#include <xtensor/xarray.hpp>
+#include <xtensor/xmath.hpp>
+#include <xtensor/xrandom.hpp>
+
+#include "tensorward/core/data_loader.h"
+#include "tensorward/dataset/spiral.h"
+#include "tensorward/function/relu.h"
+#include "tensorward/function/sigmoid.h"
+#include "tensorward/model/multi_layer_perceptron.h"
+
+namespace tensorward::model {
+
+namespace {
+
+constexpr int kHiddenSize = 10;
+constexpr int kOutSize = 3;
+constexpr int kBatchSize = 30;
+
+// Tolerance of the int8 inference relative to the max absolute value of the float output.
+constexpr float kRelativeTolerance = 0.1;
+
+}  // namespace
+
+class QuantizedMultiLayerPerceptronTest : public ::testing::Test {
+ protected:
+  QuantizedMultiLayerPerceptronTest()
+      : dataset_ptr_(core::AsDatasetSharedPtr<dataset::Spiral>(/* is_training_mode = */ true)),
+        calibration_data_loader_(dataset_ptr_, kBatchSize, /* does_shuffle_dataset = */ false) {}
+
+  // Checks that the int8 inference is close to the float inference of the (untrained) model.
+  void ExpectCloseToFloatModel(const MultiLayerPerceptron& model) {
+    const QuantizedMultiLayerPerceptron quantized_model(model, calibration_data_loader_);
+    ASSERT_EQ(quantized_model.int8_linears().size(), model.layer_ptrs().size());
+    ASSERT_EQ(quantized_model.input_scales().size(), model.layer_ptrs().size());
+
+    const xt::xarray<float>& x = dataset_ptr_->data();
+    const xt::xarray<float> actual_y = quantized_model.Predict(x);
+    xt::xarray<float> expected_y;
+    {
+      core::UseConfig with(core::Config::kDoesEnableBackpropagation, false);
+      expected_y = model.Predict({core::AsTensorSharedPtr(x)})[0]->data();
+    }
+
+    ASSERT_EQ(actual_y.shape(), expected_y.shape());
+    const float tolerance = kRelativeTolerance * xt::amax(xt::abs(expected_y))();
+    EXPECT_TRUE(xt::allclose(actual_y, expected_y, 0.0, tolerance));
+  }
+
+  const core::DatasetSharedPtr dataset_ptr_;
+  core::DataLoader calibration_data_loader_;
+};
+
+TEST_F(QuantizedMultiLayerPerceptronTest, FusedReLUPredictTest) {
+  const MultiLayerPerceptron model({kHiddenSize, kHiddenSize, kOutSize}, core::AsFunctionSharedPtr<function::ReLU>());
+  ExpectCloseToFloatModel(model);
+}
+
+TEST_F(QuantizedMultiLayerPerceptronTest, UnfusedSigmoidPredictTest) {
+  const MultiLayerPerceptron model({kHiddenSize, kHiddenSize, kOutSize},
+                                   core::AsFunctionSharedPtr<function::Sigmoid>());
+  ExpectCloseToFloatModel(model);
+}
+
+TEST_F(QuantizedMultiLayerPerceptronTest, FuseReLUTest) {
+  const MultiLayerPerceptron relu_model({kHiddenSize, kOutSize}, core::AsFunctionSharedPtr<function::ReLU>());
+  const MultiLayerPerceptron sigmoid_model({kHiddenSize, kOutSize}, core::AsFunctionSharedPtr<function::Sigmoid>());
+
+  EXPECT_TRUE(QuantizedMultiLayerPerceptron(relu_model, calibration_data_loader_).does_fuse_relu());
+  EXPECT_FALSE(QuantizedMultiLayerPerceptron(sigmoid_model, calibration_data_loader_).does_fuse_relu());
+}
+
+}  // namespace tensorward::model
@@ -0,0 +1,82 @@
+#include "tensorward/model/static_multi_layer_perceptron.h"
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+#include <xtensor/xarray.hpp>
+#include <xtensor/xfixed.hpp>
+#include <xtensor/xrandom.hpp>
+
+#include "tensorward/core/config.h"
+#include "tensorward/function/relu.h"
+#include "tensorward/function/sigmoid.h"
+#include "tensorward/model/multi_layer_perceptron.h"
+
+namespace tensorward::model {
+
+namespace {
+
+constexpr std::size_t kBatchSize = 4;
+constexpr std::size_t kInSize = 5;
+constexpr std::size_t kHiddenSize = 7;
+constexpr std::size_t kOutSize = 3;
+
+using TestStaticMultiLayerPerceptron = StaticMultiLayerPerceptron<kInSize, kHiddenSize, kHiddenSize, kOutSize>;
+
+}  // namespace
+
+class StaticMultiLayerPerceptronTest : public ::testing::Test {
+ protected:
+  StaticMultiLayerPerceptronTest() : x_(xt::random::randn<float>({kBatchSize, kInSize})) {
+    std::copy(x_.begin(), x_.end(), static_x_.begin());
+  }
+
+  // Checks that the prediction of the static model is the same as the one of the dynamic model.
+  void ExpectSameAsDynamicModel(const MultiLayerPerceptron& model) {
+    core::UseConfig with(core::Config::kDoesEnableBackpropagation, false);
+    const xt::xarray<float> expected_y = model.Predict({core::AsTensorSharedPtr(x_)})[0]->data();
+
+    const TestStaticMultiLayerPerceptron static_model(model);
+    const TestStaticMultiLayerPerceptron::Output<kBatchSize> actual_y = static_model.Predict<kBatchSize>(static_x_);
+
+    ASSERT_EQ(expected_y.shape(0), kBatchSize);
+    ASSERT_EQ(expected_y.shape(1), kOutSize);
+    for (std::size_t n = 0; n < kBatchSize; ++n) {
+      for (std::size_t o = 0; o < kOutSize; ++o) {
+        EXPECT_NEAR(actual_y(n, o), expected_y(n, o), 1.0e-5);
+      }
+    }
+  }
+
+  const xt::xarray<float> x_;
+  TestStaticMultiLayerPerceptron::Input<kBatchSize> static_x_;
+};
+
+TEST_F(StaticMultiLayerPerceptronTest, ReLUPredictTest) {
+  const MultiLayerPerceptron model({kHiddenSize, kHiddenSize, kOutSize}, core::AsFunctionSharedPtr<function::ReLU>());
+  ExpectSameAsDynamicModel(model);
+}
+
+TEST_F(StaticMultiLayerPerceptronTest, SigmoidPredictTest) {
+  const MultiLayerPerceptron model({kHiddenSize, kHiddenSize, kOutSize},
+                                   core::AsFunctionSharedPtr<function::Sigmoid>());
+  ExpectSameAsDynamicModel(model);
+}
+
+TEST_F(StaticMultiLayerPerceptronTest, CompileTimeShapeTest) {
+  static_assert(TestStaticMultiLayerPerceptron::kNumLayers == 3);
+  static_assert(TestStaticMultiLayerPerceptron::kInSize == kInSize);
+  static_assert(TestStaticMultiLayerPerceptron::kOutSize == kOutSize);
+
+  const MultiLayerPerceptron model({kHiddenSize, kHiddenSize, kOutSize}, core::AsFunctionSharedPtr<function::ReLU>());
+  {
+    core::UseConfig with(core::Config::kDoesEnableBackpropagation, false);
+    model.Predict({core::AsTensorSharedPtr(x_)});  // Initializes the parameters.
+  }
+  const TestStaticMultiLayerPerceptron static_model(model);
+  EXPECT_TRUE(static_model.does_use_relu());
+  EXPECT_EQ(static_model.linear<0>().W(kInSize - 1, kHiddenSize - 1),
+            model.layer_ptrs()[0]->param_map().at("W")->data()(kInSize - 1, kHiddenSize - 1));
+}
+
+}  // namespace tensorward::model
@@ -1,5 +1,6 @@
 #pragma once
 
 // Header file aggregation for users.
+#include "tensorward/optimizer/hogwild_stochastic_gradient_descent.h"
 #include "tensorward/optimizer/momentum_stochastic_gradient_descent.h"
 #include "tensorward/optimizer/stochastic_gradient_descent.h"
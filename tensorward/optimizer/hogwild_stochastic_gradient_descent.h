@@ -0,0 +1,184 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <xtensor/xarray.hpp>
+
+#include "tensorward/core/model.h"
+#include "tensorward/core/parameter.h"
+#include "tensorward/util/atomic.h"
+
+namespace tensorward::optimizer {
+
+// How `HogwildStochasticGradientDescent` writes the elements of the shared parameters.
+enum class HogwildUpdateMode {
+  // Plain read-modify-write, where an update racing with another one on the same element can be lost. It's the fastest,
+  // and the lost updates are rare if the updates are sparse (e.g. the rows of an embedding).
+  kBenignRace,
+
+  // Atomic subtraction with the relaxed order (`util::AtomicFetchAdd()`), where no update is lost, but the elements of
+  // an update can still be interleaved with those of the others.
+  kRelaxedAtomic,
+};
+
+// Asynchronous stochastic gradient descent of Hogwild! (Niu et al., 2011): each worker thread trains its own replica of
+// the model on its own batches, and applies its update into the parameter storages shared by all of the replicas in
+// place without any lock, instead of waiting for the others to average the gradients.
+//
+//   p <--- p - lr * dL_dp  (of a replica, whenever the replica finishes its backpropagation)
+//
+// So the gradient of a replica can be computed on the parameters which are partially updated by the others (stale). The
+// staleness of each update (the number of the updates by the others since the replica read the clock before its
+// forward calculation) is recorded.
+//
+// e.g.
+//
+//   HogwildStochasticGradientDescent optimizer(model, learning_rate);
+//   MultiLayerPerceptron replica(...);  // For each worker thread.
+//   optimizer.ShareParams(replica);
+//   // In the worker thread:
+//   for (...) {
+//     const std::uint64_t read_clock = optimizer.clock();
+//     const TensorSharedPtr loss_ptr = ...(replica.Predict({batch_x_ptr})[0], batch_t_ptr);
+//     replica.ClearGrads();
+//     loss_ptr->Backpropagation();
+//     optimizer.Update(replica.GetParamPtrs(), read_clock);
+//   }
+//
+// NOTE: The model must have performed the forward calculation (to initialize the parameters). While the workers run,
+// NOTE: the forward and backward calculations read the shared parameters racing with the writes (benignly, which is
+// NOTE: the premise of Hogwild!), and the in-place writes bypass the copy-on-write and the version of the parameters.
+// NOTE: So don't snapshot the parameters (e.g. for a checkpoint) or use the models caching the data derived from them
+// NOTE: (e.g. `layer::Conv2d` with the Winograd filters) until the workers stop.
+class HogwildStochasticGradientDescent {
+ public:
+  HogwildStochasticGradientDescent(core::Model& model, const float learning_rate,
+                                   const HogwildUpdateMode update_mode = HogwildUpdateMode::kRelaxedAtomic)
+      : model_(model),
+        learning_rate_(learning_rate),
+        update_mode_(update_mode),
+        clock_(0),
+        sum_staleness_(0),
+        max_staleness_(0) {
+    for (const core::LayerSharedPtr& layer_ptr : model.layer_ptrs()) {
+      assert((static_cast<void>("The model must have performed the forward calculation."),
+              !layer_ptr->param_map().empty()));
+      for (const auto& [param_name, param_ptr] : layer_ptr->param_map()) {
+        // Takes the storage which is exclusively owned by the parameter (copied first if it's shared by a snapshot), so
+        // that the replicas share it with nothing else.
+        xt::xarray<float>& shared_data = param_ptr->MutableData();
+        shared_data_map_[&shared_data] = &shared_data;
+      }
+    }
+  }
+
+  ~HogwildStochasticGradientDescent() {}
+
+  // Prevents copy construction.
+  HogwildStochasticGradientDescent(const HogwildStochasticGradientDescent&) = delete;
+
+  // Prevents copy assignment.
+  HogwildStochasticGradientDescent& operator=(const HogwildStochasticGradientDescent&) = delete;
+
+  // Replaces the parameters of the replica (another instance of the same architecture as the model, which is owned by
+  // a worker thread) with the ones sharing the storages with the model.
+  // NOTE: Call this before `GetParamPtrs()` of the replica, which caches the parameters.
+  void ShareParams(core::Model& replica_model) const {
+    const std::vector<core::LayerSharedPtr>& layer_ptrs = model_.layer_ptrs();
+    const std::vector<core::LayerSharedPtr>& replica_layer_ptrs = replica_model.layer_ptrs();
+    assert((static_cast<void>("The replica must have the same layers as the model."),
+            replica_layer_ptrs.size() == layer_ptrs.size()));
+    assert((static_cast<void>("The parameters of the replica must not be cached yet."),
+            replica_model.param_ptrs().empty()));
+    for (std::size_t i = 0; i < layer_ptrs.size(); ++i) {
+      for (const auto& [param_name, param_ptr] : layer_ptrs[i]->param_map()) {
+        replica_layer_ptrs[i]->SetParamPtr(param_name,
+                                           std::make_shared<core::Parameter>(param_ptr->data_ptr(), param_ptr->name()));
+      }
+    }
+  }
+
+  // Subtracts the gradients (or the row-sparse gradients) of the parameters of the replica from the shared storages in
+  // place, and records the staleness of this update since `read_clock` (obtained by `clock()`).
+  void Update(const std::vector<core::ParameterSharedPtr>& replica_param_ptrs, const std::uint64_t read_clock) {
+    for (const core::ParameterSharedPtr& param_ptr : replica_param_ptrs) {
+      const auto found = shared_data_map_.find(param_ptr->data_ptr().get());
+      assert((static_cast<void>("The parameter must be shared by `ShareParams()`."), found != shared_data_map_.end()));
+      xt::xarray<float>& shared_data = *found->second;
+
+      if (param_ptr->grad_opt().has_value()) {
+        const xt::xarray<float>& grad = param_ptr->grad();
+        assert(grad.size() == shared_data.size());
+        SubtractScaled(shared_data.data(), grad.data(), grad.size());
+      } else if (param_ptr->sparse_grad_opt().has_value()) {
+        // p[r] <--- p[r] - lr * dL_dp[r] for only the touched rows "r" (like `StochasticGradientDescent`)
+        const core::RowSparseGrad& sparse_grad = param_ptr->sparse_grad();
+        const std::size_t row_size = shared_data.size() / shared_data.shape(0);
+        assert(sparse_grad.rows.size() == sparse_grad.row_indices.size() * row_size);
+        for (std::size_t i = 0; i < sparse_grad.row_indices.size(); ++i) {
+          assert(sparse_grad.row_indices[i] < shared_data.shape(0));
+          SubtractScaled(shared_data.data() + sparse_grad.row_indices[i] * row_size,
+                         sparse_grad.rows.data() + i * row_size, row_size);
+        }
+      }
+    }
+
+    const std::uint64_t staleness = clock_.fetch_add(1, std::memory_order_acq_rel) - read_clock;
+    sum_staleness_.fetch_add(staleness, std::memory_order_relaxed);
+    std::uint64_t max_staleness = max_staleness_.load(std::memory_order_relaxed);
+    while (max_staleness < staleness &&
+           !max_staleness_.compare_exchange_weak(max_staleness, staleness, std::memory_order_relaxed)) {
+    }
+  }
+
+  // Number of the updates so far, which a worker reads before its forward calculation.
+  const std::uint64_t clock() const { return clock_.load(std::memory_order_acquire); }
+
+  // Average number of the updates by the other workers between the read and the update of a worker.
+  const double average_staleness() const {
+    const std::uint64_t num_updates = clock();
+    return num_updates == 0 ? 0.0 : static_cast<double>(sum_staleness_.load(std::memory_order_relaxed)) / num_updates;
+  }
+
+  const std::uint64_t max_staleness() const { return max_staleness_.load(std::memory_order_relaxed); }
+
+  const float learning_rate() const { return learning_rate_; }
+
+  const HogwildUpdateMode update_mode() const { return update_mode_; }
+
+ private:
+  // data[i] <--- data[i] - lr * grad[i]
+  void SubtractScaled(float* data, const float* grad, const std::size_t size) const {
+    if (update_mode_ == HogwildUpdateMode::kRelaxedAtomic) {
+      for (std::size_t i = 0; i < size; ++i) {
+        util::AtomicFetchAdd(data[i], -learning_rate_ * grad[i], std::memory_order_relaxed);
+      }
+    } else {
+      for (std::size_t i = 0; i < size; ++i) {
+        data[i] -= learning_rate_ * grad[i];
+      }
+    }
+  }
+
+  core::Model& model_;
+
+  float learning_rate_;
+
+  HogwildUpdateMode update_mode_;
+
+  // Writable storage of each parameter of the model by its address, which the parameters of the replicas share.
+  std::unordered_map<const xt::xarray<float>*, xt::xarray<float>*> shared_data_map_;
+
+  std::atomic<std::uint64_t> clock_;
+
+  std::atomic<std::uint64_t> sum_staleness_;
+
+  std::atomic<std::uint64_t> max_staleness_;
+};
+
+}  // namespace tensorward::optimizer
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <xtensor/xarray.hpp>
 
@@ -12,34 +17,95 @@ namespace tensorward::optimizer {
 class MomentumStochasticGradientDescent : public core::Optimizer {
  public:
   MomentumStochasticGradientDescent(const float learning_rate, const float momentum)
-      : learning_rate_(learning_rate), momentum_(momentum) {}
+      : learning_rate_(learning_rate), momentum_(momentum), velocity_name_("velocity") {}
 
   ~MomentumStochasticGradientDescent() {}
 
   void UpdateSingleParameter(const core::ParameterSharedPtr param_ptr) override {
     // Initializes the velocity of the given parameter as zero if it doesn't exit yet.
     if (velocity_map_.count(param_ptr) == 0) {
-      velocity_map_[param_ptr] = xt::zeros_like(param_ptr->data());
+      velocity_map_[param_ptr] = std::make_shared<xt::xarray<float>>(xt::zeros_like(param_ptr->data()));
     }
 
     // v <--- m * v - lr * dL_dp
     // p <--- p + v
-    velocity_map_[param_ptr] = momentum_ * velocity_map_[param_ptr] - learning_rate_ * param_ptr->grad();
-    param_ptr->SeData(param_ptr->data() + velocity_map_[param_ptr]);
+    // NOTE: The velocity is replaced (instead of being updated in place) in the same way as the parameter.
+    velocity_map_[param_ptr] = std::make_shared<xt::xarray<float>>(momentum_ * (*velocity_map_[param_ptr]) -
+                                                                   learning_rate_ * param_ptr->grad());
+    param_ptr->SeData(param_ptr->data() + *velocity_map_[param_ptr]);
+  }
+
+  // NOTE: This is the "lazy" momentum, which updates the velocity (and the parameter) of only the touched rows.
+  // NOTE: That is, the velocity of the untouched rows is kept as is until they are touched again, instead of being
+  // NOTE: decayed and applied at every step as the dense update does.
+  void UpdateSingleParameterSparse(const core::ParameterSharedPtr param_ptr) override {
+    if (velocity_map_.count(param_ptr) == 0) {
+      velocity_map_[param_ptr] = std::make_shared<xt::xarray<float>>(xt::zeros_like(param_ptr->data()));
+    } else if (velocity_map_[param_ptr].use_count() > 1) {
+      // Copies the velocity shared with a snapshot (copy-on-write) before updating it in place.
+      velocity_map_[param_ptr] = std::make_shared<xt::xarray<float>>(*velocity_map_[param_ptr]);
+    } else {
+      // Orders the reads of the snapshot released on another thread before the writes in place below, in the same way
+      // as `Tensor::MutableData()`.
+      std::atomic_thread_fence(std::memory_order_acquire);
+    }
+
+    // The velocity update is not linear in the gradient, so the duplicated rows must be summed up in advance.
+    const core::RowSparseGrad sparse_grad = core::CoalesceRowSparseGrad(param_ptr->sparse_grad());
+    const std::vector<std::size_t>& row_indices = sparse_grad.row_indices;
+
+    // v[r] <--- m * v[r] - lr * dL_dp[r] for only the touched rows "r"
+    // p[r] <--- p[r] + v[r]
+    xt::xarray<float>& param_data = param_ptr->MutableData();
+    const std::size_t row_size = param_data.size() / param_data.shape(0);
+    assert(sparse_grad.rows.size() == row_indices.size() * row_size);
+    const float* grad_pointer = sparse_grad.rows.data();
+    float* velocity_pointer = velocity_map_[param_ptr]->data();
+    float* param_pointer = param_data.data();
+    for (std::size_t i = 0; i < row_indices.size(); ++i) {
+      assert(row_indices[i] < param_data.shape(0));
+      float* velocity_row = velocity_pointer + row_indices[i] * row_size;
+      float* param_row = param_pointer + row_indices[i] * row_size;
+      const float* grad_row = grad_pointer + i * row_size;
+      for (std::size_t j = 0; j < row_size; ++j) {
+        velocity_row[j] = momentum_ * velocity_row[j] - learning_rate_ * grad_row[j];
+        param_row[j] += velocity_row[j];
+      }
+    }
+  }
+
+  const std::unordered_map<std::string, std::shared_ptr<const xt::xarray<float>>> GetStateMap(
+      const core::ParameterSharedPtr param_ptr) const override {
+    if (velocity_map_.count(param_ptr) == 0) {
+      return {};
+    }
+    return {{velocity_name_, velocity_map_.at(param_ptr)}};
+  }
+
+  void SetStateMap(const core::ParameterSharedPtr param_ptr,
+                   const std::unordered_map<std::string, xt::xarray<float>>& state_map) override {
+    if (state_map.count(velocity_name_) != 0) {
+      assert(state_map.at(velocity_name_).shape() == param_ptr->data().shape());
+      velocity_map_[param_ptr] = std::make_shared<xt::xarray<float>>(state_map.at(velocity_name_));
+    }
   }
 
   const float learning_rate() const { return learning_rate_; }
 
   const float momentum() const { return momentum_; }
 
-  const std::unordered_map<core::ParameterSharedPtr, xt::xarray<float>>& velocity_map() const { return velocity_map_; }
+  const std::unordered_map<core::ParameterSharedPtr, std::shared_ptr<xt::xarray<float>>>& velocity_map() const {
+    return velocity_map_;
+  }
 
  private:
   float learning_rate_;
 
   float momentum_;
 
-  std::unordered_map<core::ParameterSharedPtr, xt::xarray<float>> velocity_map_;
+  std::string velocity_name_;
+
+  std::unordered_map<core::ParameterSharedPtr, std::shared_ptr<xt::xarray<float>>> velocity_map_;
 };
 
 }  // namespace tensorward::optimizer
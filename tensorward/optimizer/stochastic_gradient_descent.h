@@ -1,5 +1,10 @@
 #pragma once
 
+#include <cassert>
+#include <vector>
+
+#include <xtensor/xarray.hpp>
+
 #include "tensorward/core/optimizer.h"
 #include "tensorward/core/parameter.h"
 
@@ -16,6 +21,27 @@ class StochasticGradientDescent : public core::Optimizer {
     param_ptr->SeData(param_ptr->data() - learning_rate_ * param_ptr->grad());
   }
 
+  void UpdateSingleParameterSparse(const core::ParameterSharedPtr param_ptr) override {
+    const core::RowSparseGrad& sparse_grad = param_ptr->sparse_grad();
+    const std::vector<std::size_t>& row_indices = sparse_grad.row_indices;
+
+    // p[r] <--- p[r] - lr * dL_dp[r] for only the touched rows "r"
+    // NOTE: No need to sum up the duplicated rows in advance, because this update is linear in the gradient.
+    xt::xarray<float>& param_data = param_ptr->MutableData();
+    const std::size_t row_size = param_data.size() / param_data.shape(0);
+    assert(sparse_grad.rows.size() == row_indices.size() * row_size);
+    const float* grad_pointer = sparse_grad.rows.data();
+    float* param_pointer = param_data.data();
+    for (std::size_t i = 0; i < row_indices.size(); ++i) {
+      assert(row_indices[i] < param_data.shape(0));
+      float* param_row = param_pointer + row_indices[i] * row_size;
+      const float* grad_row = grad_pointer + i * row_size;
+      for (std::size_t j = 0; j < row_size; ++j) {
+        param_row[j] -= learning_rate_ * grad_row[j];
+      }
+    }
+  }
+
   const float learning_rate() const { return learning_rate_; }
 
  private:
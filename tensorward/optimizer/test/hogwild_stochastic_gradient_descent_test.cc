@@ -0,0 +1,157 @@
+#include "tensorward/optimizer/hogwild_stochastic_gradient_descent.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <xtensor/xarray.hpp>
+#include <xtensor/xbuilder.hpp>
+#include <xtensor/xrandom.hpp>
+
+#include "tensorward/core/config.h"
+#include "tensorward/function/relu.h"
+#include "tensorward/model/multi_layer_perceptron.h"
+
+namespace tensorward::optimizer {
+
+namespace {
+
+constexpr std::size_t kBatchSize = 4;
+constexpr std::size_t kInSize = 3;
+constexpr std::size_t kHiddenSize = 5;
+constexpr std::size_t kOutSize = 2;
+constexpr float kLearningRate = 0.5;
+constexpr std::size_t kNumThreads = 4;
+constexpr std::size_t kNumIterations = 100;
+
+}  // namespace
+
+class HogwildStochasticGradientDescentTest : public ::testing::Test {
+ protected:
+  HogwildStochasticGradientDescentTest()
+      : model_({kHiddenSize, kOutSize}, core::AsFunctionSharedPtr<function::ReLU>()),
+        x_ptr_(core::AsTensorSharedPtr(xt::random::randn<float>({kBatchSize, kInSize}))) {
+    // Initializes the parameters.
+    core::UseConfig with(core::Config::kDoesEnableBackpropagation, false);
+    model_.Predict({x_ptr_});
+  }
+
+  const std::unique_ptr<model::MultiLayerPerceptron> CreateReplica() const {
+    return std::make_unique<model::MultiLayerPerceptron>(std::vector<std::size_t>({kHiddenSize, kOutSize}),
+                                                         core::AsFunctionSharedPtr<function::ReLU>());
+  }
+
+  // Sets the gradients of ones into the parameters of the replica.
+  void SetOnesGrads(model::MultiLayerPerceptron& replica) const {
+    for (const core::ParameterSharedPtr& param_ptr : replica.GetParamPtrs()) {
+      param_ptr->SetGradOpt(xt::ones_like(param_ptr->data()));
+    }
+  }
+
+  // Copies the data of the parameters of the model.
+  const std::vector<xt::xarray<float>> CopyParamData() {
+    std::vector<xt::xarray<float>> param_data;
+    for (const core::ParameterSharedPtr& param_ptr : model_.GetParamPtrs()) {
+      param_data.push_back(param_ptr->data());
+    }
+    return param_data;
+  }
+
+  model::MultiLayerPerceptron model_;
+  const core::TensorSharedPtr x_ptr_;
+};
+
+TEST_F(HogwildStochasticGradientDescentTest, ShareParamsTest) {
+  HogwildStochasticGradientDescent optimizer(model_, kLearningRate);
+  const std::unique_ptr<model::MultiLayerPerceptron> replica_ptr = CreateReplica();
+  optimizer.ShareParams(*replica_ptr);
+
+  core::UseConfig with(core::Config::kDoesEnableBackpropagation, false);
+  EXPECT_EQ(replica_ptr->Predict({x_ptr_})[0]->data(), model_.Predict({x_ptr_})[0]->data());
+  ASSERT_EQ(replica_ptr->GetParamPtrs().size(), model_.GetParamPtrs().size());
+  for (std::size_t i = 0; i < model_.layer_ptrs().size(); ++i) {
+    for (const auto& [param_name, param_ptr] : model_.layer_ptrs()[i]->param_map()) {
+      EXPECT_EQ(replica_ptr->layer_ptrs()[i]->param_map().at(param_name)->data_ptr(), param_ptr->data_ptr());
+    }
+  }
+}
+
+TEST_F(HogwildStochasticGradientDescentTest, UpdateTest) {
+  for (const HogwildUpdateMode update_mode : {HogwildUpdateMode::kBenignRace, HogwildUpdateMode::kRelaxedAtomic}) {
+    HogwildStochasticGradientDescent optimizer(model_, kLearningRate, update_mode);
+    const std::unique_ptr<model::MultiLayerPerceptron> replica_ptr = CreateReplica();
+    optimizer.ShareParams(*replica_ptr);
+    const std::vector<xt::xarray<float>> initial_param_data = CopyParamData();
+
+    // p <--- p - lr * dL_dp
+    SetOnesGrads(*replica_ptr);
+    optimizer.Update(replica_ptr->GetParamPtrs(), optimizer.clock());
+
+    const std::vector<core::ParameterSharedPtr>& param_ptrs = model_.GetParamPtrs();
+    for (std::size_t i = 0; i < param_ptrs.size(); ++i) {
+      EXPECT_EQ(param_ptrs[i]->data(), xt::xarray<float>(initial_param_data[i] - kLearningRate));
+    }
+    EXPECT_EQ(optimizer.clock(), 1);
+    EXPECT_EQ(optimizer.max_staleness(), 0);
+  }
+}
+
+TEST_F(HogwildStochasticGradientDescentTest, SparseUpdateTest) {
+  HogwildStochasticGradientDescent optimizer(model_, kLearningRate);
+  const std::unique_ptr<model::MultiLayerPerceptron> replica_ptr = CreateReplica();
+  optimizer.ShareParams(*replica_ptr);
+
+  // Only the row 1 of "W" of the first layer is touched.
+  const core::ParameterSharedPtr W_ptr = replica_ptr->layer_ptrs()[0]->param_map().at("W");
+  const xt::xarray<float> initial_W_data = W_ptr->data();
+  core::RowSparseGrad sparse_grad;
+  sparse_grad.row_indices = {1};
+  sparse_grad.rows = xt::ones<float>({std::size_t(1), kHiddenSize});
+  W_ptr->SetSparseGradOpt(sparse_grad);
+  optimizer.Update({W_ptr}, optimizer.clock());
+
+  const xt::xarray<float>& W_data = model_.layer_ptrs()[0]->param_map().at("W")->data();
+  for (std::size_t r = 0; r < kInSize; ++r) {
+    for (std::size_t c = 0; c < kHiddenSize; ++c) {
+      EXPECT_EQ(W_data(r, c), r == 1 ? initial_W_data(r, c) - kLearningRate : initial_W_data(r, c));
+    }
+  }
+}
+
+TEST_F(HogwildStochasticGradientDescentTest, ConcurrentUpdateTest) {
+  // Starts from zeros, so that the updates (the multiples of the learning rate 0.5) are exact in any order.
+  for (const core::ParameterSharedPtr& param_ptr : model_.GetParamPtrs()) {
+    param_ptr->SeData(xt::zeros_like(param_ptr->data()));
+  }
+  HogwildStochasticGradientDescent optimizer(model_, kLearningRate, HogwildUpdateMode::kRelaxedAtomic);
+  std::vector<std::unique_ptr<model::MultiLayerPerceptron>> replica_ptrs;
+  for (std::size_t t = 0; t < kNumThreads; ++t) {
+    replica_ptrs.push_back(CreateReplica());
+    optimizer.ShareParams(*replica_ptrs.back());
+    SetOnesGrads(*replica_ptrs.back());
+  }
+
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&optimizer, &replica = *replica_ptrs[t]] {
+      for (std::size_t i = 0; i < kNumIterations; ++i) {
+        optimizer.Update(replica.GetParamPtrs(), optimizer.clock());
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  // No update is lost by the relaxed atomics.
+  for (const core::ParameterSharedPtr& param_ptr : model_.GetParamPtrs()) {
+    EXPECT_EQ(param_ptr->data(),
+              xt::xarray<float>(xt::full_like(param_ptr->data(), -kLearningRate * kNumThreads * kNumIterations)));
+  }
+  EXPECT_EQ(optimizer.clock(), kNumThreads * kNumIterations);
+  EXPECT_LT(optimizer.max_staleness(), kNumThreads * kNumIterations);
+  EXPECT_LE(optimizer.average_staleness(), optimizer.max_staleness());
+}
+
+}  // namespace tensorward::optimizer
@@ -0,0 +1,6 @@
+#pragma once
+
+// Header file aggregation for users.
+#include "tensorward/serving/batching_inference_engine.h"
+#include "tensorward/serving/unix_socket_message.h"
+#include "tensorward/serving/unix_socket_server.h"
@@ -0,0 +1,122 @@
+#include "tensorward/serving/batching_inference_engine.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iterator>
+#include <utility>
+
+#include <xtensor/xbuilder.hpp>
+
+#include "tensorward/core/config.h"
+#include "tensorward/core/tensor.h"
+
+namespace tensorward::serving {
+
+BatchingInferenceEngine::BatchingInferenceEngine(const core::Model& model, const std::size_t max_batch_size,
+                                                 const std::chrono::microseconds max_latency,
+                                                 const std::size_t num_workers /* = 1 */)
+    : model_(model),
+      max_batch_size_(max_batch_size),
+      max_latency_(max_latency),
+      is_stopping_(false),
+      num_requests_(0),
+      num_batches_(0) {
+  assert((static_cast<void>("The max batch size must be positive."), 0 < max_batch_size));
+  assert((static_cast<void>("The number of the workers must be positive."), 0 < num_workers));
+  threads_.reserve(num_workers);
+  for (std::size_t i = 0; i < num_workers; ++i) {
+    threads_.emplace_back(&BatchingInferenceEngine::Run, this);
+  }
+}
+
+BatchingInferenceEngine::~BatchingInferenceEngine() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_stopping_ = true;
+  }
+  condition_variable_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+std::future<xt::xarray<float>> BatchingInferenceEngine::Submit(const xt::xarray<float>& x) {
+  Request request{x, std::promise<xt::xarray<float>>(), std::chrono::steady_clock::now()};
+  std::future<xt::xarray<float>> y_future = request.y_promise.get_future();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    assert((static_cast<void>("The engine must not be stopped."), !is_stopping_));
+    requests_.push_back(std::move(request));
+  }
+  ++num_requests_;
+  condition_variable_.notify_all();
+  return y_future;
+}
+
+void BatchingInferenceEngine::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    condition_variable_.wait(lock, [this] { return !requests_.empty() || is_stopping_; });
+    if (requests_.empty()) {
+      // Stops only after all of the queued requests are predicted.
+      break;
+    }
+
+    // Waits for more requests until the batch gets full or the oldest request reaches the max latency.
+    const std::chrono::steady_clock::time_point deadline = requests_.front().arrival_time + max_latency_;
+    condition_variable_.wait_until(lock, deadline,
+                                   [this] { return max_batch_size_ <= requests_.size() || is_stopping_; });
+    if (requests_.empty()) {
+      // The requests have been taken by another worker in the meantime.
+      continue;
+    }
+
+    const std::size_t batch_size = std::min(requests_.size(), max_batch_size_);
+    std::vector<Request> requests(std::make_move_iterator(requests_.begin()),
+                                  std::make_move_iterator(requests_.begin() + batch_size));
+    requests_.erase(requests_.begin(), requests_.begin() + batch_size);
+    if (!requests_.empty()) {
+      // Lets another worker take the rest.
+      condition_variable_.notify_all();
+    }
+
+    lock.unlock();
+    Predict(requests);
+    lock.lock();
+  }
+}
+
+void BatchingInferenceEngine::Predict(std::vector<Request>& requests) {
+  // Stacks the samples into a batch {batch size, sample shape...}.
+  const auto& x_shape = requests[0].x.shape();
+  xt::xarray<float>::shape_type batch_x_shape({requests.size()});
+  batch_x_shape.insert(batch_x_shape.end(), x_shape.begin(), x_shape.end());
+  xt::xarray<float> batch_x = xt::empty<float>(batch_x_shape);
+  const std::size_t x_size = requests[0].x.size();
+  for (std::size_t i = 0; i < requests.size(); ++i) {
+    assert((static_cast<void>("All of the samples must have the same shape."), requests[i].x.shape() == x_shape));
+    std::memcpy(batch_x.data() + i * x_size, requests[i].x.data(), x_size * sizeof(float));
+  }
+
+  xt::xarray<float> batch_y;
+  {
+    std::lock_guard<std::mutex> predict_lock(predict_mutex_);
+    // NOTE: The backpropagation is disabled only for this worker thread, since the global config can be read (or
+    // NOTE: changed) by the other threads at the same time (e.g. training the model in the same process).
+    core::UseThreadLocalConfig with(core::Config::kDoesEnableBackpropagation, false);
+    batch_y = model_.Predict({core::AsTensorSharedPtr(std::move(batch_x))})[0]->data();
+  }
+  ++num_batches_;
+
+  // Splits the batch of the predictions {batch size, prediction shape...} into each request.
+  const xt::xarray<float>::shape_type y_shape(batch_y.shape().begin() + 1, batch_y.shape().end());
+  const std::size_t y_size = batch_y.size() / requests.size();
+  for (std::size_t i = 0; i < requests.size(); ++i) {
+    xt::xarray<float> y = xt::empty<float>(y_shape);
+    std::memcpy(y.data(), batch_y.data() + i * y_size, y_size * sizeof(float));
+    requests[i].y_promise.set_value(std::move(y));
+  }
+}
+
+}  // namespace tensorward::serving
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <xtensor/xarray.hpp>
+
+#include "tensorward/core/model.h"
+
+namespace tensorward::serving {
+
+// Inference engine which coalesces the concurrent single-sample requests into a batch, so that the model performs the
+// forward calculation (a GEMM per linear layer) once per batch instead of once per sample:
+//
+//   1. `Submit()` pushes a sample into the request queue, and returns the future of its prediction.
+//   2. A worker waits for the queue until either `max_batch_size` requests are queued or the oldest request has waited
+//      for `max_latency`, and then pops (up to `max_batch_size`) requests as a batch.
+//   3. The worker stacks the samples, performs `Model::Predict()` without the backpropagation, and splits the batch of
+//      the predictions into the futures.
+//
+// NOTE: `Model::Predict()` is not thread-safe (each layer records its inputs and outputs, and `Config` is shared in
+// NOTE: the process), so the forward calculation is serialized among the workers. Instead, the workers overlap the
+// NOTE: batching and the splitting with the forward calculation of the other batch. Also, the model must not be
+// NOTE: trained at the same time.
+class BatchingInferenceEngine {
+ public:
+  BatchingInferenceEngine(const core::Model& model, const std::size_t max_batch_size,
+                          const std::chrono::microseconds max_latency, const std::size_t num_workers = 1);
+
+  // Performs the predictions of the queued requests, and then stops the workers.
+  ~BatchingInferenceEngine();
+
+  // Prevents copy construction.
+  BatchingInferenceEngine(const BatchingInferenceEngine&) = delete;
+
+  // Prevents copy assignment.
+  BatchingInferenceEngine& operator=(const BatchingInferenceEngine&) = delete;
+
+  // Queues the single sample `x` (without the batch axis), and returns the future of its prediction (without the batch
+  // axis either).
+  // NOTE: All of the samples must have the same shape.
+  std::future<xt::xarray<float>> Submit(const xt::xarray<float>& x);
+
+  const std::size_t max_batch_size() const { return max_batch_size_; }
+
+  const std::chrono::microseconds max_latency() const { return max_latency_; }
+
+  const std::size_t num_requests() const { return num_requests_; }
+
+  const std::size_t num_batches() const { return num_batches_; }
+
+ private:
+  struct Request {
+    xt::xarray<float> x;
+
+    std::promise<xt::xarray<float>> y_promise;
+
+    std::chrono::steady_clock::time_point arrival_time;
+  };
+
+  // Main loop of the workers.
+  void Run();
+
+  // Performs the prediction of the batch of the requests, and fulfills their promises.
+  void Predict(std::vector<Request>& requests);
+
+  const core::Model& model_;
+
+  std::size_t max_batch_size_;
+
+  std::chrono::microseconds max_latency_;
+
+  std::mutex mutex_;
+
+  // Notified when a request is queued and when the engine is stopped.
+  std::condition_variable condition_variable_;
+
+  std::deque<Request> requests_;
+
+  bool is_stopping_;
+
+  // Serializes `Model::Predict()` among the workers.
+  std::mutex predict_mutex_;
+
+  std::atomic<std::size_t> num_requests_;
+
+  std::atomic<std::size_t> num_batches_;
+
+  // NOTE: This must be declared at the end, so that the workers start after all of the members above are initialized.
+  std::vector<std::thread> threads_;
+};
+
+}  // namespace tensorward::serving
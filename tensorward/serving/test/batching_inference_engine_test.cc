@@ -0,0 +1,99 @@
+#include "tensorward/serving/batching_inference_engine.h"
+
+#include <future>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <xtensor/xarray.hpp>
+#include <xtensor/xrandom.hpp>
+#include <xtensor/xview.hpp>
+
+#include "tensorward/core/config.h"
+#include "tensorward/function/relu.h"
+#include "tensorward/model/multi_layer_perceptron.h"
+
+namespace tensorward::serving {
+
+namespace {
+
+constexpr int kDataSize = 64;
+constexpr int kInSize = 4;
+constexpr int kHiddenSize = 8;
+constexpr int kOutSize = 3;
+constexpr int kMaxBatchSize = 16;
+constexpr int kNumWorkers = 2;
+
+// Long enough for all of the requests to be queued before the first batch is cut by the latency.
+constexpr std::chrono::microseconds kMaxLatency(100000);
+
+}  // namespace
+
+class BatchingInferenceEngineTest : public ::testing::Test {
+ protected:
+  BatchingInferenceEngineTest()
+      : x_(xt::random::randn<float>({kDataSize, kInSize})),
+        model_({kHiddenSize, kOutSize}, core::AsFunctionSharedPtr<function::ReLU>()) {
+    core::UseConfig with(core::Config::kDoesEnableBackpropagation, false);
+    expected_y_ = model_.Predict({core::AsTensorSharedPtr(x_)})[0]->data();  // Also initializes the parameters.
+  }
+
+  const xt::xarray<float> x_;
+  const model::MultiLayerPerceptron model_;
+  xt::xarray<float> expected_y_;
+};
+
+TEST_F(BatchingInferenceEngineTest, SubmitTest) {
+  BatchingInferenceEngine engine(model_, kMaxBatchSize, kMaxLatency, kNumWorkers);
+
+  std::vector<std::future<xt::xarray<float>>> y_futures;
+  for (std::size_t i = 0; i < kDataSize; ++i) {
+    y_futures.push_back(engine.Submit(xt::view(x_, i, xt::all())));
+  }
+
+  // Checks that each prediction is the same as the one of the whole batch.
+  for (std::size_t i = 0; i < kDataSize; ++i) {
+    const xt::xarray<float> actual_y = y_futures[i].get();
+    const xt::xarray<float> expected_y = xt::view(expected_y_, i, xt::all());
+    ASSERT_EQ(actual_y.shape(), expected_y.shape());
+    EXPECT_TRUE(xt::allclose(actual_y, expected_y));
+  }
+
+  // Checks that the requests are batched into full batches.
+  EXPECT_EQ(engine.num_requests(), kDataSize);
+  EXPECT_EQ(engine.num_batches(), kDataSize / kMaxBatchSize);
+}
+
+TEST_F(BatchingInferenceEngineTest, MaxLatencyTest) {
+  BatchingInferenceEngine engine(model_, kMaxBatchSize, std::chrono::microseconds(1000));
+
+  // Checks that a single request is predicted after the max latency even if the batch isn't full.
+  std::future<xt::xarray<float>> y_future = engine.Submit(xt::view(x_, 0, xt::all()));
+  ASSERT_EQ(y_future.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+  EXPECT_TRUE(xt::allclose(y_future.get(), xt::view(expected_y_, 0, xt::all())));
+  EXPECT_EQ(engine.num_batches(), 1);
+}
+
+TEST_F(BatchingInferenceEngineTest, ConcurrentSubmitTest) {
+  BatchingInferenceEngine engine(model_, kMaxBatchSize, std::chrono::microseconds(1000), kNumWorkers);
+
+  // Submits the requests from the concurrent threads, each of which waits for its prediction before the next request.
+  std::vector<std::thread> threads;
+  std::vector<xt::xarray<float>> actual_ys(kDataSize);
+  for (std::size_t i = 0; i < kDataSize; ++i) {
+    threads.emplace_back([this, &engine, &actual_ys, i] {
+      actual_ys[i] = engine.Submit(xt::view(x_, i, xt::all())).get();
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (std::size_t i = 0; i < kDataSize; ++i) {
+    EXPECT_TRUE(xt::allclose(actual_ys[i], xt::view(expected_y_, i, xt::all())));
+  }
+  EXPECT_EQ(engine.num_requests(), kDataSize);
+  EXPECT_LE(engine.num_batches(), kDataSize);
+}
+
+}  // namespace tensorward::serving
@@ -0,0 +1,115 @@
+#include "tensorward/serving/unix_socket_server.h"
+
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <xtensor/xarray.hpp>
+#include <xtensor/xrandom.hpp>
+#include <xtensor/xview.hpp>
+
+#include "tensorward/core/config.h"
+#include "tensorward/function/relu.h"
+#include "tensorward/model/multi_layer_perceptron.h"
+
+namespace tensorward::serving {
+
+namespace {
+
+constexpr int kDataSize = 32;
+constexpr int kInSize = 4;
+constexpr int kHiddenSize = 8;
+constexpr int kOutSize = 3;
+constexpr int kMaxBatchSize = 8;
+constexpr int kNumClients = 4;
+constexpr std::chrono::microseconds kMaxLatency(1000);
+
+}  // namespace
+
+class UnixSocketServerTest : public ::testing::Test {
+ protected:
+  UnixSocketServerTest()
+      : x_(xt::random::randn<float>({kDataSize, kInSize})),
+        model_({kHiddenSize, kOutSize}, core::AsFunctionSharedPtr<function::ReLU>()),
+        engine_(model_, kMaxBatchSize, kMaxLatency),
+        socket_path_(std::filesystem::temp_directory_path() /
+                     ("tensorward_" + std::to_string(getpid()) + "_" +
+                      ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".sock")),
+        server_(engine_, socket_path_, kInSize) {
+    core::UseConfig with(core::Config::kDoesEnableBackpropagation, false);
+    expected_y_ = model_.Predict({core::AsTensorSharedPtr(x_)})[0]->data();  // Also initializes the parameters.
+  }
+
+  const xt::xarray<float> x_;
+  const model::MultiLayerPerceptron model_;
+  BatchingInferenceEngine engine_;
+  const std::filesystem::path socket_path_;
+  UnixSocketServer server_;
+  xt::xarray<float> expected_y_;
+};
+
+TEST_F(UnixSocketServerTest, PredictTest) {
+  ASSERT_TRUE(server_.Start());
+
+  // Sends the requests from the concurrent clients.
+  std::vector<std::thread> threads;
+  std::vector<xt::xarray<float>> actual_ys(kDataSize);
+  for (std::size_t c = 0; c < kNumClients; ++c) {
+    threads.emplace_back([this, &actual_ys, c] {
+      UnixSocketClient client;
+      ASSERT_TRUE(client.Connect(socket_path_));
+      for (std::size_t i = c; i < kDataSize; i += kNumClients) {
+        ASSERT_TRUE(client.Predict(xt::view(x_, i, xt::all()), actual_ys[i]));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (std::size_t i = 0; i < kDataSize; ++i) {
+    ASSERT_EQ(actual_ys[i].size(), kOutSize);
+    EXPECT_TRUE(xt::allclose(actual_ys[i], xt::view(expected_y_, i, xt::all())));
+  }
+  EXPECT_EQ(engine_.num_requests(), kDataSize);
+
+  server_.Stop();
+  EXPECT_FALSE(std::filesystem::exists(socket_path_));
+}
+
+TEST_F(UnixSocketServerTest, RejectTest) {
+  ASSERT_TRUE(server_.Start());
+
+  // Checks that the request of the wrong size is rejected, but the connection is still available.
+  UnixSocketClient client;
+  ASSERT_TRUE(client.Connect(socket_path_));
+  xt::xarray<float> y;
+  EXPECT_FALSE(client.Predict(xt::zeros<float>({kInSize + 1}), y));
+  ASSERT_TRUE(client.Predict(xt::view(x_, 0, xt::all()), y));
+  EXPECT_TRUE(xt::allclose(y, xt::view(expected_y_, 0, xt::all())));
+  EXPECT_EQ(engine_.num_requests(), 1);
+}
+
+TEST_F(UnixSocketServerTest, ReconnectTest) {
+  constexpr int kNumConnections = 16;
+
+  // Checks that the short-lived connections are served one after another (while their finished threads are reaped),
+  // and that the server can be restarted after stopping it.
+  for (int restart = 0; restart < 2; ++restart) {
+    ASSERT_TRUE(server_.Start());
+    for (int i = 0; i < kNumConnections; ++i) {
+      UnixSocketClient client;
+      ASSERT_TRUE(client.Connect(socket_path_));
+      xt::xarray<float> y;
+      ASSERT_TRUE(client.Predict(xt::view(x_, i % kDataSize, xt::all()), y));
+      EXPECT_TRUE(xt::allclose(y, xt::view(expected_y_, i % kDataSize, xt::all())));
+    }
+    server_.Stop();
+  }
+  EXPECT_EQ(engine_.num_requests(), 2 * kNumConnections);
+}
+
+}  // namespace tensorward::serving
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace tensorward::serving {
+
+// Message over a Unix domain socket, which is the number of the floats (uint32) followed by the floats, both in the
+// native byte order (the server and the clients are on the same machine):
+//
+//   +---------------------------+-------------------------------------+
+//   | number of floats (uint32) | floats (float * number of floats)   |
+//   +---------------------------+-------------------------------------+
+//
+// A request has a single sample, and its response has the prediction of the sample. An empty response means that the
+// request is rejected (e.g. due to the wrong size of the sample).
+
+// Flags of `send()`, where `MSG_NOSIGNAL` keeps the process from being killed by `SIGPIPE` when the peer has closed the
+// connection. If it isn't available (e.g. macOS), then `SO_NOSIGPIPE` is set on the socket instead (see
+// `DisableSigpipe()`).
+#if defined(MSG_NOSIGNAL)
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0;
+#endif
+
+// Keeps the socket from raising `SIGPIPE` where `MSG_NOSIGNAL` isn't available, which must be called for each socket
+// (e.g. both of the accepted and the connected ones) before sending. Returns false if it fails.
+inline const bool DisableSigpipe(const int socket_descriptor) {
+#if !defined(MSG_NOSIGNAL) && defined(SO_NOSIGPIPE)
+  const int value = 1;
+  return setsockopt(socket_descriptor, SOL_SOCKET, SO_NOSIGPIPE, &value, sizeof(value)) == 0;
+#else
+  return true;
+#endif
+}
+
+// Receives exactly `size` bytes. Returns false if the connection is closed or broken.
+inline const bool ReceiveAll(const int socket_descriptor, void* buffer, const std::size_t size) {
+  std::size_t received_size = 0;
+  while (received_size < size) {
+    const ssize_t size_once = recv(socket_descriptor, static_cast<char*>(buffer) + received_size,
+                                   size - received_size, 0);
+    if (size_once < 0 && errno == EINTR) {
+      continue;
+    }
+    if (size_once <= 0) {
+      return false;
+    }
+    received_size += size_once;
+  }
+  return true;
+}
+
+// Sends exactly `size` bytes. Returns false if the connection is closed or broken.
+inline const bool SendAll(const int socket_descriptor, const void* buffer, const std::size_t size) {
+  std::size_t sent_size = 0;
+  while (sent_size < size) {
+    const ssize_t size_once = send(socket_descriptor, static_cast<const char*>(buffer) + sent_size,
+                                   size - sent_size, kSendFlags);
+    if (size_once < 0 && errno == EINTR) {
+      continue;
+    }
+    if (size_once <= 0) {
+      return false;
+    }
+    sent_size += size_once;
+  }
+  return true;
+}
+
+// Receives a message into `values`. Returns false if the connection is closed or broken.
+// NOTE: The number of the floats is chosen by the peer, so a message of more than `max_num_values` floats is drained
+// NOTE: through a small buffer (and `values` is left empty) instead of allocating it. A server must pass the max size
+// NOTE: which it accepts.
+inline const bool ReceiveMessage(const int socket_descriptor, std::vector<float>& values,
+                                 const std::size_t max_num_values = std::numeric_limits<std::uint32_t>::max()) {
+  std::uint32_t num_values;
+  if (!ReceiveAll(socket_descriptor, &num_values, sizeof(num_values))) {
+    return false;
+  }
+
+  if (max_num_values < num_values) {
+    values.clear();
+    constexpr std::size_t kDrainBufferSize = 1024;
+    float drain_buffer[kDrainBufferSize];
+    for (std::size_t drained_size = 0; drained_size < num_values; drained_size += kDrainBufferSize) {
+      const std::size_t size_once = std::min<std::size_t>(kDrainBufferSize, num_values - drained_size);
+      if (!ReceiveAll(socket_descriptor, drain_buffer, size_once * sizeof(float))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  values.resize(num_values);
+  return ReceiveAll(socket_descriptor, values.data(), num_values * sizeof(float));
+}
+
+// Sends a message of `num_values` floats. Returns false if the connection is closed or broken.
+inline const bool SendMessage(const int socket_descriptor, const float* values, const std::size_t num_values) {
+  const std::uint32_t num_values_uint32 = num_values;
+  return SendAll(socket_descriptor, &num_values_uint32, sizeof(num_values_uint32)) &&
+         SendAll(socket_descriptor, values, num_values * sizeof(float));
+}
+
+}  // namespace tensorward::serving
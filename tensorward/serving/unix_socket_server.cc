@@ -0,0 +1,245 @@
+#include "tensorward/serving/unix_socket_server.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <utility>
+
+#include <xtensor/xadapt.hpp>
+
+#include "tensorward/serving/unix_socket_message.h"
+
+namespace tensorward::serving {
+
+namespace {
+
+constexpr int kListenBacklog = 128;
+
+// Interval [ms] before retrying `accept()` after it fails (e.g. `EMFILE` while the connections use up the file
+// descriptors), which stops the retries from spinning, since the pending connection keeps the socket readable.
+constexpr int kAcceptRetryIntervalInMilliseconds = 100;
+
+// Fills the address of the socket. Returns false if the path is too long.
+const bool SetSocketAddress(const std::filesystem::path& socket_path, sockaddr_un& address) {
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  const std::string& socket_path_string = socket_path.native();
+  if (sizeof(address.sun_path) <= socket_path_string.size()) {
+    return false;
+  }
+  std::memcpy(address.sun_path, socket_path_string.c_str(), socket_path_string.size());
+  return true;
+}
+
+}  // namespace
+
+UnixSocketServer::UnixSocketServer(BatchingInferenceEngine& engine, const std::filesystem::path& socket_path,
+                                   const std::size_t in_size)
+    : engine_(engine),
+      socket_path_(socket_path),
+      in_size_(in_size),
+      listening_descriptor_(-1),
+      wake_up_pipe_descriptors_{-1, -1},
+      is_stopping_(false) {}
+
+UnixSocketServer::~UnixSocketServer() { Stop(); }
+
+const bool UnixSocketServer::Start() {
+  if (0 <= listening_descriptor_) {
+    return false;
+  }
+
+  sockaddr_un address;
+  if (!SetSocketAddress(socket_path_, address)) {
+    return false;
+  }
+  listening_descriptor_ = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listening_descriptor_ < 0) {
+    return false;
+  }
+  std::error_code error_code;
+  std::filesystem::remove(socket_path_, error_code);
+  if (bind(listening_descriptor_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+      listen(listening_descriptor_, kListenBacklog) != 0 || pipe(wake_up_pipe_descriptors_) != 0) {
+    close(listening_descriptor_);
+    listening_descriptor_ = -1;
+    return false;
+  }
+
+  // NOTE: The listening socket is non-blocking, so that `accept()` never blocks if the connection polled is aborted
+  // NOTE: before being accepted.
+  fcntl(listening_descriptor_, F_SETFL, fcntl(listening_descriptor_, F_GETFL) | O_NONBLOCK);
+
+  is_stopping_ = false;
+  accepting_thread_ = std::thread(&UnixSocketServer::Accept, this);
+  return true;
+}
+
+void UnixSocketServer::Stop() {
+  if (listening_descriptor_ < 0) {
+    return;
+  }
+
+  // Wakes up the accepting thread, and then unblocks `recv()` of the connection threads.
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_stopping_ = true;
+  }
+  const char wake_up_byte = 0;
+  while (write(wake_up_pipe_descriptors_[1], &wake_up_byte, 1) < 0 && errno == EINTR) {
+  }
+  accepting_thread_.join();
+  std::unordered_map<std::thread::id, std::thread> connection_threads;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const int connection_descriptor : connection_descriptors_) {
+      shutdown(connection_descriptor, SHUT_RDWR);
+    }
+    connection_threads.swap(connection_threads_);
+  }
+  for (auto& [id, connection_thread] : connection_threads) {
+    connection_thread.join();
+  }
+  {
+    // NOTE: Cleared after joining all of the threads, which report that they have finished until they exit.
+    std::lock_guard<std::mutex> lock(mutex_);
+    finished_connection_thread_ids_.clear();
+  }
+
+  close(listening_descriptor_);
+  listening_descriptor_ = -1;
+  close(wake_up_pipe_descriptors_[0]);
+  close(wake_up_pipe_descriptors_[1]);
+  wake_up_pipe_descriptors_[0] = -1;
+  wake_up_pipe_descriptors_[1] = -1;
+  std::error_code error_code;
+  std::filesystem::remove(socket_path_, error_code);
+}
+
+void UnixSocketServer::Accept() {
+  while (true) {
+    // Waits for either a connection or the wake-up by `Stop()`.
+    pollfd poll_descriptors[2] = {{listening_descriptor_, POLLIN, 0}, {wake_up_pipe_descriptors_[0], POLLIN, 0}};
+    const int num_ready_descriptors = poll(poll_descriptors, 2, -1);
+    if (num_ready_descriptors < 0) {
+      if (errno != EINTR) {
+        std::cerr << "[UnixSocketServer::Accept()] poll() failed: " << std::strerror(errno) << std::endl;
+        std::this_thread::sleep_for(std::chrono::milliseconds(kAcceptRetryIntervalInMilliseconds));
+      }
+      continue;
+    }
+    if (poll_descriptors[1].revents != 0) {
+      break;
+    }
+
+    const int connection_descriptor = accept(listening_descriptor_, nullptr, nullptr);
+    if (connection_descriptor < 0 && (errno == EINTR || errno == ECONNABORTED || errno == EAGAIN)) {
+      continue;
+    }
+    // Keeps accepting after the other failures (e.g. `EMFILE` or `ENFILE` under load), which may be temporary. Only
+    // `Stop()` stops accepting, and it also wakes up this back-off.
+    if (connection_descriptor < 0) {
+      std::cerr << "[UnixSocketServer::Accept()] accept() failed: " << std::strerror(errno) << std::endl;
+      poll(&poll_descriptors[1], 1, kAcceptRetryIntervalInMilliseconds);
+      continue;
+    }
+    // NOTE: The accepted socket inherits `O_NONBLOCK` of the listening socket on some platforms (e.g. macOS), but the
+    // NOTE: connection threads block on it.
+    fcntl(connection_descriptor, F_SETFL, fcntl(connection_descriptor, F_GETFL) & ~O_NONBLOCK);
+
+    std::vector<std::thread> finished_connection_threads;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (is_stopping_) {
+        close(connection_descriptor);
+        break;
+      }
+      for (const std::thread::id id : finished_connection_thread_ids_) {
+        finished_connection_threads.push_back(std::move(connection_threads_.at(id)));
+        connection_threads_.erase(id);
+      }
+      finished_connection_thread_ids_.clear();
+
+      DisableSigpipe(connection_descriptor);
+      connection_descriptors_.insert(connection_descriptor);
+      // NOTE: The thread is registered under the lock, so it's registered before it reports that it has finished.
+      std::thread connection_thread(&UnixSocketServer::Serve, this, connection_descriptor);
+      const std::thread::id id = connection_thread.get_id();
+      connection_threads_.emplace(id, std::move(connection_thread));
+    }
+
+    // The finished threads are just exiting, so joining them takes no time.
+    for (auto& finished_connection_thread : finished_connection_threads) {
+      finished_connection_thread.join();
+    }
+  }
+}
+
+void UnixSocketServer::Serve(const int connection_descriptor) {
+  std::vector<float> x_values;
+  while (ReceiveMessage(connection_descriptor, x_values, in_size_)) {
+    if (x_values.size() != in_size_) {
+      // Rejects the request by the empty response.
+      if (!SendMessage(connection_descriptor, nullptr, 0)) {
+        break;
+      }
+      continue;
+    }
+
+    const xt::xarray<float> y = engine_.Submit(xt::adapt(x_values, {in_size_})).get();
+    if (!SendMessage(connection_descriptor, y.data(), y.size())) {
+      break;
+    }
+  }
+
+  // NOTE: The descriptor is closed under the lock, so that `Stop()` never shuts down a reused descriptor.
+  std::lock_guard<std::mutex> lock(mutex_);
+  connection_descriptors_.erase(connection_descriptor);
+  close(connection_descriptor);
+  finished_connection_thread_ids_.push_back(std::this_thread::get_id());
+}
+
+UnixSocketClient::UnixSocketClient() : socket_descriptor_(-1) {}
+
+UnixSocketClient::~UnixSocketClient() {
+  if (0 <= socket_descriptor_) {
+    close(socket_descriptor_);
+  }
+}
+
+const bool UnixSocketClient::Connect(const std::filesystem::path& socket_path) {
+  sockaddr_un address;
+  if (0 <= socket_descriptor_ || !SetSocketAddress(socket_path, address)) {
+    return false;
+  }
+  socket_descriptor_ = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (socket_descriptor_ < 0) {
+    return false;
+  }
+  if (connect(socket_descriptor_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+      !DisableSigpipe(socket_descriptor_)) {
+    close(socket_descriptor_);
+    socket_descriptor_ = -1;
+    return false;
+  }
+  return true;
+}
+
+const bool UnixSocketClient::Predict(const xt::xarray<float>& x, xt::xarray<float>& y) {
+  if (socket_descriptor_ < 0 || !SendMessage(socket_descriptor_, x.data(), x.size()) ||
+      !ReceiveMessage(socket_descriptor_, buffer_) || buffer_.empty()) {
+    return false;
+  }
+  y = xt::adapt(buffer_, {buffer_.size()});
+  return true;
+}
+
+}  // namespace tensorward::serving
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "tensorward/serving/batching_inference_engine.h"
+
+namespace tensorward::serving {
+
+// Front end of the inference engine over a Unix domain socket (see `unix_socket_message.h` for the protocol). Each
+// connection is served by its own thread, which submits the requests one by one to the engine, so the concurrent
+// requests come from the concurrent connections and are batched by the engine.
+class UnixSocketServer {
+ public:
+  // `in_size` is the size of a sample, and the requests of the other sizes are rejected.
+  UnixSocketServer(BatchingInferenceEngine& engine, const std::filesystem::path& socket_path,
+                   const std::size_t in_size);
+
+  // Stops the server if it's running.
+  ~UnixSocketServer();
+
+  // Prevents copy construction.
+  UnixSocketServer(const UnixSocketServer&) = delete;
+
+  // Prevents copy assignment.
+  UnixSocketServer& operator=(const UnixSocketServer&) = delete;
+
+  // Binds the socket, and starts accepting the connections in the background. Returns false if it fails to listen.
+  // NOTE: An existing file at `socket_path` is removed.
+  const bool Start();
+
+  // Closes the socket and all of the connections, and waits for their threads.
+  void Stop();
+
+  const std::filesystem::path& socket_path() const { return socket_path_; }
+
+  const std::size_t in_size() const { return in_size_; }
+
+ private:
+  // Main loop of the thread accepting the connections.
+  void Accept();
+
+  // Main loop of the thread serving a connection.
+  void Serve(const int connection_descriptor);
+
+  BatchingInferenceEngine& engine_;
+
+  std::filesystem::path socket_path_;
+
+  std::size_t in_size_;
+
+  int listening_descriptor_;
+
+  // Pipe written by `Stop()` in order to wake up the accepting thread polling it together with the listening socket.
+  // NOTE: `shutdown()` of the listening socket doesn't wake up `accept()` on every platform (e.g. macOS).
+  int wake_up_pipe_descriptors_[2];
+
+  std::mutex mutex_;
+
+  bool is_stopping_;
+
+  // Connections which are open, which are shut down by `Stop()` in order to unblock their threads.
+  std::unordered_set<int> connection_descriptors_;
+
+  // Threads of the connections by their IDs.
+  std::unordered_map<std::thread::id, std::thread> connection_threads_;
+
+  // IDs of the connection threads which have finished serving (i.e. are about to exit), which are joined and removed
+  // by the accepting thread at the next connection, so that `connection_threads_` doesn't grow forever.
+  std::vector<std::thread::id> finished_connection_thread_ids_;
+
+  std::thread accepting_thread_;
+};
+
+// Client of `UnixSocketServer`, which sends the requests one by one over a single connection.
+class UnixSocketClient {
+ public:
+  UnixSocketClient();
+
+  // Closes the connection.
+  ~UnixSocketClient();
+
+  // Prevents copy construction.
+  UnixSocketClient(const UnixSocketClient&) = delete;
+
+  // Prevents copy assignment.
+  UnixSocketClient& operator=(const UnixSocketClient&) = delete;
+
+  // Connects to the server. Returns false if it fails to connect.
+  const bool Connect(const std::filesystem::path& socket_path);
+
+  // Sends the single sample `x`, and receives its prediction `y` (flattened). Returns false if the connection is
+  // broken or the request is rejected.
+  const bool Predict(const xt::xarray<float>& x, xt::xarray<float>& y);
+
+ private:
+  int socket_descriptor_;
+
+  std::vector<float> buffer_;
+};
+
+}  // namespace tensorward::serving
@@ -0,0 +1,4 @@
+#pragma once
+
+// Header file aggregation for users.
+#include "tensorward/transforms/compose.h"
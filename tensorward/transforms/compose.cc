@@ -0,0 +1,270 @@
+#include "tensorward/transforms/compose.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <utility>
+
+#include <xtensor/xbuilder.hpp>
+#include <xtensor/xrandom.hpp>
+
+namespace tensorward::transforms {
+
+namespace {
+
+using ShapeType = xt::xarray<float>::shape_type;
+
+// Number of the elements which all of the element-wise transforms are applied to in turn (small enough to stay in L1
+// cache between them).
+constexpr std::size_t kElementwiseBlockSize = 1024;
+
+// Element-wise transform, which is an affine transform (folded from the consecutive ones) or a cast.
+struct ElementwiseTransform {
+  bool is_affine;
+
+  float scale;
+
+  float bias;
+
+  bool does_round;
+
+  float lower_bound;
+
+  float upper_bound;
+};
+
+// Crop or flip, with the height and the width of the sample before it.
+struct GeometricTransform {
+  const Transform* transform;
+
+  std::size_t height;
+
+  std::size_t width;
+};
+
+// Transforms compiled for the shape of the sample, where the sample is viewed as {num_rows, height, width}.
+struct Plan {
+  std::size_t height;
+
+  std::size_t width;
+
+  std::size_t transformed_height;
+
+  std::size_t transformed_width;
+
+  std::vector<GeometricTransform> geometric_transforms;
+
+  std::vector<ElementwiseTransform> elementwise_transforms;
+
+  // Number of the classes of `OneHot()` (or 0 without it).
+  std::size_t num_classes;
+
+  ShapeType transformed_sample_shape;
+};
+
+const std::size_t SizeOf(const ShapeType& shape) {
+  return std::accumulate(shape.begin(), shape.end(), std::size_t(1), std::multiplies<std::size_t>());
+}
+
+// Height and width of the sample {..., H, W}, where they are 1 if the rank is less than 2.
+const std::size_t HeightOf(const ShapeType& shape) { return (2 <= shape.size()) ? shape[shape.size() - 2] : 1; }
+
+const std::size_t WidthOf(const ShapeType& shape) { return (1 <= shape.size()) ? shape.back() : 1; }
+
+const Plan MakePlan(const std::vector<Transform>& transforms, const ShapeType& sample_shape) {
+  Plan plan{.height = HeightOf(sample_shape), .width = WidthOf(sample_shape), .num_classes = 0};
+
+  ShapeType shape = sample_shape;
+  bool is_flattened = false;
+  for (std::size_t i = 0; i < transforms.size(); ++i) {
+    const Transform& transform = transforms[i];
+    switch (transform.type) {
+      case Transform::Type::kFlatten:
+        is_flattened = true;
+        break;
+      case Transform::Type::kAffine:
+        if (!plan.elementwise_transforms.empty() && plan.elementwise_transforms.back().is_affine) {
+          // (x * s1 + b1) * s2 + b2 = x * (s1 * s2) + (b1 * s2 + b2)
+          ElementwiseTransform& affine = plan.elementwise_transforms.back();
+          affine.scale *= transform.scale;
+          affine.bias = affine.bias * transform.scale + transform.bias;
+        } else {
+          plan.elementwise_transforms.push_back({true, transform.scale, transform.bias, false, 0.0, 0.0});
+        }
+        break;
+      case Transform::Type::kCast:
+        plan.elementwise_transforms.push_back(
+            {false, 1.0, 0.0, transform.does_round, transform.lower_bound, transform.upper_bound});
+        break;
+      case Transform::Type::kOneHot:
+        assert((static_cast<void>("`OneHot()` must be the last transform."), i + 1 == transforms.size()));
+        assert((static_cast<void>("The sample of `OneHot()` must be a single class index."), SizeOf(shape) == 1));
+        plan.num_classes = transform.num_classes;
+        break;
+      case Transform::Type::kRandomCrop:
+        assert((static_cast<void>("The sample must not be flattened before `RandomCrop()`."), !is_flattened));
+        assert((static_cast<void>("The sample of `RandomCrop()` must be {..., H, W}."), 2 <= shape.size()));
+        assert((static_cast<void>("The crop must fit in the sample."),
+                transform.height <= HeightOf(shape) && transform.width <= WidthOf(shape)));
+        plan.geometric_transforms.push_back({&transform, HeightOf(shape), WidthOf(shape)});
+        shape[shape.size() - 2] = transform.height;
+        shape[shape.size() - 1] = transform.width;
+        break;
+      case Transform::Type::kRandomHorizontalFlip:
+        assert((static_cast<void>("The sample must not be flattened before `RandomHorizontalFlip()`."), !is_flattened));
+        plan.geometric_transforms.push_back({&transform, HeightOf(shape), WidthOf(shape)});
+        break;
+    }
+  }
+
+  plan.transformed_height = HeightOf(shape);
+  plan.transformed_width = WidthOf(shape);
+  if (plan.num_classes != 0) {
+    plan.transformed_sample_shape = {plan.num_classes};
+  } else if (is_flattened) {
+    plan.transformed_sample_shape = {SizeOf(shape)};
+  } else {
+    plan.transformed_sample_shape = shape;
+  }
+
+  return plan;
+}
+
+// Applies all of the element-wise transforms to the data block by block (each loop over a block can be vectorized).
+void ApplyElementwiseTransforms(const std::vector<ElementwiseTransform>& elementwise_transforms, float* data,
+                                const std::size_t size) {
+  for (std::size_t begin = 0; begin < size; begin += kElementwiseBlockSize) {
+    float* block = data + begin;
+    const std::size_t block_size = std::min(kElementwiseBlockSize, size - begin);
+    for (const ElementwiseTransform& elementwise_transform : elementwise_transforms) {
+      if (elementwise_transform.is_affine) {
+        const float scale = elementwise_transform.scale;
+        const float bias = elementwise_transform.bias;
+        for (std::size_t i = 0; i < block_size; ++i) {
+          block[i] = block[i] * scale + bias;
+        }
+      } else {
+        if (elementwise_transform.does_round) {
+          for (std::size_t i = 0; i < block_size; ++i) {
+            block[i] = std::nearbyint(block[i]);
+          }
+        }
+        const float lower_bound = elementwise_transform.lower_bound;
+        const float upper_bound = elementwise_transform.upper_bound;
+        for (std::size_t i = 0; i < block_size; ++i) {
+          block[i] = std::clamp(block[i], lower_bound, upper_bound);
+        }
+      }
+    }
+  }
+}
+
+// Transforms a sample into the transformed sample (which must not overlap), drawing the random parameters of the crops
+// and the flips from the engine.
+void TransformSample(const Plan& plan, const float* sample, std::mt19937& engine, float* transformed_sample) {
+  if (plan.num_classes != 0) {
+    float class_index = sample[0];
+    ApplyElementwiseTransforms(plan.elementwise_transforms, &class_index, 1);
+    assert((static_cast<void>("The class index must be less than the number of the classes."),
+            0.0 <= class_index && class_index < plan.num_classes));
+    std::fill(transformed_sample, transformed_sample + plan.num_classes, 0.0f);
+    transformed_sample[static_cast<std::size_t>(class_index)] = 1.0;
+    return;
+  }
+
+  // Composes the crops and the flips into a mapping of the indices of the transformed sample into the sample:
+  //
+  //   (h, w) -> (h + row_offset, column_sign * w + column_offset)
+  //
+  std::size_t row_offset = 0;
+  std::ptrdiff_t column_offset = 0;
+  std::ptrdiff_t column_sign = 1;
+  for (const GeometricTransform& geometric_transform : plan.geometric_transforms) {
+    const Transform& transform = *geometric_transform.transform;
+    if (transform.type == Transform::Type::kRandomCrop) {
+      std::uniform_int_distribution<std::size_t> top_distribution(0, geometric_transform.height - transform.height);
+      std::uniform_int_distribution<std::size_t> left_distribution(0, geometric_transform.width - transform.width);
+      row_offset += top_distribution(engine);
+      column_offset += column_sign * static_cast<std::ptrdiff_t>(left_distribution(engine));
+    } else if (std::bernoulli_distribution(transform.probability)(engine)) {
+      column_offset += column_sign * static_cast<std::ptrdiff_t>(geometric_transform.width - 1);
+      column_sign = -column_sign;
+    }
+  }
+
+  const std::size_t num_rows =
+      (plan.transformed_width == 0) ? 0 : SizeOf(plan.transformed_sample_shape) / plan.transformed_width;
+  for (std::size_t r = 0; r < num_rows; ++r) {
+    const std::size_t l = r / plan.transformed_height;
+    const std::size_t h = r % plan.transformed_height;
+    const float* row = sample + (l * plan.height + h + row_offset) * plan.width + column_offset;
+    float* transformed_row = transformed_sample + r * plan.transformed_width;
+    if (0 < column_sign) {
+      std::copy(row, row + plan.transformed_width, transformed_row);
+    } else {
+      std::reverse_copy(row - plan.transformed_width + 1, row + 1, transformed_row);
+    }
+    ApplyElementwiseTransforms(plan.elementwise_transforms, transformed_row, plan.transformed_width);
+  }
+}
+
+}  // namespace
+
+Compose::Compose(const std::vector<Transform>& transforms) : transforms_(transforms) {}
+
+void Compose::operator()(xt::xarray<float>& batch) const {
+  assert((static_cast<void>("The batch must be {N, ...}."), 1 <= batch.dimension()));
+
+  const std::size_t batch_size = batch.shape(0);
+  const ShapeType sample_shape(batch.shape().begin() + 1, batch.shape().end());
+  const Plan plan = MakePlan(transforms_, sample_shape);
+  const std::size_t sample_size = SizeOf(sample_shape);
+  const std::size_t transformed_sample_size = SizeOf(plan.transformed_sample_shape);
+  ShapeType transformed_batch_shape = plan.transformed_sample_shape;
+  transformed_batch_shape.insert(transformed_batch_shape.begin(), batch_size);
+
+  const bool is_in_place = (plan.num_classes == 0 && transformed_sample_size == sample_size);
+  if (is_in_place && plan.geometric_transforms.empty()) {
+    // Only the element-wise transforms (and the flattening) in a single pass over the whole batch.
+    ApplyElementwiseTransforms(plan.elementwise_transforms, batch.data(), batch.size());
+    batch.reshape(transformed_batch_shape);
+    return;
+  }
+
+  // Transforms each sample into its place in the batch (after copying it into the buffer of a sample, because the
+  // flip reads the row in the reverse order), or in the new batch.
+  std::vector<float> sample_buffer;
+  xt::xarray<float> transformed_batch;
+  if (is_in_place) {
+    sample_buffer.resize(sample_size);
+  } else {
+    transformed_batch = xt::empty<float>(transformed_batch_shape);
+  }
+  float* transformed_data = is_in_place ? batch.data() : transformed_batch.data();
+
+  std::mt19937& engine = xt::random::get_default_random_engine();
+  for (std::size_t n = 0; n < batch_size; ++n) {
+    const float* sample = batch.data() + n * sample_size;
+    if (is_in_place) {
+      std::copy(sample, sample + sample_size, sample_buffer.begin());
+      sample = sample_buffer.data();
+    }
+    TransformSample(plan, sample, engine, transformed_data + n * transformed_sample_size);
+  }
+
+  if (is_in_place) {
+    batch.reshape(transformed_batch_shape);
+  } else {
+    batch = std::move(transformed_batch);
+  }
+}
+
+const xt::xarray<float>::shape_type Compose::TransformedSampleShape(
+    const xt::xarray<float>::shape_type& sample_shape) const {
+  return MakePlan(transforms_, sample_shape).transformed_sample_shape;
+}
+
+}  // namespace tensorward::transforms
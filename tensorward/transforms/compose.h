@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include <xtensor/xarray.hpp>
+
+namespace tensorward::transforms {
+
+// Built-in transform of a sample, which is created by the functions below (e.g. `Normalize(0.0, 255.0)`) and applied by
+// `Compose`.
+struct Transform {
+  enum class Type {
+    kFlatten,
+    kAffine,
+    kCast,
+    kOneHot,
+    kRandomCrop,
+    kRandomHorizontalFlip,
+  };
+
+  Type type;
+
+  // `kAffine`: x * scale + bias
+  float scale = 1.0;
+
+  float bias = 0.0;
+
+  // `kCast`: x is rounded to the nearest integer (if `does_round` is true), and clamped into the bounds.
+  bool does_round = false;
+
+  float lower_bound = -std::numeric_limits<float>::infinity();
+
+  float upper_bound = std::numeric_limits<float>::infinity();
+
+  // `kOneHot`
+  std::size_t num_classes = 0;
+
+  // `kRandomCrop`
+  std::size_t height = 0;
+
+  std::size_t width = 0;
+
+  // `kRandomHorizontalFlip`
+  float probability = 0.0;
+};
+
+// Flattens the sample into 1-D.
+inline const Transform Flatten() { return {.type = Transform::Type::kFlatten}; }
+
+// Normalizes the sample as (x - mean) / stddev.
+inline const Transform Normalize(const float mean, const float stddev) {
+  return {.type = Transform::Type::kAffine, .scale = 1.0f / stddev, .bias = -mean / stddev};
+}
+
+// Casts the sample into the type `T` (and back into float), i.e. rounds it and clamps it into the range of `T` if `T`
+// is an integer type (e.g. `Cast<std::uint8_t>()` emulates the pixels of uint8).
+template <class T>
+const Transform Cast() {
+  if constexpr (std::is_integral_v<T>) {
+    return {.type = Transform::Type::kCast,
+            .does_round = true,
+            .lower_bound = static_cast<float>(std::numeric_limits<T>::lowest()),
+            .upper_bound = static_cast<float>(std::numeric_limits<T>::max())};
+  } else {
+    return {.type = Transform::Type::kCast,
+            .lower_bound = static_cast<float>(std::numeric_limits<T>::lowest()),
+            .upper_bound = static_cast<float>(std::numeric_limits<T>::max())};
+  }
+}
+
+// Converts the class index (i.e. the sample of a single element) into the one-hot vector {num_classes}.
+// NOTE: This must be the last transform.
+inline const Transform OneHot(const std::size_t num_classes) {
+  return {.type = Transform::Type::kOneHot, .num_classes = num_classes};
+}
+
+// Crops the sample {..., H, W} into {..., height, width} at a random position.
+inline const Transform RandomCrop(const std::size_t height, const std::size_t width) {
+  return {.type = Transform::Type::kRandomCrop, .height = height, .width = width};
+}
+
+// Flips the sample {..., W} along the last axis with the probability.
+inline const Transform RandomHorizontalFlip(const float probability = 0.5) {
+  return {.type = Transform::Type::kRandomHorizontalFlip, .probability = probability};
+}
+
+// Composition of the transforms, which is applied to a whole batch {N, ...} instead of each sample (as
+// `core::TransformLambda`). The transforms are fused into a single pass over the batch: the crops and the flips are
+// composed into a single mapping of the indices (whose random parameters are drawn for each sample), the affine
+// transforms are folded into one, and all of the element-wise transforms are applied to each row while it's in the
+// cache, without any intermediate arrays.
+//
+// e.g. Compose({Flatten(), Normalize(0.0, 255.0)}) for the images of MNIST {N, 1, 28, 28} -> {N, 784}.
+//
+// NOTE: The random parameters are drawn from `xt::random::get_default_random_engine()` (so `xt::random::seed()` makes
+// NOTE: them reproducible).
+class Compose {
+ public:
+  Compose(const std::vector<Transform>& transforms);
+
+  ~Compose() {}
+
+  // Transforms each sample of the batch. The batch is transformed in place if the size of the sample doesn't change
+  // (i.e. without `RandomCrop()` smaller than the sample or `OneHot()`), otherwise it's replaced with a new batch.
+  void operator()(xt::xarray<float>& batch) const;
+
+  // Returns the shape of the transformed sample.
+  const xt::xarray<float>::shape_type TransformedSampleShape(const xt::xarray<float>::shape_type& sample_shape) const;
+
+  const std::vector<Transform>& transforms() const { return transforms_; }
+
+ private:
+  std::vector<Transform> transforms_;
+};
+
+}  // namespace tensorward::transforms
@@ -0,0 +1,117 @@
+#include "tensorward/transforms/compose.h"
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+#include <xtensor/xbuilder.hpp>
+#include <xtensor/xmanipulation.hpp>
+#include <xtensor/xmath.hpp>
+#include <xtensor/xrandom.hpp>
+#include <xtensor/xview.hpp>
+
+namespace tensorward::transforms {
+
+namespace {
+
+constexpr std::size_t kBatchSize = 4;
+constexpr std::size_t kNumChannels = 2;
+constexpr std::size_t kHeight = 5;
+constexpr std::size_t kWidth = 6;
+constexpr std::size_t kCropHeight = 3;
+constexpr std::size_t kCropWidth = 4;
+constexpr std::size_t kNumClasses = 10;
+constexpr float kMean = 0.5;
+constexpr float kStddev = 2.0;
+
+}  // namespace
+
+class ComposeTest : public ::testing::Test {
+ protected:
+  ComposeTest() : batch_(xt::arange<float>(kBatchSize * kNumChannels * kHeight * kWidth)) {
+    // The value of each pixel is its flat index, so where it comes from can be identified.
+    batch_.reshape({kBatchSize, kNumChannels, kHeight, kWidth});
+  }
+
+  xt::xarray<float> batch_;
+};
+
+TEST_F(ComposeTest, FlattenAndNormalizeTest) {
+  xt::xarray<float> expected_batch = (batch_ - kMean) / kStddev;
+  expected_batch.reshape({kBatchSize, kNumChannels * kHeight * kWidth});
+
+  // Two normalizations are folded into one.
+  const Compose compose({Flatten(), Normalize(kMean, 1.0), Normalize(0.0, kStddev)});
+  const float* data = batch_.data();
+  compose(batch_);
+
+  // Checks that the batch is transformed in place.
+  EXPECT_EQ(batch_.data(), data);
+  EXPECT_TRUE(xt::allclose(batch_, expected_batch));
+  EXPECT_EQ(compose.TransformedSampleShape({kNumChannels, kHeight, kWidth}),
+            xt::xarray<float>::shape_type({kNumChannels * kHeight * kWidth}));
+}
+
+TEST_F(ComposeTest, CastTest) {
+  xt::xarray<float> batch = {{-1.0, 0.4, 0.6, 254.5, 300.0}, {1.5, 2.5, 127.0, 128.0, -129.0}};
+
+  Compose({Cast<std::uint8_t>()})(batch);
+  const xt::xarray<float> expected_uint8_batch = {{0.0, 0.0, 1.0, 254.0, 255.0}, {2.0, 2.0, 127.0, 128.0, 0.0}};
+  EXPECT_EQ(batch, expected_uint8_batch);
+
+  // Casts after the normalization.
+  Compose({Normalize(128.0, 1.0), Cast<std::int8_t>()})(batch);
+  const xt::xarray<float> expected_int8_batch = {{-128.0, -128.0, -127.0, 126.0, 127.0},
+                                                 {-126.0, -126.0, -1.0, 0.0, -128.0}};
+  EXPECT_EQ(batch, expected_int8_batch);
+}
+
+TEST_F(ComposeTest, OneHotTest) {
+  xt::xarray<float> label = {3.0, 0.0, 9.0, 3.0};
+
+  Compose({OneHot(kNumClasses)})(label);
+
+  xt::xarray<float> expected_label = xt::zeros<float>({std::size_t(4), kNumClasses});
+  expected_label(0, 3) = 1.0;
+  expected_label(1, 0) = 1.0;
+  expected_label(2, 9) = 1.0;
+  expected_label(3, 3) = 1.0;
+  EXPECT_EQ(label, expected_label);
+}
+
+TEST_F(ComposeTest, RandomHorizontalFlipTest) {
+  const xt::xarray<float> original_batch = batch_;
+
+  // Never flips.
+  Compose({RandomHorizontalFlip(0.0)})(batch_);
+  EXPECT_EQ(batch_, original_batch);
+
+  // Always flips, fused with the normalization.
+  Compose({RandomHorizontalFlip(1.0), Normalize(kMean, kStddev)})(batch_);
+  const xt::xarray<float> expected_batch = (xt::flip(original_batch, 3) - kMean) / kStddev;
+  EXPECT_TRUE(xt::allclose(batch_, expected_batch));
+}
+
+TEST_F(ComposeTest, RandomCropTest) {
+  const xt::xarray<float> original_batch = batch_;
+  xt::random::seed(0);
+
+  Compose({RandomCrop(kCropHeight, kCropWidth), RandomHorizontalFlip(1.0)})(batch_);
+  ASSERT_EQ(batch_.shape(), xt::xarray<float>::shape_type({kBatchSize, kNumChannels, kCropHeight, kCropWidth}));
+
+  // Checks that each sample is a (flipped) window of the original sample at the same position for all the channels.
+  for (std::size_t n = 0; n < kBatchSize; ++n) {
+    // The pixel at the top right of the window is the top left of the flipped one.
+    const std::size_t top_right_index = static_cast<std::size_t>(batch_(n, 0, 0, 0)) % (kHeight * kWidth);
+    const std::size_t top = top_right_index / kWidth;
+    const std::size_t left = top_right_index % kWidth - (kCropWidth - 1);
+    ASSERT_LE(top + kCropHeight, kHeight);
+    ASSERT_LE(left + kCropWidth, kWidth);
+
+    const xt::xarray<float> expected_sample = xt::flip(
+        xt::view(original_batch, n, xt::all(), xt::range(top, top + kCropHeight), xt::range(left, left + kCropWidth)),
+        2);
+    EXPECT_EQ(xt::xarray<float>(xt::view(batch_, n)), expected_sample);
+  }
+}
+
+}  // namespace tensorward::transforms
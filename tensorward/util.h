@@ -2,7 +2,21 @@
 
 // Header file aggregation for users.
 #include "tensorward/util/accuracy.h"
+#include "tensorward/util/atomic.h"
+#include "tensorward/util/gzip_file_reader.h"
+#include "tensorward/util/idx_file.h"
+#include "tensorward/util/numa.h"
 #include "tensorward/util/numerical_gradient.h"
+#include "tensorward/util/random_engine.h"
+#include "tensorward/util/reduced_precision.h"
+#include "tensorward/util/spsc_queue.h"
+#include "tensorward/util/thread_pool.h"
 #include "tensorward/util/xtensor_cross_entropy_error.h"
+#include "tensorward/util/xtensor_gather_scatter.h"
+#include "tensorward/util/xtensor_im2col.h"
+#include "tensorward/util/xtensor_numa_local.h"
+#include "tensorward/util/xtensor_quantization.h"
+#include "tensorward/util/xtensor_rank.h"
 #include "tensorward/util/xtensor_softmax.h"
 #include "tensorward/util/xtensor_sum_to.h"
+#include "tensorward/util/xtensor_winograd.h"
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <type_traits>
+
+namespace tensorward::util {
+
+// Atomic operations on a plain object (e.g. an element of an array, or a field of a shared memory mapping), which are
+// the subset of `std::atomic_ref` used by this library. They are built on the `__atomic` builtins of GCC and Clang,
+// since `std::atomic_ref` isn't available on every standard library yet (e.g. Apple libc++).
+// NOTE: The object must be aligned to its size, and must be accessed only by these functions while it's shared.
+
+namespace detail {
+
+// Converts the memory order into the one of the `__atomic` builtins.
+constexpr int ToBuiltinMemoryOrder(const std::memory_order order) {
+  switch (order) {
+    case std::memory_order_relaxed:
+      return __ATOMIC_RELAXED;
+    case std::memory_order_consume:
+      return __ATOMIC_CONSUME;
+    case std::memory_order_acquire:
+      return __ATOMIC_ACQUIRE;
+    case std::memory_order_release:
+      return __ATOMIC_RELEASE;
+    case std::memory_order_acq_rel:
+      return __ATOMIC_ACQ_REL;
+    default:
+      return __ATOMIC_SEQ_CST;
+  }
+}
+
+// Memory order of the failed compare-and-exchange, which can't contain the release.
+constexpr int ToBuiltinFailureMemoryOrder(const std::memory_order order) {
+  switch (order) {
+    case std::memory_order_release:
+      return __ATOMIC_RELAXED;
+    case std::memory_order_acq_rel:
+      return __ATOMIC_ACQUIRE;
+    default:
+      return ToBuiltinMemoryOrder(order);
+  }
+}
+
+}  // namespace detail
+
+template <class T>
+inline T AtomicLoad(const T& object, const std::memory_order order = std::memory_order_seq_cst) {
+  static_assert(std::is_integral_v<T>, "Only the integers are supported.");
+  return __atomic_load_n(&object, detail::ToBuiltinMemoryOrder(order));
+}
+
+template <class T>
+inline void AtomicStore(T& object, const T value, const std::memory_order order = std::memory_order_seq_cst) {
+  static_assert(std::is_integral_v<T>, "Only the integers are supported.");
+  __atomic_store_n(&object, value, detail::ToBuiltinMemoryOrder(order));
+}
+
+// Replaces the object with the desired value if it's the expected value, and returns true. Otherwise, loads the
+// object into the expected value, and returns false.
+template <class T>
+inline const bool AtomicCompareExchange(T& object, T& expected, const T desired,
+                                        const std::memory_order order = std::memory_order_seq_cst) {
+  static_assert(std::is_integral_v<T>, "Only the integers are supported.");
+  return __atomic_compare_exchange_n(&object, &expected, desired, false, detail::ToBuiltinMemoryOrder(order),
+                                     detail::ToBuiltinFailureMemoryOrder(order));
+}
+
+// Adds the value to the float, and returns the old one. It's the loop of the compare-and-exchange of the bits of the
+// float, since there's no atomic addition of a float in hardware.
+inline float AtomicFetchAdd(float& object, const float value,
+                            const std::memory_order order = std::memory_order_seq_cst) {
+  float expected;
+  __atomic_load(&object, &expected, __ATOMIC_RELAXED);
+  float desired = expected + value;
+  while (!__atomic_compare_exchange(&object, &expected, &desired, true, detail::ToBuiltinMemoryOrder(order),
+                                    detail::ToBuiltinFailureMemoryOrder(order))) {
+    desired = expected + value;
+  }
+  return expected;
+}
+
+}  // namespace tensorward::util
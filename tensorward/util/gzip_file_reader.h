@@ -0,0 +1,112 @@
+#pragma once
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace tensorward::util {
+
+// Reader of a gzip-compressed file (e.g. the IDX files of MNIST), which decompresses the file on the fly into the
+// caller's buffer. Unlike decompressing the whole file at once, it never holds the whole compressed or decompressed
+// data, so the memory is bounded by two buffers of `buffer_size` bytes (and the state of zlib) besides the destination.
+//
+// NOTE: The file may also be in the zlib format (the header is detected automatically), or a concatenation of gzip
+// NOTE: members.
+class GzipFileReader {
+ public:
+  static constexpr std::size_t kDefaultBufferSize = 1 << 16;
+
+  GzipFileReader(const std::filesystem::path& file_path, const std::size_t buffer_size = kDefaultBufferSize)
+      : ifs_(file_path, std::ios::in | std::ios::binary),
+        input_buffer_(buffer_size),
+        output_buffer_(buffer_size),
+        stream_({}),
+        is_valid_(false) {
+    // windowBits = 15 (max) + 32 (detects the gzip or zlib header automatically)
+    is_valid_ = ifs_.is_open() && inflateInit2(&stream_, 15 + 32) == Z_OK;
+  }
+
+  ~GzipFileReader() { inflateEnd(&stream_); }
+
+  // Prevents copy construction.
+  GzipFileReader(const GzipFileReader&) = delete;
+
+  // Prevents copy assignment.
+  GzipFileReader& operator=(const GzipFileReader&) = delete;
+
+  // Decompresses the next `size` bytes directly into `output`.
+  // Returns false if the file ends before or is broken.
+  const bool Read(void* output, const std::size_t size) { return Inflate(static_cast<Bytef*>(output), size); }
+
+  // Decompresses the next `size` bytes by chunks of the buffer size, and converts each (unsigned) byte into `T` in
+  // `output` (e.g. the pixels of the images into the data of a tensor).
+  // Returns false if the file ends before or is broken.
+  template <class T>
+  const bool ReadBytesAs(T* output, std::size_t size) {
+    while (0 < size) {
+      const std::size_t chunk_size = std::min(size, output_buffer_.size());
+      if (!Inflate(output_buffer_.data(), chunk_size)) {
+        return false;
+      }
+      std::copy(output_buffer_.begin(), output_buffer_.begin() + chunk_size, output);
+      output += chunk_size;
+      size -= chunk_size;
+    }
+    return true;
+  }
+
+  const bool is_valid() const { return is_valid_; }
+
+ private:
+  const bool Inflate(Bytef* output, std::size_t size) {
+    if (!is_valid_) {
+      return false;
+    }
+
+    while (0 < size) {
+      // Refills the input buffer from the file when it's consumed.
+      if (stream_.avail_in == 0) {
+        ifs_.read(input_buffer_.data(), input_buffer_.size());
+        if (ifs_.gcount() == 0) {
+          return false;
+        }
+        stream_.next_in = reinterpret_cast<Bytef*>(input_buffer_.data());
+        stream_.avail_in = ifs_.gcount();
+      }
+
+      const uInt requested_size = std::min<std::size_t>(size, UINT_MAX);
+      stream_.next_out = output;
+      stream_.avail_out = requested_size;
+      const int status = inflate(&stream_, Z_NO_FLUSH);
+      const std::size_t inflated_size = requested_size - stream_.avail_out;
+      output += inflated_size;
+      size -= inflated_size;
+
+      if (status == Z_STREAM_END) {
+        // Continues to the next gzip member (if any).
+        inflateReset(&stream_);
+      } else if (status != Z_OK && status != Z_BUF_ERROR) {
+        is_valid_ = false;
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::ifstream ifs_;
+
+  std::vector<char> input_buffer_;
+
+  std::vector<Bytef> output_buffer_;
+
+  z_stream stream_;
+
+  bool is_valid_;
+};
+
+}  // namespace tensorward::util
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <xtensor/xadapt.hpp>
+#include <xtensor/xarray.hpp>
+#include <xtensor/xbuilder.hpp>
+
+#include "tensorward/util/gzip_file_reader.h"
+
+namespace tensorward::util {
+
+// IDX file format (e.g. of MNIST), which stores an array of an arbitrary rank and data type:
+//
+//   magic number {0x00, 0x00, data type (uint8), rank (uint8)} | length of each dimension (big-endian uint32) |
+//   elements (big-endian, in the row-major order)
+//
+// Reference: http://yann.lecun.com/exdb/mnist/
+
+enum class IdxDataType : std::uint8_t {
+  kUnsignedByte = 0x08,
+  kSignedByte = 0x09,
+  kShort = 0x0B,
+  kInt = 0x0C,
+  kFloat = 0x0D,
+  kDouble = 0x0E,
+};
+
+// Alignment of the payload of `IdxFile` (the size of a cache line, which is also the widest SIMD register).
+constexpr std::size_t kIdxPayloadAlignment = 64;
+
+// Returns the size of an element of the data type in bytes, or 0 if it's not a valid data type.
+inline const std::size_t IdxElementSize(const IdxDataType data_type) {
+  switch (data_type) {
+    case IdxDataType::kUnsignedByte:
+    case IdxDataType::kSignedByte:
+      return 1;
+    case IdxDataType::kShort:
+      return 2;
+    case IdxDataType::kInt:
+    case IdxDataType::kFloat:
+      return 4;
+    case IdxDataType::kDouble:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+// IDX file loaded into the memory, whose elements are kept in the data type of the file (e.g. uint8 for the images of
+// MNIST, which is a quarter of float) but in the native endian.
+struct IdxFile {
+  struct PayloadDeleter {
+    void operator()(std::byte* payload) const { std::free(payload); }
+  };
+
+  IdxDataType data_type;
+
+  std::vector<std::size_t> shape;
+
+  // Number of the elements (i.e. the product of the shape).
+  std::size_t size;
+
+  // Elements aligned to `kIdxPayloadAlignment` bytes.
+  std::unique_ptr<std::byte[], PayloadDeleter> payload;
+};
+
+namespace detail {
+
+// Reads the bytes of the size from the file, which is decompressed if it's gzip-compressed.
+class IdxByteReader {
+ public:
+  IdxByteReader(const std::filesystem::path& file_path) : ifs_(file_path, std::ios::in | std::ios::binary) {
+    // Checks the magic number of gzip {0x1F, 0x8B}.
+    unsigned char magic[2] = {0, 0};
+    ifs_.read(reinterpret_cast<char*>(magic), sizeof(magic));
+    if (magic[0] == 0x1F && magic[1] == 0x8B) {
+      ifs_.close();
+      gzip_file_reader_ptr_ = std::make_unique<GzipFileReader>(file_path);
+    } else {
+      ifs_.clear();
+      ifs_.seekg(0);
+    }
+  }
+
+  const bool Read(void* output, const std::size_t size) {
+    if (gzip_file_reader_ptr_) {
+      return gzip_file_reader_ptr_->Read(output, size);
+    }
+    ifs_.read(static_cast<char*>(output), size);
+    return static_cast<std::size_t>(ifs_.gcount()) == size;
+  }
+
+  // Returns true if there are no more bytes.
+  const bool IsEnd() {
+    if (gzip_file_reader_ptr_) {
+      std::byte byte;
+      return !gzip_file_reader_ptr_->Read(&byte, 1);
+    }
+    return ifs_.peek() == std::ifstream::traits_type::eof();
+  }
+
+ private:
+  std::ifstream ifs_;
+
+  std::unique_ptr<GzipFileReader> gzip_file_reader_ptr_;
+};
+
+// Number of the elements converted by each inner loop of `ConvertToFloat()`.
+constexpr std::size_t kConvertBlockSize = 16;
+
+// Converts the elements into float. The inner loop over the block of the constant size (without the remainder) is
+// vectorized by the compiler even at -O2 (e.g. 16 bytes are zero-extended and converted into 16 floats with a few SIMD
+// instructions), and the rest of the elements are converted one by one.
+template <class T>
+void ConvertToFloat(const T* __restrict input, const std::size_t size, float* __restrict output) {
+  const std::size_t block_end = size / kConvertBlockSize * kConvertBlockSize;
+  for (std::size_t i = 0; i < block_end; i += kConvertBlockSize) {
+    for (std::size_t j = 0; j < kConvertBlockSize; ++j) {
+      output[i + j] = static_cast<float>(input[i + j]);
+    }
+  }
+  for (std::size_t i = block_end; i < size; ++i) {
+    output[i] = static_cast<float>(input[i]);
+  }
+}
+
+}  // namespace detail
+
+// Reads the IDX file (which may be gzip-compressed) with a single bulk read of the payload, and returns false if it's
+// not a valid IDX file (e.g. the data type is unknown or the payload is truncated).
+inline const bool ReadIdxFile(const std::filesystem::path& file_path, IdxFile& idx_file) {
+  detail::IdxByteReader reader(file_path);
+
+  // magic number = {0x00, 0x00, data type, rank}
+  std::uint8_t magic[4];
+  if (!reader.Read(magic, sizeof(magic)) || magic[0] != 0 || magic[1] != 0) {
+    return false;
+  }
+  idx_file.data_type = static_cast<IdxDataType>(magic[2]);
+  const std::size_t element_size = IdxElementSize(idx_file.data_type);
+  const std::size_t rank = magic[3];
+  if (element_size == 0 || rank == 0) {
+    return false;
+  }
+
+  idx_file.shape.resize(rank);
+  idx_file.size = 1;
+  for (std::size_t& length : idx_file.shape) {
+    std::uint8_t length_bytes[4];
+    if (!reader.Read(length_bytes, sizeof(length_bytes))) {
+      return false;
+    }
+    length = (std::size_t(length_bytes[0]) << 24) | (std::size_t(length_bytes[1]) << 16) |
+             (std::size_t(length_bytes[2]) << 8) | (std::size_t(length_bytes[3]) << 0);
+    if (length != 0 && std::numeric_limits<std::size_t>::max() / element_size / length < idx_file.size) {
+      return false;
+    }
+    idx_file.size *= length;
+  }
+
+  // Allocates the payload rounded up to the alignment (as required by `std::aligned_alloc()`).
+  const std::size_t payload_size = idx_file.size * element_size;
+  const std::size_t allocated_size =
+      std::max<std::size_t>((payload_size + kIdxPayloadAlignment - 1) / kIdxPayloadAlignment, 1) * kIdxPayloadAlignment;
+  idx_file.payload.reset(static_cast<std::byte*>(std::aligned_alloc(kIdxPayloadAlignment, allocated_size)));
+  if (!idx_file.payload || !reader.Read(idx_file.payload.get(), payload_size) || !reader.IsEnd()) {
+    return false;
+  }
+
+  // Converts the elements from the big endian into the native endian.
+  if constexpr (std::endian::native == std::endian::little) {
+    if (1 < element_size) {
+      for (std::byte* element = idx_file.payload.get(); element < idx_file.payload.get() + payload_size;
+           element += element_size) {
+        std::reverse(element, element + element_size);
+      }
+    }
+  }
+
+  return true;
+}
+
+// Views the payload of the IDX file as a tensor of its data type and shape without copying it (e.g. a uint8 tensor of
+// the images of MNIST).
+// NOTE: `T` must match the data type of the file (e.g. `std::uint8_t` for `IdxDataType::kUnsignedByte`), and the
+// NOTE: returned view must not outlive the IDX file.
+template <class T>
+auto XtensorAdaptIdxFile(const IdxFile& idx_file) {
+  assert((static_cast<void>("The size of `T` must match the data type."),
+          sizeof(T) == IdxElementSize(idx_file.data_type)));
+  return xt::adapt(reinterpret_cast<const T*>(idx_file.payload.get()), idx_file.size, xt::no_ownership(),
+                   idx_file.shape);
+}
+
+// Converts the `size` elements of the IDX file from the `begin`-th one into float in `output` (e.g. a record of the
+// file, or the whole payload into the data of a tensor).
+inline void ConvertIdxFileToFloat(const IdxFile& idx_file, const std::size_t begin, const std::size_t size,
+                                  float* output) {
+  assert((static_cast<void>("The elements must be in the payload."), begin + size <= idx_file.size));
+
+  const std::byte* payload = idx_file.payload.get();
+  switch (idx_file.data_type) {
+    case IdxDataType::kUnsignedByte:
+      detail::ConvertToFloat(reinterpret_cast<const std::uint8_t*>(payload) + begin, size, output);
+      break;
+    case IdxDataType::kSignedByte:
+      detail::ConvertToFloat(reinterpret_cast<const std::int8_t*>(payload) + begin, size, output);
+      break;
+    case IdxDataType::kShort:
+      detail::ConvertToFloat(reinterpret_cast<const std::int16_t*>(payload) + begin, size, output);
+      break;
+    case IdxDataType::kInt:
+      detail::ConvertToFloat(reinterpret_cast<const std::int32_t*>(payload) + begin, size, output);
+      break;
+    case IdxDataType::kFloat:
+      std::memcpy(output, reinterpret_cast<const float*>(payload) + begin, size * sizeof(float));
+      break;
+    case IdxDataType::kDouble:
+      detail::ConvertToFloat(reinterpret_cast<const double*>(payload) + begin, size, output);
+      break;
+  }
+}
+
+// Converts the whole IDX file into a float tensor of its shape.
+inline const xt::xarray<float> XtensorFromIdxFile(const IdxFile& idx_file) {
+  xt::xarray<float> data = xt::empty<float>(idx_file.shape);
+  ConvertIdxFileToFloat(idx_file, 0, idx_file.size, data.data());
+  return data;
+}
+
+}  // namespace tensorward::util
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <pthread.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/syscall.h>
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tensorward::util {
+
+// Root of the sysfs directories of the NUMA nodes (e.g. "online" is the list of the online nodes, and
+// "node0/cpulist" is the list of the CPUs of the node 0).
+constexpr char kNumaNodeSysfsDirectory[] = "/sys/devices/system/node/";
+
+// Parses the CPU list of the sysfs (e.g. "0-3,8,10-11") into the CPU indices.
+inline const std::vector<int> ParseCpuList(const std::string& cpu_list) {
+  std::vector<int> cpus;
+  std::stringstream cpu_list_stream(cpu_list);
+  std::string range;
+  while (std::getline(cpu_list_stream, range, ',')) {
+    if (range.empty() || range == "\n") {
+      continue;
+    }
+    const std::size_t dash_position = range.find('-');
+    const int first_cpu = std::stoi(range.substr(0, dash_position));
+    const int last_cpu = dash_position == std::string::npos ? first_cpu : std::stoi(range.substr(dash_position + 1));
+    for (int cpu = first_cpu; cpu <= last_cpu; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+// Reads the NUMA node of each CPU (by the CPU index) from the sysfs directory of the nodes. The node IDs are read
+// from "online" instead of probing "node0", "node1", ... until one is missing, since they can be sparse (e.g. "0,2"
+// after a node is offlined, or on some multi-socket hosts). All of the CPUs are on the node 0 if the system isn't NUMA
+// (or the sysfs isn't available).
+inline const std::vector<int> ReadNumaNodesOfCpus(const std::string& sysfs_directory) {
+  std::vector<int> numa_nodes_of_cpus(std::max<unsigned int>(std::thread::hardware_concurrency(), 1), 0);
+  std::ifstream online_ifs(sysfs_directory + "online");
+  if (!online_ifs) {
+    return numa_nodes_of_cpus;
+  }
+  std::string online_node_list;
+  std::getline(online_ifs, online_node_list);
+  // NOTE: The list of the nodes has the same format as the list of the CPUs.
+  for (const int node : ParseCpuList(online_node_list)) {
+    std::ifstream ifs(sysfs_directory + "node" + std::to_string(node) + "/cpulist");
+    if (!ifs) {
+      continue;
+    }
+    std::string cpu_list;
+    std::getline(ifs, cpu_list);
+    for (const int cpu : ParseCpuList(cpu_list)) {
+      if (numa_nodes_of_cpus.size() <= static_cast<std::size_t>(cpu)) {
+        numa_nodes_of_cpus.resize(cpu + 1, 0);
+      }
+      numa_nodes_of_cpus[cpu] = node;
+    }
+  }
+  return numa_nodes_of_cpus;
+}
+
+// NUMA node of each CPU (by the CPU index), which is read from the sysfs once (see `ReadNumaNodesOfCpus()`).
+inline const std::vector<int>& NumaNodesOfCpus() {
+  static const std::vector<int> numa_nodes_of_cpus = ReadNumaNodesOfCpus(kNumaNodeSysfsDirectory);
+  return numa_nodes_of_cpus;
+}
+
+inline const int NumaNodeOfCpu(const int cpu) {
+  const std::vector<int>& numa_nodes_of_cpus = NumaNodesOfCpus();
+  return 0 <= cpu && static_cast<std::size_t>(cpu) < numa_nodes_of_cpus.size() ? numa_nodes_of_cpus[cpu] : 0;
+}
+
+inline const int NumNumaNodes() {
+  const std::vector<int>& numa_nodes_of_cpus = NumaNodesOfCpus();
+  return *std::max_element(numa_nodes_of_cpus.begin(), numa_nodes_of_cpus.end()) + 1;
+}
+
+// NUMA node of the CPU which the calling thread is running on now (which can change unless the thread is pinned). It's
+// always the node 0 if the platform can't tell the CPU (e.g. macOS).
+inline const int CurrentNumaNode() {
+#if defined(__linux__)
+  return NumaNodeOfCpu(sched_getcpu());
+#else
+  return 0;
+#endif
+}
+
+// CPUs which this process is allowed to run on, ordered so that the consecutive CPUs alternate between the NUMA nodes
+// (e.g. {node0 cpu0, node1 cpu8, node0 cpu1, node1 cpu9, ...}). So pinning the first N threads to the first N CPUs
+// balances them over the sockets, which doubles the memory bandwidth available to them on a dual-socket host. It's
+// empty if the platform doesn't support the CPU affinity (e.g. macOS).
+inline const std::vector<int> CpusSpreadOverNumaNodes() {
+#if defined(__linux__)
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) != 0) {
+    return {};
+  }
+  std::vector<std::vector<int>> cpus_of_nodes(NumNumaNodes());
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &cpu_set)) {
+      cpus_of_nodes[NumaNodeOfCpu(cpu)].push_back(cpu);
+    }
+  }
+  std::vector<int> cpus;
+  for (std::size_t i = 0; cpus.size() < static_cast<std::size_t>(CPU_COUNT(&cpu_set)); ++i) {
+    for (const std::vector<int>& cpus_of_node : cpus_of_nodes) {
+      if (i < cpus_of_node.size()) {
+        cpus.push_back(cpus_of_node[i]);
+      }
+    }
+  }
+  return cpus;
+#else
+  return {};
+#endif
+}
+
+// Pins the thread to the CPU, and returns whether it succeeded (always false if the platform doesn't support the CPU
+// affinity, e.g. macOS, whose affinity tags are only hints).
+inline const bool PinThreadToCpu(const pthread_t thread, const int cpu) {
+#if defined(__linux__)
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(cpu, &cpu_set);
+  return pthread_setaffinity_np(thread, sizeof(cpu_set), &cpu_set) == 0;
+#else
+  static_cast<void>(thread);
+  static_cast<void>(cpu);
+  return false;
+#endif
+}
+
+// Sets the memory policy of the pages in [data, data + size) to prefer the NUMA node, and migrates the pages already
+// touched (on the other nodes) to it, by `mbind()`. The pages not touched yet are allocated on the node when they are
+// touched first, regardless of the thread touching them. Returns whether it succeeded, and does nothing (returns false)
+// if `mbind()` isn't available or the system isn't NUMA.
+// NOTE: Only the pages entirely inside the range are bound, since the pages on the boundaries can be shared with other
+// NOTE: allocations.
+inline const bool BindMemoryToNumaNode(void* data, const std::size_t size, const int node) {
+#if defined(__linux__) && defined(SYS_mbind)
+  // Same values as `MPOL_PREFERRED` and `MPOL_MF_MOVE` of <numaif.h> (of libnuma), which may not be installed.
+  constexpr int kMemoryPolicyPreferred = 1;
+  constexpr unsigned int kMemoryBindFlagMove = 1 << 1;
+  constexpr std::size_t kNumNodeMaskBits = 64;
+
+  if (NumNumaNodes() <= 1 || node < 0 || kNumNodeMaskBits <= static_cast<std::size_t>(node)) {
+    return false;
+  }
+  const std::uintptr_t page_size = sysconf(_SC_PAGESIZE);
+  const std::uintptr_t begin = (reinterpret_cast<std::uintptr_t>(data) + page_size - 1) / page_size * page_size;
+  const std::uintptr_t end = (reinterpret_cast<std::uintptr_t>(data) + size) / page_size * page_size;
+  if (end <= begin) {
+    return false;
+  }
+  const unsigned long node_mask = 1UL << node;
+  // NOTE: The max node of `mbind()` is the number of the bits of the mask + 1 (like libnuma passes).
+  return syscall(SYS_mbind, begin, end - begin, kMemoryPolicyPreferred, &node_mask, kNumNodeMaskBits + 1,
+                 kMemoryBindFlagMove) == 0;
+#else
+  return false;
+#endif
+}
+
+}  // namespace tensorward::util
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace tensorward::util {
+
+// Fast pseudo random engine xoshiro256** (by Blackman and Vigna) of 256-bit state, which is a few times faster than
+// `std::mt19937` and much smaller (32 bytes instead of 2.5 KB). It satisfies the requirements of
+// UniformRandomBitGenerator, so it can be used with the distributions of <random> too.
+// NOTE: This isn't cryptographically secure.
+class Xoshiro256StarStar {
+ public:
+  using result_type = std::uint64_t;
+
+  explicit Xoshiro256StarStar(const std::uint64_t seed = 0) { Seed(seed); }
+
+  ~Xoshiro256StarStar() {}
+
+  // Fills the state with SplitMix64 of the seed (as recommended by the authors), so that the similar seeds give the
+  // uncorrelated sequences and the state is never all zeros.
+  void Seed(std::uint64_t seed) {
+    for (std::uint64_t& s : state_) {
+      seed += 0x9E3779B97F4A7C15;
+      std::uint64_t z = seed;
+      z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+      z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+      s = z ^ (z >> 31);
+    }
+  }
+
+  result_type operator()() {
+    const std::uint64_t result = RotateLeft(state_[1] * 5, 7) * 9;
+    const std::uint64_t t = state_[1] << 17;
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= t;
+    state_[3] = RotateLeft(state_[3], 45);
+    return result;
+  }
+
+  // Returns a uniform random integer in [0, bound) without the modulo bias or (mostly) any division, by Lemire's
+  // multiply-and-shift method.
+  // NOTE: `bound` must be positive.
+  const std::uint64_t UniformIndex(const std::uint64_t bound) {
+    unsigned __int128 product = static_cast<unsigned __int128>((*this)()) * bound;
+    std::uint64_t low = static_cast<std::uint64_t>(product);
+    if (low < bound) {
+      // Rejects the few values which would make the bias.
+      const std::uint64_t threshold = -bound % bound;
+      while (low < threshold) {
+        product = static_cast<unsigned __int128>((*this)()) * bound;
+        low = static_cast<std::uint64_t>(product);
+      }
+    }
+    return static_cast<std::uint64_t>(product >> 64);
+  }
+
+  // Returns a uniform random double in [0, 1) of the 53 random bits.
+  const double UniformReal() { return ((*this)() >> 11) * 0x1.0p-53; }
+
+  static constexpr result_type min() { return 0; }
+
+  static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+ private:
+  static constexpr std::uint64_t RotateLeft(const std::uint64_t x, const int k) { return (x << k) | (x >> (64 - k)); }
+
+  std::uint64_t state_[4];
+};
+
+}  // namespace tensorward::util
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <xtensor/xarray.hpp>
+
+namespace tensorward::util {
+
+// Conversions between float (32 bits) and the 16-bit floating point formats for mixed-precision training:
+//
+//   * bfloat16: 1 sign bit, 8 exponent bits, 7 mantissa bits (the same range as float, but less precision)
+//   * float16:  1 sign bit, 5 exponent bits, 10 mantissa bits (more precision than bfloat16, but max is 65504)
+//
+// All of the conversions from float round to the nearest even, and overflow to infinity.
+//
+// NOTE: The functions are `inline`, because this header is included by the sources of `core` (e.g. `function.cc` and
+// NOTE: `tensor.cc`), which would define them more than once otherwise.
+
+inline const std::uint16_t FloatToBFloat16(const float value) {
+  std::uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+
+  // Keeps NaN as (quiet) NaN, because the rounding below could turn it into infinity.
+  if (std::isnan(value)) {
+    return static_cast<std::uint16_t>((bits >> 16) | 0x0040);
+  }
+
+  // Rounds the lower 16 bits to the nearest even (which overflows to infinity by the carry if needed).
+  bits += 0x7fff + ((bits >> 16) & 1);
+  return static_cast<std::uint16_t>(bits >> 16);
+}
+
+inline const float BFloat16ToFloat(const std::uint16_t value) {
+  const std::uint32_t bits = static_cast<std::uint32_t>(value) << 16;
+  float result;
+  std::memcpy(&result, &bits, sizeof(result));
+  return result;
+}
+
+inline const std::uint16_t FloatToFloat16(const float value) {
+  std::uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const std::uint32_t sign = (bits >> 16) & 0x8000;
+  const std::uint32_t abs_bits = bits & 0x7fffffff;
+
+  // Infinity or NaN.
+  if (0x7f800000 <= abs_bits) {
+    return static_cast<std::uint16_t>(sign | 0x7c00 | (0x7f800000 < abs_bits ? 0x0200 : 0));
+  }
+
+  // Overflow: 65520 (= 0x477ff000) is the midpoint between the max float16 (65504) and 65536, which rounds to infinity.
+  if (0x477ff000 <= abs_bits) {
+    return static_cast<std::uint16_t>(sign | 0x7c00);
+  }
+
+  // Subnormal (or zero): the value is a multiple of 2^-24, which is scaled exactly and rounded to the nearest even.
+  if (abs_bits < 0x38800000) {
+    float abs_value;
+    std::memcpy(&abs_value, &abs_bits, sizeof(abs_value));
+    const std::uint32_t mantissa = static_cast<std::uint32_t>(std::nearbyint(abs_value * 16777216.0f));  // 2^24
+    return static_cast<std::uint16_t>(sign | mantissa);
+  }
+
+  // Normal: re-biases the exponent (127 ---> 15), and rounds the lower 13 bits of the mantissa to the nearest even.
+  std::uint32_t half = (((abs_bits >> 23) - 127 + 15) << 10) | ((abs_bits & 0x007fffff) >> 13);
+  const std::uint32_t remainder = abs_bits & 0x1fff;
+  if (0x1000 < remainder || (remainder == 0x1000 && (half & 1))) {
+    ++half;  // The carry into the exponent is still correct.
+  }
+  return static_cast<std::uint16_t>(sign | half);
+}
+
+inline const float Float16ToFloat(const std::uint16_t value) {
+  const std::uint32_t sign = static_cast<std::uint32_t>(value & 0x8000) << 16;
+  const std::uint32_t exponent = (value >> 10) & 0x1f;
+  const std::uint32_t mantissa = value & 0x03ff;
+
+  // Subnormal (or zero).
+  if (exponent == 0) {
+    const float abs_value = std::ldexp(static_cast<float>(mantissa), -24);
+    return sign ? -abs_value : abs_value;
+  }
+
+  const std::uint32_t bits = (exponent == 0x1f) ? (sign | 0x7f800000 | (mantissa << 13))
+                                                : (sign | ((exponent - 15 + 127) << 23) | (mantissa << 13));
+  float result;
+  std::memcpy(&result, &bits, sizeof(result));
+  return result;
+}
+
+// Rounds each element to the nearest bfloat16 value in place (i.e. emulates the bfloat16 storage in float).
+inline void XtensorRoundToBFloat16(xt::xarray<float>& data) {
+  for (float& element : data) {
+    element = BFloat16ToFloat(FloatToBFloat16(element));
+  }
+}
+
+// Rounds each element to the nearest float16 value in place (i.e. emulates the float16 storage in float).
+inline void XtensorRoundToFloat16(xt::xarray<float>& data) {
+  for (float& element : data) {
+    element = Float16ToFloat(FloatToFloat16(element));
+  }
+}
+
+// Packs the data into the bfloat16 storage, which is a half of the float storage.
+inline const std::vector<std::uint16_t> XtensorPackBFloat16(const xt::xarray<float>& data) {
+  std::vector<std::uint16_t> packed_data;
+  packed_data.reserve(data.size());
+  for (const float element : data) {
+    packed_data.push_back(FloatToBFloat16(element));
+  }
+  return packed_data;
+}
+
+// Unpacks the bfloat16 storage into the float data whose shape is `shape`.
+inline const xt::xarray<float> XtensorUnpackBFloat16(const std::vector<std::uint16_t>& packed_data,
+                                                     const xt::xarray<float>::shape_type& shape) {
+  xt::xarray<float> data = xt::xarray<float>::from_shape(shape);
+  assert((static_cast<void>("`packed_data.size()` must be the size of `shape`."), packed_data.size() == data.size()));
+  float* data_pointer = data.data();
+  for (std::size_t i = 0; i < packed_data.size(); ++i) {
+    data_pointer[i] = BFloat16ToFloat(packed_data[i]);
+  }
+  return data;
+}
+
+// Packs the data into the float16 storage, which is a half of the float storage.
+inline const std::vector<std::uint16_t> XtensorPackFloat16(const xt::xarray<float>& data) {
+  std::vector<std::uint16_t> packed_data;
+  packed_data.reserve(data.size());
+  for (const float element : data) {
+    packed_data.push_back(FloatToFloat16(element));
+  }
+  return packed_data;
+}
+
+// Unpacks the float16 storage into the float data whose shape is `shape`.
+inline const xt::xarray<float> XtensorUnpackFloat16(const std::vector<std::uint16_t>& packed_data,
+                                                    const xt::xarray<float>::shape_type& shape) {
+  xt::xarray<float> data = xt::xarray<float>::from_shape(shape);
+  assert((static_cast<void>("`packed_data.size()` must be the size of `shape`."), packed_data.size() == data.size()));
+  float* data_pointer = data.data();
+  for (std::size_t i = 0; i < packed_data.size(); ++i) {
+    data_pointer[i] = Float16ToFloat(packed_data[i]);
+  }
+  return data;
+}
+
+}  // namespace tensorward::util
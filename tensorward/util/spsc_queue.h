@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <utility>
+
+namespace tensorward::util {
+
+// Lock-free bounded queue of a single producer thread and a single consumer thread (e.g. the activations between two
+// stages of a pipeline), which is the ring buffer whose head is written only by the consumer and whose tail is written
+// only by the producer. Each of them loads the index of the other with the acquire order, and stores its own index with
+// the release order, so an element is visible to the consumer once the tail has passed it, without any lock.
+//
+// NOTE: The head and the tail are on the separate cache lines, so that the producer and the consumer don't invalidate
+// NOTE: the cache line of each other on every push and pop (false sharing).
+template <class T>
+class SpscQueue {
+ public:
+  // The capacity is rounded up to a power of two, so that the index is wrapped by a mask instead of a division.
+  explicit SpscQueue(const std::size_t capacity)
+      : capacity_(RoundUpToPowerOfTwo(capacity)),
+        mask_(capacity_ - 1),
+        slots_(std::make_unique<T[]>(capacity_)),
+        head_(0),
+        tail_(0) {}
+
+  ~SpscQueue() {}
+
+  // Prevents copy construction.
+  SpscQueue(const SpscQueue&) = delete;
+
+  // Prevents copy assignment.
+  SpscQueue& operator=(const SpscQueue&) = delete;
+
+  // Pushes the value if the queue isn't full. Returns false (without moving the value) if it's full.
+  // NOTE: Only the producer thread can call this.
+  const bool TryPush(T&& value) {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == capacity_) {
+      return false;
+    }
+    slots_[tail & mask_] = std::move(value);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Pops the value into `value` if the queue isn't empty. Returns false if it's empty.
+  // NOTE: Only the consumer thread can call this.
+  const bool TryPop(T& value) {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    if (tail_.load(std::memory_order_acquire) == head) {
+      return false;
+    }
+    value = std::move(slots_[head & mask_]);
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Pushes the value, spinning (and then yielding) while the queue is full.
+  void Push(T&& value) {
+    for (std::size_t i = 0; !TryPush(std::move(value)); ++i) {
+      if (kNumSpins <= i) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  // Pops a value, spinning (and then yielding) while the queue is empty.
+  T Pop() {
+    T value;
+    for (std::size_t i = 0; !TryPop(value); ++i) {
+      if (kNumSpins <= i) {
+        std::this_thread::yield();
+      }
+    }
+    return value;
+  }
+
+  const std::size_t capacity() const { return capacity_; }
+
+  // Number of the values in the queue, which is only a snapshot if the other thread is running.
+  const std::size_t size() const {
+    return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+  }
+
+ private:
+  // Number of the times of spinning before yielding the CPU to the other threads.
+  static constexpr std::size_t kNumSpins = 1024;
+
+  static constexpr std::size_t kCacheLineSize = 64;
+
+  static constexpr std::size_t RoundUpToPowerOfTwo(const std::size_t number) {
+    std::size_t power_of_two = 1;
+    while (power_of_two < number) {
+      power_of_two <<= 1;
+    }
+    return power_of_two;
+  }
+
+  std::size_t capacity_;
+
+  std::size_t mask_;
+
+  std::unique_ptr<T[]> slots_;
+
+  // Index of the next value to pop, written only by the consumer.
+  alignas(kCacheLineSize) std::atomic<std::size_t> head_;
+
+  // Index of the next value to push, written only by the producer.
+  alignas(kCacheLineSize) std::atomic<std::size_t> tail_;
+};
+
+}  // namespace tensorward::util
@@ -0,0 +1,55 @@
+#include "tensorward/util/atomic.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace tensorward::util {
+
+namespace {
+
+constexpr std::size_t kNumThreads = 4;
+constexpr std::size_t kNumAdditions = 100000;
+
+}  // namespace
+
+class AtomicTest : public ::testing::Test {};
+
+TEST_F(AtomicTest, LoadStoreTest) {
+  std::uint64_t value = 0;
+  AtomicStore(value, std::uint64_t(3), std::memory_order_release);
+  EXPECT_EQ(AtomicLoad(value, std::memory_order_acquire), 3);
+  EXPECT_EQ(value, 3);
+}
+
+TEST_F(AtomicTest, CompareExchangeTest) {
+  std::uint8_t flag = 0;
+  std::uint8_t expected = 1;
+  EXPECT_FALSE(AtomicCompareExchange(flag, expected, std::uint8_t(2), std::memory_order_acq_rel));
+  EXPECT_EQ(expected, 0);
+  EXPECT_TRUE(AtomicCompareExchange(flag, expected, std::uint8_t(2), std::memory_order_acq_rel));
+  EXPECT_EQ(flag, 2);
+}
+
+TEST_F(AtomicTest, FetchAddTest) {
+  // No addition is lost, and the sums of the small integers are exact in float.
+  float sum = 0.0;
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&sum] {
+      for (std::size_t i = 0; i < kNumAdditions; ++i) {
+        AtomicFetchAdd(sum, 1.0f, std::memory_order_relaxed);
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(sum, static_cast<float>(kNumThreads * kNumAdditions));
+  EXPECT_EQ(AtomicFetchAdd(sum, -1.0f), static_cast<float>(kNumThreads * kNumAdditions));
+}
+
+}  // namespace tensorward::util
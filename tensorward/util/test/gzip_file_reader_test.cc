@@ -0,0 +1,174 @@
+#include "tensorward/util/gzip_file_reader.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <zlib.h>
+
+namespace {
+
+// Bytes allocated by `operator new` currently, and their high-water mark, to measure the memory of the reader.
+std::atomic<std::size_t> current_allocated_size(0);
+std::atomic<std::size_t> peak_allocated_size(0);
+
+// Size of the header in front of each allocation, which holds the size (and keeps the alignment of `malloc()`).
+constexpr std::size_t kAllocationHeaderSize = alignof(std::max_align_t);
+
+}  // namespace
+
+void* operator new(const std::size_t size) {
+  void* pointer = std::malloc(kAllocationHeaderSize + size);
+  if (pointer == nullptr) {
+    throw std::bad_alloc();
+  }
+  *static_cast<std::size_t*>(pointer) = size;
+
+  const std::size_t allocated_size = current_allocated_size += size;
+  std::size_t peak_size = peak_allocated_size;
+  while (peak_size < allocated_size && !peak_allocated_size.compare_exchange_weak(peak_size, allocated_size)) {
+  }
+
+  return static_cast<std::byte*>(pointer) + kAllocationHeaderSize;
+}
+
+void operator delete(void* pointer) noexcept {
+  if (pointer == nullptr) {
+    return;
+  }
+  void* allocated_pointer = static_cast<std::byte*>(pointer) - kAllocationHeaderSize;
+  current_allocated_size -= *static_cast<std::size_t*>(allocated_pointer);
+  std::free(allocated_pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept { operator delete(pointer); }
+
+namespace tensorward::util {
+
+namespace {
+
+constexpr std::size_t kPayloadSize = 1 << 20;
+constexpr std::size_t kSmallBufferSize = 100;  // Not a divisor of the payload size, to cross the chunks unevenly.
+constexpr std::size_t kNumMembers = 3;
+constexpr std::uint32_t kSeed = 0;
+
+}  // namespace
+
+class GzipFileReaderTest : public ::testing::Test {
+ protected:
+  GzipFileReaderTest()
+      : directory_path_(std::filesystem::temp_directory_path() /
+                        ("tensorward_" + std::to_string(getpid()) + "_" +
+                         ::testing::UnitTest::GetInstance()->current_test_info()->name())),
+        payload_(kPayloadSize) {
+    std::filesystem::create_directories(directory_path_);
+
+    // Random bytes (hardly compressible), so the compressed file is as large as the payload.
+    std::mt19937 engine(kSeed);
+    for (auto& byte : payload_) {
+      byte = static_cast<unsigned char>(engine());
+    }
+  }
+
+  ~GzipFileReaderTest() { std::filesystem::remove_all(directory_path_); }
+
+  // Writes the bytes into the gzip file, as the members of the given number split evenly.
+  const std::filesystem::path WriteGzipFile(const std::string& file_name, const std::vector<unsigned char>& bytes,
+                                            const std::size_t num_members = 1) {
+    const std::filesystem::path file_path = directory_path_ / file_name;
+    const std::size_t member_size = bytes.size() / num_members;
+    for (std::size_t m = 0; m < num_members; ++m) {
+      const std::size_t begin = m * member_size;
+      const std::size_t end = (m + 1 == num_members) ? bytes.size() : begin + member_size;
+      gzFile file = gzopen(file_path.c_str(), (m == 0) ? "wb" : "ab");
+      EXPECT_NE(file, nullptr);
+      EXPECT_EQ(gzwrite(file, bytes.data() + begin, end - begin), static_cast<int>(end - begin));
+      EXPECT_EQ(gzclose(file), Z_OK);
+    }
+    return file_path;
+  }
+
+  const std::filesystem::path directory_path_;
+  std::vector<unsigned char> payload_;
+};
+
+TEST_F(GzipFileReaderTest, ReadTest) {
+  const std::filesystem::path file_path = WriteGzipFile("payload.gz", payload_);
+
+  GzipFileReader reader(file_path, kSmallBufferSize);
+  ASSERT_TRUE(reader.is_valid());
+
+  // Reads the first bytes as they are, and the rest converted into floats.
+  constexpr std::size_t kHeaderSize = 16;
+  std::vector<unsigned char> actual_header(kHeaderSize);
+  EXPECT_TRUE(reader.Read(actual_header.data(), actual_header.size()));
+  EXPECT_EQ(actual_header, std::vector<unsigned char>(payload_.begin(), payload_.begin() + kHeaderSize));
+
+  std::vector<float> actual_floats(kPayloadSize - kHeaderSize);
+  EXPECT_TRUE(reader.ReadBytesAs(actual_floats.data(), actual_floats.size()));
+  EXPECT_EQ(actual_floats, std::vector<float>(payload_.begin() + kHeaderSize, payload_.end()));
+
+  // Fails to read beyond the end.
+  unsigned char byte;
+  EXPECT_FALSE(reader.Read(&byte, 1));
+}
+
+TEST_F(GzipFileReaderTest, ConcatenatedMembersTest) {
+  const std::filesystem::path file_path = WriteGzipFile("members.gz", payload_, kNumMembers);
+
+  GzipFileReader reader(file_path);
+  std::vector<unsigned char> actual_payload(kPayloadSize);
+  EXPECT_TRUE(reader.Read(actual_payload.data(), actual_payload.size()));
+  EXPECT_EQ(actual_payload, payload_);
+}
+
+TEST_F(GzipFileReaderTest, BrokenFileTest) {
+  const std::filesystem::path file_path = WriteGzipFile("payload.gz", payload_);
+  std::vector<unsigned char> actual_payload(kPayloadSize);
+
+  // Nonexistent file.
+  GzipFileReader nonexistent_reader(directory_path_ / "nonexistent.gz");
+  EXPECT_FALSE(nonexistent_reader.is_valid());
+  EXPECT_FALSE(nonexistent_reader.Read(actual_payload.data(), actual_payload.size()));
+
+  // Truncated file.
+  std::filesystem::resize_file(file_path, std::filesystem::file_size(file_path) / 2);
+  GzipFileReader truncated_reader(file_path);
+  EXPECT_FALSE(truncated_reader.Read(actual_payload.data(), actual_payload.size()));
+
+  // Not a gzip file.
+  std::filesystem::resize_file(file_path, 0);
+  std::filesystem::resize_file(file_path, kSmallBufferSize);
+  GzipFileReader invalid_reader(file_path);
+  EXPECT_FALSE(invalid_reader.Read(actual_payload.data(), actual_payload.size()));
+  EXPECT_FALSE(invalid_reader.is_valid());
+}
+
+TEST_F(GzipFileReaderTest, MemoryHighWaterMarkTest) {
+  const std::filesystem::path file_path = WriteGzipFile("payload.gz", payload_);
+  std::vector<float> actual_floats(kPayloadSize);
+
+  // Measures the memory allocated while reading, besides the destination (which is allocated in advance).
+  const std::size_t base_allocated_size = current_allocated_size;
+  peak_allocated_size = base_allocated_size;
+  {
+    GzipFileReader reader(file_path);
+    EXPECT_TRUE(reader.ReadBytesAs(actual_floats.data(), actual_floats.size()));
+  }
+  const std::size_t actual_peak_size = peak_allocated_size - base_allocated_size;
+
+  // Only the input and the output buffers, regardless of the size of the file (i.e. without the whole compressed or
+  // decompressed data).
+  EXPECT_LE(actual_peak_size, 4 * GzipFileReader::kDefaultBufferSize);
+  EXPECT_LT(4 * GzipFileReader::kDefaultBufferSize, std::filesystem::file_size(file_path));
+  EXPECT_EQ(actual_floats, std::vector<float>(payload_.begin(), payload_.end()));
+}
+
+}  // namespace tensorward::util
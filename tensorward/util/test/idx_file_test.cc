@@ -0,0 +1,153 @@
+#include "tensorward/util/idx_file.h"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <zlib.h>
+
+namespace tensorward::util {
+
+namespace {
+
+constexpr std::size_t kNumImages = 3;
+constexpr std::size_t kHeight = 2;
+constexpr std::size_t kWidth = 4;
+
+// Appends the value to the bytes in the big endian.
+template <class T>
+void AppendBigEndian(std::string& bytes, const T& value) {
+  char value_bytes[sizeof(T)];
+  std::memcpy(value_bytes, &value, sizeof(T));
+  for (std::size_t b = sizeof(T); 0 < b--;) {
+    bytes.push_back(value_bytes[b]);
+  }
+}
+
+}  // namespace
+
+class IdxFileTest : public ::testing::Test {
+ protected:
+  IdxFileTest()
+      : directory_path_(std::filesystem::temp_directory_path() /
+                        ("tensorward_" + std::to_string(getpid()) + "_" +
+                         ::testing::UnitTest::GetInstance()->current_test_info()->name())) {
+    std::filesystem::create_directories(directory_path_);
+  }
+
+  ~IdxFileTest() { std::filesystem::remove_all(directory_path_); }
+
+  // Writes the values into the IDX file of the data type and the shape (gzip-compressed if the name ends with ".gz").
+  template <class T>
+  const std::filesystem::path WriteIdxFile(const std::string& file_name, const IdxDataType data_type,
+                                           const std::vector<std::uint32_t>& shape, const std::vector<T>& values) {
+    std::string bytes = {0, 0, static_cast<char>(data_type), static_cast<char>(shape.size())};
+    for (const std::uint32_t length : shape) {
+      AppendBigEndian(bytes, length);
+    }
+    for (const T& value : values) {
+      AppendBigEndian(bytes, value);
+    }
+    return WriteFile(file_name, bytes);
+  }
+
+  const std::filesystem::path WriteFile(const std::string& file_name, const std::string& bytes) {
+    const std::filesystem::path file_path = directory_path_ / file_name;
+    if (file_path.extension() == ".gz") {
+      gzFile file = gzopen(file_path.c_str(), "wb");
+      gzwrite(file, bytes.data(), bytes.size());
+      gzclose(file);
+    } else {
+      std::ofstream ofs(file_path, std::ios::out | std::ios::binary);
+      ofs.write(bytes.data(), bytes.size());
+    }
+    return file_path;
+  }
+
+  const std::filesystem::path directory_path_;
+};
+
+TEST_F(IdxFileTest, UnsignedByteTest) {
+  std::vector<std::uint8_t> pixels(kNumImages * kHeight * kWidth);
+  for (std::size_t i = 0; i < pixels.size(); ++i) {
+    pixels[i] = static_cast<std::uint8_t>(i * 11);  // Up to 253, beyond the range of int8.
+  }
+  const std::vector<float> expected_data(pixels.begin(), pixels.end());
+
+  for (const std::string file_name : {"images-idx3-ubyte", "images-idx3-ubyte.gz"}) {
+    const std::filesystem::path file_path =
+        WriteIdxFile(file_name, IdxDataType::kUnsignedByte, {kNumImages, kHeight, kWidth}, pixels);
+
+    IdxFile idx_file;
+    ASSERT_TRUE(ReadIdxFile(file_path, idx_file));
+    EXPECT_EQ(idx_file.data_type, IdxDataType::kUnsignedByte);
+    EXPECT_EQ(idx_file.shape, std::vector<std::size_t>({kNumImages, kHeight, kWidth}));
+    EXPECT_EQ(idx_file.size, pixels.size());
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(idx_file.payload.get()) % kIdxPayloadAlignment, 0);
+
+    // Views the payload as a uint8 tensor.
+    const auto actual_pixels = XtensorAdaptIdxFile<std::uint8_t>(idx_file);
+    EXPECT_EQ(actual_pixels(1, 0, 2), pixels[1 * kHeight * kWidth + 0 * kWidth + 2]);
+    EXPECT_EQ(actual_pixels(2, 1, 3), pixels[2 * kHeight * kWidth + 1 * kWidth + 3]);
+
+    const xt::xarray<float> actual_data = XtensorFromIdxFile(idx_file);
+    EXPECT_EQ(actual_data.shape(), xt::xarray<float>::shape_type({kNumImages, kHeight, kWidth}));
+    EXPECT_EQ(std::vector<float>(actual_data.begin(), actual_data.end()), expected_data);
+  }
+}
+
+TEST_F(IdxFileTest, DataTypesTest) {
+  const std::vector<float> expected_values({-3.0, 0.0, 1.0, 2.0, 127.0, -128.0});
+  const std::vector<std::uint32_t> shape({2, 3});
+
+  std::vector<std::filesystem::path> file_paths;
+  file_paths.push_back(WriteIdxFile("byte", IdxDataType::kSignedByte, shape,
+                                    std::vector<std::int8_t>(expected_values.begin(), expected_values.end())));
+  file_paths.push_back(WriteIdxFile("short", IdxDataType::kShort, shape,
+                                    std::vector<std::int16_t>(expected_values.begin(), expected_values.end())));
+  file_paths.push_back(WriteIdxFile("int", IdxDataType::kInt, shape,
+                                    std::vector<std::int32_t>(expected_values.begin(), expected_values.end())));
+  file_paths.push_back(WriteIdxFile("float.gz", IdxDataType::kFloat, shape, expected_values));
+  file_paths.push_back(WriteIdxFile("double", IdxDataType::kDouble, shape,
+                                    std::vector<double>(expected_values.begin(), expected_values.end())));
+
+  for (const auto& file_path : file_paths) {
+    IdxFile idx_file;
+    ASSERT_TRUE(ReadIdxFile(file_path, idx_file));
+    EXPECT_EQ(idx_file.shape, std::vector<std::size_t>(shape.begin(), shape.end()));
+
+    const xt::xarray<float> actual_values = XtensorFromIdxFile(idx_file);
+    EXPECT_EQ(std::vector<float>(actual_values.begin(), actual_values.end()), expected_values);
+
+    // Converts only the second row.
+    std::vector<float> actual_row(shape[1]);
+    ConvertIdxFileToFloat(idx_file, shape[1], shape[1], actual_row.data());
+    EXPECT_EQ(actual_row, std::vector<float>(expected_values.begin() + shape[1], expected_values.end()));
+  }
+}
+
+TEST_F(IdxFileTest, BrokenFileTest) {
+  IdxFile idx_file;
+  EXPECT_FALSE(ReadIdxFile(directory_path_ / "nonexistent", idx_file));
+
+  const std::vector<std::uint8_t> values({1, 2, 3, 4});
+
+  // The payload is shorter or longer than the shape.
+  EXPECT_FALSE(ReadIdxFile(WriteIdxFile("short", IdxDataType::kUnsignedByte, {5}, values), idx_file));
+  EXPECT_FALSE(ReadIdxFile(WriteIdxFile("long.gz", IdxDataType::kUnsignedByte, {3}, values), idx_file));
+
+  // Unknown data type.
+  EXPECT_FALSE(ReadIdxFile(WriteIdxFile("unknown", static_cast<IdxDataType>(0x0A), {4}, values), idx_file));
+
+  // Not an IDX file.
+  EXPECT_FALSE(ReadIdxFile(WriteFile("text.gz", "Not an IDX file."), idx_file));
+
+  EXPECT_TRUE(ReadIdxFile(WriteIdxFile("valid", IdxDataType::kUnsignedByte, {4}, values), idx_file));
+}
+
+}  // namespace tensorward::util
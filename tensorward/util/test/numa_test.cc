@@ -0,0 +1,109 @@
+#include "tensorward/util/numa.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace tensorward::util {
+
+namespace {
+
+constexpr std::size_t kSize = 1 << 22;
+
+}  // namespace
+
+class NumaTest : public ::testing::Test {};
+
+TEST_F(NumaTest, ParseCpuListTest) {
+  EXPECT_EQ(ParseCpuList("0-3,8,10-11\n"), std::vector<int>({0, 1, 2, 3, 8, 10, 11}));
+  EXPECT_EQ(ParseCpuList("5"), std::vector<int>({5}));
+  EXPECT_TRUE(ParseCpuList("").empty());
+}
+
+TEST_F(NumaTest, ReadNumaNodesOfCpusTest) {
+  const std::filesystem::path sysfs_directory_path =
+      std::filesystem::temp_directory_path() / ("tensorward_" + std::to_string(getpid()) + "_numa_node");
+  const auto write_file = [&sysfs_directory_path](const std::string& file_name, const std::string& content) {
+    std::filesystem::create_directories((sysfs_directory_path / file_name).parent_path());
+    std::ofstream(sysfs_directory_path / file_name) << content << "\n";
+  };
+
+  // All of the CPUs are on the node 0 without the sysfs.
+  const std::string sysfs_directory = sysfs_directory_path.string() + "/";
+  std::vector<int> numa_nodes_of_cpus = ReadNumaNodesOfCpus(sysfs_directory);
+  EXPECT_TRUE(std::all_of(numa_nodes_of_cpus.begin(), numa_nodes_of_cpus.end(),
+                          [](const int node) { return node == 0; }));
+
+  // The node IDs can be sparse, so the node 2 is read even though the node 1 is missing.
+  write_file("online", "0,2");
+  write_file("node0/cpulist", "0-1");
+  write_file("node2/cpulist", "2-3");
+  numa_nodes_of_cpus = ReadNumaNodesOfCpus(sysfs_directory);
+  ASSERT_GE(numa_nodes_of_cpus.size(), 4);
+  EXPECT_EQ(std::vector<int>(numa_nodes_of_cpus.begin(), numa_nodes_of_cpus.begin() + 4),
+            std::vector<int>({0, 0, 2, 2}));
+
+  std::filesystem::remove_all(sysfs_directory_path);
+}
+
+TEST_F(NumaTest, CpusSpreadOverNumaNodesTest) {
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  ASSERT_EQ(sched_getaffinity(0, sizeof(cpu_set), &cpu_set), 0);
+
+  // Each allowed CPU appears exactly once.
+  const std::vector<int> cpus = CpusSpreadOverNumaNodes();
+  ASSERT_EQ(cpus.size(), CPU_COUNT(&cpu_set));
+  EXPECT_EQ(std::set<int>(cpus.begin(), cpus.end()).size(), cpus.size());
+  for (const int cpu : cpus) {
+    EXPECT_TRUE(CPU_ISSET(cpu, &cpu_set));
+    EXPECT_GE(NumaNodeOfCpu(cpu), 0);
+    EXPECT_LT(NumaNodeOfCpu(cpu), NumNumaNodes());
+  }
+
+  // The first CPUs are on the different nodes (as many as the nodes having the allowed CPUs).
+  std::set<int> numa_nodes_of_cpus;
+  for (const int cpu : cpus) {
+    numa_nodes_of_cpus.insert(NumaNodeOfCpu(cpu));
+  }
+  std::set<int> numa_nodes_of_first_cpus;
+  for (std::size_t i = 0; i < numa_nodes_of_cpus.size(); ++i) {
+    numa_nodes_of_first_cpus.insert(NumaNodeOfCpu(cpus[i]));
+  }
+  EXPECT_EQ(numa_nodes_of_first_cpus, numa_nodes_of_cpus);
+}
+
+TEST_F(NumaTest, PinThreadToCpuTest) {
+  const int cpu = CpusSpreadOverNumaNodes().back();
+  int actual_cpu = -1;
+  std::thread thread([&actual_cpu, cpu] {
+    ASSERT_TRUE(PinThreadToCpu(pthread_self(), cpu));
+    actual_cpu = sched_getcpu();
+  });
+  thread.join();
+  EXPECT_EQ(actual_cpu, cpu);
+  EXPECT_EQ(NumaNodeOfCpu(actual_cpu), NumaNodeOfCpu(cpu));
+}
+
+TEST_F(NumaTest, BindMemoryToNumaNodeTest) {
+  std::vector<float> data(kSize, 1.0);
+  const bool is_bound = BindMemoryToNumaNode(data.data(), kSize * sizeof(float), NumNumaNodes() - 1);
+
+  // It's a no-op on a non-NUMA system, and the data is kept (even if the pages are migrated) anyway.
+  if (NumNumaNodes() == 1) {
+    EXPECT_FALSE(is_bound);
+  }
+  EXPECT_TRUE(std::all_of(data.begin(), data.end(), [](const float value) { return value == 1.0; }));
+  EXPECT_FALSE(BindMemoryToNumaNode(data.data(), 1, 0));
+}
+
+}  // namespace tensorward::util
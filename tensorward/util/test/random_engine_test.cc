@@ -0,0 +1,79 @@
+#include "tensorward/util/random_engine.h"
+
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace tensorward::util {
+
+namespace {
+
+constexpr std::uint64_t kSeed = 1234;
+constexpr std::size_t kNumDraws = 100000;
+constexpr std::uint64_t kBound = 10;
+
+}  // namespace
+
+class RandomEngineTest : public ::testing::Test {};
+
+TEST_F(RandomEngineTest, SeedTest) {
+  Xoshiro256StarStar engine(kSeed);
+  Xoshiro256StarStar same_engine(kSeed);
+  Xoshiro256StarStar other_engine(kSeed + 1);
+
+  // The same seed gives the same sequence, and the different (even adjacent) seed gives a different one.
+  std::vector<std::uint64_t> values, same_values, other_values;
+  for (std::size_t i = 0; i < 8; ++i) {
+    values.push_back(engine());
+    same_values.push_back(same_engine());
+    other_values.push_back(other_engine());
+  }
+  EXPECT_EQ(values, same_values);
+  EXPECT_NE(values, other_values);
+
+  // Reseeding restarts the sequence.
+  engine.Seed(kSeed);
+  EXPECT_EQ(engine(), values[0]);
+}
+
+TEST_F(RandomEngineTest, UniformIndexTest) {
+  Xoshiro256StarStar engine(kSeed);
+
+  std::vector<std::size_t> counts(kBound, 0);
+  for (std::size_t i = 0; i < kNumDraws; ++i) {
+    const std::uint64_t index = engine.UniformIndex(kBound);
+    ASSERT_LT(index, kBound);
+    ++counts[index];
+  }
+
+  // Each count is within 5% of the expected one (which is about 12 sigma).
+  for (const std::size_t count : counts) {
+    EXPECT_NEAR(static_cast<double>(count), static_cast<double>(kNumDraws / kBound), 0.05 * kNumDraws / kBound);
+  }
+
+  EXPECT_EQ(engine.UniformIndex(1), 0);
+}
+
+TEST_F(RandomEngineTest, UniformRealTest) {
+  Xoshiro256StarStar engine(kSeed);
+
+  double sum = 0.0;
+  for (std::size_t i = 0; i < kNumDraws; ++i) {
+    const double value = engine.UniformReal();
+    ASSERT_GE(value, 0.0);
+    ASSERT_LT(value, 1.0);
+    sum += value;
+  }
+  EXPECT_NEAR(sum / kNumDraws, 0.5, 0.01);
+
+  // Works with the distributions of <random>.
+  std::normal_distribution<double> distribution(0.0, 1.0);
+  sum = 0.0;
+  for (std::size_t i = 0; i < kNumDraws; ++i) {
+    sum += distribution(engine);
+  }
+  EXPECT_NEAR(sum / kNumDraws, 0.0, 0.02);
+}
+
+}  // namespace tensorward::util
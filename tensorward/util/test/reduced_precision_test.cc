@@ -0,0 +1,100 @@
+#include "tensorward/util/reduced_precision.h"
+
+#include <cmath>
+#include <limits>
+
+#include <gtest/gtest.h>
+#include <xtensor/xarray.hpp>
+#include <xtensor/xrandom.hpp>
+
+namespace tensorward::util {
+
+namespace {
+
+constexpr int kHeight = 3;
+constexpr int kWidth = 4;
+
+// Relative rounding errors (the half of the machine epsilon).
+constexpr float kBFloat16RelativeError = 1.0 / 256.0;   // 2^-8
+constexpr float kFloat16RelativeError = 1.0 / 2048.0;  // 2^-11
+
+}  // namespace
+
+class ReducedPrecisionTest : public ::testing::Test {
+ protected:
+  ReducedPrecisionTest() : data_(xt::random::randn<float>({kHeight, kWidth})) {}
+
+  const xt::xarray<float> data_;
+};
+
+TEST_F(ReducedPrecisionTest, BFloat16Test) {
+  // Exactly representable values.
+  EXPECT_EQ(FloatToBFloat16(1.0), 0x3f80);
+  EXPECT_EQ(FloatToBFloat16(-2.0), 0xc000);
+  EXPECT_EQ(BFloat16ToFloat(0x3f80), 1.0);
+
+  // Rounds to the nearest even: 1 + 2^-8 is the midpoint between 1 and 1 + 2^-7.
+  EXPECT_EQ(FloatToBFloat16(1.0 + std::ldexp(1.0, -8)), 0x3f80);
+  EXPECT_EQ(FloatToBFloat16(1.0 + 3.0 * std::ldexp(1.0, -8)), 0x3f82);
+
+  // Keeps the special values.
+  EXPECT_TRUE(std::isinf(BFloat16ToFloat(FloatToBFloat16(std::numeric_limits<float>::infinity()))));
+  EXPECT_TRUE(std::isnan(BFloat16ToFloat(FloatToBFloat16(std::numeric_limits<float>::quiet_NaN()))));
+}
+
+TEST_F(ReducedPrecisionTest, Float16Test) {
+  // Exactly representable values.
+  EXPECT_EQ(FloatToFloat16(1.0), 0x3c00);
+  EXPECT_EQ(FloatToFloat16(-2.0), 0xc000);
+  EXPECT_EQ(FloatToFloat16(65504.0), 0x7bff);  // Max.
+  EXPECT_EQ(Float16ToFloat(0x3c00), 1.0);
+  EXPECT_EQ(Float16ToFloat(0x7bff), 65504.0);
+
+  // Rounds to the nearest even: 1 + 2^-11 is the midpoint between 1 and 1 + 2^-10.
+  EXPECT_EQ(FloatToFloat16(1.0 + std::ldexp(1.0, -11)), 0x3c00);
+  EXPECT_EQ(FloatToFloat16(1.0 + 3.0 * std::ldexp(1.0, -11)), 0x3c02);
+
+  // Subnormals: 2^-24 is the min (positive) value, and 2^-26 underflows to zero.
+  EXPECT_EQ(FloatToFloat16(std::ldexp(1.0, -24)), 0x0001);
+  EXPECT_EQ(FloatToFloat16(std::ldexp(1.0, -26)), 0x0000);
+  EXPECT_EQ(Float16ToFloat(0x0001), std::ldexp(1.0, -24));
+
+  // Overflows to infinity.
+  EXPECT_EQ(FloatToFloat16(65520.0), 0x7c00);
+  EXPECT_EQ(FloatToFloat16(-1.0e6), 0xfc00);
+  EXPECT_TRUE(std::isnan(Float16ToFloat(FloatToFloat16(std::numeric_limits<float>::quiet_NaN()))));
+}
+
+TEST_F(ReducedPrecisionTest, RoundTest) {
+  xt::xarray<float> bfloat16_data = data_;
+  XtensorRoundToBFloat16(bfloat16_data);
+  xt::xarray<float> float16_data = data_;
+  XtensorRoundToFloat16(float16_data);
+
+  for (std::size_t i = 0; i < data_.size(); ++i) {
+    const float value = data_.data()[i];
+    EXPECT_LE(std::abs(bfloat16_data.data()[i] - value), kBFloat16RelativeError * std::abs(value));
+    EXPECT_LE(std::abs(float16_data.data()[i] - value), kFloat16RelativeError * std::abs(value));
+  }
+
+  // Checks that the rounding is idempotent.
+  xt::xarray<float> rounded_bfloat16_data = bfloat16_data;
+  XtensorRoundToBFloat16(rounded_bfloat16_data);
+  EXPECT_EQ(rounded_bfloat16_data, bfloat16_data);
+}
+
+TEST_F(ReducedPrecisionTest, PackUnpackTest) {
+  const std::vector<std::uint16_t> packed_bfloat16_data = XtensorPackBFloat16(data_);
+  ASSERT_EQ(packed_bfloat16_data.size(), data_.size());
+  xt::xarray<float> expected_bfloat16_data = data_;
+  XtensorRoundToBFloat16(expected_bfloat16_data);
+  EXPECT_EQ(XtensorUnpackBFloat16(packed_bfloat16_data, data_.shape()), expected_bfloat16_data);
+
+  const std::vector<std::uint16_t> packed_float16_data = XtensorPackFloat16(data_);
+  ASSERT_EQ(packed_float16_data.size(), data_.size());
+  xt::xarray<float> expected_float16_data = data_;
+  XtensorRoundToFloat16(expected_float16_data);
+  EXPECT_EQ(XtensorUnpackFloat16(packed_float16_data, data_.shape()), expected_float16_data);
+}
+
+}  // namespace tensorward::util
@@ -0,0 +1,72 @@
+#include "tensorward/util/spsc_queue.h"
+
+#include <cstddef>
+#include <memory>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+namespace tensorward::util {
+
+namespace {
+
+constexpr std::size_t kCapacity = 5;
+constexpr std::size_t kNumValues = 100000;
+
+}  // namespace
+
+class SpscQueueTest : public ::testing::Test {
+ protected:
+  SpscQueueTest() : queue_(kCapacity) {}
+
+  SpscQueue<std::size_t> queue_;
+};
+
+TEST_F(SpscQueueTest, TryPushPopTest) {
+  // The capacity is rounded up to a power of two.
+  ASSERT_EQ(queue_.capacity(), 8);
+
+  std::size_t value;
+  EXPECT_FALSE(queue_.TryPop(value));
+  for (std::size_t i = 0; i < queue_.capacity(); ++i) {
+    EXPECT_TRUE(queue_.TryPush(std::size_t(i)));
+  }
+  EXPECT_FALSE(queue_.TryPush(std::size_t(0)));
+  EXPECT_EQ(queue_.size(), queue_.capacity());
+
+  // The values are popped in the order of pushing, and wrap around the ring buffer.
+  for (std::size_t i = 0; i < 3 * queue_.capacity(); ++i) {
+    ASSERT_TRUE(queue_.TryPop(value));
+    EXPECT_EQ(value, i);
+    EXPECT_TRUE(queue_.TryPush(i + queue_.capacity()));
+  }
+  EXPECT_EQ(queue_.size(), queue_.capacity());
+}
+
+TEST_F(SpscQueueTest, MoveOnlyTest) {
+  SpscQueue<std::unique_ptr<int>> queue(kCapacity);
+  queue.Push(std::make_unique<int>(42));
+  const std::unique_ptr<int> value = queue.Pop();
+  ASSERT_TRUE(value);
+  EXPECT_EQ(*value, 42);
+}
+
+TEST_F(SpscQueueTest, ProducerConsumerTest) {
+  // The consumer receives all of the values in the order, although the queue is much smaller than them.
+  std::thread producer([this] {
+    for (std::size_t i = 0; i < kNumValues; ++i) {
+      queue_.Push(std::size_t(i));
+    }
+  });
+
+  bool is_in_order = true;
+  for (std::size_t i = 0; i < kNumValues; ++i) {
+    is_in_order &= queue_.Pop() == i;
+  }
+  producer.join();
+
+  EXPECT_TRUE(is_in_order);
+  EXPECT_EQ(queue_.size(), 0);
+}
+
+}  // namespace tensorward::util
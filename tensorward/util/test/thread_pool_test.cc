@@ -0,0 +1,224 @@
+#include "tensorward/util/thread_pool.h"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "tensorward/util/numa.h"
+
+namespace tensorward::util {
+
+namespace {
+
+constexpr std::size_t kNumThreads = 3;
+constexpr std::size_t kSize = 100000;
+constexpr std::size_t kGrainSize = 1000;
+constexpr std::size_t kNumCallers = 4;
+constexpr std::size_t kNumChunks = 8;
+
+}  // namespace
+
+class ThreadPoolTest : public ::testing::Test {
+ protected:
+  ThreadPoolTest() : thread_pool_(kNumThreads) {}
+
+  ThreadPool thread_pool_;
+};
+
+TEST_F(ThreadPoolTest, ParallelForTest) {
+  // Each index is visited exactly once.
+  std::vector<int> counts(kSize, 0);
+  std::atomic<std::size_t> num_chunks = 0;
+  thread_pool_.ParallelFor(0, kSize, kGrainSize, [&](const std::size_t begin, const std::size_t end) {
+    EXPECT_LT(begin, end);
+    for (std::size_t i = begin; i < end; ++i) {
+      ++counts[i];
+    }
+    ++num_chunks;
+  });
+  for (std::size_t i = 0; i < kSize; ++i) {
+    ASSERT_EQ(counts[i], 1);
+  }
+  EXPECT_GT(num_chunks, 1);
+  EXPECT_LE(num_chunks, kSize / kGrainSize);
+
+  // The range smaller than the grain size is a single chunk.
+  num_chunks = 0;
+  thread_pool_.ParallelFor(10, 10 + kGrainSize - 1, kGrainSize, [&](const std::size_t begin, const std::size_t end) {
+    EXPECT_EQ(begin, 10);
+    EXPECT_EQ(end, 10 + kGrainSize - 1);
+    ++num_chunks;
+  });
+  EXPECT_EQ(num_chunks, 1);
+}
+
+TEST_F(ThreadPoolTest, NestedParallelForTest) {
+  std::vector<int> counts(kSize, 0);
+  thread_pool_.ParallelFor(0, kSize / kGrainSize, 1, [&](const std::size_t begin, const std::size_t end) {
+    for (std::size_t j = begin; j < end; ++j) {
+      thread_pool_.ParallelFor(j * kGrainSize, (j + 1) * kGrainSize, 1,
+                               [&](const std::size_t inner_begin, const std::size_t inner_end) {
+                                 for (std::size_t i = inner_begin; i < inner_end; ++i) {
+                                   ++counts[i];
+                                 }
+                               });
+    }
+  });
+  for (std::size_t i = 0; i < kSize; ++i) {
+    ASSERT_EQ(counts[i], 1);
+  }
+}
+
+TEST_F(ThreadPoolTest, ConcurrentCallersTest) {
+  std::vector<std::vector<int>> counts(kNumCallers, std::vector<int>(kSize, 0));
+  std::vector<std::thread> callers;
+  for (std::size_t c = 0; c < kNumCallers; ++c) {
+    callers.emplace_back([this, &caller_counts = counts[c]] {
+      thread_pool_.ParallelFor(0, kSize, kGrainSize, [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          ++caller_counts[i];
+        }
+      });
+    });
+  }
+  for (std::thread& caller : callers) {
+    caller.join();
+  }
+  for (std::size_t c = 0; c < kNumCallers; ++c) {
+    for (std::size_t i = 0; i < kSize; ++i) {
+      ASSERT_EQ(counts[c][i], 1);
+    }
+  }
+}
+
+TEST_F(ThreadPoolTest, ParallelReduceTest) {
+  const auto sum_chunk = [](const std::size_t begin, const std::size_t end) {
+    std::size_t sum = 0;
+    for (std::size_t i = begin; i < end; ++i) {
+      sum += i;
+    }
+    return sum;
+  };
+  const auto add = [](const std::size_t lhs, const std::size_t rhs) { return lhs + rhs; };
+  const std::size_t expected_sum = kSize * (kSize - 1) / 2;
+  EXPECT_EQ(thread_pool_.ParallelReduce(std::size_t(0), kSize, kGrainSize, std::size_t(0), sum_chunk, add),
+            expected_sum);
+  EXPECT_EQ(thread_pool_.ParallelReduce(std::size_t(0), kSize, kGrainSize, std::size_t(0), sum_chunk, add,
+                                        /* is_deterministic = */ false),
+            expected_sum);
+  EXPECT_EQ(thread_pool_.ParallelReduce(std::size_t(0), std::size_t(0), kGrainSize, std::size_t(0), sum_chunk, add),
+            0);
+}
+
+TEST_F(ThreadPoolTest, DeterministicParallelReduceTest) {
+  // The float sum (with the rounding errors) doesn't depend on the number of the threads.
+  std::vector<float> values(kSize);
+  for (std::size_t i = 0; i < kSize; ++i) {
+    values[i] = 1.0f / (i + 1);
+  }
+  const auto sum_chunk = [&values](const std::size_t begin, const std::size_t end) {
+    float sum = 0.0f;
+    for (std::size_t i = begin; i < end; ++i) {
+      sum += values[i];
+    }
+    return sum;
+  };
+  const auto add = [](const float lhs, const float rhs) { return lhs + rhs; };
+
+  ThreadPool serial_thread_pool(0);
+  const float expected_sum = serial_thread_pool.ParallelReduce(std::size_t(0), kSize, kGrainSize, 0.0f, sum_chunk, add);
+  for (std::size_t i = 0; i < 10; ++i) {
+    EXPECT_EQ(thread_pool_.ParallelReduce(std::size_t(0), kSize, kGrainSize, 0.0f, sum_chunk, add), expected_sum);
+  }
+}
+
+TEST_F(ThreadPoolTest, InstanceTest) {
+  ThreadPool::ResetInstance(kNumThreads);
+  EXPECT_EQ(ThreadPool::instance().num_threads(), kNumThreads);
+  ThreadPool::ResetInstance(0);
+  EXPECT_EQ(ThreadPool::instance().num_threads(), 0);
+
+  std::vector<int> counts(kSize, 0);
+  ThreadPool::instance().ParallelFor(0, kSize, kGrainSize, [&](const std::size_t begin, const std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      ++counts[i];
+    }
+  });
+  for (std::size_t i = 0; i < kSize; ++i) {
+    ASSERT_EQ(counts[i], 1);
+  }
+
+  // The workers are pinned by the caller (e.g. by `Config::kDoesUseNumaLocalPlacement`).
+  ThreadPool::ResetInstance(kNumThreads, true);
+  EXPECT_TRUE(ThreadPool::instance().does_pin_threads());
+  // The existing pool is kept.
+  EXPECT_TRUE(ThreadPool::instance(false).does_pin_threads());
+  ThreadPool::ResetInstance(kNumThreads);
+  EXPECT_FALSE(ThreadPool::instance().does_pin_threads());
+}
+
+TEST_F(ThreadPoolTest, ForkTest) {
+  ThreadPool::ResetInstance(kNumThreads);
+
+  // The child process, where the workers don't exist, runs the chunks serially, and in parallel again after the reset.
+  const pid_t process_id = fork();
+  ASSERT_GE(process_id, 0);
+  if (process_id == 0) {
+    bool is_ok = ThreadPool::instance().num_threads() == 0;
+    for (const std::size_t num_threads : {std::size_t(0), kNumThreads}) {
+      if (num_threads != 0) {
+        ThreadPool::ResetInstance(num_threads);
+      }
+      std::atomic<std::size_t> count = 0;
+      ThreadPool::instance().ParallelFor(0, kSize, kGrainSize, [&](const std::size_t begin, const std::size_t end) {
+        count += end - begin;
+      });
+      is_ok &= count == kSize;
+    }
+    _exit(is_ok ? EXIT_SUCCESS : EXIT_FAILURE);
+  }
+  int status = 0;
+  ASSERT_EQ(waitpid(process_id, &status, 0), process_id);
+  EXPECT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(WEXITSTATUS(status), EXIT_SUCCESS);
+
+  // The pool of the parent process is kept.
+  EXPECT_EQ(ThreadPool::instance().num_threads(), kNumThreads);
+}
+
+TEST_F(ThreadPoolTest, PinnedThreadPoolTest) {
+  ThreadPool pinned_thread_pool(kNumThreads, /* does_pin_threads = */ true);
+  EXPECT_TRUE(pinned_thread_pool.does_pin_threads());
+  for (std::size_t i = 0; i < kNumThreads; ++i) {
+    EXPECT_GE(pinned_thread_pool.worker_numa_node(i), 0);
+    EXPECT_LT(pinned_thread_pool.worker_numa_node(i), NumNumaNodes());
+    EXPECT_EQ(thread_pool_.worker_numa_node(i), -1);
+  }
+
+  std::vector<int> counts(kSize, 0);
+  pinned_thread_pool.ParallelFor(0, kSize, kGrainSize, [&](const std::size_t begin, const std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      ++counts[i];
+    }
+  });
+  for (std::size_t i = 0; i < kSize; ++i) {
+    ASSERT_EQ(counts[i], 1);
+  }
+
+  // The chunks (larger than the pages) are bound only on a NUMA system, and never by the pool whose workers aren't
+  // pinned.
+  std::vector<float> data(kNumChunks * kSize, 1.0);
+  EXPECT_EQ(pinned_thread_pool.BindChunksToNumaNodes(data.data(), sizeof(float), data.size(), kSize),
+            1 < NumNumaNodes());
+  EXPECT_FALSE(thread_pool_.BindChunksToNumaNodes(data.data(), sizeof(float), data.size(), kSize));
+  EXPECT_EQ(data[data.size() - 1], 1.0);
+}
+
+}  // namespace tensorward::util
@@ -0,0 +1,111 @@
+#include "tensorward/util/xtensor_gather_scatter.h"
+
+#include <gtest/gtest.h>
+#include <xtensor/xindex_view.hpp>
+#include <xtensor/xrandom.hpp>
+#include <xtensor/xview.hpp>
+
+namespace tensorward::util {
+
+namespace {
+
+constexpr int kNumRows = 5;
+constexpr int kHeight = 3;
+constexpr int kWidth = 4;
+
+// Large enough to take the parallel path of the scatter-add.
+constexpr int kNumLargeIndices = 100000;
+constexpr int kNumLargeRows = 1000;
+constexpr int kLargeRowSize = 8;
+
+}  // namespace
+
+class XtensorGatherScatterTest : public ::testing::Test {
+ protected:
+  XtensorGatherScatterTest()
+      : input_data_(xt::random::rand<float>({kNumRows, kHeight, kWidth})),
+        indices_({{0, 0, 0}, {4, 2, 3}, {1, 2, 0}, {4, 2, 3}}),  // Extracts {4, 2, 3} twice.
+        row_indices_({3, 0, 3, 1}) {}                            // Extracts the 4th row twice.
+
+  const xt::xarray<float> input_data_;
+  const std::vector<xt::xindex> indices_;
+  const std::vector<std::size_t> row_indices_;
+};
+
+TEST_F(XtensorGatherScatterTest, FlatOffsetsTest) {
+  const std::vector<std::size_t> actual_offsets = XtensorFlatOffsets(input_data_.shape(), indices_);
+
+  // offset = i * (kHeight * kWidth) + j * kWidth + k
+  const std::vector<std::size_t> expected_offsets({0 * (kHeight * kWidth) + 0 * kWidth + 0,
+                                                   4 * (kHeight * kWidth) + 2 * kWidth + 3,
+                                                   1 * (kHeight * kWidth) + 2 * kWidth + 0,
+                                                   4 * (kHeight * kWidth) + 2 * kWidth + 3});
+  EXPECT_EQ(actual_offsets, expected_offsets);
+}
+
+TEST_F(XtensorGatherScatterTest, GatherTest) {
+  const std::vector<std::size_t> offsets = XtensorFlatOffsets(input_data_.shape(), indices_);
+  const xt::xarray<float> actual_output_data = XtensorGather(input_data_, offsets);
+
+  // Checks that the result is the same as `xt::index_view()`.
+  const xt::xarray<float> expected_output_data = xt::index_view(input_data_, indices_);
+  EXPECT_EQ(actual_output_data, expected_output_data);
+}
+
+TEST_F(XtensorGatherScatterTest, ScatterAddTest) {
+  const std::vector<std::size_t> offsets = XtensorFlatOffsets(input_data_.shape(), indices_);
+  const xt::xarray<float> actual_output_data = XtensorScatterAdd(xt::ones<float>({indices_.size()}), offsets,
+                                                                 input_data_.shape());
+
+  // Checks that the duplicated index is accumulated twice.
+  xt::xarray<float> expected_output_data = xt::zeros<float>(input_data_.shape());
+  expected_output_data(0, 0, 0) = 1.0;
+  expected_output_data(4, 2, 3) = 2.0;
+  expected_output_data(1, 2, 0) = 1.0;
+  EXPECT_EQ(actual_output_data, expected_output_data);
+}
+
+TEST_F(XtensorGatherScatterTest, GatherRowsTest) {
+  const xt::xarray<float> actual_output_data = XtensorGatherRows(input_data_, row_indices_);
+  const xt::xarray<float>::shape_type expected_output_shape({row_indices_.size(), kHeight, kWidth});
+  ASSERT_EQ(actual_output_data.shape(), expected_output_shape);
+
+  for (std::size_t i = 0; i < row_indices_.size(); ++i) {
+    EXPECT_EQ(xt::xarray<float>(xt::view(actual_output_data, i)),
+              xt::xarray<float>(xt::view(input_data_, row_indices_[i])));
+  }
+}
+
+TEST_F(XtensorGatherScatterTest, ScatterAddRowsTest) {
+  const xt::xarray<float>::shape_type rows_shape({row_indices_.size(), kHeight, kWidth});
+  const xt::xarray<float> rows_data = xt::random::rand<float>(rows_shape);
+  const xt::xarray<float> actual_output_data = XtensorScatterAddRows(rows_data, row_indices_, input_data_.shape());
+
+  xt::xarray<float> expected_output_data = xt::zeros<float>(input_data_.shape());
+  for (std::size_t i = 0; i < row_indices_.size(); ++i) {
+    xt::view(expected_output_data, row_indices_[i]) += xt::view(rows_data, i);
+  }
+  EXPECT_EQ(actual_output_data, expected_output_data);
+}
+
+TEST_F(XtensorGatherScatterTest, ParallelScatterAddRowsTest) {
+  const xt::xarray<float> rows_data = xt::random::rand<float>({kNumLargeIndices, kLargeRowSize});
+  const xt::xarray<std::size_t> random_row_indices =
+      xt::random::randint<std::size_t>({kNumLargeIndices}, 0, kNumLargeRows);
+  const std::vector<std::size_t> row_indices(random_row_indices.begin(), random_row_indices.end());
+  const xt::xarray<float>::shape_type output_shape({kNumLargeRows, kLargeRowSize});
+
+  const xt::xarray<float> actual_output_data = XtensorScatterAddRows(rows_data, row_indices, output_shape);
+
+  // Checks that the parallel result is exactly the same as the sequential one, because each row is accumulated by a
+  // single thread in the same order.
+  xt::xarray<float> expected_output_data = xt::zeros<float>(output_shape);
+  for (std::size_t i = 0; i < row_indices.size(); ++i) {
+    for (std::size_t j = 0; j < kLargeRowSize; ++j) {
+      expected_output_data(row_indices[i], j) += rows_data(i, j);
+    }
+  }
+  EXPECT_EQ(actual_output_data, expected_output_data);
+}
+
+}  // namespace tensorward::util
@@ -0,0 +1,69 @@
+#include "tensorward/util/xtensor_im2col.h"
+
+#include <gtest/gtest.h>
+#include <xtensor/xrandom.hpp>
+
+namespace tensorward::util {
+
+namespace {
+
+constexpr int kDataSize = 2;
+constexpr int kChannel = 3;
+constexpr int kHeight = 5;
+constexpr int kWidth = 4;
+constexpr int kKernelSize = 3;
+constexpr int kStride = 1;
+constexpr int kPad = 1;
+
+}  // namespace
+
+class XtensorIm2colTest : public ::testing::Test {
+ protected:
+  XtensorIm2colTest() : input_data_(xt::random::rand<float>({kDataSize, kChannel, kHeight, kWidth})) {}
+
+  const xt::xarray<float> input_data_;
+};
+
+TEST_F(XtensorIm2colTest, Im2colTest) {
+  // clang-format off
+  const xt::xarray<float> input_data({{{{1.0, 2.0, 3.0},
+                                        {4.0, 5.0, 6.0},
+                                        {7.0, 8.0, 9.0}}}});
+  // Each row is a 2x2 receptive field (without padding).
+  const xt::xarray<float> expected_output_data({{1.0, 2.0, 4.0, 5.0},
+                                                {2.0, 3.0, 5.0, 6.0},
+                                                {4.0, 5.0, 7.0, 8.0},
+                                                {5.0, 6.0, 8.0, 9.0}});
+  // clang-format on
+
+  const xt::xarray<float> actual_output_data = XtensorIm2col(input_data, 2, 2, 1, 0);
+
+  EXPECT_EQ(actual_output_data, expected_output_data);
+}
+
+TEST_F(XtensorIm2colTest, OutputShapeTest) {
+  const xt::xarray<float> actual_output_data = XtensorIm2col(input_data_, kKernelSize, kKernelSize, kStride, kPad);
+
+  const std::size_t OH = ConvOutputSize(kHeight, kKernelSize, kStride, kPad);
+  const std::size_t OW = ConvOutputSize(kWidth, kKernelSize, kStride, kPad);
+  const xt::xarray<float>::shape_type expected_output_shape(
+      {kDataSize * OH * OW, kChannel * kKernelSize * kKernelSize});
+
+  EXPECT_EQ(OH, kHeight);
+  EXPECT_EQ(OW, kWidth);
+  EXPECT_EQ(actual_output_data.shape(), expected_output_shape);
+}
+
+TEST_F(XtensorIm2colTest, Col2imIsAdjointTest) {
+  const xt::xarray<float> col = XtensorIm2col(input_data_, kKernelSize, kKernelSize, kStride, kPad);
+  const xt::xarray<float> random_col = xt::random::rand<float>(col.shape());
+  const xt::xarray<float> image =
+      XtensorCol2im(random_col, input_data_.shape(), kKernelSize, kKernelSize, kStride, kPad);
+
+  // Checks that `col2im()` is the adjoint (transpose) of `im2col()`, i.e. <im2col(x), c> = <x, col2im(c)>.
+  const float lhs = xt::sum(col * random_col)();
+  const float rhs = xt::sum(input_data_ * image)();
+  EXPECT_NEAR(lhs, rhs, 1.0e-3);
+}
+
+}  // namespace tensorward::util
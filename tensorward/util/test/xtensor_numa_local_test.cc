@@ -0,0 +1,59 @@
+#include "tensorward/util/xtensor_numa_local.h"
+
+#include <gtest/gtest.h>
+#include <xtensor/xrandom.hpp>
+
+#include "tensorward/util/thread_pool.h"
+
+namespace tensorward::util {
+
+namespace {
+
+constexpr std::size_t kHeight = 3;
+constexpr std::size_t kNumThreads = 3;
+
+}  // namespace
+
+class XtensorNumaLocalTest : public ::testing::Test {
+ protected:
+  // Large enough to be processed in parallel.
+  XtensorNumaLocalTest() : input_data_(xt::random::randn<float>({kHeight, 2 * kDefaultGrainSize})) {}
+
+  const xt::xarray<float> input_data_;
+};
+
+TEST_F(XtensorNumaLocalTest, CopyNumaLocalTest) {
+  // Plain copy.
+  ThreadPool::ResetInstance(kNumThreads);
+  const xt::xarray<float> copied_data = XtensorCopyNumaLocal(input_data_, false);
+  EXPECT_EQ(copied_data, input_data_);
+  EXPECT_NE(copied_data.data(), input_data_.data());
+
+  // Copy placed on the NUMA nodes of the pinned workers.
+  ThreadPool::ResetInstance(kNumThreads, true);
+  const xt::xarray<float> numa_local_data = XtensorCopyNumaLocal(input_data_, true);
+  EXPECT_EQ(numa_local_data.shape(), input_data_.shape());
+  EXPECT_EQ(numa_local_data, input_data_);
+  EXPECT_NE(numa_local_data.data(), input_data_.data());
+
+  // The small data is copied as is.
+  const xt::xarray<float> small_data = xt::random::randn<float>({kHeight, kHeight});
+  EXPECT_EQ(XtensorCopyNumaLocal(small_data, true), small_data);
+  ThreadPool::ResetInstance(kNumThreads);
+}
+
+TEST_F(XtensorNumaLocalTest, BindToNumaNodesTest) {
+  xt::xarray<float> data = input_data_;
+
+  // Nothing is migrated by the pool whose workers aren't pinned.
+  ThreadPool::ResetInstance(kNumThreads);
+  EXPECT_FALSE(XtensorBindToNumaNodes(data));
+
+  // The data is kept (even if the pages are migrated).
+  ThreadPool::ResetInstance(kNumThreads, true);
+  XtensorBindToNumaNodes(data);
+  EXPECT_EQ(data, input_data_);
+  ThreadPool::ResetInstance(kNumThreads);
+}
+
+}  // namespace tensorward::util
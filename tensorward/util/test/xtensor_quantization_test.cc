@@ -0,0 +1,95 @@
+#include "tensorward/util/xtensor_quantization.h"
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+#include <xtensor/xarray.hpp>
+#include <xtensor/xmath.hpp>
+#include <xtensor/xrandom.hpp>
+#include <xtensor-blas/xlinalg.hpp>
+
+namespace tensorward::util {
+
+namespace {
+
+constexpr int kBatchSize = 7;  // Not a multiple of the row block size of the GEMM.
+constexpr int kInSize = 33;
+constexpr int kOutSize = 5;
+
+// Tolerance of the int8 inference relative to the max absolute value of the float output.
+constexpr float kRelativeTolerance = 0.05;
+
+}  // namespace
+
+class XtensorQuantizationTest : public ::testing::Test {
+ protected:
+  XtensorQuantizationTest()
+      : x_(xt::random::randn<float>({kBatchSize, kInSize})),
+        W_(xt::random::randn<float>({kInSize, kOutSize})),
+        b_(xt::random::randn<float>({kOutSize})),
+        x_scale_(Int8Scale(xt::amax(xt::abs(x_))())) {}
+
+  const xt::xarray<float> x_;
+  const xt::xarray<float> W_;
+  const xt::xarray<float> b_;
+  const float x_scale_;
+};
+
+TEST_F(XtensorQuantizationTest, QuantizeInt8Test) {
+  const std::vector<std::int8_t> x_q = XtensorQuantizeInt8(x_, x_scale_);
+  ASSERT_EQ(x_q.size(), x_.size());
+
+  // Checks that the max absolute value is mapped to 127, and the rounding error is at most the half of the scale.
+  int max_abs_x_q = 0;
+  for (std::size_t i = 0; i < x_q.size(); ++i) {
+    max_abs_x_q = std::max(max_abs_x_q, std::abs(static_cast<int>(x_q[i])));
+    EXPECT_LE(std::abs(x_scale_ * x_q[i] - x_.data()[i]), 0.5 * x_scale_ * (1.0 + 1.0e-5));
+  }
+  EXPECT_EQ(max_abs_x_q, kInt8Max);
+}
+
+TEST_F(XtensorQuantizationTest, QuantizeLinearTest) {
+  const Int8Linear linear = XtensorQuantizeLinear(W_, b_);
+  ASSERT_EQ(linear.in_size, kInSize);
+  ASSERT_EQ(linear.out_size, kOutSize);
+
+  // Checks that each output channel has its own scale.
+  for (std::size_t o = 0; o < kOutSize; ++o) {
+    float max_abs_W = 0.0;
+    for (std::size_t i = 0; i < kInSize; ++i) {
+      max_abs_W = std::max(max_abs_W, std::abs(W_(i, o)));
+      EXPECT_NEAR(linear.W_scales[o] * linear.W_transposed[o * kInSize + i], W_(i, o), 0.5 * linear.W_scales[o]);
+    }
+    EXPECT_FLOAT_EQ(linear.W_scales[o], max_abs_W / kInt8Max);
+    EXPECT_EQ(linear.b[o], b_(o));
+  }
+}
+
+TEST_F(XtensorQuantizationTest, LinearDequantizeTest) {
+  const Int8Linear linear = XtensorQuantizeLinear(W_, b_);
+  const xt::xarray<float> actual_y = Int8LinearDequantize(XtensorQuantizeInt8(x_, x_scale_), x_scale_, linear);
+
+  const xt::xarray<float> expected_y = xt::linalg::dot(x_, W_) + b_;
+  ASSERT_EQ(actual_y.shape(), expected_y.shape());
+  const float tolerance = kRelativeTolerance * xt::amax(xt::abs(expected_y))();
+  EXPECT_TRUE(xt::allclose(actual_y, expected_y, 0.0, tolerance));
+}
+
+TEST_F(XtensorQuantizationTest, LinearRequantizeWithReLUTest) {
+  const Int8Linear linear = XtensorQuantizeLinear(W_, b_);
+  const std::vector<std::int8_t> x_q = XtensorQuantizeInt8(x_, x_scale_);
+
+  const xt::xarray<float> y = Int8LinearDequantize(x_q, x_scale_, linear);
+  const float y_scale = Int8Scale(xt::amax(xt::abs(y))());
+  const std::vector<std::int8_t> actual_y_q = Int8LinearRequantize(x_q, x_scale_, linear, y_scale, true);
+
+  // Checks that the fused requantization is the same as the dequantization followed by ReLU and the quantization.
+  const std::vector<std::int8_t> expected_y_q = XtensorQuantizeInt8(xt::maximum(y, 0.0f), y_scale);
+  ASSERT_EQ(actual_y_q.size(), expected_y_q.size());
+  for (std::size_t i = 0; i < actual_y_q.size(); ++i) {
+    EXPECT_LE(0, actual_y_q[i]);
+    EXPECT_NEAR(actual_y_q[i], expected_y_q[i], 1);  // Only the rounding of the midpoint can differ.
+  }
+}
+
+}  // namespace tensorward::util
@@ -0,0 +1,91 @@
+#include "tensorward/util/xtensor_rank.h"
+
+#include <gtest/gtest.h>
+#include <xtensor/xarray.hpp>
+#include <xtensor/xmath.hpp>
+#include <xtensor/xoperation.hpp>
+#include <xtensor/xrandom.hpp>
+
+namespace tensorward::util {
+
+namespace {
+
+constexpr int kBatchSize = 3;
+constexpr int kChannels = 2;
+constexpr int kHeight = 4;
+constexpr int kWidth = 5;
+constexpr std::size_t kNumThreads = 3;
+
+}  // namespace
+
+class XtensorRankTest : public ::testing::Test {
+ protected:
+  XtensorRankTest() {}
+
+  // Checks that the evaluation with the rank is the same as the one of the dynamic rank.
+  void ExpectSameAsDynamicRank(const xt::xarray<float>::shape_type& shape) {
+    const xt::xarray<float> a = xt::random::randn<float>(shape);
+    const xt::xarray<float> b = xt::random::randn<float>(shape);
+
+    const xt::xarray<float> actual_y = XtensorEvaluateWithRank(
+        shape, [](const auto& a, const auto& b) { return a * (1.0 - xt::exp(-b)) + 2 * b; }, a, b);
+    const xt::xarray<float> expected_y = a * (1.0 - xt::exp(-b)) + 2 * b;
+
+    EXPECT_EQ(actual_y.shape(), shape);
+    EXPECT_TRUE(xt::allclose(actual_y, expected_y));
+  }
+};
+
+TEST_F(XtensorRankTest, AsRankTest) {
+  xt::xarray<float> data = xt::random::randn<float>({kHeight, kWidth});
+
+  // Checks that the view shares the data, and has the same shape.
+  auto view = XtensorAsRank<2>(data);
+  EXPECT_EQ(view.data(), data.data());
+  EXPECT_EQ(view.shape(0), kHeight);
+  EXPECT_EQ(view.shape(1), kWidth);
+  EXPECT_EQ(view(kHeight - 1, kWidth - 1), data(kHeight - 1, kWidth - 1));
+
+  view(0, 0) = 1.0;
+  EXPECT_EQ(data(0, 0), 1.0);
+}
+
+TEST_F(XtensorRankTest, EvaluateWithRankTest) {
+  ExpectSameAsDynamicRank({kWidth});
+  ExpectSameAsDynamicRank({kHeight, kWidth});
+  ExpectSameAsDynamicRank({kChannels, kHeight, kWidth});
+  ExpectSameAsDynamicRank({kBatchSize, kChannels, kHeight, kWidth});
+}
+
+TEST_F(XtensorRankTest, FallbackToDynamicRankTest) {
+  // The rank higher than `kMaxSpecializedRank`.
+  ExpectSameAsDynamicRank({kBatchSize, kChannels, kChannels, kHeight, kWidth});
+
+  // The scalar.
+  ExpectSameAsDynamicRank({});
+
+  // The broadcasting between the different ranks.
+  const xt::xarray<float> a = xt::random::randn<float>({kHeight, kWidth});
+  const xt::xarray<float> b = xt::random::randn<float>({kWidth});
+  const xt::xarray<float> actual_y =
+      XtensorEvaluateWithRank(a.shape(), [](const auto& a, const auto& b) { return a * b; }, a, b);
+  const xt::xarray<float> expected_y = a * b;
+  EXPECT_TRUE(xt::allclose(actual_y, expected_y));
+
+  // The broadcasting between the different shapes of the same rank.
+  const xt::xarray<float> c = xt::random::randn<float>({1, kWidth});
+  const xt::xarray<float> actual_z =
+      XtensorEvaluateWithRank(c.shape(), [](const auto& a, const auto& c) { return a + c; }, a, c);
+  const xt::xarray<float> expected_z = a + c;
+  EXPECT_EQ(actual_z.shape(), expected_z.shape());
+  EXPECT_TRUE(xt::allclose(actual_z, expected_z));
+}
+
+TEST_F(XtensorRankTest, ParallelEvaluateTest) {
+  // Large enough to be split into the chunks evaluated by the threads.
+  ThreadPool::ResetInstance(kNumThreads);
+  ExpectSameAsDynamicRank({kNumThreads, kDefaultGrainSize, kChannels});
+  ExpectSameAsDynamicRank({kNumThreads * kDefaultGrainSize + 1});
+}
+
+}  // namespace tensorward::util
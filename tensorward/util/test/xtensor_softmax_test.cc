@@ -1,8 +1,11 @@
 #include "tensorward/util/xtensor_softmax.h"
 
 #include <gtest/gtest.h>
+#include <xtensor/xmath.hpp>
 #include <xtensor/xrandom.hpp>
 
+#include "tensorward/util/thread_pool.h"
+
 namespace tensorward::util {
 
 namespace {
@@ -10,6 +13,7 @@ namespace {
 constexpr int kHeight = 2;
 constexpr int kWidth = 3;
 constexpr float kEpsilon = 1.0e-3;
+constexpr std::size_t kNumThreads = 3;
 
 }  // namespace
 
@@ -41,4 +45,18 @@ TEST_F(XtensorSoftmaxTest, SoftmaxTest) {
   }
 }
 
+TEST_F(XtensorSoftmaxTest, ParallelSoftmaxTest) {
+  // Large enough to be split into the chunks of the rows calculated by the threads.
+  ThreadPool::ResetInstance(kNumThreads);
+  const xt::xarray<float> input_data = 10.0 * xt::random::randn<float>({kNumThreads * kDefaultGrainSize, kWidth});
+  const xt::xarray<float> input_data_exp = xt::exp(input_data - xt::amax(input_data, {-1}, xt::keep_dims));
+  const xt::xarray<float> input_data_sum_exp = xt::sum(input_data_exp, {-1}, xt::keep_dims);
+  const xt::xarray<float> expected_output_data = input_data_exp / input_data_sum_exp;
+
+  const xt::xarray<float> actual_output_data = XtensorSoftmax(input_data);
+
+  ASSERT_EQ(actual_output_data.shape(), expected_output_data.shape());
+  EXPECT_TRUE(xt::allclose(actual_output_data, expected_output_data));
+}
+
 }  // namespace tensorward::util
@@ -1,14 +1,18 @@
 #include "tensorward/util/xtensor_sum_to.h"
 
 #include <gtest/gtest.h>
+#include <xtensor/xmath.hpp>
 #include <xtensor/xrandom.hpp>
 
+#include "tensorward/util/thread_pool.h"
+
 namespace tensorward::util {
 
 namespace {
 
 constexpr int kHeight = 2;
 constexpr int kWidth = 3;
+constexpr std::size_t kNumThreads = 3;
 
 }  // namespace
 
@@ -78,4 +82,17 @@ TEST_F(XtensorSumToTest, SumAlongWithAxis0and1Test) {
   EXPECT_EQ(actual_output_data_0D, expected_output_data_0D);
 }
 
+TEST_F(XtensorSumToTest, ParallelSumAlongWithLeadingAxesTest) {
+  // Large enough to be split into the chunks of the output elements summed up by the threads.
+  ThreadPool::ResetInstance(kNumThreads);
+  const xt::xarray<float> input_data = xt::random::rand<float>({kNumThreads, kDefaultGrainSize, kWidth});
+
+  const xt::xarray<float>::shape_type output_shape({kWidth});
+  const xt::xarray<float> actual_output_data = XtensorSumTo(input_data, output_shape);
+  const xt::xarray<float> expected_output_data = xt::sum(input_data, {0, 1});
+
+  EXPECT_EQ(actual_output_data.shape(), output_shape);
+  EXPECT_TRUE(xt::allclose(actual_output_data, expected_output_data));
+}
+
 }  // namespace tensorward::util
@@ -0,0 +1,86 @@
+#include "tensorward/util/xtensor_winograd.h"
+
+#include <gtest/gtest.h>
+#include <xtensor/xmanipulation.hpp>
+#include <xtensor/xrandom.hpp>
+#include <xtensor-blas/xlinalg.hpp>
+
+#include "tensorward/util/xtensor_im2col.h"
+
+namespace tensorward::util {
+
+namespace {
+
+constexpr int kDataSize = 2;
+constexpr int kInChannel = 3;
+constexpr int kOutChannel = 4;
+constexpr int kHeight = 11;  // Not divisible by the output tile sizes, in order to check the overhanging tiles.
+constexpr int kWidth = 9;
+constexpr int kKernelSize = 3;
+
+constexpr float kRelativeTolerance = 1.0e-4;
+constexpr float kAbsoluteTolerance = 1.0e-4;
+
+// Convolution by the im2col formulation, which is the reference of the Winograd formulation.
+const xt::xarray<float> Im2colConv2d(const xt::xarray<float>& x, const xt::xarray<float>& W, const std::size_t pad) {
+  const std::size_t N = x.shape(0);
+  const std::size_t K = W.shape(0);
+  const std::size_t OH = ConvOutputSize(x.shape(2), kKernelSize, 1, pad);
+  const std::size_t OW = ConvOutputSize(x.shape(3), kKernelSize, 1, pad);
+
+  const xt::xarray<float> col = XtensorIm2col(x, kKernelSize, kKernelSize, 1, pad);
+  xt::xarray<float> W_col = W;
+  W_col.reshape({K, W.size() / K});
+  xt::xarray<float> y_col = xt::linalg::dot(col, xt::transpose(W_col));
+  y_col.reshape({N, OH, OW, K});
+
+  return xt::transpose(y_col, {0, 3, 1, 2});
+}
+
+}  // namespace
+
+class XtensorWinogradTest : public ::testing::Test {
+ protected:
+  XtensorWinogradTest()
+      : input_data_(xt::random::randn<float>({kDataSize, kInChannel, kHeight, kWidth})),
+        kernel_(xt::random::randn<float>({kOutChannel, kInChannel, kKernelSize, kKernelSize})) {}
+
+  const xt::xarray<float> input_data_;
+  const xt::xarray<float> kernel_;
+};
+
+TEST_F(XtensorWinogradTest, IsWinogradEligibleTest) {
+  EXPECT_TRUE(IsWinogradEligible({kOutChannel, kInChannel, 3, 3}, 1));
+  EXPECT_FALSE(IsWinogradEligible({kOutChannel, kInChannel, 3, 3}, 2));
+  EXPECT_FALSE(IsWinogradEligible({kOutChannel, kInChannel, 5, 5}, 1));
+}
+
+TEST_F(XtensorWinogradTest, F2x2Test) {
+  for (const std::size_t pad : {0, 1, 2}) {
+    const WinogradFilter winograd_filter = XtensorWinogradFilterTransform(kernel_, 2);
+    ASSERT_EQ(winograd_filter.transformed_filters.size(), 4 * 4);
+
+    const xt::xarray<float> actual_output_data = XtensorWinogradConv2d(input_data_, winograd_filter, pad);
+    const xt::xarray<float> expected_output_data = Im2colConv2d(input_data_, kernel_, pad);
+
+    // Checks that the Winograd path matches the im2col path within the numeric tolerance.
+    ASSERT_EQ(actual_output_data.shape(), expected_output_data.shape());
+    EXPECT_TRUE(xt::allclose(actual_output_data, expected_output_data, kRelativeTolerance, kAbsoluteTolerance));
+  }
+}
+
+TEST_F(XtensorWinogradTest, F4x4Test) {
+  for (const std::size_t pad : {0, 1, 2}) {
+    const WinogradFilter winograd_filter = XtensorWinogradFilterTransform(kernel_, 4);
+    ASSERT_EQ(winograd_filter.transformed_filters.size(), 6 * 6);
+
+    const xt::xarray<float> actual_output_data = XtensorWinogradConv2d(input_data_, winograd_filter, pad);
+    const xt::xarray<float> expected_output_data = Im2colConv2d(input_data_, kernel_, pad);
+
+    // Checks that the Winograd path matches the im2col path within the numeric tolerance.
+    ASSERT_EQ(actual_output_data.shape(), expected_output_data.shape());
+    EXPECT_TRUE(xt::allclose(actual_output_data, expected_output_data, kRelativeTolerance, kAbsoluteTolerance));
+  }
+}
+
+}  // namespace tensorward::util
@@ -0,0 +1,311 @@
+#pragma once
+
+#include <pthread.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "tensorward/util/numa.h"
+
+namespace tensorward::util {
+
+// Default minimum number of the elements in each chunk of `ThreadPool::ParallelFor()` for the elementwise and reduction
+// kernels, below which the cost of handing a chunk over to another thread outweighs the work (e.g. an array smaller
+// than 2x this isn't parallelized at all).
+constexpr std::size_t kDefaultGrainSize = 1 << 14;
+
+// Pool of the worker threads for the intra-op parallelism (e.g. splitting an elementwise kernel into chunks).
+//
+// Each worker has its own deque of the tasks. `ParallelFor()` splits the range into chunks, deals them out to the
+// deques, and runs the chunks on the calling thread too. A worker pops the tasks from the back of its own deque, and
+// once it's empty, steals from the front of the deques of the others (work stealing), so the workers that are delayed
+// (e.g. by the other processes) or got the more expensive chunks don't delay the whole loop. The calling thread also
+// steals while waiting for its chunks, so a pool of N workers runs a loop on N + 1 threads.
+//
+// NOTE: `ParallelFor()` can be called from multiple threads at once (e.g. the stages of a pipeline). A nested call
+// NOTE: from a worker of the same pool runs serially on the worker instead of waiting for the other workers, which
+// NOTE: could be waiting for it.
+//
+// If `does_pin_threads` is true, then the workers are pinned to the CPUs alternating between the NUMA nodes (see
+// `CpusSpreadOverNumaNodes()`), so the chunks dealt out to a worker always run on the same node. Since `ParallelFor()`
+// deals out the chunks of the same range in the same way every time, a chunk of an array first touched by a worker
+// (e.g. the output of an elementwise kernel, whose pages aren't touched until the kernel writes them) is read by the
+// same worker from the local memory in the next kernels. See also `BindChunksToNumaNodes()`.
+class ThreadPool {
+ public:
+  explicit ThreadPool(const std::size_t num_threads, const bool does_pin_threads = false)
+      : does_pin_threads_(does_pin_threads), num_queued_tasks_(0), is_stopping_(false) {
+    const std::vector<int> cpus = does_pin_threads ? CpusSpreadOverNumaNodes() : std::vector<int>();
+    for (std::size_t i = 0; i < num_threads; ++i) {
+      worker_ptrs_.push_back(std::make_unique<Worker>());
+    }
+    for (std::size_t i = 0; i < num_threads; ++i) {
+      threads_.emplace_back(&ThreadPool::Run, this, i);
+      // The first CPU is left to the calling thread (e.g. the main thread).
+      if (!cpus.empty()) {
+        const int cpu = cpus[(i + 1) % cpus.size()];
+        if (PinThreadToCpu(threads_.back().native_handle(), cpu)) {
+          worker_ptrs_[i]->numa_node = NumaNodeOfCpu(cpu);
+        }
+      }
+    }
+  }
+
+  // Stops the workers, after they finish the queued tasks.
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      is_stopping_ = true;
+    }
+    condition_variable_.notify_all();
+    for (std::thread& thread : threads_) {
+      thread.join();
+    }
+  }
+
+  // Prevents copy construction.
+  ThreadPool(const ThreadPool&) = delete;
+
+  // Prevents copy assignment.
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Calls `body(chunk_begin, chunk_end)` for the chunks which cover [begin, end) without overlaps, in parallel. Each
+  // chunk has at least `grain_size` indices (except if the range is smaller), and the range is split into at most
+  // `kNumChunksPerThread` chunks per thread, so that the work stealing can balance the load at a small overhead.
+  // NOTE: `body` must be thread-safe (e.g. each chunk writes only its own elements of the output).
+  void ParallelFor(const std::size_t begin, const std::size_t end, const std::size_t grain_size,
+                   const std::function<void(std::size_t, std::size_t)>& body) {
+    if (end <= begin) {
+      return;
+    }
+    const std::size_t size = end - begin;
+    const std::size_t num_chunks = NumChunks(size, grain_size);
+    if (num_chunks <= 1 || worker_ptrs_.empty() || current_pool_ == this) {
+      body(begin, end);
+      return;
+    }
+    const auto chunk_begin = [begin, size, num_chunks](const std::size_t c) { return begin + size * c / num_chunks; };
+
+    // The chunks 1, 2, ... are dealt out to the workers, and the chunk 0 is run by this thread. The tasks refer to the
+    // counter on this stack frame, which outlives them since this function returns only after all of them finish.
+    std::atomic<std::size_t> num_running_chunks = num_chunks - 1;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      num_queued_tasks_ += num_chunks - 1;
+    }
+    for (std::size_t c = 1; c < num_chunks; ++c) {
+      Worker& worker = *worker_ptrs_[c % worker_ptrs_.size()];
+      std::lock_guard<std::mutex> lock(worker.mutex);
+      worker.tasks.push_back([&body, &num_running_chunks, begin = chunk_begin(c), end = chunk_begin(c + 1)] {
+        body(begin, end);
+        num_running_chunks.fetch_sub(1, std::memory_order_acq_rel);
+      });
+    }
+    condition_variable_.notify_all();
+
+    body(chunk_begin(0), chunk_begin(1));
+
+    // Helps the workers (with any tasks, which may be of the other callers) until all of the chunks finish.
+    const ThreadPool* const previous_pool = current_pool_;
+    current_pool_ = this;
+    while (num_running_chunks.load(std::memory_order_acquire) != 0) {
+      Task task;
+      if (TryPopOrSteal(num_chunks % worker_ptrs_.size(), task)) {
+        task();
+      } else {
+        std::this_thread::yield();
+      }
+    }
+    current_pool_ = previous_pool;
+  }
+
+  // Reduces [begin, end) into a value: `map_chunk(chunk_begin, chunk_end)` reduces each chunk in parallel, and
+  // `combine(partial0, partial1)` combines the partial results one by one in the order of the chunks from `identity`.
+  //
+  // If `is_deterministic` is true, then the chunks are of `grain_size` indices regardless of the number of the threads,
+  // so the result (e.g. the rounding errors of a float sum) is the same on any machine. Otherwise, the range is split
+  // into one chunk per thread, which combines fewer partial results, but the result depends on the number of the
+  // threads (while it's still the same for the same number of the threads).
+  template <class T, class MapChunkLambda, class CombineLambda>
+  T ParallelReduce(const std::size_t begin, const std::size_t end, const std::size_t grain_size, const T& identity,
+                   MapChunkLambda&& map_chunk, CombineLambda&& combine, const bool is_deterministic = true) {
+    if (end <= begin) {
+      return identity;
+    }
+    const std::size_t size = end - begin;
+    const std::size_t chunk_size =
+        is_deterministic ? std::max<std::size_t>(grain_size, 1)
+                         : std::max<std::size_t>(grain_size, (size + num_threads()) / (num_threads() + 1));
+    const std::size_t num_chunks = (size + chunk_size - 1) / chunk_size;
+
+    std::vector<T> partials(num_chunks, identity);
+    ParallelFor(0, num_chunks, 1, [&](const std::size_t chunk_index_begin, const std::size_t chunk_index_end) {
+      for (std::size_t c = chunk_index_begin; c < chunk_index_end; ++c) {
+        partials[c] = map_chunk(begin + c * chunk_size, std::min(begin + (c + 1) * chunk_size, end));
+      }
+    });
+
+    T result = identity;
+    for (const T& partial : partials) {
+      result = combine(result, partial);
+    }
+    return result;
+  }
+
+  // Binds the pages of each chunk of `ParallelFor(0, size, grain_size, ...)` over the array of `size` elements of
+  // `element_size` bytes to the NUMA node of the thread which the chunk is dealt out to (the node of the calling thread
+  // for the chunk 0), and migrates the pages already touched, for the array written by a single thread (e.g. the
+  // parameters initialized randomly) but read by the parallel kernels. Returns whether any chunk is bound, and does
+  // nothing if the workers aren't pinned or `BindMemoryToNumaNode()` isn't available.
+  // NOTE: A stolen chunk is still read from the remote memory, so the placement is the best effort.
+  const bool BindChunksToNumaNodes(void* data, const std::size_t element_size, const std::size_t size,
+                                   const std::size_t grain_size) const {
+    if (!does_pin_threads_ || worker_ptrs_.empty()) {
+      return false;
+    }
+    const std::size_t num_chunks = NumChunks(size, grain_size);
+    bool is_bound = false;
+    for (std::size_t c = 0; c < num_chunks; ++c) {
+      const int numa_node = c == 0 ? CurrentNumaNode() : worker_ptrs_[c % worker_ptrs_.size()]->numa_node;
+      const std::size_t chunk_begin = size * c / num_chunks;
+      const std::size_t chunk_end = size * (c + 1) / num_chunks;
+      is_bound |= BindMemoryToNumaNode(static_cast<char*>(data) + chunk_begin * element_size,
+                                       (chunk_end - chunk_begin) * element_size, numa_node);
+    }
+    return is_bound;
+  }
+
+  // Number of the worker threads (excluding the calling thread of `ParallelFor()`).
+  const std::size_t num_threads() const { return threads_.size(); }
+
+  const bool does_pin_threads() const { return does_pin_threads_; }
+
+  // NUMA node of the CPU which the worker is pinned to, or -1 if it isn't pinned.
+  const int worker_numa_node(const std::size_t worker_index) const { return worker_ptrs_[worker_index]->numa_node; }
+
+  // Gets the pool shared by the kernels, which has (the number of the hardware threads - 1) workers by default, since
+  // the calling thread also runs the chunks. The workers are pinned if `does_pin_threads` is true (e.g. given by the
+  // callers which place the data by `Config::kDoesUseNumaLocalPlacement`), but only if this call creates the pool.
+  //
+  // NOTE: Only the calling thread is forked (e.g. by `distributed::LaunchWorkers()`), so the pool is replaced in the
+  // NOTE: child process with the one of no workers, whose `ParallelFor()` runs serially on the calling thread. Call
+  // NOTE: `ResetInstance()` in the child to run the kernels in parallel again.
+  static ThreadPool& instance(const bool does_pin_threads = false) { return *instance_ptr(does_pin_threads); }
+
+  // Replaces the pool shared by the kernels with the one of the number of the worker threads (e.g. 0 for no
+  // parallelism, or for measuring the scaling), whose workers are pinned if `does_pin_threads` is true.
+  // NOTE: This isn't thread-safe, so call this only while no kernel is running.
+  static void ResetInstance(const std::size_t num_threads, const bool does_pin_threads = false) {
+    instance_ptr(does_pin_threads) = std::make_unique<ThreadPool>(num_threads, does_pin_threads);
+  }
+
+ private:
+  using Task = std::function<void()>;
+
+  struct Worker {
+    std::mutex mutex;
+
+    std::deque<Task> tasks;
+
+    // NUMA node of the CPU which the worker is pinned to, or -1 if it isn't pinned.
+    int numa_node = -1;
+  };
+
+  // Gets the pointer to the pool shared by the kernels, which is created by the first call.
+  static std::unique_ptr<ThreadPool>& instance_ptr(const bool does_pin_threads) {
+    static std::unique_ptr<ThreadPool> instance_ptr = [does_pin_threads] {
+      pthread_atfork(nullptr, nullptr, &ThreadPool::ResetInstanceInChild);
+      return std::make_unique<ThreadPool>(std::max<std::size_t>(std::thread::hardware_concurrency(), 1) - 1,
+                                          does_pin_threads);
+    }();
+    return instance_ptr;
+  }
+
+  // Replaces the pool in the child process right after the fork, where its workers don't exist (and its mutexes may be
+  // locked by them), with the one of no workers. The old pool is leaked, since it can't be destroyed without them.
+  static void ResetInstanceInChild() {
+    std::unique_ptr<ThreadPool>& instance_ptr = ThreadPool::instance_ptr(false);
+    static_cast<void>(instance_ptr.release());
+    instance_ptr = std::make_unique<ThreadPool>(0);
+  }
+
+  // Number of the chunks per thread (including the calling thread) at most.
+  static constexpr std::size_t kNumChunksPerThread = 4;
+
+  // Number of the chunks which `ParallelFor()` splits the range of the size into.
+  const std::size_t NumChunks(const std::size_t size, const std::size_t grain_size) const {
+    return std::min((size + std::max<std::size_t>(grain_size, 1) - 1) / std::max<std::size_t>(grain_size, 1),
+                    (num_threads() + 1) * kNumChunksPerThread);
+  }
+
+  // Pops a task from the back of the deque of the worker, or steals one from the front of the deque of another.
+  const bool TryPopOrSteal(const std::size_t worker_index, Task& task) {
+    if (num_queued_tasks_.load(std::memory_order_acquire) == 0) {
+      return false;
+    }
+    for (std::size_t i = 0; i < worker_ptrs_.size(); ++i) {
+      Worker& worker = *worker_ptrs_[(worker_index + i) % worker_ptrs_.size()];
+      std::lock_guard<std::mutex> lock(worker.mutex);
+      if (worker.tasks.empty()) {
+        continue;
+      }
+      if (i == 0) {
+        task = std::move(worker.tasks.back());
+        worker.tasks.pop_back();
+      } else {
+        task = std::move(worker.tasks.front());
+        worker.tasks.pop_front();
+      }
+      num_queued_tasks_.fetch_sub(1, std::memory_order_acq_rel);
+      return true;
+    }
+    return false;
+  }
+
+  // Main loop of the worker thread.
+  void Run(const std::size_t worker_index) {
+    current_pool_ = this;
+    while (true) {
+      Task task;
+      if (TryPopOrSteal(worker_index, task)) {
+        task();
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(mutex_);
+      condition_variable_.wait(lock, [this] { return 0 < num_queued_tasks_.load() || is_stopping_; });
+      if (is_stopping_ && num_queued_tasks_.load() == 0) {
+        break;
+      }
+    }
+  }
+
+  // Pool whose worker (or helping caller) this thread is, which makes the nested `ParallelFor()` serial.
+  inline static thread_local const ThreadPool* current_pool_ = nullptr;
+
+  bool does_pin_threads_;
+
+  std::vector<std::unique_ptr<Worker>> worker_ptrs_;
+
+  // Number of the tasks in all of the deques (or about to be pushed into them), which is incremented under `mutex_`
+  // before the tasks are pushed, so that no notification is lost and it never underflows.
+  std::atomic<std::size_t> num_queued_tasks_;
+
+  std::mutex mutex_;
+
+  // Notified when tasks are queued and when the workers are stopped.
+  std::condition_variable condition_variable_;
+
+  bool is_stopping_;
+
+  std::vector<std::thread> threads_;
+};
+
+}  // namespace tensorward::util
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <xtensor/xarray.hpp>
+#include <xtensor/xbuilder.hpp>
+
+namespace tensorward::util {
+
+// Gather / scatter-add kernels for `function::GetItem` (and embedding-like lookups).
+//
+// Both of the element-wise indexing (`xt::xindex`, one element per index) and the leading-axis indexing (one row per
+// index) are reduced to "rows" of a flat buffer, where an element is a row whose size is 1. Then:
+//
+//   gather:      output[i, :] = input[rows[i], :]
+//   scatter-add: output[rows[i], :] += input[i, :]
+//
+// NOTE: The scatter-add is parallelized by partitioning the destination rows (not the source rows) among threads, so
+// NOTE: that each destination row is accumulated by a single thread in the same order as the sequential loop. That is,
+// NOTE: it needs neither locks nor atomics, and the result is deterministic even if the indices have duplicates.
+//
+// NOTE: The functions are `inline`, because this header is included by both of the headers and the sources (e.g.
+// NOTE: `core/parameter.cc`), which would define them more than once otherwise.
+
+namespace detail {
+
+// Minimum number of the accumulated elements to parallelize the scatter-add, because spawning threads costs more than
+// accumulating a small number of elements.
+constexpr std::size_t kParallelScatterAddMinNumElements = 1 << 16;
+
+inline const std::size_t NumScatterAddThreads(const std::size_t num_elements, const std::size_t num_dst_rows) {
+  if (num_elements < kParallelScatterAddMinNumElements) {
+    return 1;
+  }
+  const std::size_t hardware_concurrency = std::thread::hardware_concurrency();
+  return std::max<std::size_t>(std::min(hardware_concurrency, num_dst_rows), 1);
+}
+
+// Accumulates `src` rows into `dst` rows, which is the core of the scatter-add.
+inline void ScatterAddRows(const float* src, const std::vector<std::size_t>& dst_rows, const std::size_t row_size,
+                           const std::size_t num_dst_rows, float* dst) {
+  const std::size_t num_threads = NumScatterAddThreads(dst_rows.size() * row_size, num_dst_rows);
+
+  if (num_threads == 1) {
+    for (std::size_t i = 0; i < dst_rows.size(); ++i) {
+      const float* src_row = src + i * row_size;
+      float* dst_row = dst + dst_rows[i] * row_size;
+      for (std::size_t j = 0; j < row_size; ++j) {
+        dst_row[j] += src_row[j];
+      }
+    }
+    return;
+  }
+
+  // Buckets the source rows by the thread owning their destination row (with a counting sort), which keeps the order
+  // of the source rows within each destination row.
+  const auto owner_thread = [num_threads, num_dst_rows](const std::size_t dst_row) {
+    return dst_row * num_threads / num_dst_rows;
+  };
+  std::vector<std::size_t> bucket_offsets(num_threads + 1, 0);
+  for (const std::size_t dst_row : dst_rows) {
+    ++bucket_offsets[owner_thread(dst_row) + 1];
+  }
+  for (std::size_t t = 0; t < num_threads; ++t) {
+    bucket_offsets[t + 1] += bucket_offsets[t];
+  }
+  std::vector<std::size_t> sorted_src_rows(dst_rows.size());
+  std::vector<std::size_t> bucket_cursors(bucket_offsets.begin(), bucket_offsets.end() - 1);
+  for (std::size_t i = 0; i < dst_rows.size(); ++i) {
+    sorted_src_rows[bucket_cursors[owner_thread(dst_rows[i])]++] = i;
+  }
+
+  const auto accumulate_bucket = [&](const std::size_t t) {
+    for (std::size_t k = bucket_offsets[t]; k < bucket_offsets[t + 1]; ++k) {
+      const std::size_t i = sorted_src_rows[k];
+      const float* src_row = src + i * row_size;
+      float* dst_row = dst + dst_rows[i] * row_size;
+      for (std::size_t j = 0; j < row_size; ++j) {
+        dst_row[j] += src_row[j];
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads - 1);
+  for (std::size_t t = 1; t < num_threads; ++t) {
+    threads.emplace_back(accumulate_bucket, t);
+  }
+  accumulate_bucket(0);  // The calling thread takes the first bucket.
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+}  // namespace detail
+
+// Converts the (full) multi-dimensional indices into the flat offsets of the row-major data whose shape is `shape`.
+inline const std::vector<std::size_t> XtensorFlatOffsets(const xt::xarray<float>::shape_type& shape,
+                                                         const std::vector<xt::xindex>& indices) {
+  // strides = {shape[1] * shape[2] * ..., shape[2] * ..., ..., 1}
+  std::vector<std::size_t> strides(shape.size(), 1);
+  for (std::size_t axis = shape.size(); 1 < axis; --axis) {
+    strides[axis - 2] = strides[axis - 1] * shape[axis - 1];
+  }
+
+  std::vector<std::size_t> offsets;
+  offsets.reserve(indices.size());
+  for (const auto& index : indices) {
+    assert((static_cast<void>("Each index must have the same dimension as the shape."), index.size() == shape.size()));
+    std::size_t offset = 0;
+    for (std::size_t axis = 0; axis < index.size(); ++axis) {
+      assert(index[axis] < shape[axis]);
+      offset += index[axis] * strides[axis];
+    }
+    offsets.push_back(offset);
+  }
+
+  return offsets;
+}
+
+// Gathers the elements at the flat offsets.
+//
+//   input_data: {...} ---> output_data: {offsets.size()}
+//
+inline const xt::xarray<float> XtensorGather(const xt::xarray<float>& input_data,
+                                             const std::vector<std::size_t>& offsets) {
+  xt::xarray<float> output_data = xt::empty<float>({offsets.size()});
+  const float* input_pointer = input_data.data();
+  float* output_pointer = output_data.data();
+
+  for (std::size_t i = 0; i < offsets.size(); ++i) {
+    assert(offsets[i] < input_data.size());
+    output_pointer[i] = input_pointer[offsets[i]];
+  }
+
+  return output_data;
+}
+
+// Scatter-adds the elements into the flat offsets, which is the adjoint of `XtensorGather()`.
+//
+//   input_data: {offsets.size()} ---> output_data: output_shape
+//
+inline const xt::xarray<float> XtensorScatterAdd(const xt::xarray<float>& input_data,
+                                                 const std::vector<std::size_t>& offsets,
+                                                 const xt::xarray<float>::shape_type& output_shape) {
+  assert((static_cast<void>("`input_data.size()` must be `offsets.size()`."), input_data.size() == offsets.size()));
+
+  xt::xarray<float> output_data = xt::zeros<float>(output_shape);
+  detail::ScatterAddRows(input_data.data(), offsets, 1, output_data.size(), output_data.data());
+
+  return output_data;
+}
+
+// Gathers the rows (the sub-arrays along the leading axis) at the row indices.
+//
+//   input_data: {R, ...} ---> output_data: {row_indices.size(), ...}
+//
+inline const xt::xarray<float> XtensorGatherRows(const xt::xarray<float>& input_data,
+                                                 const std::vector<std::size_t>& row_indices) {
+  assert((static_cast<void>("`input_data.dimension()` must be greater than 0."), 0 < input_data.dimension()));
+
+  xt::xarray<float>::shape_type output_shape = input_data.shape();
+  output_shape[0] = row_indices.size();
+  const std::size_t row_size = input_data.size() / std::max<std::size_t>(input_data.shape(0), 1);
+
+  xt::xarray<float> output_data = xt::empty<float>(output_shape);
+  const float* input_pointer = input_data.data();
+  float* output_pointer = output_data.data();
+
+  for (std::size_t i = 0; i < row_indices.size(); ++i) {
+    assert(row_indices[i] < input_data.shape(0));
+    std::memcpy(output_pointer + i * row_size, input_pointer + row_indices[i] * row_size, row_size * sizeof(float));
+  }
+
+  return output_data;
+}
+
+// Scatter-adds the rows into the row indices, which is the adjoint of `XtensorGatherRows()`.
+//
+//   input_data: {row_indices.size(), ...} ---> output_data: output_shape = {R, ...}
+//
+inline const xt::xarray<float> XtensorScatterAddRows(const xt::xarray<float>& input_data,
+                                                     const std::vector<std::size_t>& row_indices,
+                                                     const xt::xarray<float>::shape_type& output_shape) {
+  assert((static_cast<void>("`output_shape.size()` must be greater than 0."), 0 < output_shape.size()));
+  assert((static_cast<void>("`input_data.shape(0)` must be `row_indices.size()`."),
+          input_data.dimension() == output_shape.size() && input_data.shape(0) == row_indices.size()));
+
+  xt::xarray<float> output_data = xt::zeros<float>(output_shape);
+  const std::size_t num_rows = output_shape[0];
+  const std::size_t row_size = output_data.size() / std::max<std::size_t>(num_rows, 1);
+  detail::ScatterAddRows(input_data.data(), row_indices, row_size, num_rows, output_data.data());
+
+  return output_data;
+}
+
+}  // namespace tensorward::util
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cassert>
+
+#include <xtensor/xarray.hpp>
+
+namespace tensorward::util {
+
+inline const std::size_t ConvOutputSize(const std::size_t input_size, const std::size_t kernel_size,
+                                        const std::size_t stride, const std::size_t pad) {
+  assert((static_cast<void>("The kernel must fit in the padded input."), kernel_size <= input_size + 2 * pad));
+  return (input_size + 2 * pad - kernel_size) / stride + 1;
+}
+
+// Unfolds every receptive field of the input image into a row, so that the convolution becomes a single GEMM.
+//
+//   input_data: {N, C, H, W} ---> output_data: {N * OH * OW, C * KH * KW}
+//
+inline const xt::xarray<float> XtensorIm2col(const xt::xarray<float>& input_data, const std::size_t kernel_height,
+                                             const std::size_t kernel_width, const std::size_t stride,
+                                             const std::size_t pad) {
+  assert((static_cast<void>("`input_data.dimension()` must be 4 {N, C, H, W}."), input_data.dimension() == 4));
+
+  const std::size_t N = input_data.shape(0);
+  const std::size_t C = input_data.shape(1);
+  const std::size_t H = input_data.shape(2);
+  const std::size_t W = input_data.shape(3);
+  const std::size_t OH = ConvOutputSize(H, kernel_height, stride, pad);
+  const std::size_t OW = ConvOutputSize(W, kernel_width, stride, pad);
+
+  xt::xarray<float> output_data = xt::zeros<float>({N * OH * OW, C * kernel_height * kernel_width});
+  const float* input_pointer = input_data.data();
+  float* output_pointer = output_data.data();
+
+  for (std::size_t n = 0; n < N; ++n) {
+    for (std::size_t oh = 0; oh < OH; ++oh) {
+      for (std::size_t ow = 0; ow < OW; ++ow) {
+        float* row_pointer = output_pointer + ((n * OH + oh) * OW + ow) * (C * kernel_height * kernel_width);
+        for (std::size_t c = 0; c < C; ++c) {
+          for (std::size_t kh = 0; kh < kernel_height; ++kh) {
+            // Uses a signed integer because the padded position can be negative.
+            const long h = static_cast<long>(oh * stride + kh) - static_cast<long>(pad);
+            for (std::size_t kw = 0; kw < kernel_width; ++kw) {
+              const long w = static_cast<long>(ow * stride + kw) - static_cast<long>(pad);
+              const bool is_inside = (0 <= h && h < static_cast<long>(H) && 0 <= w && w < static_cast<long>(W));
+              row_pointer[(c * kernel_height + kh) * kernel_width + kw] =
+                  is_inside ? input_pointer[((n * C + c) * H + h) * W + w] : 0.0;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  return output_data;
+}
+
+// Folds the rows back into the image, which is the adjoint of `XtensorIm2col()` (overlapping fields are accumulated).
+//
+//   input_data: {N * OH * OW, C * KH * KW} ---> output_data: {N, C, H, W}
+//
+inline const xt::xarray<float> XtensorCol2im(const xt::xarray<float>& input_data,
+                                             const xt::xarray<float>::shape_type& output_shape,
+                                             const std::size_t kernel_height, const std::size_t kernel_width,
+                                             const std::size_t stride, const std::size_t pad) {
+  assert((static_cast<void>("`output_shape.size()` must be 4 {N, C, H, W}."), output_shape.size() == 4));
+
+  const std::size_t N = output_shape[0];
+  const std::size_t C = output_shape[1];
+  const std::size_t H = output_shape[2];
+  const std::size_t W = output_shape[3];
+  const std::size_t OH = ConvOutputSize(H, kernel_height, stride, pad);
+  const std::size_t OW = ConvOutputSize(W, kernel_width, stride, pad);
+  assert(input_data.dimension() == 2);
+  assert(input_data.shape(0) == N * OH * OW);
+  assert(input_data.shape(1) == C * kernel_height * kernel_width);
+
+  xt::xarray<float> output_data = xt::zeros<float>(output_shape);
+  const float* input_pointer = input_data.data();
+  float* output_pointer = output_data.data();
+
+  for (std::size_t n = 0; n < N; ++n) {
+    for (std::size_t oh = 0; oh < OH; ++oh) {
+      for (std::size_t ow = 0; ow < OW; ++ow) {
+        const float* row_pointer = input_pointer + ((n * OH + oh) * OW + ow) * (C * kernel_height * kernel_width);
+        for (std::size_t c = 0; c < C; ++c) {
+          for (std::size_t kh = 0; kh < kernel_height; ++kh) {
+            const long h = static_cast<long>(oh * stride + kh) - static_cast<long>(pad);
+            if (h < 0 || static_cast<long>(H) <= h) {
+              continue;
+            }
+            for (std::size_t kw = 0; kw < kernel_width; ++kw) {
+              const long w = static_cast<long>(ow * stride + kw) - static_cast<long>(pad);
+              if (w < 0 || static_cast<long>(W) <= w) {
+                continue;
+              }
+              const std::size_t column = (c * kernel_height + kh) * kernel_width + kw;
+              output_pointer[((n * C + c) * H + h) * W + w] += row_pointer[column];
+            }
+          }
+        }
+      }
+    }
+  }
+
+  return output_data;
+}
+
+}  // namespace tensorward::util
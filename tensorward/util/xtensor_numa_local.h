@@ -0,0 +1,59 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+
+#include <xtensor/xarray.hpp>
+#include <xtensor/xbuilder.hpp>
+
+#include "tensorward/util/thread_pool.h"
+
+namespace tensorward::util {
+
+// Copies the data into the storage placed on the NUMA nodes of the threads which process its chunks in the parallel
+// kernels, if `does_use_numa_local_placement` is true (e.g. `Config::kDoesUseNumaLocalPlacement`) and the data is large
+// enough to be processed in parallel. Each chunk is bound to the node of its thread (see
+// `ThreadPool::BindChunksToNumaNodes()`), and copied by the thread itself, so it's placed on the node by the first
+// touch even without `mbind()`. Otherwise, it's a plain copy.
+// NOTE: This returns the non-const array, so that it can be moved into a tensor without another (serial) copy.
+// NOTE: The workers of the pool shared by the kernels must be pinned, since the first touch by an unpinned worker
+// NOTE: can place a chunk on any node. They are pinned if this creates the pool (see `ThreadPool::instance()`), but
+// NOTE: the pool created before without the pinning (e.g. by a kernel) has to be replaced by
+// NOTE: `ThreadPool::ResetInstance(num_threads, true)`. It's asserted, and it's a plain copy in the release build.
+inline xt::xarray<float> XtensorCopyNumaLocal(const xt::xarray<float>& data,
+                                               const bool does_use_numa_local_placement) {
+  if (data.size() < 2 * kDefaultGrainSize || !does_use_numa_local_placement) {
+    return data;
+  }
+  ThreadPool& thread_pool = ThreadPool::instance(true);
+  if (thread_pool.num_threads() == 0) {
+    return data;
+  }
+  assert((static_cast<void>("The workers of the thread pool must be pinned for the NUMA-local placement."),
+          thread_pool.does_pin_threads()));
+  if (!thread_pool.does_pin_threads()) {
+    return data;
+  }
+
+  xt::xarray<float> copied_data = xt::empty<float>(data.shape());
+  thread_pool.BindChunksToNumaNodes(copied_data.data(), sizeof(float), copied_data.size(), kDefaultGrainSize);
+  const float* source_pointer = data.data();
+  float* destination_pointer = copied_data.data();
+  thread_pool.ParallelFor(0, data.size(), kDefaultGrainSize, [&](const std::size_t begin, const std::size_t end) {
+    std::copy(source_pointer + begin, source_pointer + end, destination_pointer + begin);
+  });
+  return copied_data;
+}
+
+// Migrates the pages of the data (e.g. written by a single thread) to the NUMA nodes of the threads which process its
+// chunks in the parallel kernels in place. Returns whether any page is migrated (false if the workers of the pool
+// aren't pinned or the data is too small to be processed in parallel).
+inline const bool XtensorBindToNumaNodes(xt::xarray<float>& data) {
+  if (data.size() < 2 * kDefaultGrainSize) {
+    return false;
+  }
+  return ThreadPool::instance().BindChunksToNumaNodes(data.data(), sizeof(float), data.size(), kDefaultGrainSize);
+}
+
+}  // namespace tensorward::util
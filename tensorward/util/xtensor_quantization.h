@@ -0,0 +1,202 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include <xtensor/xarray.hpp>
+#include <xtensor/xbuilder.hpp>
+
+namespace tensorward::util {
+
+// Symmetric int8 quantization for the inference, where a float value "x" is represented by an int8 value "q" and a
+// float scale "s" (without zero point):
+//
+//   q = clamp(round(x / s), -127, 127)  <--->  x ~= s * q
+//
+// The weight of a linear layer is quantized per output channel (i.e. a scale for each column of W {in_size, out_size}),
+// and the activation is quantized per tensor with the scale calibrated in advance (e.g. from the max absolute value).
+//
+// NOTE: -128 is not used, so that the range is symmetric and the negation never overflows.
+
+constexpr int kInt8Max = 127;
+
+// Weight (and bias) of a linear layer quantized per output channel.
+struct Int8Linear {
+  std::size_t in_size;
+
+  std::size_t out_size;
+
+  // Quantized weight transposed to {out_size, in_size}, so that the weight of each output channel is contiguous in the
+  // inner loop of the GEMM.
+  std::vector<std::int8_t> W_transposed;
+
+  // Scale of the weight for each output channel {out_size}.
+  std::vector<float> W_scales;
+
+  // Bias in float {out_size}, which is added after the dequantization of the int32 accumulator.
+  std::vector<float> b;
+};
+
+namespace detail {
+
+inline const std::int8_t QuantizeToInt8(const float value, const float inverse_scale) {
+  const float rounded_value = std::nearbyint(value * inverse_scale);
+  constexpr float kLowerBound = -kInt8Max;
+  constexpr float kUpperBound = kInt8Max;
+  return static_cast<std::int8_t>(std::clamp(rounded_value, kLowerBound, kUpperBound));
+}
+
+// Number of the rows of the activation which share a pass over the weight in the GEMM, so that the weight is loaded
+// from memory once for every `kInt8GemmRowBlockSize` rows (instead of every row).
+constexpr std::size_t kInt8GemmRowBlockSize = 4;
+
+// Computes the int32 accumulators of (up to `kInt8GemmRowBlockSize`) rows of the activation and all of the output
+// channels.
+//
+//   accumulators[n, o] = sum_i(x_rows[n, i] * W_transposed[o, i])
+//
+inline void Int8DotRows(const std::int8_t* x_rows, const std::size_t num_rows, const Int8Linear& linear,
+                        std::int32_t* accumulators) {
+  assert(num_rows <= kInt8GemmRowBlockSize);
+  for (std::size_t o = 0; o < linear.out_size; ++o) {
+    const std::int8_t* W_row = linear.W_transposed.data() + o * linear.in_size;
+    for (std::size_t n = 0; n < num_rows; ++n) {
+      const std::int8_t* x_row = x_rows + n * linear.in_size;
+      // NOTE: The products are accumulated in int32 (not in int8 or int16), which never overflows as long as
+      // NOTE: `in_size` < 2^31 / 127^2 (~ 133,000).
+      std::int32_t accumulator = 0;
+      for (std::size_t i = 0; i < linear.in_size; ++i) {
+        accumulator += static_cast<std::int32_t>(x_row[i]) * static_cast<std::int32_t>(W_row[i]);
+      }
+      accumulators[n * linear.out_size + o] = accumulator;
+    }
+  }
+}
+
+}  // namespace detail
+
+// Computes the scale from the max absolute value of the data to be quantized.
+inline const float Int8Scale(const float max_abs_value) {
+  return (0.0 < max_abs_value) ? max_abs_value / kInt8Max : 1.0;
+}
+
+// Quantizes the weight {in_size, out_size} per output channel, and keeps the bias {out_size} in float. If `b_opt` has
+// no value (i.e. the linear layer doesn't use bias), then the bias is zero.
+inline const Int8Linear XtensorQuantizeLinear(const xt::xarray<float>& W,
+                                              const std::optional<xt::xarray<float>>& b_opt = std::nullopt) {
+  assert((static_cast<void>("`W.dimension()` must be 2 {in_size, out_size}."), W.dimension() == 2));
+
+  Int8Linear linear;
+  linear.in_size = W.shape(0);
+  linear.out_size = W.shape(1);
+  linear.W_transposed.resize(linear.in_size * linear.out_size);
+  linear.W_scales.resize(linear.out_size);
+  linear.b.assign(linear.out_size, 0.0);
+
+  for (std::size_t o = 0; o < linear.out_size; ++o) {
+    float max_abs_value = 0.0;
+    for (std::size_t i = 0; i < linear.in_size; ++i) {
+      max_abs_value = std::max(max_abs_value, std::abs(W(i, o)));
+    }
+    linear.W_scales[o] = Int8Scale(max_abs_value);
+
+    const float inverse_scale = 1.0 / linear.W_scales[o];
+    for (std::size_t i = 0; i < linear.in_size; ++i) {
+      linear.W_transposed[o * linear.in_size + i] = detail::QuantizeToInt8(W(i, o), inverse_scale);
+    }
+  }
+
+  if (b_opt.has_value()) {
+    const xt::xarray<float>& b = b_opt.value();
+    assert((static_cast<void>("`b.size()` must be `out_size`."), b.size() == linear.out_size));
+    std::copy(b.data(), b.data() + b.size(), linear.b.begin());
+  }
+
+  return linear;
+}
+
+// Quantizes the data with the scale (per tensor).
+inline const std::vector<std::int8_t> XtensorQuantizeInt8(const xt::xarray<float>& data, const float scale) {
+  const float inverse_scale = 1.0 / scale;
+  std::vector<std::int8_t> quantized_data(data.size());
+  const float* data_pointer = data.data();
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    quantized_data[i] = detail::QuantizeToInt8(data_pointer[i], inverse_scale);
+  }
+  return quantized_data;
+}
+
+// Int8 GEMM followed by the requantization for the next layer, optionally fused with ReLU:
+//
+//   y[n, o] = x_scale * W_scales[o] * sum_i(x_q[n, i] * W_q[o, i]) + b[o]  (int32 accumulation)
+//   y_q[n, o] = clamp(round(y[n, o] / y_scale), 0 (ReLU) or -127, 127)
+//
+//   x_q: {N, in_size} ---> y_q: {N, out_size}
+//
+// NOTE: Fusing ReLU into the requantization is free, because it's just the lower bound of the clamp.
+inline const std::vector<std::int8_t> Int8LinearRequantize(const std::vector<std::int8_t>& x_q, const float x_scale,
+                                                           const Int8Linear& linear, const float y_scale,
+                                                           const bool does_apply_relu) {
+  assert((static_cast<void>("`x_q.size()` must be a multiple of `in_size`."), x_q.size() % linear.in_size == 0));
+  const std::size_t N = x_q.size() / linear.in_size;
+
+  // Folds all of the scales into a multiplier for each output channel in advance.
+  std::vector<float> multipliers(linear.out_size);
+  std::vector<float> offsets(linear.out_size);
+  for (std::size_t o = 0; o < linear.out_size; ++o) {
+    multipliers[o] = x_scale * linear.W_scales[o] / y_scale;
+    offsets[o] = linear.b[o] / y_scale;
+  }
+  const float lower_bound = does_apply_relu ? 0.0 : -kInt8Max;
+  const float upper_bound = kInt8Max;
+
+  std::vector<std::int8_t> y_q(N * linear.out_size);
+  std::vector<std::int32_t> accumulators(detail::kInt8GemmRowBlockSize * linear.out_size);
+  for (std::size_t n0 = 0; n0 < N; n0 += detail::kInt8GemmRowBlockSize) {
+    const std::size_t num_rows = std::min(detail::kInt8GemmRowBlockSize, N - n0);
+    detail::Int8DotRows(x_q.data() + n0 * linear.in_size, num_rows, linear, accumulators.data());
+    for (std::size_t k = 0; k < num_rows * linear.out_size; ++k) {
+      const std::size_t o = k % linear.out_size;
+      const float rounded_value = std::nearbyint(multipliers[o] * accumulators[k] + offsets[o]);
+      y_q[n0 * linear.out_size + k] = static_cast<std::int8_t>(std::clamp(rounded_value, lower_bound, upper_bound));
+    }
+  }
+
+  return y_q;
+}
+
+// Int8 GEMM followed by the dequantization into float (e.g. for the last layer, or for the activation function which
+// is not fused into the requantization).
+//
+//   x_q: {N, in_size} ---> y: {N, out_size}
+//
+inline const xt::xarray<float> Int8LinearDequantize(const std::vector<std::int8_t>& x_q, const float x_scale,
+                                                    const Int8Linear& linear) {
+  assert((static_cast<void>("`x_q.size()` must be a multiple of `in_size`."), x_q.size() % linear.in_size == 0));
+  const std::size_t N = x_q.size() / linear.in_size;
+
+  std::vector<float> multipliers(linear.out_size);
+  for (std::size_t o = 0; o < linear.out_size; ++o) {
+    multipliers[o] = x_scale * linear.W_scales[o];
+  }
+
+  xt::xarray<float> y = xt::empty<float>({N, linear.out_size});
+  std::vector<std::int32_t> accumulators(detail::kInt8GemmRowBlockSize * linear.out_size);
+  for (std::size_t n0 = 0; n0 < N; n0 += detail::kInt8GemmRowBlockSize) {
+    const std::size_t num_rows = std::min(detail::kInt8GemmRowBlockSize, N - n0);
+    detail::Int8DotRows(x_q.data() + n0 * linear.in_size, num_rows, linear, accumulators.data());
+    float* y_rows = y.data() + n0 * linear.out_size;
+    for (std::size_t k = 0; k < num_rows * linear.out_size; ++k) {
+      const std::size_t o = k % linear.out_size;
+      y_rows[k] = multipliers[o] * accumulators[k] + linear.b[o];
+    }
+  }
+
+  return y;
+}
+
+}  // namespace tensorward::util
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <type_traits>
+
+#include <xtensor/xadapt.hpp>
+#include <xtensor/xarray.hpp>
+#include <xtensor/xbuilder.hpp>
+#include <xtensor/xnoalias.hpp>
+
+#include "tensorward/util/thread_pool.h"
+
+namespace tensorward::util {
+
+// Max rank which `XtensorEvaluateWithRank()` is specialized for. The higher ranks fall back to the dynamic rank.
+constexpr std::size_t kMaxSpecializedRank = 4;
+
+// Views the data as a tensor of the static rank `N` without copying it, whose shape and strides are `std::array`
+// instead of `xt::svector` (as `xt::xtensor<float, N>`), so the expressions on it don't have the dynamic-rank
+// bookkeeping (e.g. the broadcasting of the shapes of the dynamic ranks and the dynamic loops of the steppers).
+// NOTE: `data.dimension()` must be `N`.
+template <std::size_t N>
+auto XtensorAsRank(const xt::xarray<float>& data) {
+  assert((static_cast<void>("`data.dimension()` must be the rank."), data.dimension() == N));
+  std::array<std::size_t, N> shape;
+  std::copy(data.shape().begin(), data.shape().end(), shape.begin());
+  return xt::adapt(data.data(), data.size(), xt::no_ownership(), shape);
+}
+
+template <std::size_t N>
+auto XtensorAsRank(xt::xarray<float>& data) {
+  assert((static_cast<void>("`data.dimension()` must be the rank."), data.dimension() == N));
+  std::array<std::size_t, N> shape;
+  std::copy(data.shape().begin(), data.shape().end(), shape.begin());
+  return xt::adapt(data.data(), data.size(), xt::no_ownership(), shape);
+}
+
+// Views the elements [begin, end) of the flattened data as a 1-D tensor without copying it (e.g. a chunk of a parallel
+// elementwise kernel).
+template <class Data>
+auto XtensorAsChunk(Data& data, const std::size_t begin, const std::size_t end) {
+  return xt::adapt(data.data() + begin, end - begin, xt::no_ownership(), std::array<std::size_t, 1>({end - begin}));
+}
+
+namespace detail {
+
+template <std::size_t N, class ExpressionBuilder, class... Inputs>
+void XtensorAssignWithRank(xt::xarray<float>& y, ExpressionBuilder&& expression_builder, const Inputs&... inputs) {
+  auto y_view = XtensorAsRank<N>(y);
+  xt::noalias(y_view) = expression_builder(XtensorAsRank<N>(inputs)...);
+}
+
+}  // namespace detail
+
+// Evaluates the expression built by `expression_builder` from the inputs into an array of the shape (e.g.
+// `[](const auto& x) { return xt::exp(x); }`). If all of the inputs have the same shape as the output (whose rank is
+// up to `kMaxSpecializedRank`), then the expression is built from the static-rank views of them (see
+// `XtensorAsRank()`), and evaluated into the static-rank view of the output. Otherwise (e.g. the broadcasting), it's
+// built from the inputs themselves, and the output is resized to the broadcasted shape.
+//
+// If all of the inputs have the same shape as the output and it has at least 2x `kDefaultGrainSize` elements, then the
+// flattened arrays are split into chunks (see `XtensorAsChunk()`), whose expressions are evaluated in parallel by
+// `ThreadPool::instance()`.
+// NOTE: `expression_builder` is instantiated for each rank, so it must be a generic lambda (or a function object).
+// NOTE: The expression must be elementwise (e.g. not `xt::sum()`), and `expression_builder` must be thread-safe.
+template <class ExpressionBuilder, class... Inputs>
+const xt::xarray<float> XtensorEvaluateWithRank(const xt::xarray<float>::shape_type& shape,
+                                                ExpressionBuilder&& expression_builder, const Inputs&... inputs) {
+  static_assert((std::is_same_v<Inputs, xt::xarray<float>> && ...), "All of the inputs must be `xt::xarray<float>`.");
+
+  xt::xarray<float> y = xt::empty<float>(shape);
+  const std::size_t rank = shape.size();
+  const bool is_same_shape = ((inputs.shape() == shape) && ...);
+  ThreadPool& thread_pool = ThreadPool::instance();
+  if (is_same_shape && 2 * kDefaultGrainSize <= y.size() && 0 < thread_pool.num_threads()) {
+    thread_pool.ParallelFor(0, y.size(), kDefaultGrainSize, [&](const std::size_t begin, const std::size_t end) {
+      auto y_chunk = XtensorAsChunk(y, begin, end);
+      xt::noalias(y_chunk) = expression_builder(XtensorAsChunk(inputs, begin, end)...);
+    });
+  } else if (is_same_shape && rank == 1) {
+    detail::XtensorAssignWithRank<1>(y, expression_builder, inputs...);
+  } else if (is_same_shape && rank == 2) {
+    detail::XtensorAssignWithRank<2>(y, expression_builder, inputs...);
+  } else if (is_same_shape && rank == 3) {
+    detail::XtensorAssignWithRank<3>(y, expression_builder, inputs...);
+  } else if (is_same_shape && rank == kMaxSpecializedRank) {
+    detail::XtensorAssignWithRank<kMaxSpecializedRank>(y, expression_builder, inputs...);
+  } else {
+    xt::noalias(y) = expression_builder(inputs...);
+  }
+
+  return y;
+}
+
+}  // namespace tensorward::util
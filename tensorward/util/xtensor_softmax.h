@@ -1,10 +1,43 @@
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+
 #include <xtensor/xarray.hpp>
+#include <xtensor/xbuilder.hpp>
+
+#include "tensorward/util/thread_pool.h"
 
 namespace tensorward::util {
 
 const xt::xarray<float> XtensorSoftmax(const xt::xarray<float>& input_data) {
+  // Calculates the rows (along with the last axis) of the large input in parallel, each of which is calculated in the
+  // same steps as below but in a single pass over the row.
+  if (1 <= input_data.dimension() && 2 * kDefaultGrainSize <= input_data.size()) {
+    xt::xarray<float> output_data = xt::empty<float>(input_data.shape());
+    const std::size_t row_size = input_data.shape().back();
+    const float* input_pointer = input_data.data();
+    float* output_pointer = output_data.data();
+    ThreadPool::instance().ParallelFor(
+        0, input_data.size() / row_size, (kDefaultGrainSize + row_size - 1) / row_size,
+        [&](const std::size_t begin, const std::size_t end) {
+          for (std::size_t r = begin; r < end; ++r) {
+            const float* x = input_pointer + r * row_size;
+            float* y = output_pointer + r * row_size;
+            const float max_x = *std::max_element(x, x + row_size);
+            float sum_exp_x = 0.0;
+            for (std::size_t i = 0; i < row_size; ++i) {
+              y[i] = std::exp(x[i] - max_x);
+              sum_exp_x += y[i];
+            }
+            for (std::size_t i = 0; i < row_size; ++i) {
+              y[i] /= sum_exp_x;
+            }
+          }
+        });
+    return output_data;
+  }
+
   // Subtracts the max element along with the last axis from the input data in order to avoid overflow when `exp()`.
   const xt::xarray<float> max_input_data = xt::amax(input_data, {-1}, xt::keep_dims);
   const xt::xarray<float> modified_input_data = input_data - max_input_data;
@@ -1,9 +1,13 @@
 #pragma once
 
 #include <cassert>
+#include <functional>
 #include <numeric>
 
 #include <xtensor/xarray.hpp>
+#include <xtensor/xbuilder.hpp>
+
+#include "tensorward/util/thread_pool.h"
 
 namespace tensorward::util {
 
@@ -32,6 +36,31 @@ const xt::xarray<float> XtensorSumTo(const xt::xarray<float>& input_data,
     }
   }
 
+  // Sums up only the leading axes (e.g. the gradient of a bias over a batch) of the large input in parallel over the
+  // chunks of the output elements, each of which is summed up in the order of the rows, so that the result doesn't
+  // depend on the number of the threads.
+  //
+  //   input: {R, C} (flattened leading axes, flattened output axes) ---> output: {C}
+  //
+  if (non_squeeze_axes.empty() && 2 * kDefaultGrainSize <= input_data.size()) {
+    xt::xarray<float> output_data = xt::zeros<float>(output_shape);
+    const std::size_t output_size = output_data.size();
+    const std::size_t num_rows = input_data.size() / output_size;
+    const float* input_pointer = input_data.data();
+    float* output_pointer = output_data.data();
+    ThreadPool::instance().ParallelFor(
+        0, output_size, (kDefaultGrainSize + num_rows - 1) / num_rows,
+        [&](const std::size_t begin, const std::size_t end) {
+          for (std::size_t r = 0; r < num_rows; ++r) {
+            const float* input_row = input_pointer + r * output_size;
+            for (std::size_t c = begin; c < end; ++c) {
+              output_pointer[c] += input_row[c];
+            }
+          }
+        });
+    return output_data;
+  }
+
   // sum_axes = Concat(squeeze_axes, non_squeeze_axes)
   xt::xarray<float>::shape_type sum_axes;
   sum_axes.insert(sum_axes.end(), squeeze_axes.begin(), squeeze_axes.end());
@@ -0,0 +1,255 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+#include <xtensor/xarray.hpp>
+#include <xtensor-blas/xlinalg.hpp>
+
+#include "tensorward/util/xtensor_im2col.h"
+
+namespace tensorward::util {
+
+// Winograd minimal filtering F(m x m, 3 x 3) (Lavin & Gray, "Fast Algorithms for Convolutional Neural Networks").
+//
+// Each m x m output tile is computed from an alpha x alpha input tile (alpha = m + 2) as:
+//
+//   Y = A^T [ (G g G^T) (.) (B^T d B) ] A
+//
+// where (.) is the element-wise product, so that a tile costs alpha^2 multiplications instead of m^2 * 9.
+// Summing over the input channels turns the element-wise products into alpha^2 independent GEMMs of {K, C} x {C, P}.
+//
+// NOTE: Only 3x3 kernels with stride 1 are eligible.
+
+struct WinogradFilter {
+  // Output tile size "m", which is either 2 (alpha = 4) or 4 (alpha = 6).
+  std::size_t output_tile_size;
+
+  // Transformed filter "G g G^T" split into alpha^2 matrices whose shape is {K, C}.
+  std::vector<xt::xarray<float>> transformed_filters;
+};
+
+namespace detail {
+
+constexpr std::size_t kWinogradKernelSize = 3;
+
+// clang-format off
+// F(2x2, 3x3)
+constexpr float kWinogradBT2[4 * 4] = {
+  1.0,  0.0, -1.0,  0.0,
+  0.0,  1.0,  1.0,  0.0,
+  0.0, -1.0,  1.0,  0.0,
+  0.0,  1.0,  0.0, -1.0,
+};
+constexpr float kWinogradG2[4 * 3] = {
+  1.0,  0.0, 0.0,
+  0.5,  0.5, 0.5,
+  0.5, -0.5, 0.5,
+  0.0,  0.0, 1.0,
+};
+constexpr float kWinogradAT2[2 * 4] = {
+  1.0, 1.0,  1.0,  0.0,
+  0.0, 1.0, -1.0, -1.0,
+};
+
+// F(4x4, 3x3)
+constexpr float kWinogradBT4[6 * 6] = {
+  4.0,  0.0, -5.0,  0.0, 1.0, 0.0,
+  0.0, -4.0, -4.0,  1.0, 1.0, 0.0,
+  0.0,  4.0, -4.0, -1.0, 1.0, 0.0,
+  0.0, -2.0, -1.0,  2.0, 1.0, 0.0,
+  0.0,  2.0, -1.0, -2.0, 1.0, 0.0,
+  0.0,  4.0,  0.0, -5.0, 0.0, 1.0,
+};
+constexpr float kWinogradG4[6 * 3] = {
+   1.0 / 4.0,   0.0,         0.0,
+  -1.0 / 6.0,  -1.0 / 6.0,  -1.0 / 6.0,
+  -1.0 / 6.0,   1.0 / 6.0,  -1.0 / 6.0,
+   1.0 / 24.0,  1.0 / 12.0,  1.0 / 6.0,
+   1.0 / 24.0, -1.0 / 12.0,  1.0 / 6.0,
+   0.0,         0.0,         1.0,
+};
+constexpr float kWinogradAT4[4 * 6] = {
+  1.0, 1.0,  1.0, 1.0,  1.0, 0.0,
+  0.0, 1.0, -1.0, 2.0, -2.0, 0.0,
+  0.0, 1.0,  1.0, 4.0,  4.0, 0.0,
+  0.0, 1.0, -1.0, 8.0, -8.0, 1.0,
+};
+// clang-format on
+
+// Computes `output = lhs rhs^T` for small row-major matrices, where lhs: {rows, inner} and rhs: {cols, inner}.
+inline void MultiplyByTransposed(const float* lhs, const float* rhs, const std::size_t rows, const std::size_t inner,
+                                 const std::size_t cols, float* output) {
+  for (std::size_t i = 0; i < rows; ++i) {
+    for (std::size_t j = 0; j < cols; ++j) {
+      float sum = 0.0;
+      for (std::size_t k = 0; k < inner; ++k) {
+        sum += lhs[i * inner + k] * rhs[j * inner + k];
+      }
+      output[i * cols + j] = sum;
+    }
+  }
+}
+
+// Computes `output = M X M^T` for small row-major matrices, where M: {rows, inner} and X: {inner, inner}.
+// All of the three Winograd transforms have this form (G g G^T, B^T d B, A^T m A).
+inline void SandwichTransform(const float* M, const float* X, const std::size_t rows, const std::size_t inner,
+                              float* output) {
+  float X_transposed[6 * 6];
+  for (std::size_t i = 0; i < inner; ++i) {
+    for (std::size_t j = 0; j < inner; ++j) {
+      X_transposed[j * inner + i] = X[i * inner + j];
+    }
+  }
+  float MX[6 * 6];
+  MultiplyByTransposed(M, X_transposed, rows, inner, inner, MX);  // M X: {rows, inner}
+  MultiplyByTransposed(MX, M, rows, inner, rows, output);         // (M X) M^T: {rows, rows}
+}
+
+}  // namespace detail
+
+inline const bool IsWinogradEligible(const xt::xarray<float>::shape_type& kernel_shape, const std::size_t stride) {
+  return kernel_shape.size() == 4 && kernel_shape[2] == detail::kWinogradKernelSize &&
+         kernel_shape[3] == detail::kWinogradKernelSize && stride == 1;
+}
+
+// Chooses F(4x4, 3x3) for feature maps large enough to fill its tiles, and F(2x2, 3x3) otherwise, because F(4x4, 3x3)
+// reduces more multiplications (4.0x vs 2.25x) but wastes more of them on partially filled tiles.
+inline const std::size_t SelectWinogradOutputTileSize(const std::size_t output_height, const std::size_t output_width) {
+  return (8 <= std::min(output_height, output_width)) ? 4 : 2;
+}
+
+// Transforms the filter W: {K, C, 3, 3} into "G W G^T", which only depends on W so that it can be cached.
+inline const WinogradFilter XtensorWinogradFilterTransform(const xt::xarray<float>& kernel,
+                                                           const std::size_t output_tile_size) {
+  assert((static_cast<void>("`output_tile_size` must be 2 or 4."), output_tile_size == 2 || output_tile_size == 4));
+  assert(IsWinogradEligible(kernel.shape(), 1));
+
+  const std::size_t alpha = output_tile_size + detail::kWinogradKernelSize - 1;
+  const float* G = (output_tile_size == 2) ? detail::kWinogradG2 : detail::kWinogradG4;
+
+  const std::size_t K = kernel.shape(0);
+  const std::size_t C = kernel.shape(1);
+
+  WinogradFilter winograd_filter;
+  winograd_filter.output_tile_size = output_tile_size;
+  winograd_filter.transformed_filters.reserve(alpha * alpha);
+  for (std::size_t i = 0; i < alpha * alpha; ++i) {
+    winograd_filter.transformed_filters.push_back(xt::zeros<float>({K, C}));
+  }
+
+  const float* kernel_pointer = kernel.data();
+  float transformed_tile[6 * 6];
+  for (std::size_t k = 0; k < K; ++k) {
+    for (std::size_t c = 0; c < C; ++c) {
+      const float* g = kernel_pointer + (k * C + c) * detail::kWinogradKernelSize * detail::kWinogradKernelSize;
+      detail::SandwichTransform(G, g, alpha, detail::kWinogradKernelSize, transformed_tile);  // G g G^T
+      for (std::size_t i = 0; i < alpha * alpha; ++i) {
+        winograd_filter.transformed_filters[i](k, c) = transformed_tile[i];
+      }
+    }
+  }
+
+  return winograd_filter;
+}
+
+// Computes the 3x3, stride 1 convolution (cross-correlation) of x: {N, C, H, W} with the pre-transformed filter.
+//
+//   input_data: {N, C, H, W} ---> output_data: {N, K, OH, OW}
+//
+inline const xt::xarray<float> XtensorWinogradConv2d(const xt::xarray<float>& input_data,
+                                                     const WinogradFilter& winograd_filter, const std::size_t pad) {
+  assert((static_cast<void>("`input_data.dimension()` must be 4 {N, C, H, W}."), input_data.dimension() == 4));
+
+  const std::size_t m = winograd_filter.output_tile_size;
+  const std::size_t alpha = m + detail::kWinogradKernelSize - 1;
+  const float* BT = (m == 2) ? detail::kWinogradBT2 : detail::kWinogradBT4;
+  const float* AT = (m == 2) ? detail::kWinogradAT2 : detail::kWinogradAT4;
+  assert(winograd_filter.transformed_filters.size() == alpha * alpha);
+
+  const std::size_t N = input_data.shape(0);
+  const std::size_t C = input_data.shape(1);
+  const std::size_t H = input_data.shape(2);
+  const std::size_t W = input_data.shape(3);
+  const std::size_t K = winograd_filter.transformed_filters[0].shape(0);
+  assert(winograd_filter.transformed_filters[0].shape(1) == C);
+
+  const std::size_t OH = ConvOutputSize(H, detail::kWinogradKernelSize, 1, pad);
+  const std::size_t OW = ConvOutputSize(W, detail::kWinogradKernelSize, 1, pad);
+  const std::size_t tile_rows = (OH + m - 1) / m;
+  const std::size_t tile_cols = (OW + m - 1) / m;
+  const std::size_t P = N * tile_rows * tile_cols;  // Number of tiles.
+
+  // Input transform "B^T d B", split into alpha^2 matrices whose shape is {C, P}.
+  std::vector<xt::xarray<float>> transformed_inputs;
+  transformed_inputs.reserve(alpha * alpha);
+  for (std::size_t i = 0; i < alpha * alpha; ++i) {
+    transformed_inputs.push_back(xt::zeros<float>({C, P}));
+  }
+
+  const float* input_pointer = input_data.data();
+  float d[6 * 6];
+  float transformed_tile[6 * 6];
+  for (std::size_t n = 0; n < N; ++n) {
+    for (std::size_t c = 0; c < C; ++c) {
+      const float* channel_pointer = input_pointer + (n * C + c) * H * W;
+      for (std::size_t tile_row = 0; tile_row < tile_rows; ++tile_row) {
+        for (std::size_t tile_col = 0; tile_col < tile_cols; ++tile_col) {
+          // Extracts the alpha x alpha input tile, where the positions outside of the image are zero padding.
+          for (std::size_t i = 0; i < alpha; ++i) {
+            const long h = static_cast<long>(tile_row * m + i) - static_cast<long>(pad);
+            for (std::size_t j = 0; j < alpha; ++j) {
+              const long w = static_cast<long>(tile_col * m + j) - static_cast<long>(pad);
+              const bool is_inside = (0 <= h && h < static_cast<long>(H) && 0 <= w && w < static_cast<long>(W));
+              d[i * alpha + j] = is_inside ? channel_pointer[h * W + w] : 0.0;
+            }
+          }
+
+          detail::SandwichTransform(BT, d, alpha, alpha, transformed_tile);  // B^T d B
+
+          const std::size_t p = (n * tile_rows + tile_row) * tile_cols + tile_col;
+          for (std::size_t i = 0; i < alpha * alpha; ++i) {
+            transformed_inputs[i](c, p) = transformed_tile[i];
+          }
+        }
+      }
+    }
+  }
+
+  // Element-wise products summed over the input channels, which are alpha^2 GEMMs: {K, C} x {C, P} ---> {K, P}
+  std::vector<xt::xarray<float>> transformed_outputs;
+  transformed_outputs.reserve(alpha * alpha);
+  for (std::size_t i = 0; i < alpha * alpha; ++i) {
+    transformed_outputs.push_back(xt::linalg::dot(winograd_filter.transformed_filters[i], transformed_inputs[i]));
+  }
+
+  // Output transform "A^T M A", and scatters each m x m tile into the output image (cropping the overhanging tiles).
+  xt::xarray<float> output_data = xt::zeros<float>({N, K, OH, OW});
+  float* output_pointer = output_data.data();
+  float M[6 * 6];
+  float Y[4 * 4];
+  for (std::size_t k = 0; k < K; ++k) {
+    for (std::size_t p = 0; p < P; ++p) {
+      for (std::size_t i = 0; i < alpha * alpha; ++i) {
+        M[i] = transformed_outputs[i](k, p);
+      }
+
+      detail::SandwichTransform(AT, M, m, alpha, Y);  // A^T M A
+
+      const std::size_t n = p / (tile_rows * tile_cols);
+      const std::size_t tile_row = (p / tile_cols) % tile_rows;
+      const std::size_t tile_col = p % tile_cols;
+      float* channel_pointer = output_pointer + (n * K + k) * OH * OW;
+      for (std::size_t i = 0; i < m && tile_row * m + i < OH; ++i) {
+        for (std::size_t j = 0; j < m && tile_col * m + j < OW; ++j) {
+          channel_pointer[(tile_row * m + i) * OW + (tile_col * m + j)] = Y[i * m + j];
+        }
+      }
+    }
+  }
+
+  return output_data;
+}
+
+}  // namespace tensorward::util
@@ -0,0 +1,200 @@
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <xtensor/xarray.hpp>
+#include <xtensor/xbuilder.hpp>
+
+#include "tensorward/core.h"
+#include "tensorward/util.h"
+
+namespace TW = tensorward::core;
+namespace U = tensorward::util;
+
+namespace {
+
+constexpr std::size_t kDefaultNumRecordsPerFile = 65536;
+
+// Parses the non-negative integer argument (or keeps the default value if it's not given), and returns false if it's
+// not a number (or out of range).
+const bool ParseSizeArgument(const int argc, char* argv[], const int index, std::size_t& value) {
+  if (argc <= index) {
+    return true;
+  }
+  const std::string_view argument = argv[index];
+  const auto [end, error_code] = std::from_chars(argument.data(), argument.data() + argument.size(), value);
+  return error_code == std::errc() && end == argument.data() + argument.size();
+}
+
+void PrintUsage(const char* program_name) {
+  std::cerr << "Usage:" << std::endl
+            << "  " << program_name << " idx <data IDX file> <label IDX file> <output prefix> [records per file]"
+            << std::endl
+            << "  " << program_name << " csv <CSV file> <output prefix> [records per file] [label column]"
+            << std::endl
+            << "where the number of the records per file must be positive." << std::endl;
+}
+
+// Returns the i-th record (i.e. the sub-array along the first axis) of the IDX file.
+const xt::xarray<float> IdxRecordAt(const U::IdxFile& idx_file, const std::size_t i) {
+  const xt::xarray<float>::shape_type record_shape(idx_file.shape.begin() + 1, idx_file.shape.end());
+  xt::xarray<float> record = xt::empty<float>(record_shape);
+  U::ConvertIdxFileToFloat(idx_file, i * record.size(), record.size(), record.data());
+  return record;
+}
+
+// Writer into the record files of up to the number of the records each, named "<prefix>-<5-digit file index>.twrec".
+class ShardedRecordFileWriter {
+ public:
+  ShardedRecordFileWriter(const std::string& output_prefix, const std::size_t num_records_per_file)
+      : output_prefix_(output_prefix), num_records_per_file_(num_records_per_file), num_records_(0), num_files_(0) {
+    const std::filesystem::path output_directory_path = std::filesystem::path(output_prefix_).parent_path();
+    if (!output_directory_path.empty()) {
+      std::filesystem::create_directories(output_directory_path);
+    }
+  }
+
+  const bool Write(const xt::xarray<float>& data, const xt::xarray<float>& label) {
+    if (num_records_ % num_records_per_file_ == 0) {
+      if (writer_ptr_ && !writer_ptr_->Close()) {
+        return false;
+      }
+      char file_index[16];
+      std::snprintf(file_index, sizeof(file_index), "%05zu", num_files_++);
+      writer_ptr_ = std::make_unique<TW::RecordFileWriter>(output_prefix_ + "-" + file_index + ".twrec");
+    }
+    ++num_records_;
+    return writer_ptr_->Write(data, label);
+  }
+
+  const bool Close() { return !writer_ptr_ || writer_ptr_->Close(); }
+
+  const std::size_t num_records() const { return num_records_; }
+
+  const std::size_t num_files() const { return num_files_; }
+
+ private:
+  std::string output_prefix_;
+
+  std::size_t num_records_per_file_;
+
+  std::size_t num_records_;
+
+  std::size_t num_files_;
+
+  std::unique_ptr<TW::RecordFileWriter> writer_ptr_;
+};
+
+int ConvertIdx(const std::filesystem::path& data_file_path, const std::filesystem::path& label_file_path,
+               ShardedRecordFileWriter& writer) {
+  U::IdxFile data_file;
+  U::IdxFile label_file;
+  if (!U::ReadIdxFile(data_file_path, data_file) || !U::ReadIdxFile(label_file_path, label_file)) {
+    std::cerr << "Failed to read the IDX files." << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (data_file.shape[0] != label_file.shape[0]) {
+    std::cerr << "The numbers of the data and the labels are different." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  for (std::size_t i = 0; i < data_file.shape[0]; ++i) {
+    if (!writer.Write(IdxRecordAt(data_file, i), IdxRecordAt(label_file, i))) {
+      std::cerr << "Failed to write the record " << i << "." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+// Converts each line of the CSV file into a record, whose label is the column of the index and whose data is the
+// other columns. The first line is skipped if it's not numeric (i.e. the header).
+int ConvertCsv(const std::filesystem::path& csv_file_path, const std::size_t label_column,
+               ShardedRecordFileWriter& writer) {
+  std::ifstream ifs(csv_file_path);
+  if (!ifs) {
+    std::cerr << "Failed to read the CSV file." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::size_t num_columns = 0;
+  std::string line;
+  std::vector<float> values;
+  for (std::size_t line_number = 1; std::getline(ifs, line); ++line_number) {
+    if (line.empty() || line == "\r") {
+      continue;
+    }
+
+    // Parses the comma-separated values.
+    values.clear();
+    bool is_numeric = true;
+    std::stringstream ss(line);
+    std::string field;
+    while (std::getline(ss, field, ',')) {
+      char* end;
+      values.push_back(std::strtof(field.c_str(), &end));
+      is_numeric = is_numeric && end != field.c_str() && (*end == '\0' || *end == '\r');
+    }
+    if (!is_numeric && line_number == 1) {
+      continue;
+    }
+    if (num_columns == 0) {
+      num_columns = values.size();
+    }
+    if (!is_numeric || values.size() != num_columns || num_columns <= label_column) {
+      std::cerr << "Invalid line " << line_number << ": " << line << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    xt::xarray<float> data = xt::empty<float>({num_columns - 1});
+    std::copy(values.begin(), values.begin() + label_column, data.begin());
+    std::copy(values.begin() + label_column + 1, values.end(), data.begin() + label_column);
+    if (!writer.Write(data, xt::xarray<float>(values[label_column]))) {
+      std::cerr << "Failed to write the record of the line " << line_number << "." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+}  // namespace
+
+// Converts a dataset into the record files of tensorward (see `tensorward::core::RecordFileWriter`).
+//
+// Usage:
+//   main idx <data IDX file> <label IDX file> <output prefix> [number of records per file (default: 65536)]
+//   main csv <CSV file> <output prefix> [number of records per file (default: 65536)] [label column (default: 0)]
+//
+// The IDX files can be gzip-compressed (e.g. "train-images-idx3-ubyte.gz" of MNIST), and the output files are named
+// "<output prefix>-<5-digit file index>.twrec".
+int main(int argc, char* argv[]) {
+  const std::string format = (2 <= argc) ? argv[1] : "";
+  std::size_t num_records_per_file = kDefaultNumRecordsPerFile;
+  std::size_t label_column = 0;
+  const bool is_idx =
+      format == "idx" && 5 <= argc && argc <= 6 && ParseSizeArgument(argc, argv, 5, num_records_per_file);
+  const bool is_csv = format == "csv" && 4 <= argc && argc <= 6 &&
+                      ParseSizeArgument(argc, argv, 4, num_records_per_file) &&
+                      ParseSizeArgument(argc, argv, 5, label_column);
+  if ((!is_idx && !is_csv) || num_records_per_file == 0) {
+    PrintUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  ShardedRecordFileWriter writer(is_idx ? argv[4] : argv[3], num_records_per_file);
+  int status = is_idx ? ConvertIdx(argv[2], argv[3], writer) : ConvertCsv(argv[2], label_column, writer);
+  status = (writer.Close()) ? status : EXIT_FAILURE;
+  std::cout << "Converted " << writer.num_records() << " records into " << writer.num_files() << " files."
+            << std::endl;
+
+  return status;
+}